@@ -20,14 +20,43 @@ let package = Package(
         // Targets are the basic building blocks of a package, defining a module or a test suite.
         // Targets can depend on other targets in this package and products from dependencies.
 
+        // The number formatting and parsing used by the lexer, built as C with
+        // the settings of its upstream CMakeLists.txt.
+        .target(
+            name: "dtoa",
+            path: "Sources/cxxHermesForSwift/include/dtoa",
+            sources: ["dtoa.c", "g_fmt.c", "locks.cpp"],
+            cSettings: [
+                .define("IEEE_8087"),
+                .define("Long", to: "int"),
+                .define("NO_HEX_FP"),
+                .define("NO_INFNAN_CHECK"),
+                .define("MULTIPLE_THREADS"),
+            ]
+        ),
+
         .target(
             name: "cxxHermesForSwift",
+            dependencies: [
+                "dtoa",
+            ],
             path: "Sources/cxxHermesForSwift",
-            sources: ["Greeter.cpp"],
+            sources: [
+                "Greeter.cpp",
+                "HermesDocBlock.cpp",
+                "HermesESTreeBridge.cpp",
+                "HermesJSON.cpp",
+                "HermesParseSession.cpp",
+                // The parser, the AST and the support code they use.
+                "hermes",
+            ],
             publicHeadersPath: "include",
             cxxSettings: [
                 .unsafeFlags(["-std=c++17"]),
                 .headerSearchPath("include"), // maybe?
+                // SwiftPM does not define NDEBUG itself, which would leave
+                // the assertions and the parser statistics in release builds.
+                .define("NDEBUG", .when(configuration: .release)),
             ],
             swiftSettings: [
                 .interoperabilityMode(.Cxx),
@@ -49,9 +78,51 @@ let package = Package(
             ]
         ),
 
+        // Benchmarks. Generate inputs with utils/gen-bench-corpus.py, then run
+        // `swift run -c release hermes-parser-bench .build/bench-corpus`.
+        .executableTarget(
+            name: "hermes-parser-bench",
+            dependencies: [
+                "cxxHermesForSwift",
+            ],
+            path: "Sources/hermes-parser-bench",
+            cxxSettings: [
+                .unsafeFlags(["-std=c++17"]),
+                .define("NDEBUG", .when(configuration: .release)),
+            ]
+        ),
+
+        .executableTarget(
+            name: "swift-hermes-bench",
+            dependencies: [
+                "swift-cpp-hermes",
+            ],
+            path: "Sources/swift-hermes-bench",
+            swiftSettings: [
+                .interoperabilityMode(.Cxx),
+            ]
+        ),
+
+        // Hardware counters of the lexer's hot paths on synthetic inputs
+        // (Linux only): `swift run -c release hermes-lexer-perf`.
+        .executableTarget(
+            name: "hermes-lexer-perf",
+            dependencies: [
+                "cxxHermesForSwift",
+            ],
+            path: "Sources/hermes-lexer-perf",
+            cxxSettings: [
+                .unsafeFlags(["-std=c++17"]),
+                .define("NDEBUG", .when(configuration: .release)),
+            ]
+        ),
+
         .testTarget(
             name: "swift-cpp-hermesTests",
-            dependencies: ["swift-cpp-hermes"]
+            dependencies: ["swift-cpp-hermes"],
+            swiftSettings: [
+                .interoperabilityMode(.Cxx),
+            ]
         ),
     ]
 )
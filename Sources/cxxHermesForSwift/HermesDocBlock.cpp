@@ -0,0 +1,27 @@
+#include "include/HermesDocBlock.h"
+
+#include "hermes/Parser/DocBlock.h"
+#include "hermes/Parser/FlowHelpers.h"
+
+using namespace hermes::parser;
+
+HermesDocBlock hermesScanDocBlock(const char *data, size_t size) {
+  HermesDocBlock result;
+  std::vector<StoredComment> comments;
+  result.end = scanDocBlock(
+                   llvh::StringRef(data, size),
+                   [&](const DocBlockComment &comment) {
+                     result.comments.push_back(comment.text.str());
+                     comments.emplace_back(
+                         comment.kind,
+                         llvh::SMRange{
+                             llvh::SMLoc::getFromPointer(comment.text.begin()),
+                             llvh::SMLoc::getFromPointer(comment.text.end())});
+                   },
+                   [&](llvh::StringRef name, const DocBlockComment &) {
+                     result.pragmas.push_back(name.str());
+                   })
+                   .end;
+  result.hasFlowPragma = hasFlowPragma(comments);
+  return result;
+}
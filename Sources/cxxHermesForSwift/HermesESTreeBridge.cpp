@@ -0,0 +1,215 @@
+#include "include/HermesESTreeBridge.h"
+
+using namespace hermes::ESTree;
+
+namespace {
+
+enum class FieldType { Ptr, List, String, Boolean, Number };
+
+/// The address and type of a node field.
+struct Field {
+  const void *addr;
+  FieldType type;
+};
+
+// NodeLabel and NodeString are the same type, so both are String.
+inline Field fieldOf(const NodePtr &f) {
+  return {&f, FieldType::Ptr};
+}
+inline Field fieldOf(const NodeList &f) {
+  return {&f, FieldType::List};
+}
+inline Field fieldOf(const NodeString &f) {
+  return {&f, FieldType::String};
+}
+inline Field fieldOf(const NodeBoolean &f) {
+  return {&f, FieldType::Boolean};
+}
+inline Field fieldOf(const NodeNumber &f) {
+  return {&f, FieldType::Number};
+}
+
+/// \return field \p index of \p node, in ESTree.def order.
+Field getField(const Node *node, unsigned index) {
+  switch (node->getKind()) {
+    default:
+      break;
+
+#define ESTREE_FIELD(ARGNM, I) \
+  case I:                      \
+    return fieldOf(n->_##ARGNM);
+#define ESTREE_FIELDS(NAME, FIELDS)          \
+  case NodeKind::NAME: {                     \
+    auto *n = llvh::cast<NAME##Node>(node);  \
+    (void)n;                                 \
+    switch (index) { FIELDS }                \
+    break;                                   \
+  }
+
+#define ESTREE_NODE_0_ARGS(NAME, BASE) ESTREE_FIELDS(NAME, )
+#define ESTREE_NODE_1_ARGS(NAME, BASE, T0, N0, O0) \
+  ESTREE_FIELDS(NAME, ESTREE_FIELD(N0, 0))
+#define ESTREE_NODE_2_ARGS(NAME, BASE, T0, N0, O0, T1, N1, O1) \
+  ESTREE_FIELDS(NAME, ESTREE_FIELD(N0, 0) ESTREE_FIELD(N1, 1))
+#define ESTREE_NODE_3_ARGS(NAME, BASE, T0, N0, O0, T1, N1, O1, T2, N2, O2) \
+  ESTREE_FIELDS(                                                          \
+      NAME, ESTREE_FIELD(N0, 0) ESTREE_FIELD(N1, 1) ESTREE_FIELD(N2, 2))
+#define ESTREE_NODE_4_ARGS(                                                \
+    NAME, BASE, T0, N0, O0, T1, N1, O1, T2, N2, O2, T3, N3, O3)           \
+  ESTREE_FIELDS(                                                          \
+      NAME,                                                               \
+      ESTREE_FIELD(N0, 0) ESTREE_FIELD(N1, 1) ESTREE_FIELD(N2, 2)         \
+          ESTREE_FIELD(N3, 3))
+#define ESTREE_NODE_5_ARGS(                                                \
+    NAME, BASE, T0, N0, O0, T1, N1, O1, T2, N2, O2, T3, N3, O3, T4, N4, O4) \
+  ESTREE_FIELDS(                                                          \
+      NAME,                                                               \
+      ESTREE_FIELD(N0, 0) ESTREE_FIELD(N1, 1) ESTREE_FIELD(N2, 2)         \
+          ESTREE_FIELD(N3, 3) ESTREE_FIELD(N4, 4))
+#define ESTREE_NODE_6_ARGS(                                                \
+    NAME,                                                                 \
+    BASE,                                                                 \
+    T0, N0, O0,                                                           \
+    T1, N1, O1,                                                           \
+    T2, N2, O2,                                                           \
+    T3, N3, O3,                                                           \
+    T4, N4, O4,                                                           \
+    T5, N5, O5)                                                           \
+  ESTREE_FIELDS(                                                          \
+      NAME,                                                               \
+      ESTREE_FIELD(N0, 0) ESTREE_FIELD(N1, 1) ESTREE_FIELD(N2, 2)         \
+          ESTREE_FIELD(N3, 3) ESTREE_FIELD(N4, 4) ESTREE_FIELD(N5, 5))
+#define ESTREE_NODE_7_ARGS(                                                \
+    NAME,                                                                 \
+    BASE,                                                                 \
+    T0, N0, O0,                                                           \
+    T1, N1, O1,                                                           \
+    T2, N2, O2,                                                           \
+    T3, N3, O3,                                                           \
+    T4, N4, O4,                                                           \
+    T5, N5, O5,                                                           \
+    T6, N6, O6)                                                           \
+  ESTREE_FIELDS(                                                          \
+      NAME,                                                               \
+      ESTREE_FIELD(N0, 0) ESTREE_FIELD(N1, 1) ESTREE_FIELD(N2, 2)         \
+          ESTREE_FIELD(N3, 3) ESTREE_FIELD(N4, 4) ESTREE_FIELD(N5, 5)     \
+              ESTREE_FIELD(N6, 6))
+#define ESTREE_NODE_8_ARGS(                                                \
+    NAME,                                                                 \
+    BASE,                                                                 \
+    T0, N0, O0,                                                           \
+    T1, N1, O1,                                                           \
+    T2, N2, O2,                                                           \
+    T3, N3, O3,                                                           \
+    T4, N4, O4,                                                           \
+    T5, N5, O5,                                                           \
+    T6, N6, O6,                                                           \
+    T7, N7, O7)                                                           \
+  ESTREE_FIELDS(                                                          \
+      NAME,                                                               \
+      ESTREE_FIELD(N0, 0) ESTREE_FIELD(N1, 1) ESTREE_FIELD(N2, 2)         \
+          ESTREE_FIELD(N3, 3) ESTREE_FIELD(N4, 4) ESTREE_FIELD(N5, 5)     \
+              ESTREE_FIELD(N6, 6) ESTREE_FIELD(N7, 7))
+#define ESTREE_NODE_9_ARGS(                                                \
+    NAME,                                                                 \
+    BASE,                                                                 \
+    T0, N0, O0,                                                           \
+    T1, N1, O1,                                                           \
+    T2, N2, O2,                                                           \
+    T3, N3, O3,                                                           \
+    T4, N4, O4,                                                           \
+    T5, N5, O5,                                                           \
+    T6, N6, O6,                                                           \
+    T7, N7, O7,                                                           \
+    T8, N8, O8)                                                           \
+  ESTREE_FIELDS(                                                          \
+      NAME,                                                               \
+      ESTREE_FIELD(N0, 0) ESTREE_FIELD(N1, 1) ESTREE_FIELD(N2, 2)         \
+          ESTREE_FIELD(N3, 3) ESTREE_FIELD(N4, 4) ESTREE_FIELD(N5, 5)     \
+              ESTREE_FIELD(N6, 6) ESTREE_FIELD(N7, 7) ESTREE_FIELD(N8, 8))
+
+#include "hermes/AST/ESTree.def"
+
+#undef ESTREE_FIELDS
+#undef ESTREE_FIELD
+  }
+  llvm_unreachable("invalid ESTree field index");
+}
+
+/// \return field \p index of \p node, which must have type \p type.
+inline const void *
+getField(const void *node, unsigned index, FieldType type) {
+  Field field = getField(static_cast<const Node *>(node), index);
+  assert(field.type == type && "ESTree field accessed with the wrong type");
+  (void)type;
+  return field.addr;
+}
+
+} // namespace
+
+NodeKind hermesNodeKind(const void *node) {
+  return static_cast<const Node *>(node)->getKind();
+}
+
+const char *hermesNodeKindName(unsigned kind) {
+  switch (static_cast<NodeKind>(kind)) {
+#define ESTREE_NODE_0_ARGS(NAME, ...) \
+  case NodeKind::NAME:                \
+    return #NAME;
+#define ESTREE_NODE_1_ARGS(NAME, ...) ESTREE_NODE_0_ARGS(NAME)
+#define ESTREE_NODE_2_ARGS(NAME, ...) ESTREE_NODE_0_ARGS(NAME)
+#define ESTREE_NODE_3_ARGS(NAME, ...) ESTREE_NODE_0_ARGS(NAME)
+#define ESTREE_NODE_4_ARGS(NAME, ...) ESTREE_NODE_0_ARGS(NAME)
+#define ESTREE_NODE_5_ARGS(NAME, ...) ESTREE_NODE_0_ARGS(NAME)
+#define ESTREE_NODE_6_ARGS(NAME, ...) ESTREE_NODE_0_ARGS(NAME)
+#define ESTREE_NODE_7_ARGS(NAME, ...) ESTREE_NODE_0_ARGS(NAME)
+#define ESTREE_NODE_8_ARGS(NAME, ...) ESTREE_NODE_0_ARGS(NAME)
+#define ESTREE_NODE_9_ARGS(NAME, ...) ESTREE_NODE_0_ARGS(NAME)
+#include "hermes/AST/ESTree.def"
+    default:
+      return nullptr;
+  }
+}
+
+HermesSourceRange hermesNodeSourceRange(const void *node) {
+  SMRange range = static_cast<const Node *>(node)->getSourceRange();
+  return {range.Start.getPointer(), range.End.getPointer()};
+}
+
+const void *hermesNodeGetNode(const void *node, unsigned index) {
+  return *static_cast<const NodePtr *>(getField(node, index, FieldType::Ptr));
+}
+
+const void *hermesNodeGetList(const void *node, unsigned index) {
+  return getField(node, index, FieldType::List);
+}
+
+HermesStringRef hermesNodeGetString(const void *node, unsigned index) {
+  const NodeString str =
+      *static_cast<const NodeString *>(getField(node, index, FieldType::String));
+  if (!str)
+    return {nullptr, 0};
+  return {str->str().data(), str->str().size()};
+}
+
+bool hermesNodeGetBoolean(const void *node, unsigned index) {
+  return *static_cast<const NodeBoolean *>(
+      getField(node, index, FieldType::Boolean));
+}
+
+double hermesNodeGetNumber(const void *node, unsigned index) {
+  return *static_cast<const NodeNumber *>(
+      getField(node, index, FieldType::Number));
+}
+
+const void *hermesNodeListFirst(const void *list) {
+  auto *l = static_cast<const NodeList *>(list);
+  return l->empty() ? nullptr : &l->front();
+}
+
+const void *hermesNodeListNext(const void *list, const void *node) {
+  auto *l = static_cast<const NodeList *>(list);
+  auto it = static_cast<const Node *>(node)->getIterator();
+  ++it;
+  return it == l->end() ? nullptr : &*it;
+}
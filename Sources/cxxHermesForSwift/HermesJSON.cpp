@@ -0,0 +1,102 @@
+#include "include/HermesJSON.h"
+
+#include "hermes/Parser/JSONCursor.h"
+#include "hermes/Support/JSONEmitter.h"
+#include "hermes/Support/SourceErrorManager.h"
+
+#include "llvh/Support/MemoryBuffer.h"
+#include "llvh/Support/raw_ostream.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace hermes::parser;
+
+namespace {
+
+/// \return \p value printed as compact JSON.
+std::string printJSON(const JSONValue *value) {
+  std::string output;
+  llvh::raw_string_ostream os{output};
+  hermes::JSONEmitter json{os};
+  value->emitInto(json);
+  os.flush();
+  return output;
+}
+
+} // namespace
+
+std::string hermesFormatJSON(
+    const char *data,
+    size_t size,
+    JSONParserEngine engine) {
+  assert(data[size] == 0 && "buffer must be zero terminated");
+  hermes::SourceErrorManager sm;
+  // Only whether there are errors matters.
+  sm.setDiagHandler([](const llvh::SMDiagnostic &, void *) {});
+  JSONFactory::Allocator allocator;
+  JSONFactory factory{allocator};
+  JSONParser parser{
+      factory,
+      llvh::MemoryBuffer::getMemBuffer(
+          llvh::StringRef(data, size), "JSON", /* RequiresNullTerminator */ true),
+      sm};
+  parser.setEngine(engine);
+  auto value = parser.parse();
+
+  std::string output;
+  if (!value || sm.getErrorCount() != 0)
+    return output;
+  return printJSON(*value);
+}
+
+std::string hermesFindJSONField(
+    const char *data,
+    size_t size,
+    const std::string &name) {
+  assert(data[size] == 0 && "buffer must be zero terminated");
+  hermes::SourceErrorManager sm;
+  sm.setDiagHandler([](const llvh::SMDiagnostic &, void *) {});
+  JSONFactory::Allocator allocator;
+  JSONFactory factory{allocator};
+  JSONCursor cursor{
+      llvh::MemoryBuffer::getMemBuffer(
+          llvh::StringRef(data, size), "JSON", /* RequiresNullTerminator */ true),
+      sm};
+  if (!cursor.enterObject() || !cursor.findField(name))
+    return std::string{};
+  auto value = cursor.getValue(factory);
+  // The rest of the object must be readable too.
+  if (!value || !cursor.exitContainer() || sm.getErrorCount() != 0)
+    return std::string{};
+  return printJSON(*value);
+}
+
+HermesJSONLines hermesReadJSONLines(
+    const char *data,
+    size_t size,
+    const JSONLinesOptions &options,
+    unsigned recordDelayUs) {
+  assert(data[size] == 0 && "buffer must be zero terminated");
+  HermesJSONLines out;
+  JSONLinesReader reader{options};
+  out.ok = reader.read(
+      *llvh::MemoryBuffer::getMemBuffer(
+          llvh::StringRef(data, size),
+          "JSON Lines",
+          /* RequiresNullTerminator */ true),
+      [&](size_t offset, JSONSharedValue value) {
+        if (recordDelayUs)
+          std::this_thread::sleep_for(std::chrono::microseconds(recordDelayUs));
+        out.offsets.push_back(offset);
+        out.records.push_back(printJSON(*value));
+        return true;
+      },
+      [&](size_t offset, llvh::StringRef message) {
+        out.offsets.push_back(offset);
+        out.records.push_back("error: " + message.str());
+        return true;
+      });
+  out.peakChunksInFlight = reader.getPeakChunksInFlight();
+  return out;
+}
@@ -0,0 +1,527 @@
+#include "include/HermesParseSession.h"
+
+#include "hermes/AST/ESTreeJSONDumper.h"
+#include "hermes/Parser/JSParser.h"
+#include "hermes/Support/SourceErrorManager.h"
+
+#include "llvh/Support/MemoryBuffer.h"
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using hermes::parser::ParseInterrupt;
+
+void HermesParseCanceller::cancel() const {
+  interrupt_->cancel();
+}
+
+struct HermesParseSession::Impl {
+  hermes::SourceErrorManager sm{};
+  hermes::Context context{sm};
+  hermes::ESTree::ProgramNode *program = nullptr;
+  /// Shared with the context and with every HermesParseCanceller.
+  std::shared_ptr<ParseInterrupt> interrupt =
+      std::make_shared<ParseInterrupt>();
+  std::chrono::microseconds timeLimit{0};
+  /// Set as the statistics of the context if they are collected.
+  hermes::parser::ParseStats stats{};
+  /// Formatted diagnostics, see getErrors().
+  std::string errors{};
+  /// The types skipped by the last parse, and its source.
+  std::vector<hermes::parser::SkippedType> skippedTypes{};
+  const char *bufferStart = nullptr;
+  size_t bufferSize = 0;
+  /// The source buffer of the last parse in sm, or 0.
+  uint32_t bufferId = 0;
+  /// The source of reparse(), with room to grow. An edit is applied to it in
+  /// place, so that the locations before the edit stay where they are.
+  std::unique_ptr<char[]> editable{};
+  size_t editableCapacity = 0;
+  /// The arena bytes allocated before the last reset of the arena, and by
+  /// the last full parse. reparse() leaves the statements it replaces in the
+  /// arena, so it starts over once they may outweigh the program.
+  uint64_t arenaStart = 0;
+  uint64_t parsedBytes = 0;
+  /// Whether the last reparse() only parsed the statements around the edit.
+  bool reparsedIncrementally = false;
+  /// The dependencies found by the last scanDependencies().
+  std::vector<hermes::parser::ModuleDependency> dependencies{};
+  /// The output of the last stripTypes().
+  std::string strippedCode{};
+  std::string strippedSourceMap{};
+  /// See HermesParseOptions::detectDialect.
+  bool detectDialect = false;
+  /// Whether the last parse detected its dialect, and the dialect.
+  bool dialectDetected = false;
+  hermes::parser::SourceDialect dialect = hermes::parser::SourceDialect::JS;
+
+  static void collectDiagnostic(const llvh::SMDiagnostic &diag, void *ctx) {
+    auto *self = static_cast<Impl *>(ctx);
+    if (diag.getLineNo() > 0) {
+      self->errors += diag.getFilename();
+      self->errors += ':';
+      self->errors += std::to_string(diag.getLineNo());
+      self->errors += ':';
+      self->errors += std::to_string(diag.getColumnNo() + 1);
+      self->errors += ": ";
+    }
+    self->errors += diag.getMessage();
+    self->errors += '\n';
+  }
+
+  /// Prepare for a parse, reparse, strip or scan: give it a fresh time limit,
+  /// step budget and errors, so that it is not failed by the errors or
+  /// the interruption of an earlier one. Only a cancellation carries over,
+  /// see HermesParseCanceller.
+  void beginParse() {
+    interrupt->restart();
+    errors.clear();
+    if (timeLimit.count() != 0)
+      interrupt->setDeadline(ParseInterrupt::Clock::now() + timeLimit);
+    sm.clearErrorLimitReached();
+  }
+
+  /// If dialects are detected, set up the context for the dialect of the
+  /// buffer \p bufferId.
+  void applyDetectedDialect(uint32_t bufferId) {
+    dialectDetected = detectDialect;
+    if (!detectDialect)
+      return;
+    dialect = hermes::parser::detectSourceDialect(context, bufferId);
+    hermes::parser::applySourceDialect(context, dialect);
+  }
+
+  /// Register \p buffer as the source of the next parse, in place of the
+  /// source of the last one, whose locations must not be used again.
+  /// \return its buffer id.
+  uint32_t addSource(std::unique_ptr<llvh::MemoryBuffer> buffer) {
+    if (bufferId)
+      sm.removeSourceBuffer(bufferId);
+    bufferStart = buffer->getBufferStart();
+    bufferSize = buffer->getBufferSize();
+    bufferId = sm.addNewSourceBuffer(std::move(buffer));
+    return bufferId;
+  }
+
+  /// \return a parser for \p buffer, see applyDetectedDialect(). The dialect
+  /// of the last parse is kept if \p keepDialect.
+  hermes::parser::JSParser createParser(
+      std::unique_ptr<llvh::MemoryBuffer> buffer,
+      bool keepDialect = false) {
+    uint32_t id = addSource(std::move(buffer));
+    if (!keepDialect)
+      applyDetectedDialect(id);
+    return hermes::parser::JSParser{context, id, hermes::parser::FullParse};
+  }
+
+  /// Parse \p buffer, passing every top-level statement to \p callback if
+  /// it is set (see JSParser::parseStreaming()).
+  bool parse(
+      std::unique_ptr<llvh::MemoryBuffer> buffer,
+      bool keepDialect = false,
+      hermes::parser::StatementCallback callback = nullptr) {
+    beginParse();
+    unsigned errorsBefore = sm.getErrorCount();
+    uint64_t allocatedBefore = context.getAllocator().getBytesAllocated();
+    reparsedIncrementally = false;
+    hermes::parser::JSParser parser =
+        createParser(std::move(buffer), keepDialect);
+    auto parsed =
+        callback ? parser.parseStreaming(callback) : parser.parse();
+    program = parsed ? *parsed : nullptr;
+    skippedTypes = parser.moveSkippedTypes();
+    dependencies.clear();
+    parsedBytes = context.getAllocator().getBytesAllocated() - allocatedBefore;
+    return program && sm.getErrorCount() == errorsBefore;
+  }
+
+  /// Make room for \p size bytes and a terminating zero in editable. The old
+  /// storage is moved to \p previous if it is replaced.
+  void reserveEditable(size_t size, std::unique_ptr<char[]> &previous) {
+    if (size < editableCapacity)
+      return;
+    previous = std::move(editable);
+    editableCapacity = size + size / 2 + 1;
+    editable.reset(new char[editableCapacity]);
+  }
+
+  /// Bring the program up to date with \p source, which is the source of the
+  /// last parse with \p edit applied. The program is parsed from a copy of
+  /// \p source, so that the session keeps no reference to it.
+  bool reparse(
+      llvh::StringRef source,
+      const std::string &name,
+      const hermes::parser::SourceEdit &edit) {
+    llvh::StringRef oldSource{bufferStart, bufferSize};
+    hermes::BacktrackingBumpPtrAllocator &allocator = context.getAllocator();
+    bool edited = program && hermes::parser::isEditOf(oldSource, source, edit);
+    if (!edited ||
+        allocator.getBytesAllocated() - arenaStart > 2 * parsedBytes) {
+      // The old program is dropped, along with the statements replaced in it.
+      // A program that is only parsed again to free them keeps its dialect,
+      // like one reparsed incrementally.
+      program = nullptr;
+      allocator.reset();
+      arenaStart = allocator.getBytesAllocated();
+      std::unique_ptr<char[]> previous;
+      reserveEditable(source.size(), previous);
+      memcpy(editable.get(), source.data(), source.size());
+      editable[source.size()] = 0;
+      return parse(editableBuffer(source.size(), name), edited);
+    }
+
+    beginParse();
+    unsigned errorsBefore = sm.getErrorCount();
+    uint64_t allocatedBefore = allocator.getBytesAllocated();
+    // Edit the source in place if the program was parsed from it, so that
+    // only the locations after the edit need to be moved. Otherwise copy it,
+    // keeping the old source alive until the locations have moved.
+    std::unique_ptr<char[]> previous;
+    bool inPlace = bufferStart == editable.get() &&
+        source.size() < editableCapacity;
+    if (inPlace) {
+      char *start = editable.get();
+      memmove(
+          start + edit.offset + edit.inserted,
+          start + edit.offset + edit.removed,
+          bufferSize - edit.offset - edit.removed);
+      memcpy(start + edit.offset, source.data() + edit.offset, edit.inserted);
+    } else {
+      reserveEditable(source.size(), previous);
+      memcpy(editable.get(), source.data(), source.size());
+    }
+    editable[source.size()] = 0;
+
+    // The buffers end at the same address if the size did not change, so
+    // the old one must be removed first when edited in place.
+    uint32_t oldBufferId = bufferId;
+    if (inPlace) {
+      sm.removeSourceBuffer(oldBufferId);
+      oldBufferId = 0;
+    }
+    bufferStart = editable.get();
+    bufferSize = source.size();
+    bufferId = sm.addNewSourceBuffer(editableBuffer(source.size(), name));
+    hermes::parser::JSParser parser{
+        context, bufferId, hermes::parser::FullParse};
+    auto parsed = parser.reparse(program, oldSource, edit, skippedTypes);
+    if (oldBufferId)
+      sm.removeSourceBuffer(oldBufferId);
+    program = parsed ? *parsed : nullptr;
+    reparsedIncrementally = parser.wasReparsedIncrementally();
+    skippedTypes = parser.moveSkippedTypes();
+    dependencies.clear();
+    if (!reparsedIncrementally)
+      parsedBytes = allocator.getBytesAllocated() - allocatedBefore;
+    return program && sm.getErrorCount() == errorsBefore;
+  }
+
+  /// \return a buffer for the first \p size bytes of editable.
+  std::unique_ptr<llvh::MemoryBuffer> editableBuffer(
+      size_t size,
+      const std::string &name) {
+    return llvh::MemoryBuffer::getMemBuffer(
+        llvh::StringRef(editable.get(), size),
+        name,
+        /* RequiresNullTerminator */ true);
+  }
+};
+
+HermesParseSession::HermesParseSession(const HermesParseOptions &options)
+    : impl_(std::make_shared<Impl>()) {
+  impl_->sm.setDiagHandler(Impl::collectDiagnostic, impl_.get());
+  hermes::Context &context = impl_->context;
+  context.setStrictMode(options.strictMode);
+  context.setParseJSX(options.parseJSX);
+  context.setParseFlow(options.parseFlow);
+  context.setParseFlowComponentSyntax(options.parseFlowComponentSyntax);
+  context.setParseTS(options.parseTS);
+  context.setTypeSyntax(options.typeSyntax);
+  impl_->detectDialect = options.detectDialect;
+  impl_->timeLimit = std::chrono::microseconds(options.timeLimitMicroseconds);
+  impl_->interrupt->setStepBudget(options.stepBudget);
+  context.setParseInterrupt(impl_->interrupt);
+  context.setMemoryLimit(options.memoryLimitBytes);
+  context.setMaxParseDepth(options.maxNestingDepth);
+  context.setParseStackLimit(options.stackLimitBytes);
+  if (options.collectStats)
+    context.setParseStats(&impl_->stats);
+
+  // Everything interned so far survives reset().
+  hermes::parser::JSParser::initializeKnownIdentifiers(context);
+  context.setStringTableCheckpoint();
+}
+
+bool HermesParseSession::parseBuffer(
+    const char *data,
+    size_t size,
+    const std::string &name) {
+  assert(data[size] == 0 && "buffer must be zero terminated");
+  return impl_->parse(llvh::MemoryBuffer::getMemBuffer(
+      llvh::StringRef(data, size), name, /* RequiresNullTerminator */ true));
+}
+
+bool HermesParseSession::parseBufferStreaming(
+    const char *data,
+    size_t size,
+    const std::string &name,
+    bool (*keep)(void *keepContext, hermes::ESTree::Node *statement),
+    void *keepContext) {
+  assert(data[size] == 0 && "buffer must be zero terminated");
+  using hermes::parser::StatementAction;
+  return impl_->parse(
+      llvh::MemoryBuffer::getMemBuffer(
+          llvh::StringRef(data, size), name, /* RequiresNullTerminator */ true),
+      /* keepDialect */ false,
+      [keep, keepContext](hermes::ESTree::Node *statement) {
+        return keep(keepContext, statement) ? StatementAction::Keep
+                                            : StatementAction::Release;
+      });
+}
+
+bool HermesParseSession::reparseBuffer(
+    const char *data,
+    size_t size,
+    const std::string &name,
+    size_t offset,
+    size_t removed,
+    size_t inserted) {
+  assert(data[size] == 0 && "buffer must be zero terminated");
+  // The whole buffer is parsed if there is no program or the edit does not
+  // match.
+  return impl_->reparse(
+      llvh::StringRef(data, size), name, {offset, removed, inserted});
+}
+
+bool HermesParseSession::wasReparsedIncrementally() const {
+  return impl_->reparsedIncrementally;
+}
+
+bool HermesParseSession::wasDialectDetected() const {
+  return impl_->dialectDetected;
+}
+
+hermes::parser::SourceDialect HermesParseSession::getDetectedDialect() const {
+  return impl_->dialect;
+}
+
+bool HermesParseSession::parseFile(const std::string &path) {
+  auto fileOrErr = llvh::MemoryBuffer::getFile(path);
+  if (!fileOrErr) {
+    impl_->beginParse();
+    impl_->program = nullptr;
+    impl_->skippedTypes.clear();
+    impl_->dependencies.clear();
+    impl_->sm.error(
+        llvh::SMLoc{},
+        "cannot read '" + path + "': " + fileOrErr.getError().message());
+    return false;
+  }
+  return impl_->parse(std::move(*fileOrErr));
+}
+
+bool HermesParseSession::stripTypes(
+    const char *data,
+    size_t size,
+    const std::string &name,
+    hermes::parser::StripMode mode,
+    bool buildSourceMap) {
+  assert(data[size] == 0 && "buffer must be zero terminated");
+  impl_->program = nullptr;
+  impl_->skippedTypes.clear();
+  impl_->dependencies.clear();
+  impl_->strippedCode.clear();
+  impl_->strippedSourceMap.clear();
+  impl_->beginParse();
+  uint32_t bufferId = impl_->addSource(llvh::MemoryBuffer::getMemBuffer(
+      llvh::StringRef(data, size), name, /* RequiresNullTerminator */ true));
+  impl_->applyDetectedDialect(bufferId);
+  hermes::parser::TypeStripper stripper{mode, buildSourceMap};
+  if (!stripper.strip(impl_->context, bufferId))
+    return false;
+  impl_->strippedCode = stripper.getOutput();
+  impl_->strippedSourceMap = stripper.getSourceMap(name);
+  return true;
+}
+
+bool HermesParseSession::scanDependencies(
+    const char *data,
+    size_t size,
+    const std::string &name) {
+  assert(data[size] == 0 && "buffer must be zero terminated");
+  impl_->program = nullptr;
+  impl_->skippedTypes.clear();
+  impl_->beginParse();
+  unsigned errorsBefore = impl_->sm.getErrorCount();
+  hermes::parser::JSParser parser =
+      impl_->createParser(llvh::MemoryBuffer::getMemBuffer(
+          llvh::StringRef(data, size),
+          name,
+          /* RequiresNullTerminator */ true));
+  bool scanned = parser.scanDependencies();
+  impl_->dependencies = parser.moveDependencies();
+  return scanned && impl_->sm.getErrorCount() == errorsBefore;
+}
+
+size_t HermesParseSession::getDependencyCount() const {
+  return impl_->dependencies.size();
+}
+
+hermes::parser::ModuleDependency::Kind HermesParseSession::getDependencyKind(
+    size_t index) const {
+  return impl_->dependencies[index].getKind();
+}
+
+bool HermesParseSession::isDependencyTypeOnly(size_t index) const {
+  return impl_->dependencies[index].isTypeOnly();
+}
+
+std::string HermesParseSession::getDependencySpecifier(size_t index) const {
+  return impl_->dependencies[index].getSpecifier()->str().str();
+}
+
+size_t HermesParseSession::getDependencyStart(size_t index) const {
+  return impl_->dependencies[index].getSourceRange().Start.getPointer() -
+      impl_->bufferStart;
+}
+
+size_t HermesParseSession::getDependencyEnd(size_t index) const {
+  return impl_->dependencies[index].getSourceRange().End.getPointer() -
+      impl_->bufferStart;
+}
+
+std::string HermesParseSession::getStrippedCode() const {
+  return impl_->strippedCode;
+}
+
+std::string HermesParseSession::getStrippedSourceMap() const {
+  return impl_->strippedSourceMap;
+}
+
+hermes::ESTree::ProgramNode *HermesParseSession::getProgram() const {
+  return impl_->program;
+}
+
+std::string HermesParseSession::dumpProgram() const {
+  std::string json;
+  if (!impl_->program)
+    return json;
+  llvh::raw_string_ostream os{json};
+  hermes::dumpESTreeJSON(
+      os,
+      impl_->program,
+      /* pretty */ false,
+      hermes::ESTreeDumpMode::HideEmpty,
+      impl_->sm,
+      hermes::LocationDumpMode::Range);
+  os.flush();
+  return json;
+}
+
+unsigned HermesParseSession::getErrorCount() const {
+  return impl_->sm.getErrorCount();
+}
+
+std::string HermesParseSession::getErrors() const {
+  return impl_->errors;
+}
+
+hermes::Context &HermesParseSession::getContext() const {
+  return impl_->context;
+}
+
+HermesParseCanceller HermesParseSession::getCanceller() const {
+  return HermesParseCanceller{impl_->interrupt};
+}
+
+bool HermesParseSession::wasInterrupted() const {
+  return impl_->interrupt->getReason() != ParseInterrupt::Reason::None;
+}
+
+size_t HermesParseSession::getSkippedTypeCount() const {
+  return impl_->skippedTypes.size();
+}
+
+hermes::parser::SkippedType::Kind HermesParseSession::getSkippedTypeKind(
+    size_t index) const {
+  return impl_->skippedTypes[index].getKind();
+}
+
+size_t HermesParseSession::getSkippedTypeStart(size_t index) const {
+  return impl_->skippedTypes[index].getSourceRange().Start.getPointer() -
+      impl_->bufferStart;
+}
+
+size_t HermesParseSession::getSkippedTypeEnd(size_t index) const {
+  return impl_->skippedTypes[index].getSourceRange().End.getPointer() -
+      impl_->bufferStart;
+}
+
+uint64_t HermesParseSession::getPeakMemoryBytes() const {
+  return impl_->context.getMemoryBudget().getPeak();
+}
+
+const hermes::parser::ParseStats &HermesParseSession::getParseStats() const {
+  return impl_->stats;
+}
+
+void HermesParseSession::reset() {
+  impl_->program = nullptr;
+  impl_->errors.clear();
+  impl_->skippedTypes.clear();
+  impl_->dependencies.clear();
+  impl_->bufferStart = nullptr;
+  impl_->bufferSize = 0;
+  impl_->bufferId = 0;
+  impl_->reparsedIncrementally = false;
+  impl_->dialectDetected = false;
+  impl_->strippedCode.clear();
+  impl_->strippedSourceMap.clear();
+  impl_->stats.clear();
+  impl_->context.resetParseState();
+  impl_->arenaStart = impl_->context.getAllocator().getBytesAllocated();
+  impl_->context.getMemoryBudget().resetPeak();
+  impl_->sm.clearBuffers();
+}
+
+struct HermesParseSessionPool::Impl {
+  Impl(const HermesParseOptions &options, size_t maxIdle)
+      : options(options), maxIdle(maxIdle) {}
+
+  const HermesParseOptions options;
+  const size_t maxIdle;
+  std::mutex mutex{};
+  std::vector<HermesParseSession> idle{};
+};
+
+HermesParseSessionPool::HermesParseSessionPool(
+    const HermesParseOptions &options,
+    size_t maxIdle)
+    : impl_(std::make_shared<Impl>(options, maxIdle)) {}
+
+HermesParseSession HermesParseSessionPool::acquire() const {
+  {
+    std::lock_guard<std::mutex> lock{impl_->mutex};
+    if (!impl_->idle.empty()) {
+      HermesParseSession session = std::move(impl_->idle.back());
+      impl_->idle.pop_back();
+      return session;
+    }
+  }
+  return HermesParseSession{impl_->options};
+}
+
+void HermesParseSessionPool::release(HermesParseSession session) const {
+  // Resetting frees the AST, so do it outside of the lock.
+  session.reset();
+  std::lock_guard<std::mutex> lock{impl_->mutex};
+  if (impl_->idle.size() < impl_->maxIdle)
+    impl_->idle.push_back(std::move(session));
+}
+
+size_t HermesParseSessionPool::getIdleCount() const {
+  std::lock_guard<std::mutex> lock{impl_->mutex};
+  return impl_->idle.size();
+}
@@ -8,6 +8,7 @@
 #include "hermes/AST/ESTreeJSONDumper.h"
 
 #include "hermes/Support/JSONEmitter.h"
+#include "hermes/Support/PerfSection.h"
 #include "llvh/ADT/StringMap.h"
 #include "llvh/ADT/StringSet.h"
 #include "llvh/Support/MemoryBuffer.h"
@@ -73,6 +74,7 @@ class ESTreeJSONDumper {
   }
 
   void doIt(NodePtr rootNode) {
+    PerfSection dumping("Dumping ESTree JSON");
     dumpNode(rootNode);
   }
 
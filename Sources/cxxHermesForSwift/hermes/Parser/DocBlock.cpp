@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Parser/DocBlock.h"
+
+#include "hermes/Platform/Unicode/CharacterProperties.h"
+#include "llvh/ADT/StringSwitch.h"
+
+#include <cstring>
+
+namespace hermes {
+namespace parser {
+
+namespace {
+
+/// Scans the comments and directives at the start of a source, with the
+/// rules of JSLexer, without reading past its end.
+class DocBlockScanner {
+ public:
+  explicit DocBlockScanner(llvh::StringRef source)
+      : start_(source.begin()), end_(source.end()), cur_(start_) {}
+
+  /// Scan up to the first token that is not a directive, calling
+  /// \p onComment with every comment on the way.
+  template <typename Fn>
+  size_t scan(Fn onComment) {
+    if (end_ - cur_ >= 2 && cur_[0] == '#' && cur_[1] == '!')
+      onComment(StoredComment::Kind::Hashbang, scanLineComment());
+
+    // Whether a directive was just scanned, so a ';' may end it.
+    bool afterDirective = false;
+    for (;;) {
+      cur_ = skipSpaces(cur_, /* stopAtLineTerminator */ false);
+      if (cur_ == end_)
+        return end_ - start_;
+      if (*cur_ == '/' && end_ - cur_ >= 2 && cur_[1] == '/') {
+        onComment(StoredComment::Kind::Line, scanLineComment());
+      } else if (*cur_ == '/' && end_ - cur_ >= 2 && cur_[1] == '*') {
+        const char *commentEnd = skipBlockComment(cur_);
+        onComment(
+            StoredComment::Kind::Block,
+            llvh::StringRef(cur_, commentEnd - cur_));
+        cur_ = commentEnd;
+      } else if (*cur_ == ';' && afterDirective) {
+        afterDirective = false;
+        ++cur_;
+      } else if (*cur_ == '"' || *cur_ == '\'') {
+        const char *stringEnd = skipDirective(cur_);
+        if (!stringEnd)
+          return cur_ - start_;
+        afterDirective = true;
+        cur_ = stringEnd;
+      } else {
+        return cur_ - start_;
+      }
+    }
+  }
+
+ private:
+  /// \return the length of the line or paragraph separator at \p p, or 0.
+  unsigned unicodeLineTerminatorAt(const char *p) const {
+    return end_ - p >= 3 && (unsigned char)p[0] == 0xe2 &&
+            (unsigned char)p[1] == 0x80 &&
+            ((unsigned char)p[2] == 0xa8 || (unsigned char)p[2] == 0xa9)
+        ? 3
+        : 0;
+  }
+
+  /// \return the length of the non-ASCII space at \p p (including the
+  ///   byte-order mark), or 0.
+  unsigned unicodeSpaceAt(const char *p) const {
+    auto *u = (const unsigned char *)p;
+    if (u[0] == 0xc2)
+      return end_ - p >= 2 && u[1] == 0xa0 ? 2 : 0;
+    // The other spaces are all encoded in three bytes.
+    if ((u[0] & 0xf0) != 0xe0 || end_ - p < 3 || (u[1] & 0xc0) != 0x80 ||
+        (u[2] & 0xc0) != 0x80)
+      return 0;
+    uint32_t cp = ((u[0] & 0x0f) << 12) | ((u[1] & 0x3f) << 6) | (u[2] & 0x3f);
+    return isUnicodeOnlySpace(cp) ? 3 : 0;
+  }
+
+  /// \return the first character at or after \p p that is not whitespace,
+  ///   or, with \p stopAtLineTerminator, that is a line terminator.
+  const char *skipSpaces(const char *p, bool stopAtLineTerminator) const {
+    while (p != end_) {
+      switch (*p) {
+        case ' ':
+        case '\t':
+        case '\v':
+        case '\f':
+          ++p;
+          continue;
+        case '\r':
+        case '\n':
+          if (stopAtLineTerminator)
+            return p;
+          ++p;
+          continue;
+        default:
+          break;
+      }
+      if (unsigned len = unicodeLineTerminatorAt(p)) {
+        if (stopAtLineTerminator)
+          return p;
+        p += len;
+      } else if (unsigned len = unicodeSpaceAt(p)) {
+        p += len;
+      } else {
+        return p;
+      }
+    }
+    return p;
+  }
+
+  /// Scan the line comment at cur_, up to its line terminator.
+  /// \return the comment.
+  llvh::StringRef scanLineComment() {
+    const char *p = cur_ + 2;
+    while (p != end_ && *p != '\n' && *p != '\r' &&
+           !unicodeLineTerminatorAt(p))
+      ++p;
+    llvh::StringRef comment(cur_, p - cur_);
+    cur_ = p;
+    return comment;
+  }
+
+  /// \return the end of the block comment at \p p. Like JSLexer, this is
+  ///   the end of the source if the comment is not terminated.
+  const char *skipBlockComment(const char *p) const {
+    for (p += 2; p < end_;) {
+      auto *star = (const char *)std::memchr(p, '*', end_ - p);
+      if (!star || end_ - star < 2)
+        break;
+      if (star[1] == '/')
+        return star + 2;
+      p = star + 1;
+    }
+    return end_;
+  }
+
+  /// \return the end of the string literal at \p p if it is a directive:
+  ///   without escapes, and followed by a ';', a '}', a line terminator or
+  ///   the end of the source, ignoring spaces and comments. nullptr
+  ///   otherwise.
+  const char *skipDirective(const char *p) const {
+    char quote = *p;
+    for (++p;; ++p) {
+      // Like JSLexer, end an unterminated string at the end of its line.
+      if (p == end_ || *p == '\n' || *p == '\r')
+        return p;
+      if (*p == '\\')
+        return nullptr;
+      if (*p == quote)
+        break;
+    }
+    const char *stringEnd = p + 1;
+
+    for (p = stringEnd;;) {
+      p = skipSpaces(p, /* stopAtLineTerminator */ true);
+      if (p == end_)
+        return stringEnd;
+      switch (*p) {
+        case ';':
+        case '}':
+        case '\r':
+        case '\n':
+          return stringEnd;
+        case '/':
+          if (end_ - p >= 2 && p[1] == '/')
+            return stringEnd;
+          if (end_ - p >= 2 && p[1] == '*') {
+            p = skipBlockComment(p);
+            continue;
+          }
+          return nullptr;
+        default:
+          return unicodeLineTerminatorAt(p) ? stringEnd : nullptr;
+      }
+    }
+  }
+
+  const char *const start_;
+  const char *const end_;
+  const char *cur_;
+};
+
+/// \return whether \p ch can be part of a pragma name.
+inline bool isPragmaNameChar(char ch) {
+  return ((ch | 32) >= 'a' && (ch | 32) <= 'z') || (ch >= '0' && ch <= '9') ||
+      ch == '_';
+}
+
+} // namespace
+
+uint8_t scanPragmas(
+    const DocBlockComment &comment,
+    llvh::function_ref<void(
+        llvh::StringRef name,
+        const DocBlockComment &comment)> onPragma) {
+  if (comment.kind == StoredComment::Kind::Hashbang)
+    return 0;
+  llvh::StringRef text = comment.getString();
+  const char *end = text.end();
+  uint8_t pragmas = 0;
+  for (const char *p = text.begin(); p < end;) {
+    auto *at = (const char *)std::memchr(p, '@', end - p);
+    if (!at)
+      break;
+    const char *nameEnd = at + 1;
+    while (nameEnd != end && isPragmaNameChar(*nameEnd))
+      ++nameEnd;
+    llvh::StringRef name(at + 1, nameEnd - at - 1);
+    p = nameEnd;
+    if (name.empty())
+      continue;
+
+    pragmas |= llvh::StringSwitch<uint8_t>(name)
+                   .Case("flow", DocBlockFlow)
+                   .Case("noflow", DocBlockNoFlow)
+                   .Case("format", DocBlockFormat)
+                   .Case("generated", DocBlockGenerated)
+                   .Default(0);
+    if (onPragma)
+      onPragma(name, comment);
+  }
+  return pragmas;
+}
+
+DocBlock scanDocBlock(
+    llvh::StringRef source,
+    llvh::function_ref<void(const DocBlockComment &comment)> onComment,
+    llvh::function_ref<void(
+        llvh::StringRef name,
+        const DocBlockComment &comment)> onPragma) {
+  DocBlock result{};
+  result.end = DocBlockScanner{source}.scan(
+      [&](StoredComment::Kind kind, llvh::StringRef text) {
+        DocBlockComment comment{kind, text};
+        ++result.numComments;
+        if (onComment)
+          onComment(comment);
+        result.pragmas |= scanPragmas(comment, onPragma);
+      });
+  return result;
+}
+
+} // namespace parser
+} // namespace hermes
@@ -8,8 +8,7 @@
 #include "hermes/Parser/FlowHelpers.h"
 
 #include "hermes/AST/Context.h"
-#include "hermes/Parser/JSLexer.h"
-#include "hermes/Support/SimpleDiagHandler.h"
+#include "hermes/Parser/DocBlock.h"
 
 namespace hermes {
 namespace parser {
@@ -17,67 +16,25 @@ namespace parser {
 std::vector<StoredComment> getCommentsInDocBlock(
     Context &context,
     uint32_t bufferId) {
-  // Use a SaveAndSuppressMessages to avoid accumulating extra error messages.
-  SourceErrorManager::SaveAndSuppressMessages saveAndSupress{
-      &context.getSourceErrorManager()};
-  parser::JSLexer lexer(
-      bufferId,
-      context.getSourceErrorManager(),
-      context.getAllocator(),
-      &context.getStringTable(),
-      context.isStrictMode());
-  lexer.setStoreComments(true);
-
-  // Determine which comments appear before the first non-directive token
-  lexer.advance();
-  size_t numComments = lexer.getStoredComments().size();
-
-  while (lexer.isCurrentTokenADirective()) {
-    const parser::Token *token = lexer.advance();
-
-    // A directive token can optionally be followed by a semicolon
-    if (token->getKind() == parser::TokenKind::semi) {
-      lexer.advance();
-    }
-
-    numComments = lexer.getStoredComments().size();
-  }
-
-  // Only return the first `numComments` comments, which comprise the docblock.
-  std::vector<StoredComment> result = lexer.moveStoredComments();
-  result.erase(result.begin() + numComments, result.end());
+  std::vector<StoredComment> result{};
+  scanDocBlock(
+      context.getSourceErrorManager().getSourceBuffer(bufferId)->getBuffer(),
+      [&](const DocBlockComment &comment) {
+        result.emplace_back(
+            comment.kind,
+            SMRange{
+                SMLoc::getFromPointer(comment.text.begin()),
+                SMLoc::getFromPointer(comment.text.end())});
+      });
   return result;
 }
 
 bool hasFlowPragma(llvh::ArrayRef<StoredComment> comments) {
-  // A flow pragma has the form @flow followed by a word boundary
   for (auto &comment : comments) {
-    if (comment.getKind() == parser::StoredComment::Kind::Hashbang) {
-      continue;
-    }
-
-    llvh::StringRef value = comment.getString();
-
-    size_t offset = value.find("@flow");
-    while (offset < value.size() - 4) {
-      const char *ptr = value.data() + offset;
-      // Word boundary could be end of the comment
-      if (offset == value.size() - 5) {
-        return true;
-      }
-
-      // Word boundary if @flow is followed by any non
-      // alphanumeric/underscore character.
-      const char ch = ptr[5];
-      if (!(((ch | 32) >= 'a' && (ch | 32) <= 'z') ||
-            (ch >= '0' && ch <= '9') || ch == '_')) {
-        return true;
-      }
-
-      offset = value.find("@flow", offset + 1);
-    }
+    if (scanPragmas({comment.getKind(), comment.getFullString()}) &
+        DocBlockFlow)
+      return true;
   }
-
   return false;
 }
 
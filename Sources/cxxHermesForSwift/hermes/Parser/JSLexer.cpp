@@ -10,6 +10,7 @@
 
 #include "dtoa/dtoa.h"
 #include "hermes/Support/Conversions.h"
+#include "hermes/Support/PerfSection.h"
 
 #include "llvh/ADT/ScopeExit.h"
 #include "llvh/ADT/StringSwitch.h"
@@ -108,6 +109,7 @@ void JSLexer::initializeWithBufferId(uint32_t bufId) {
 }
 
 void JSLexer::initializeReservedIdentifiers() {
+  PerfSection interning("Interning JS reserved words", "lexer");
   // Add all reserved words to the identifier table
 #define RESWORD(name) resWordIdent(TokenKind::rw_##name) = getIdentifier(#name);
 #include "hermes/Parser/TokenKinds.def"
@@ -182,6 +184,10 @@ bool JSLexer::isLetFollowedByDeclStart() {
 const Token *JSLexer::advance(GrammarContext grammarContext) {
   newLineBeforeCurrentToken_ = false;
 
+  if (LLVM_UNLIKELY(--interruptCountdown_ == 0))
+    pollInterrupt();
+  HERMES_PARSE_STAT(stats_, tokensLexed++);
+
   for (;;) {
     assert(curCharPtr_ <= bufferEnd_ && "lexing past end of input");
 #define PUNC_L1_1(ch, tok)        \
@@ -675,6 +681,7 @@ const Token *JSLexer::advance(GrammarContext grammarContext) {
 #if HERMES_PARSE_JSX
 
 const Token *JSLexer::advanceInJSXChild() {
+  HERMES_PARSE_STAT(stats_, tokensLexed++);
   token_.setStart(curCharPtr_);
   for (;;) {
     assert(curCharPtr_ <= bufferEnd_ && "lexing past end of input");
@@ -2353,6 +2360,29 @@ UniqueString *JSLexer::convertSurrogatesInString(llvh::StringRef str) {
   return strTab_.getString(output);
 }
 
+void JSLexer::pollInterrupt() {
+  interruptCountdown_ = InterruptPollInterval;
+  storageCharge_.update(
+      commentStorage_.capacity() * sizeof(StoredComment) +
+      tokenStorage_.capacity() * sizeof(StoredToken) +
+      skippedTypes_.capacity() * sizeof(SkippedType) +
+      dependencies_.capacity() * sizeof(ModuleDependency));
+  if (!interrupt_)
+    return;
+  ParseInterrupt::Reason reason = interrupt_->poll();
+  if (LLVM_UNLIKELY(reason != ParseInterrupt::Reason::None))
+    stopForInterrupt(reason);
+}
+
+void JSLexer::stopForInterrupt(ParseInterrupt::Reason reason) {
+  sm_.fatalError(
+      SMLoc::getFromPointer(curCharPtr_), ParseInterrupt::describe(reason));
+  forceEOF();
+  // The parser may rewind the lexer, so check again on the next token. The
+  // reason is sticky, so this keeps forcing EOF.
+  interruptCountdown_ = 1;
+}
+
 bool JSLexer::error(llvh::SMLoc loc, const llvh::Twine &msg) {
   sm_.error(loc, msg, Subsystem::Lexer);
   if (!sm_.isErrorLimitReached())
@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Parser/JSONCursor.h"
+
+#include "hermes/Parser/JSONStructuralIndex.h"
+#include "hermes/Platform/Unicode/CharacterProperties.h"
+#include "hermes/Support/UTF8.h"
+
+#include "llvh/ADT/SmallString.h"
+#include "llvh/ADT/StringExtras.h"
+
+#include <cstring>
+
+namespace hermes {
+namespace parser {
+
+namespace {
+
+inline bool isWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/// \return true if \p c may follow a number or a literal.
+inline bool isScalarTerminator(char c) {
+  switch (c) {
+    case '\0':
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+    case ',':
+    case ':':
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// Decode the four hex digits at \p p.
+/// \return the code unit or -1U if they are not all hex digits.
+inline uint32_t decodeHex4(const char *p) {
+  uint32_t cu = 0;
+  for (unsigned i = 0; i != 4; ++i) {
+    unsigned digit = llvh::hexDigitValue(p[i]);
+    if (digit == -1U)
+      return -1U;
+    cu = (cu << 4) | digit;
+  }
+  return cu;
+}
+
+} // namespace
+
+JSONCursor::JSONCursor(
+    std::unique_ptr<llvh::MemoryBuffer> input,
+    SourceErrorManager &sm)
+    : sm_(sm) {
+  auto bufId = sm_.addNewSourceBuffer(std::move(input));
+  auto *buffer = sm_.getSourceBuffer(bufId);
+  cur_ = buffer->getBufferStart();
+  end_ = buffer->getBufferEnd();
+  assert(*end_ == 0 && "buffer must be zero terminated");
+}
+
+bool JSONCursor::error(const char *at, const llvh::Twine &msg) {
+  if (!hasError_)
+    sm_.error(SMLoc::getFromPointer(at), msg, Subsystem::Parser);
+  hasError_ = true;
+  cur_ = end_;
+  levels_.clear();
+  valuePending_ = false;
+  return false;
+}
+
+char JSONCursor::skipWhitespace() {
+  // The terminating '\0' is not whitespace, so this stops at the end.
+  while (isWhitespace(*cur_))
+    ++cur_;
+  return *cur_;
+}
+
+bool JSONCursor::beginValue() {
+  if (hasError_)
+    return false;
+  valuePending_ = false;
+  skipWhitespace();
+  return true;
+}
+
+bool JSONCursor::advanceToMember() {
+  if (hasError_)
+    return false;
+  assert(!levels_.empty() && "not inside a container");
+
+  if (valuePending_ && !skipValue())
+    return false;
+
+  Level &level = levels_.back();
+  const char closer = level.isObject ? '}' : ']';
+  char c = skipWhitespace();
+  if (!level.first && c != closer) {
+    if (c != ',')
+      return error(cur_, level.isObject ? "expected '}'" : "expected ']'");
+    ++cur_;
+    // A trailing comma is accepted, matching JSONParser.
+    c = skipWhitespace();
+  }
+  if (c == closer) {
+    ++cur_;
+    levels_.pop_back();
+    return false;
+  }
+
+  level.first = false;
+  return true;
+}
+
+llvh::Optional<JSONKind> JSONCursor::peekKind() {
+  if (hasError_)
+    return llvh::None;
+  switch (skipWhitespace()) {
+    case '{':
+      return JSONKind::Object;
+    case '[':
+      return JSONKind::Array;
+    case '"':
+      return JSONKind::String;
+    case 't':
+    case 'f':
+      return JSONKind::Boolean;
+    case 'n':
+      return JSONKind::Null;
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      return JSONKind::Number;
+    default:
+      return llvh::None;
+  }
+}
+
+bool JSONCursor::enterObject() {
+  if (!beginValue())
+    return false;
+  if (*cur_ != '{')
+    return error(cur_, "expected '{'");
+  ++cur_;
+  levels_.push_back({true, true});
+  return true;
+}
+
+bool JSONCursor::enterArray() {
+  if (!beginValue())
+    return false;
+  if (*cur_ != '[')
+    return error(cur_, "expected '['");
+  ++cur_;
+  levels_.push_back({false, true});
+  return true;
+}
+
+bool JSONCursor::nextKey(
+    llvh::StringRef &key,
+    llvh::SmallVectorImpl<char> &storage) {
+  assert(
+      (levels_.empty() || levels_.back().isObject) && "not inside an object");
+  if (!advanceToMember())
+    return false;
+  auto name = scanKey(&storage);
+  if (!name)
+    return false;
+  key = *name;
+  valuePending_ = true;
+  return true;
+}
+
+bool JSONCursor::findField(llvh::StringRef name) {
+  assert(
+      (levels_.empty() || levels_.back().isObject) && "not inside an object");
+  while (advanceToMember()) {
+    const char *start = cur_;
+    auto raw = scanKey(nullptr);
+    if (!raw)
+      return false;
+    valuePending_ = true;
+
+    if (LLVM_LIKELY(raw->find('\\') == llvh::StringRef::npos)) {
+      if (*raw == name)
+        return true;
+      continue;
+    }
+
+    // The name has escapes; decode it again to compare.
+    const char *valueStart = cur_;
+    llvh::SmallString<32> storage;
+    cur_ = start;
+    auto decoded = scanKey(&storage);
+    assert(decoded && cur_ == valueStart && "key scanned differently");
+    (void)valueStart;
+    if (*decoded == name)
+      return true;
+  }
+  return false;
+}
+
+bool JSONCursor::nextElement() {
+  assert(
+      (levels_.empty() || !levels_.back().isObject) && "not inside an array");
+  if (!advanceToMember())
+    return false;
+  valuePending_ = true;
+  return true;
+}
+
+bool JSONCursor::exitContainer() {
+  if (hasError_)
+    return false;
+  assert(!levels_.empty() && "not inside a container");
+
+  const size_t depth = levels_.size();
+  while (advanceToMember()) {
+    if (levels_.back().isObject && !scanKey(nullptr))
+      return false;
+    valuePending_ = true;
+  }
+  assert((hasError_ || levels_.size() == depth - 1) && "unbalanced exit");
+  (void)depth;
+  return !hasError_;
+}
+
+bool JSONCursor::skipValue() {
+  if (!beginValue())
+    return false;
+
+  const char *start = cur_;
+  switch (*cur_) {
+    case '{':
+    case '[': {
+      // Balance brackets without validating anything in between. The kinds
+      // of brackets are not matched against each other.
+      size_t depth = 0;
+      for (;;) {
+        cur_ = findQuoteOrBracket(cur_, end_);
+        switch (*cur_) {
+          case '{':
+          case '[':
+            ++depth;
+            ++cur_;
+            break;
+          case '}':
+          case ']':
+            ++cur_;
+            if (--depth == 0)
+              return true;
+            break;
+          case '"':
+            if (!scanString(nullptr))
+              return false;
+            break;
+          default:
+            assert(cur_ == end_ && "unexpected stop character");
+            return error(start, "unterminated JSON container");
+        }
+      }
+    }
+
+    case '"':
+      return scanString(nullptr).hasValue();
+
+    default:
+      while (!isScalarTerminator(*cur_))
+        ++cur_;
+      if (cur_ == start)
+        return error(start, "JSON value expected");
+      return true;
+  }
+}
+
+llvh::Optional<llvh::StringRef> JSONCursor::getString(
+    llvh::SmallVectorImpl<char> &storage) {
+  if (!beginValue())
+    return llvh::None;
+  if (*cur_ != '"') {
+    error(cur_, "expected a string");
+    return llvh::None;
+  }
+  return scanString(&storage);
+}
+
+llvh::Optional<double> JSONCursor::getNumber() {
+  if (!beginValue())
+    return llvh::None;
+  double value;
+  const char *end = scanJSONNumber(cur_, end_, value);
+  if (!end || !isScalarTerminator(*end)) {
+    error(cur_, "expected a number");
+    return llvh::None;
+  }
+  cur_ = end;
+  return value;
+}
+
+llvh::Optional<bool> JSONCursor::getBoolean() {
+  if (!beginValue())
+    return llvh::None;
+  if (std::strncmp(cur_, "true", 4) == 0 && isScalarTerminator(cur_[4])) {
+    cur_ += 4;
+    return true;
+  }
+  if (std::strncmp(cur_, "false", 5) == 0 && isScalarTerminator(cur_[5])) {
+    cur_ += 5;
+    return false;
+  }
+  error(cur_, "expected a boolean");
+  return llvh::None;
+}
+
+bool JSONCursor::getNull() {
+  if (!beginValue())
+    return false;
+  if (std::strncmp(cur_, "null", 4) != 0 || !isScalarTerminator(cur_[4]))
+    return error(cur_, "expected null");
+  cur_ += 4;
+  return true;
+}
+
+llvh::Optional<JSONValue *> JSONCursor::getValue(JSONFactory &factory) {
+  if (!beginValue())
+    return llvh::None;
+  const char *start = cur_;
+  if (!skipValue())
+    return llvh::None;
+
+  // The skipped value is balanced and followed by a scalar terminator, so it
+  // can be parsed where it is. Like the other get*() methods, this only
+  // accepts strict JSON.
+  unsigned errorsBefore = sm_.getErrorCount();
+  auto res = parseJSONWithStructuralIndex(
+      factory, llvh::StringRef(start, cur_ - start), sm_);
+  if (!res || sm_.getErrorCount() != errorsBefore) {
+    hasError_ = true;
+    return llvh::None;
+  }
+  return res;
+}
+
+llvh::Optional<llvh::StringRef> JSONCursor::scanKey(
+    llvh::SmallVectorImpl<char> *storage) {
+  if (*cur_ != '"') {
+    error(cur_, "expected a string");
+    return llvh::None;
+  }
+  auto name = scanString(storage);
+  if (!name)
+    return llvh::None;
+  if (skipWhitespace() != ':') {
+    error(cur_, "expected ':'");
+    return llvh::None;
+  }
+  ++cur_;
+  return name;
+}
+
+llvh::Optional<llvh::StringRef> JSONCursor::scanString(
+    llvh::SmallVectorImpl<char> *storage) {
+  assert(*cur_ == '"' && "not at a string");
+  const char *const start = cur_;
+  const char *from = cur_ + 1;
+  const char *to = findQuoteOrBackslash(from, end_);
+
+  // Fast path: no escapes, so the string can be returned in place.
+  if (LLVM_LIKELY(*to == '"')) {
+    cur_ = to + 1;
+    return llvh::StringRef(from, to - from);
+  }
+
+  if (!storage) {
+    // Find the closing quote, stepping over escaped characters.
+    while (*to == '\\' && end_ - to > 1)
+      to = findQuoteOrBackslash(to + 2, end_);
+    if (*to != '"') {
+      error(start, "unterminated string literal");
+      return llvh::None;
+    }
+    cur_ = to + 1;
+    return llvh::StringRef(from, to - from);
+  }
+
+  storage->clear();
+  for (;;) {
+    storage->append(from, to);
+    if (to == end_) {
+      error(start, "unterminated string literal");
+      return llvh::None;
+    }
+    if (*to == '"')
+      break;
+
+    // An escape sequence.
+    const char *esc = to;
+    from = esc + 2;
+    switch (esc[1]) {
+      case 'b':
+        storage->push_back('\b');
+        break;
+      case 'f':
+        storage->push_back('\f');
+        break;
+      case 'n':
+        storage->push_back('\n');
+        break;
+      case 'r':
+        storage->push_back('\r');
+        break;
+      case 't':
+        storage->push_back('\t');
+        break;
+      case '"':
+      case '\\':
+      case '/':
+        storage->push_back(esc[1]);
+        break;
+      case 'u': {
+        uint32_t cp = decodeHex4(esc + 2);
+        if (cp == -1U) {
+          error(esc, "invalid Unicode escape");
+          return llvh::None;
+        }
+        from = esc + 6;
+        if (isHighSurrogate(cp) && from[0] == '\\' && from[1] == 'u') {
+          uint32_t trail = decodeHex4(from + 2);
+          if (isLowSurrogate(trail)) {
+            cp = utf16SurrogatePairToCodePoint(cp, trail);
+            from += 6;
+          }
+        }
+        if (isHighSurrogate(cp) || isLowSurrogate(cp))
+          cp = UNICODE_REPLACEMENT_CHARACTER;
+        char buf[4];
+        char *d = buf;
+        encodeUTF8(d, cp);
+        storage->append(buf, d);
+        break;
+      }
+      default:
+        error(esc, "invalid escape sequence");
+        return llvh::None;
+    }
+    to = findQuoteOrBackslash(from, end_);
+  }
+
+  cur_ = to + 1;
+  return llvh::StringRef(storage->data(), storage->size());
+}
+
+} // namespace parser
+} // namespace hermes
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Parser/JSONLinesReader.h"
+
+#include "hermes/Support/SourceErrorManager.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hermes {
+namespace parser {
+
+namespace {
+
+/// The outcome of parsing one line.
+struct LineResult {
+  /// Byte offset of the line in the input.
+  size_t offset;
+  /// The parsed value, or nullptr if the line failed to parse.
+  const JSONValue *value;
+  /// The error message if the line failed to parse.
+  std::string error;
+};
+
+/// The lines of a parsed chunk, and the arena their values live in.
+struct ChunkResult {
+  std::shared_ptr<JSONFactory::Allocator> allocator;
+  std::vector<LineResult> lines{};
+};
+
+/// \return the offset where the chunk with index \p index starts: just after
+///   the first newline at or after index * chunkSize - 1.
+size_t chunkStart(llvh::StringRef input, size_t chunkSize, size_t index) {
+  if (index == 0)
+    return 0;
+  if (index > (input.size() - 1) / chunkSize)
+    return input.size();
+  const size_t from = index * chunkSize - 1;
+  const void *nl =
+      std::memchr(input.data() + from, '\n', input.size() - from);
+  return nl ? (const char *)nl - input.data() + 1 : input.size();
+}
+
+/// \return true if [begin, end) contains only whitespace.
+bool isBlank(const char *begin, const char *end) {
+  for (; begin != end; ++begin) {
+    if (*begin != ' ' && *begin != '\t' && *begin != '\r')
+      return false;
+  }
+  return true;
+}
+
+/// Diagnostic handler that stores the message in the std::string \p ctx.
+void captureMessage(const llvh::SMDiagnostic &diag, void *ctx) {
+  *static_cast<std::string *>(ctx) = diag.getMessage().str();
+}
+
+/// Parse every line in [begin, end) of \p input into \p out.
+void parseChunk(
+    llvh::StringRef input,
+    size_t begin,
+    size_t end,
+    bool convertSurrogates,
+    ChunkResult &out) {
+  out.allocator = std::make_shared<JSONFactory::Allocator>();
+  JSONFactory factory{*out.allocator};
+
+  // Diagnostics are only captured, never printed. The chunk is registered so
+  // that error locations resolve.
+  std::string message;
+  SourceErrorManager sm;
+  sm.setDiagHandler(captureMessage, &message);
+  sm.addNewSourceBuffer(llvh::MemoryBuffer::getMemBuffer(
+      input.slice(begin, end), "JSON Lines", false));
+
+  const char *const chunkEnd = input.data() + end;
+  for (const char *line = input.data() + begin; line < chunkEnd;) {
+    const char *nl = (const char *)std::memchr(line, '\n', chunkEnd - line);
+    // The newline, or the terminating '\0' of the input, follows the line as
+    // parseJSONWithStructuralIndex() requires.
+    const char *lineEnd = nl ? nl : chunkEnd;
+
+    if (!isBlank(line, lineEnd)) {
+      message.clear();
+      auto res = parseJSONWithStructuralIndex(
+          factory,
+          llvh::StringRef(line, lineEnd - line),
+          sm,
+          convertSurrogates);
+      size_t offset = line - input.data();
+      if (res) {
+        out.lines.push_back({offset, *res, {}});
+      } else {
+        out.lines.push_back(
+            {offset, nullptr, message.empty() ? "invalid JSON" : message});
+        sm.clearErrorLimitReached();
+      }
+    }
+
+    line = lineEnd + 1;
+  }
+}
+
+} // namespace
+
+JSONLinesReader::JSONLinesReader(JSONLinesOptions options)
+    : options_(options) {}
+
+bool JSONLinesReader::readFile(
+    llvh::StringRef path,
+    const RecordCallback &onRecord,
+    const ErrorCallback &onError) {
+  errorMessage_.clear();
+  auto fileOrErr = llvh::MemoryBuffer::getFile(path);
+  if (!fileOrErr) {
+    errorMessage_ =
+        "cannot read '" + path.str() + "': " + fileOrErr.getError().message();
+    return false;
+  }
+  return read(**fileOrErr, onRecord, onError);
+}
+
+bool JSONLinesReader::read(
+    const llvh::MemoryBuffer &buffer,
+    const RecordCallback &onRecord,
+    const ErrorCallback &onError) {
+  errorMessage_.clear();
+  peakChunksInFlight_ = 0;
+  const llvh::StringRef input = buffer.getBuffer();
+  assert(*input.end() == 0 && "buffer must be zero terminated");
+  if (input.empty())
+    return true;
+
+  const size_t chunkSize = std::max<size_t>(options_.chunkSize, 1);
+  const size_t numChunks = (input.size() + chunkSize - 1) / chunkSize;
+  unsigned numThreads = options_.numThreads
+      ? options_.numThreads
+      : std::max(1u, std::thread::hardware_concurrency());
+  numThreads = (unsigned)std::min<size_t>(numThreads, numChunks);
+  const size_t window = options_.maxChunksInFlight
+      ? options_.maxChunksInFlight
+      : 2 * (size_t)numThreads;
+  const bool ordered = options_.ordered;
+  const bool convertSurrogates = options_.convertSurrogates;
+
+  // All of the following is protected by the mutex.
+  std::mutex mutex;
+  // Signalled when a worker may be able to claim a chunk.
+  std::condition_variable canClaim;
+  // Signalled when a chunk has been parsed.
+  std::condition_variable canDeliver;
+  // Parsed chunks that have not been delivered, by index.
+  std::vector<std::unique_ptr<ChunkResult>> results(numChunks);
+  // Indexes of parsed chunks in completion order, used when !ordered.
+  std::deque<size_t> completed;
+  // The next chunk to be claimed by a worker.
+  size_t nextChunk = 0;
+  // The number of chunks that have been delivered.
+  size_t delivered = 0;
+  // Set when the workers should exit early.
+  bool stop = false;
+  // See getPeakChunksInFlight().
+  size_t peak = 0;
+
+  auto worker = [&]() {
+    for (;;) {
+      size_t index;
+      {
+        std::unique_lock<std::mutex> lock{mutex};
+        canClaim.wait(lock, [&] {
+          return stop || nextChunk == numChunks ||
+              nextChunk < delivered + window;
+        });
+        if (stop || nextChunk == numChunks)
+          return;
+        index = nextChunk++;
+        peak = std::max(peak, nextChunk - delivered);
+      }
+
+      auto result = std::make_unique<ChunkResult>();
+      parseChunk(
+          input,
+          chunkStart(input, chunkSize, index),
+          chunkStart(input, chunkSize, index + 1),
+          convertSurrogates,
+          *result);
+
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        results[index] = std::move(result);
+        if (!ordered)
+          completed.push_back(index);
+      }
+      canDeliver.notify_one();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for (unsigned i = 0; i != numThreads; ++i)
+    threads.emplace_back(worker);
+
+  // Deliver on this thread, so the callbacks never run concurrently.
+  bool ok = true;
+  while (ok && delivered != numChunks) {
+    std::unique_ptr<ChunkResult> result;
+    {
+      std::unique_lock<std::mutex> lock{mutex};
+      size_t index;
+      if (ordered) {
+        canDeliver.wait(lock, [&] { return results[delivered] != nullptr; });
+        index = delivered;
+      } else {
+        canDeliver.wait(lock, [&] { return !completed.empty(); });
+        index = completed.front();
+        completed.pop_front();
+      }
+      result = std::move(results[index]);
+    }
+
+    for (const LineResult &line : result->lines) {
+      if (line.value) {
+        ok = onRecord(
+            line.offset, JSONSharedValue{line.value, result->allocator});
+      } else {
+        ok = onError && onError(line.offset, line.error);
+      }
+      if (!ok)
+        break;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      ++delivered;
+      stop = !ok;
+    }
+    canClaim.notify_all();
+  }
+
+  for (auto &thread : threads)
+    thread.join();
+  peakChunksInFlight_ = peak;
+  return ok;
+}
+
+} // namespace parser
+} // namespace hermes
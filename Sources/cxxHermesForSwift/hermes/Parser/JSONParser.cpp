@@ -7,13 +7,31 @@
 
 #include "hermes/Parser/JSONParser.h"
 #include "hermes/ADT/HalfPairIterator.h"
+#include "hermes/Parser/JSONStructuralIndex.h"
+#include "hermes/Support/PerfSection.h"
+#include "hermes/Support/UTF8.h"
 
+#include "llvh/ADT/SmallString.h"
 #include "llvh/ADT/SmallVector.h"
+#include "llvh/ADT/StringExtras.h"
 #include "llvh/Support/Casting.h"
+#include "llvh/Support/MathExtras.h"
+
+#include <cstring>
 
 namespace hermes {
 namespace parser {
 
+/// Hash the bit pattern of a double for JSONFactory's number table. Typical
+/// values differ only in the exponent and the high mantissa bits, so those
+/// are mixed into the low bits, which are used as the index.
+static inline uint32_t hashNumberBits(uint64_t bits) {
+  bits ^= bits >> 33;
+  bits *= 0xFF51AFD7ED558CCDULL;
+  bits ^= bits >> 33;
+  return (uint32_t)bits;
+}
+
 JSONNull JSONNull::instance_{};
 JSONBoolean JSONBoolean::true_{true};
 JSONBoolean JSONBoolean::false_{false};
@@ -77,33 +95,76 @@ JSONFactory::JSONFactory(Allocator &allocator, StringTable *strTab)
       strTab_(strTab ? *strTab : *ownStrTab_) {}
 
 JSONString *JSONFactory::getString(UniqueString *lit) {
-  llvh::FoldingSetNodeID id;
-  JSONString::Profile(id, lit);
+  auto &slot = strings_[lit];
+  if (!slot)
+    slot = new (allocator_.Allocate<JSONString>()) JSONString(lit);
+  return slot;
+}
 
-  void *insertPos;
-  if (auto *found = strings_.FindNodeOrInsertPos(id, insertPos))
-    return found;
+JSONString *JSONFactory::getString(llvh::StringRef str) {
+  auto it = stringsByText_.find(str);
+  if (it != stringsByText_.end())
+    return it->second;
 
-  auto *res = new (allocator_.Allocate<JSONString>()) JSONString(lit);
-  strings_.InsertNode(res, insertPos);
+  // The map must be keyed on the interned copy, not on the caller's buffer.
+  UniqueString *lit = strTab_.getString(str);
+  JSONString *res = getString(lit);
+  stringsByText_.insert({lit->str(), res});
   return res;
 }
 
-JSONString *JSONFactory::getString(llvh::StringRef str) {
-  return getString(strTab_.getString(str));
+JSONNumber *JSONFactory::getNumber(double value) {
+  const uint64_t bits = llvh::DoubleToBits(value);
+
+  // The bit comparison excludes -0.
+  if (value >= 0 && value < kSmallIntCacheSize) {
+    unsigned index = (unsigned)value;
+    if (bits == llvh::DoubleToBits((double)index)) {
+      JSONNumber *&cached = smallInts_[index];
+      if (LLVM_UNLIKELY(!cached))
+        cached = new (allocator_.Allocate<JSONNumber>()) JSONNumber(value);
+      return cached;
+    }
+  }
+
+  return internNumber(value, bits);
 }
 
-JSONNumber *JSONFactory::getNumber(double value) {
-  llvh::FoldingSetNodeID id;
-  JSONNumber::Profile(id, value);
+JSONNumber *JSONFactory::internNumber(double value, uint64_t bits) {
+  // Keep the load factor at or below 1/2.
+  if (LLVM_UNLIKELY((numbersSize_ + 1) * 2 > numbersCapacity_))
+    growNumbers();
+
+  const uint32_t mask = numbersCapacity_ - 1;
+  uint32_t index = hashNumberBits(bits) & mask;
+  for (;; index = (index + 1) & mask) {
+    JSONNumber *&slot = numbers_[index];
+    if (!slot) {
+      ++numbersSize_;
+      return slot = new (allocator_.Allocate<JSONNumber>()) JSONNumber(value);
+    }
+    if (llvh::DoubleToBits(slot->getValue()) == bits)
+      return slot;
+  }
+}
 
-  void *insertPos;
-  if (auto *found = numbers_.FindNodeOrInsertPos(id, insertPos))
-    return found;
+void JSONFactory::growNumbers() {
+  const uint32_t newCapacity = numbersCapacity_ ? numbersCapacity_ * 2 : 64;
+  std::unique_ptr<JSONNumber *[]> newNumbers{new JSONNumber *[newCapacity]()};
+
+  const uint32_t mask = newCapacity - 1;
+  for (uint32_t i = 0; i != numbersCapacity_; ++i) {
+    if (JSONNumber *num = numbers_[i]) {
+      uint64_t bits = llvh::DoubleToBits(num->getValue());
+      uint32_t index = hashNumberBits(bits) & mask;
+      while (newNumbers[index])
+        index = (index + 1) & mask;
+      newNumbers[index] = num;
+    }
+  }
 
-  auto *res = new (allocator_.Allocate<JSONNumber>()) JSONNumber(value);
-  numbers_.InsertNode(res, insertPos);
-  return res;
+  numbers_ = std::move(newNumbers);
+  numbersCapacity_ = newCapacity;
 }
 
 JSONHiddenClass *JSONFactory::getHiddenClass(const HiddenClassKey &key) {
@@ -135,11 +196,70 @@ JSONString *JSONFactory::sortProps(Prop *from, Prop *to) {
   return nullptr;
 }
 
+JSONFactory::Transition *JSONFactory::getTransition(
+    Transition *from,
+    JSONString *key) {
+  if (LLVM_LIKELY(from->firstKey == key))
+    return from->firstNext;
+
+  Transition **slot;
+  if (!from->firstKey) {
+    from->firstKey = key;
+    slot = &from->firstNext;
+  } else {
+    slot = &transitions_[{from, key}];
+    if (*slot)
+      return *slot;
+  }
+  return *slot = new (allocator_.Allocate<Transition>()) Transition();
+}
+
+void JSONFactory::initTransition(
+    Transition *node,
+    const Prop *from,
+    const Prop *to) {
+  const size_t size = to - from;
+
+  // Sort the insertion indexes by key.
+  llvh::SmallVector<uint32_t, 10> order;
+  order.reserve(size);
+  for (uint32_t i = 0; i != size; ++i)
+    order.push_back(i);
+  std::sort(order.begin(), order.end(), [from](uint32_t a, uint32_t b) {
+    return from[a].first->str() < from[b].first->str();
+  });
+
+  llvh::SmallVector<JSONString *, 10> keys;
+  keys.reserve(size);
+  for (uint32_t i : order) {
+    if (!keys.empty() && keys.back() == from[i].first) {
+      node->hasDuplicate = true;
+      return;
+    }
+    keys.push_back(from[i].first);
+  }
+
+  node->hiddenClass = getHiddenClass({keys.size(), keys.begin()});
+  node->slots = allocator_.Allocate<uint32_t>(size);
+  for (uint32_t slot = 0; slot != size; ++slot)
+    node->slots[order[slot]] = slot;
+}
+
 JSONObject *JSONFactory::newObject(Prop *from, Prop *to, bool propsAreSorted) {
   if (!propsAreSorted) {
-    // Sort the properties. If non-null was returned, there was a duplicate.
-    if (sortProps(from, to))
+    Transition *node = &rootTransition_;
+    for (const Prop *p = from; p != to; ++p)
+      node = getTransition(node, p->first);
+
+    if (LLVM_UNLIKELY(!node->hiddenClass && !node->hasDuplicate))
+      initTransition(node, from, to);
+    if (node->hasDuplicate)
       return nullptr;
+
+    auto *obj = newObject(node->hiddenClass, nullptr);
+    for (const Prop *p = from; p != to; ++p)
+      (*obj)[node->slots[p - from]] = p->second;
+    return obj;
   }
 
   // Look for an existing hidden class.
@@ -187,9 +307,18 @@ JSONParser::JSONParser(
           &factory_.getStringTable(),
           true,
           convertSurrogates),
-      sm_(sm) {}
+      sm_(sm),
+      convertSurrogates_(convertSurrogates) {}
 
 llvh::Optional<JSONValue *> JSONParser::parse() {
+  PerfSection parsing("Parsing JSON");
+  parsing.addArg(
+      "engine",
+      engine_ == JSONParserEngine::StructuralIndex ? "structural-index"
+                                                   : "lexer");
+  if (engine_ == JSONParserEngine::StructuralIndex)
+    return parseWithStructuralIndex();
+
   lexer_.advance();
   auto res = parseValue();
   if (!res)
@@ -314,12 +443,404 @@ llvh::Optional<JSONValue *> JSONParser::parseObject() {
 
   lexer_.advance(); // consume the '}'
 
-  if (auto *duplicate = factory_.sortProps(pairs.begin(), pairs.end())) {
-    error("key '" + duplicate->str() + "' is already present");
+  if (auto *obj = factory_.newObject(pairs.begin(), pairs.end()))
+    return obj;
+
+  // Sort the properties again to find the name of the duplicate.
+  auto *duplicate = factory_.sortProps(pairs.begin(), pairs.end());
+  error("key '" + duplicate->str() + "' is already present");
+  return llvh::None;
+}
+
+namespace {
+
+/// \return true if \p c may follow a number or a literal.
+inline bool isScalarTerminator(char c) {
+  switch (c) {
+    case '\0':
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+    case ',':
+    case ':':
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+      return true;
+    default:
+      return false;
+  }
+}
+
+inline bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+/// The second stage of JSONParserEngine::StructuralIndex. It walks the
+/// positions recorded by JSONStructuralIndex in order, with an explicit stack
+/// instead of recursion, and creates values through the same JSONFactory
+/// calls as the lexer-based parser, so the resulting trees are identical.
+class StructuralTreeBuilder {
+  JSONFactory &factory_;
+  SourceErrorManager &sm_;
+  bool const convertSurrogates_;
+
+  /// The input. *bufEnd_ is '\0' or whitespace.
+  const char *const buf_;
+  const char *const bufEnd_;
+
+  /// The structural index and the next entry to consume.
+  llvh::ArrayRef<uint32_t> positions_;
+  size_t next_ = 0;
+
+  /// Scratch space for decoding strings with escapes or non-ASCII characters.
+  llvh::SmallString<64> storage_{};
+
+  /// An array or object whose elements are still being parsed. Elements are
+  /// accumulated in the shared \c elements_ and \c props_ vectors starting
+  /// at \c start.
+  struct Frame {
+    bool isObject;
+    uint32_t start;
+    /// The key of the property whose value is being parsed.
+    JSONString *key;
+  };
+
+  llvh::SmallVector<Frame, 16> stack_{};
+  llvh::SmallVector<JSONValue *, 32> elements_{};
+  llvh::SmallVector<JSONFactory::Prop, 32> props_{};
+
+ public:
+  StructuralTreeBuilder(
+      JSONFactory &factory,
+      SourceErrorManager &sm,
+      bool convertSurrogates,
+      const char *buf,
+      const char *bufEnd,
+      llvh::ArrayRef<uint32_t> positions)
+      : factory_(factory),
+        sm_(sm),
+        convertSurrogates_(convertSurrogates),
+        buf_(buf),
+        bufEnd_(bufEnd),
+        positions_(positions) {}
+
+  llvh::Optional<JSONValue *> build();
+
+ private:
+  /// \return the next structural or scalar start, or the end of the input
+  /// once the index is exhausted.
+  const char *advance() {
+    return next_ < positions_.size() ? buf_ + positions_[next_++] : bufEnd_;
+  }
+
+  /// \return the next position without consuming it.
+  const char *peek() const {
+    return next_ < positions_.size() ? buf_ + positions_[next_] : bufEnd_;
+  }
+
+  void error(const char *at, const llvh::Twine &msg) {
+    sm_.error(SMLoc::getFromPointer(at), msg, Subsystem::Parser);
+  }
+
+  /// Parse the object key at \p at and the following ':'.
+  /// \return the key or nullptr on error.
+  JSONString *parseKey(const char *at);
+
+  /// Parse the string literal whose opening quote is at \p at.
+  /// \return the string or nullptr on error.
+  JSONString *parseString(const char *at);
+
+  /// Parse the number starting at \p at.
+  /// \return the number or nullptr on error.
+  JSONNumber *parseNumber(const char *at);
+
+  /// Append the characters in [from, to), which contain no quotes or
+  /// backslashes, to storage_, re-encoding them like JSLexer does.
+  void appendChars(const char *from, const char *to);
+};
+
+llvh::Optional<JSONValue *> StructuralTreeBuilder::build() {
+  const char *at = advance();
+  for (;;) {
+    // Parse the value starting at \c at. Arrays and objects push a frame and
+    // continue with their first element.
+    JSONValue *value;
+    switch (*at) {
+      case '{': {
+        if (*peek() == '}') {
+          advance();
+          value = factory_.newObject(props_.end(), props_.end());
+          break;
+        }
+        JSONString *key = parseKey(advance());
+        if (!key)
+          return llvh::None;
+        stack_.push_back({true, (uint32_t)props_.size(), key});
+        at = advance();
+        continue;
+      }
+      case '[':
+        if (*peek() == ']') {
+          advance();
+          value = factory_.newArray(0);
+          break;
+        }
+        stack_.push_back({false, (uint32_t)elements_.size(), nullptr});
+        at = advance();
+        continue;
+      case '"':
+        if (!(value = parseString(at)))
+          return llvh::None;
+        break;
+      case 't':
+        if (std::strncmp(at, "true", 4) != 0 || !isScalarTerminator(at[4])) {
+          error(at, "invalid literal");
+          return llvh::None;
+        }
+        value = factory_.getBoolean(true);
+        break;
+      case 'f':
+        if (std::strncmp(at, "false", 5) != 0 || !isScalarTerminator(at[5])) {
+          error(at, "invalid literal");
+          return llvh::None;
+        }
+        value = factory_.getBoolean(false);
+        break;
+      case 'n':
+        if (std::strncmp(at, "null", 4) != 0 || !isScalarTerminator(at[4])) {
+          error(at, "invalid literal");
+          return llvh::None;
+        }
+        value = factory_.getNull();
+        break;
+      case '-':
+      case '0':
+      case '1':
+      case '2':
+      case '3':
+      case '4':
+      case '5':
+      case '6':
+      case '7':
+      case '8':
+      case '9':
+        if (!(value = parseNumber(at)))
+          return llvh::None;
+        break;
+      default:
+        error(at, "JSON object or array expected");
+        return llvh::None;
+    }
+
+    // Store the completed value in its parent. Closing the parent completes
+    // another value, so keep going until a new element starts or the stack
+    // is empty.
+    for (;;) {
+      if (stack_.empty())
+        return value;
+
+      Frame &top = stack_.back();
+      if (top.isObject)
+        props_.push_back({top.key, value});
+      else
+        elements_.push_back(value);
+
+      const char closer = top.isObject ? '}' : ']';
+      const char *sep = advance();
+      if (*sep == ',') {
+        // A trailing comma is accepted, matching the lexer-based parser.
+        if (*peek() != closer) {
+          if (top.isObject && !(top.key = parseKey(advance())))
+            return llvh::None;
+          at = advance();
+          break;
+        }
+        sep = advance();
+      }
+
+      if (*sep != closer) {
+        error(sep, top.isObject ? "expected '}'" : "expected ']'");
+        return llvh::None;
+      }
+
+      if (top.isObject) {
+        auto *from = props_.begin() + top.start;
+        if (!(value = factory_.newObject(from, props_.end()))) {
+          auto *duplicate = factory_.sortProps(from, props_.end());
+          error(sep, "key '" + duplicate->str() + "' is already present");
+          return llvh::None;
+        }
+        props_.resize(top.start);
+      } else {
+        auto *from = elements_.begin() + top.start;
+        value = factory_.newArray(elements_.end() - from, from, elements_.end());
+        elements_.resize(top.start);
+      }
+      stack_.pop_back();
+    }
+  }
+}
+
+JSONString *StructuralTreeBuilder::parseKey(const char *at) {
+  if (*at != '"') {
+    error(at, "expected a string");
+    return nullptr;
+  }
+  JSONString *key = parseString(at);
+  if (!key)
+    return nullptr;
+  const char *colon = advance();
+  if (*colon != ':') {
+    error(colon, "expected ':'");
+    return nullptr;
+  }
+  return key;
+}
+
+JSONString *StructuralTreeBuilder::parseString(const char *at) {
+  const char *from = at + 1;
+  const char *to = findQuoteOrBackslash(from, bufEnd_);
+
+  // Fast path: no escapes and nothing that needs re-encoding, so the string
+  // can be interned directly from the input.
+  if (LLVM_LIKELY(*to == '"' && isAllASCII(from, to)))
+    return factory_.getString(llvh::StringRef(from, to - from));
+
+  storage_.clear();
+  for (;;) {
+    appendChars(from, to);
+    if (to == bufEnd_) {
+      error(at, "unterminated string literal");
+      return nullptr;
+    }
+    if (*to == '"')
+      break;
+
+    // An escape sequence.
+    const char *esc = to;
+    switch (esc[1]) {
+      case 'b':
+        storage_.push_back('\b');
+        break;
+      case 'f':
+        storage_.push_back('\f');
+        break;
+      case 'n':
+        storage_.push_back('\n');
+        break;
+      case 'r':
+        storage_.push_back('\r');
+        break;
+      case 't':
+        storage_.push_back('\t');
+        break;
+      case 'u': {
+        uint32_t cp = 0;
+        for (unsigned i = 2; i != 6; ++i) {
+          unsigned digit = llvh::hexDigitValue(esc[i]);
+          if (digit == -1U) {
+            error(esc, "invalid Unicode escape");
+            return nullptr;
+          }
+          cp = (cp << 4) | digit;
+        }
+        // Surrogates are kept as individual code units, like JSLexer.
+        JSLexer::appendUnicodeToStorage(cp, storage_);
+        from = esc + 6;
+        to = findQuoteOrBackslash(from, bufEnd_);
+        continue;
+      }
+      case '"':
+      case '\\':
+      case '/':
+        storage_.push_back(esc[1]);
+        break;
+      default:
+        error(esc, "invalid escape sequence");
+        return nullptr;
+    }
+    from = esc + 2;
+    to = findQuoteOrBackslash(from, bufEnd_);
+  }
+
+  if (convertSurrogates_) {
+    std::string output;
+    convertUTF8WithSurrogatesToUTF8WithReplacements(output, storage_);
+    return factory_.getString(output);
+  }
+  return factory_.getString(storage_.str());
+}
+
+void StructuralTreeBuilder::appendChars(const char *from, const char *to) {
+  if (LLVM_LIKELY(isAllASCII(from, to))) {
+    storage_.append(from, to);
+    return;
+  }
+  while (from != to) {
+    if (LLVM_LIKELY(isASCII(*from))) {
+      storage_.push_back(*from++);
+      continue;
+    }
+    // The structural index has already validated the encoding.
+    uint32_t cp = _decodeUTF8SlowPath<false>(
+        from, [](const llvh::Twine &) {
+          llvm_unreachable("UTF-8 validated by the structural index");
+        });
+    JSLexer::appendUnicodeToStorage(cp, storage_);
+  }
+}
+
+JSONNumber *StructuralTreeBuilder::parseNumber(const char *at) {
+  double value;
+  const char *end = scanJSONNumber(at, bufEnd_, value);
+  if (!end && *at == '-' && !isDigit(at[1])) {
+    error(at, "No numeric literal following minus (-) token in value");
+    return nullptr;
+  }
+  if (!end || !isScalarTerminator(*end)) {
+    error(at, "invalid numeric literal");
+    return nullptr;
+  }
+  return factory_.getNumber(value);
+}
+
+} // namespace
+
+llvh::Optional<JSONValue *> parseJSONWithStructuralIndex(
+    JSONFactory &factory,
+    llvh::StringRef input,
+    SourceErrorManager &sm,
+    bool convertSurrogates) {
+  JSONStructuralIndex index;
+  if (!index.build(input)) {
+    sm.error(
+        SMLoc::getFromPointer(input.begin() + index.getErrorOffset()),
+        index.getErrorMessage(),
+        Subsystem::Parser);
     return llvh::None;
   }
 
-  return factory_.newObject(pairs.begin(), pairs.end(), true);
+  StructuralTreeBuilder builder{
+      factory,
+      sm,
+      convertSurrogates,
+      input.begin(),
+      input.end(),
+      index.getPositions()};
+  return builder.build();
+}
+
+llvh::Optional<JSONValue *> JSONParser::parseWithStructuralIndex() {
+  const char *buf = lexer_.getBufferStart();
+  const char *bufEnd = lexer_.getBufferEnd();
+  auto res = parseJSONWithStructuralIndex(
+      factory_, llvh::StringRef(buf, bufEnd - buf), sm_, convertSurrogates_);
+  if (!res || sm_.getErrorCount() != 0)
+    return llvh::None;
+  return res;
 }
 
 } // namespace parser
@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Parser/JSONStructuralIndex.h"
+
+#include "dtoa/dtoa.h"
+#include "llvh/ADT/SmallString.h"
+#include "llvh/Support/Compiler.h"
+#include "llvh/Support/MathExtras.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HERMES_JSON_SSE2 1
+#include <emmintrin.h>
+#if defined(__PCLMUL__)
+#define HERMES_JSON_CLMUL 1
+#include <wmmintrin.h>
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define HERMES_JSON_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace hermes {
+namespace parser {
+
+namespace {
+
+/// Character classes of a 64-byte block, one bit per byte.
+struct BlockMasks {
+  uint64_t quote;
+  uint64_t backslash;
+  /// One of `{ } [ ] : ,`.
+  uint64_t op;
+  /// One of ' ', '\t', '\n', '\r'.
+  uint64_t whitespace;
+  /// A byte below 0x20.
+  uint64_t control;
+  /// A byte with the high bit set.
+  uint64_t nonASCII;
+};
+
+#if defined(HERMES_JSON_SSE2)
+
+inline unsigned eqMask(__m128i v, char c) {
+  return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+}
+
+/// Classify 16 bytes at \p p, storing the masks at bit offset \p shift.
+inline void classify16(const uint8_t *p, unsigned shift, BlockMasks &m) {
+  __m128i v = _mm_loadu_si128((const __m128i *)p);
+  // '[' and ']' differ from '{' and '}' only in bit 5.
+  __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+  unsigned op = eqMask(folded, '{') | eqMask(folded, '}') | eqMask(v, ':') |
+      eqMask(v, ',');
+  unsigned ws =
+      eqMask(v, ' ') | eqMask(v, '\t') | eqMask(v, '\n') | eqMask(v, '\r');
+  // v <= 0x1F (unsigned) iff max(v, 0x1F) == 0x1F.
+  __m128i limit = _mm_set1_epi8(0x1F);
+  unsigned control = (unsigned)_mm_movemask_epi8(
+      _mm_cmpeq_epi8(_mm_max_epu8(v, limit), limit));
+
+  m.quote |= (uint64_t)eqMask(v, '"') << shift;
+  m.backslash |= (uint64_t)eqMask(v, '\\') << shift;
+  m.op |= (uint64_t)op << shift;
+  m.whitespace |= (uint64_t)ws << shift;
+  m.control |= (uint64_t)control << shift;
+  m.nonASCII |= (uint64_t)_mm_movemask_epi8(v) << shift;
+}
+
+#elif defined(HERMES_JSON_NEON)
+
+/// Collapse a vector of 0x00/0xFF bytes into a 16-bit mask.
+inline unsigned movemask(uint8x16_t v) {
+  static const uint8_t kBits[16] = {
+      1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t masked = vandq_u8(v, vld1q_u8(kBits));
+  return (unsigned)vaddv_u8(vget_low_u8(masked)) |
+      ((unsigned)vaddv_u8(vget_high_u8(masked)) << 8);
+}
+
+inline uint8x16_t eqVec(uint8x16_t v, char c) {
+  return vceqq_u8(v, vdupq_n_u8((uint8_t)c));
+}
+
+/// Classify 16 bytes at \p p, storing the masks at bit offset \p shift.
+inline void classify16(const uint8_t *p, unsigned shift, BlockMasks &m) {
+  uint8x16_t v = vld1q_u8(p);
+  // '[' and ']' differ from '{' and '}' only in bit 5.
+  uint8x16_t folded = vorrq_u8(v, vdupq_n_u8(0x20));
+  uint8x16_t op = vorrq_u8(
+      vorrq_u8(eqVec(folded, '{'), eqVec(folded, '}')),
+      vorrq_u8(eqVec(v, ':'), eqVec(v, ',')));
+  uint8x16_t ws = vorrq_u8(
+      vorrq_u8(eqVec(v, ' '), eqVec(v, '\t')),
+      vorrq_u8(eqVec(v, '\n'), eqVec(v, '\r')));
+
+  m.quote |= (uint64_t)movemask(eqVec(v, '"')) << shift;
+  m.backslash |= (uint64_t)movemask(eqVec(v, '\\')) << shift;
+  m.op |= (uint64_t)movemask(op) << shift;
+  m.whitespace |= (uint64_t)movemask(ws) << shift;
+  m.control |= (uint64_t)movemask(vcleq_u8(v, vdupq_n_u8(0x1F))) << shift;
+  m.nonASCII |= (uint64_t)movemask(vcgeq_u8(v, vdupq_n_u8(0x80))) << shift;
+}
+
+#else
+
+enum : uint8_t {
+  ClsQuote = 1,
+  ClsBackslash = 2,
+  ClsOp = 4,
+  ClsWhitespace = 8,
+  ClsControl = 16,
+  ClsNonASCII = 32,
+};
+
+/// Character class table for the portable classifier.
+struct ClassTable {
+  uint8_t cls[256];
+
+  ClassTable() {
+    for (unsigned i = 0; i != 256; ++i)
+      cls[i] = i < 0x20 ? ClsControl : i >= 0x80 ? ClsNonASCII : 0;
+    cls[(uint8_t)'"'] |= ClsQuote;
+    cls[(uint8_t)'\\'] |= ClsBackslash;
+    for (char c : {'{', '}', '[', ']', ':', ','})
+      cls[(uint8_t)c] |= ClsOp;
+    for (char c : {' ', '\t', '\n', '\r'})
+      cls[(uint8_t)c] |= ClsWhitespace;
+  }
+};
+
+const ClassTable kClassTable{};
+
+/// Classify 16 bytes at \p p, storing the masks at bit offset \p shift.
+inline void classify16(const uint8_t *p, unsigned shift, BlockMasks &m) {
+  for (unsigned i = 0; i != 16; ++i) {
+    uint64_t bit = (uint64_t)1 << (shift + i);
+    uint8_t c = kClassTable.cls[p[i]];
+    if (c & ClsQuote)
+      m.quote |= bit;
+    if (c & ClsBackslash)
+      m.backslash |= bit;
+    if (c & ClsOp)
+      m.op |= bit;
+    if (c & ClsWhitespace)
+      m.whitespace |= bit;
+    if (c & ClsControl)
+      m.control |= bit;
+    if (c & ClsNonASCII)
+      m.nonASCII |= bit;
+  }
+}
+
+#endif
+
+inline BlockMasks classifyBlock(const uint8_t *p) {
+  BlockMasks m{0, 0, 0, 0, 0, 0};
+  classify16(p, 0, m);
+  classify16(p + 16, 16, m);
+  classify16(p + 32, 32, m);
+  classify16(p + 48, 48, m);
+  return m;
+}
+
+/// \return a mask where bit i is the XOR of bits 0..i of \p bits.
+inline uint64_t prefixXor(uint64_t bits) {
+#if defined(HERMES_JSON_CLMUL)
+  __m128i all = _mm_set1_epi8((char)0xFF);
+  __m128i res =
+      _mm_clmulepi64_si128(_mm_set_epi64x(0, (long long)bits), all, 0);
+  return (uint64_t)_mm_cvtsi128_si64(res);
+#else
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+#endif
+}
+
+/// Compute the mask of characters that are escaped by a backslash, given the
+/// mask of backslashes in the block. \p prevEscaped carries whether the first
+/// character of the block is escaped by a backslash at the end of the previous
+/// block.
+inline uint64_t findEscaped(uint64_t backslash, uint64_t &prevEscaped) {
+  // Only the first backslash of every run can start an escape; the parity of
+  // its position decides which following characters are escaped.
+  const uint64_t kEvenBits = 0x5555555555555555ULL;
+  backslash &= ~prevEscaped;
+  uint64_t followsEscape = (backslash << 1) | prevEscaped;
+  uint64_t oddSequenceStarts = backslash & ~kEvenBits & ~followsEscape;
+  uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+  // A carry out of the top bit means a run continues into the next block.
+  prevEscaped = sequencesStartingOnEvenBits < backslash ? 1 : 0;
+  uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+  return (kEvenBits ^ invertMask) & followsEscape;
+}
+
+/// Incremental UTF-8 validator. Its state survives block boundaries, so a
+/// multi-byte sequence may straddle two blocks.
+class UTF8Validator {
+  /// Continuation bytes still expected.
+  unsigned need_ = 0;
+  /// Inclusive range of the next continuation byte. The first continuation
+  /// byte is restricted to reject overlong forms, surrogates and values above
+  /// U+10FFFF.
+  uint8_t lo_ = 0x80;
+  uint8_t hi_ = 0xBF;
+  /// Offset of the lead byte of the pending sequence.
+  size_t seqStart_ = 0;
+
+ public:
+  bool pending() const {
+    return need_ != 0;
+  }
+
+  size_t getSequenceStart() const {
+    return seqStart_;
+  }
+
+  /// Validate \p len bytes at \p p, which start at input offset \p base.
+  /// \return true if valid; otherwise \p errOffset is set to the start of
+  ///   the offending sequence.
+  bool check(const uint8_t *p, size_t len, size_t base, size_t &errOffset) {
+    for (size_t i = 0; i != len; ++i) {
+      uint8_t c = p[i];
+      if (need_) {
+        if (c < lo_ || c > hi_) {
+          errOffset = seqStart_;
+          return false;
+        }
+        lo_ = 0x80;
+        hi_ = 0xBF;
+        --need_;
+        continue;
+      }
+      if (LLVM_LIKELY(c < 0x80))
+        continue;
+      seqStart_ = base + i;
+      if (c < 0xC2) {
+        errOffset = seqStart_;
+        return false;
+      } else if (c < 0xE0) {
+        need_ = 1;
+      } else if (c < 0xF0) {
+        need_ = 2;
+        if (c == 0xE0)
+          lo_ = 0xA0;
+        else if (c == 0xED)
+          hi_ = 0x9F;
+      } else if (c < 0xF5) {
+        need_ = 3;
+        if (c == 0xF0)
+          lo_ = 0x90;
+        else if (c == 0xF4)
+          hi_ = 0x8F;
+      } else {
+        errOffset = seqStart_;
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+} // namespace
+
+bool JSONStructuralIndex::build(llvh::StringRef input) {
+  positions_.clear();
+  errorMessage_ = nullptr;
+  errorOffset_ = 0;
+
+  const size_t len = input.size();
+  if (LLVM_UNLIKELY(len >= UINT32_MAX))
+    return error(0, "JSON input is too large");
+
+  // A rough guess that avoids most reallocations on typical documents.
+  positions_.reserve(len / 6 + 16);
+
+  const uint8_t *buf = (const uint8_t *)input.data();
+  UTF8Validator utf8{};
+  // Whether the first byte of the next block is escaped.
+  uint64_t prevEscaped = 0;
+  // All ones if the previous block ended inside a string.
+  uint64_t prevInString = 0;
+  // Whether the last byte of the previous block was part of a non-string
+  // scalar.
+  uint64_t prevScalar = 0;
+
+  for (size_t base = 0; base < len; base += 64) {
+    const size_t avail = len - base < 64 ? len - base : 64;
+    const uint8_t *block = buf + base;
+    uint8_t padded[64];
+    if (LLVM_UNLIKELY(avail < 64)) {
+      // Pad the tail with whitespace, which is neither a structural nor a
+      // scalar and so produces no positions.
+      std::memset(padded, ' ', sizeof(padded));
+      std::memcpy(padded, block, avail);
+      block = padded;
+    }
+
+    BlockMasks m = classifyBlock(block);
+
+    if (LLVM_UNLIKELY(m.nonASCII || utf8.pending())) {
+      size_t errOffset;
+      if (!utf8.check(block, avail, base, errOffset))
+        return error(errOffset, "invalid UTF-8 sequence");
+    }
+
+    uint64_t escaped = findEscaped(m.backslash, prevEscaped);
+    uint64_t quote = m.quote & ~escaped;
+    // Bits inside a string, including the opening quote but not the closing
+    // one.
+    uint64_t inString = prefixXor(quote) ^ prevInString;
+    prevInString = (uint64_t)((int64_t)inString >> 63);
+
+    if (LLVM_UNLIKELY(m.control & inString)) {
+      return error(
+          base + llvh::countTrailingZeros(m.control & inString),
+          "unescaped control character in string");
+    }
+
+    // Everything after the opening quote of a string, up to and including
+    // the closing quote.
+    uint64_t stringTail = inString ^ quote;
+    uint64_t scalar = ~(m.op | m.whitespace);
+    uint64_t nonQuoteScalar = scalar & ~quote;
+    uint64_t followsNonQuoteScalar = (nonQuoteScalar << 1) | prevScalar;
+    prevScalar = nonQuoteScalar >> 63;
+    uint64_t scalarStarts = scalar & ~followsNonQuoteScalar;
+    uint64_t structurals = (m.op | scalarStarts) & ~stringTail;
+
+    if (uint64_t bits = structurals) {
+      size_t count = llvh::countPopulation(bits);
+      size_t at = positions_.size();
+      positions_.resize(at + count);
+      uint32_t *out = positions_.data() + at;
+      do {
+        *out++ = (uint32_t)(base + llvh::countTrailingZeros(bits));
+        bits &= bits - 1;
+      } while (bits);
+    }
+  }
+
+  if (LLVM_UNLIKELY(utf8.pending()))
+    return error(utf8.getSequenceStart(), "invalid UTF-8 sequence");
+  if (LLVM_UNLIKELY(prevInString)) {
+    // Report the error at the opening quote of the unterminated string, which
+    // is the last recorded position.
+    return error(
+        positions_.empty() ? len : positions_.back(),
+        "unterminated string literal");
+  }
+
+  return true;
+}
+
+const char *findQuoteOrBackslash(const char *p, const char *end) {
+#if defined(HERMES_JSON_SSE2)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  for (; end - p >= 16; p += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    unsigned mask = (unsigned)_mm_movemask_epi8(_mm_or_si128(
+        _mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)));
+    if (mask)
+      return p + llvh::countTrailingZeros(mask);
+  }
+#elif defined(HERMES_JSON_NEON)
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t v = vld1q_u8((const uint8_t *)p);
+    unsigned mask = movemask(vorrq_u8(eqVec(v, '"'), eqVec(v, '\\')));
+    if (mask)
+      return p + llvh::countTrailingZeros(mask);
+  }
+#endif
+  for (; p != end; ++p) {
+    if (*p == '"' || *p == '\\')
+      return p;
+  }
+  return end;
+}
+
+const char *findQuoteOrBracket(const char *p, const char *end) {
+#if defined(HERMES_JSON_SSE2)
+  for (; end - p >= 16; p += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    unsigned mask =
+        eqMask(v, '"') | eqMask(folded, '{') | eqMask(folded, '}');
+    if (mask)
+      return p + llvh::countTrailingZeros(mask);
+  }
+#elif defined(HERMES_JSON_NEON)
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t v = vld1q_u8((const uint8_t *)p);
+    uint8x16_t folded = vorrq_u8(v, vdupq_n_u8(0x20));
+    unsigned mask = movemask(vorrq_u8(
+        eqVec(v, '"'), vorrq_u8(eqVec(folded, '{'), eqVec(folded, '}'))));
+    if (mask)
+      return p + llvh::countTrailingZeros(mask);
+  }
+#endif
+  for (; p != end; ++p) {
+    switch (*p) {
+      case '"':
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+        return p;
+    }
+  }
+  return end;
+}
+
+const char *scanJSONNumber(const char *p, const char *end, double &value) {
+  auto isDigit = [end](const char *ptr) {
+    return ptr != end && *ptr >= '0' && *ptr <= '9';
+  };
+
+  const char *ptr = p;
+  const bool negative = *ptr == '-';
+  if (negative)
+    ++ptr;
+  const char *digits = ptr;
+  if (!isDigit(ptr))
+    return nullptr;
+
+  uint64_t mantissa = 0;
+  if (*ptr == '0') {
+    ++ptr;
+  } else {
+    do
+      mantissa = mantissa * 10 + (*ptr++ - '0');
+    while (isDigit(ptr));
+  }
+  const char *intEnd = ptr;
+
+  if (ptr != end && *ptr == '.') {
+    ++ptr;
+    if (!isDigit(ptr))
+      return nullptr;
+    while (isDigit(ptr))
+      ++ptr;
+  }
+  if (ptr != end && (*ptr == 'e' || *ptr == 'E')) {
+    ++ptr;
+    if (ptr != end && (*ptr == '+' || *ptr == '-'))
+      ++ptr;
+    if (!isDigit(ptr))
+      return nullptr;
+    while (isDigit(ptr))
+      ++ptr;
+  }
+
+  if (ptr == intEnd && intEnd - digits <= 15) {
+    // Integers of up to 15 digits are exactly representable.
+    value = (double)mantissa;
+  } else {
+    // The input need not be terminated right after the number, so give
+    // strtod a terminated copy.
+    llvh::SmallString<32> str{llvh::StringRef(digits, ptr - digits)};
+    value = hermes_g_strtod(str.c_str(), nullptr);
+  }
+  if (negative)
+    value = -value;
+  return ptr;
+}
+
+} // namespace parser
+} // namespace hermes
@@ -67,6 +67,30 @@ llvh::ArrayRef<StoredToken> JSParser::getStoredTokens() const {
   return impl_->getLexer().getStoredTokens();
 }
 
+llvh::ArrayRef<SkippedType> JSParser::getSkippedTypes() const {
+  return impl_->getLexer().getSkippedTypes();
+}
+
+std::vector<SkippedType> JSParser::moveSkippedTypes() const {
+  return impl_->getLexer().moveSkippedTypes();
+}
+
+void JSParser::setCollectDependencies(bool collect) {
+  impl_->setCollectDependencies(collect);
+}
+
+bool JSParser::scanDependencies() {
+  return impl_->scanDependencies();
+}
+
+llvh::ArrayRef<ModuleDependency> JSParser::getDependencies() const {
+  return impl_->getLexer().getDependencies();
+}
+
+std::vector<ModuleDependency> JSParser::moveDependencies() const {
+  return impl_->getLexer().moveDependencies();
+}
+
 void JSParser::setStoreComments(bool storeComments) {
   impl_->getLexer().setStoreComments(storeComments);
 }
@@ -83,6 +107,23 @@ llvh::Optional<ESTree::ProgramNode *> JSParser::parse() {
   return impl_->parse();
 }
 
+llvh::Optional<ESTree::ProgramNode *> JSParser::parseStreaming(
+    StatementCallback callback) {
+  return impl_->parseStreaming(callback);
+}
+
+llvh::Optional<ESTree::ProgramNode *> JSParser::reparse(
+    ESTree::ProgramNode *program,
+    llvh::StringRef oldSource,
+    const SourceEdit &edit,
+    llvh::ArrayRef<SkippedType> oldSkippedTypes) {
+  return impl_->reparse(program, oldSource, edit, oldSkippedTypes);
+}
+
+bool JSParser::wasReparsedIncrementally() const {
+  return impl_->wasReparsedIncrementally();
+}
+
 void JSParser::seek(SMLoc startPos) {
   return impl_->seek(startPos);
 }
@@ -98,6 +139,14 @@ std::unique_ptr<JSParser> JSParser::preParseBuffer(
   }
 }
 
+void JSParser::initializeKnownIdentifiers(Context &context) {
+  if (context.getKnownIdentifiers())
+    return;
+  auto known = std::make_shared<detail::KnownIdentifiers>();
+  known->intern(context.getStringTable());
+  context.setKnownIdentifiers(std::move(known));
+}
+
 llvh::Optional<ESTree::NodePtr> JSParser::parseLazyFunction(
     ESTree::NodeKind kind,
     bool paramYield,
@@ -0,0 +1,641 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "JSParserImpl.h"
+
+#include "llvh/ADT/SmallVector.h"
+#include "llvh/ADT/StringSwitch.h"
+
+#include <algorithm>
+
+namespace hermes {
+namespace parser {
+namespace detail {
+
+namespace {
+
+/// The brackets that are open while dependencies are scanned.
+enum class Bracket : uint8_t {
+  Paren,
+  /// The parentheses after `if`, `for`, `while` or `with`, which are followed
+  /// by a statement rather than by the rest of an expression.
+  HeadParen,
+  Square,
+  Brace,
+  /// The `${` of a template literal.
+  Substitution,
+  /// The `{` of an expression in JSX.
+  JSXExpression,
+  /// The attributes of a JSX element, up to the end of its opening tag.
+  JSXTag,
+  /// The children of a JSX element, up to its closing tag.
+  JSXChildren,
+};
+
+/// What may follow a token, as far as the scanner can tell.
+enum class After : uint8_t {
+  /// An expression may start, so '/' starts a regexp and '<' may start JSX.
+  Operator,
+  /// An expression ended, so '/' divides.
+  Operand,
+  /// Either one, depending on more than the tokens before, so the program has
+  /// to be parsed if a '/' follows.
+  Unknown,
+};
+
+/// The words the scanner tells apart.
+enum class Word : uint8_t {
+  /// An identifier or a keyword that ends an expression, like `this`.
+  Name,
+  /// A keyword that an expression may follow, like `return`.
+  Operator,
+  /// A keyword followed by a parenthesized head and a statement.
+  Head,
+  /// `await`, `yield` and `of`, which may be keywords or identifiers.
+  Ambiguous,
+  Require,
+  Import,
+  Export,
+};
+
+Word classifyWord(llvh::StringRef word) {
+  return llvh::StringSwitch<Word>(word)
+      .Cases("if", "for", "while", "with", Word::Head)
+      .Cases("await", "yield", "of", Word::Ambiguous)
+      .Cases("in", "instanceof", "typeof", "new", "delete", Word::Operator)
+      .Cases("void", "throw", "return", "case", "do", Word::Operator)
+      .Cases("else", "extends", "default", Word::Operator)
+      .Case("require", Word::Require)
+      .Case("import", Word::Import)
+      .Case("export", Word::Export)
+      .Default(Word::Name);
+}
+
+inline bool isWordChar(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+      (c >= '0' && c <= '9') || c == '_' || c == '$';
+}
+
+inline bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+inline bool isLineTerminator(char c) {
+  return c == '\n' || c == '\r';
+}
+
+/// \return the first character at or after \p ptr that is not ASCII
+///   whitespace or part of a comment, or nullptr if a comment is not
+///   terminated.
+const char *skipSpace(const char *ptr, const char *end) {
+  while (ptr != end) {
+    char c = *ptr;
+    if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' ||
+        c == '\f') {
+      ++ptr;
+    } else if (c == '/' && end - ptr > 1 && ptr[1] == '/') {
+      while (ptr != end && !isLineTerminator(*ptr))
+        ++ptr;
+    } else if (c == '/' && end - ptr > 1 && ptr[1] == '*') {
+      for (ptr += 2;; ++ptr) {
+        if (end - ptr < 2)
+          return nullptr;
+        if (ptr[0] == '*' && ptr[1] == '/')
+          break;
+      }
+      ptr += 2;
+    } else {
+      break;
+    }
+  }
+  return ptr;
+}
+
+/// Skip the string literal whose opening quote is at \p ptr.
+/// \return the end of the literal, or nullptr if it is not terminated.
+const char *skipString(const char *ptr, const char *end) {
+  char quote = *ptr++;
+  while (ptr != end) {
+    char c = *ptr++;
+    if (c == quote)
+      return ptr;
+    if (isLineTerminator(c))
+      return nullptr;
+    if (c == '\\' && ptr != end) {
+      // A line continuation may be "\r\n".
+      if (*ptr == '\r' && end - ptr > 1 && ptr[1] == '\n')
+        ++ptr;
+      ++ptr;
+    }
+  }
+  return nullptr;
+}
+
+/// Skip the characters of a template literal, starting after its opening '`'
+/// or after the '}' of a substitution.
+/// \return the end of the literal or the end of the '${' of the next
+///   substitution, or nullptr if the literal is not terminated.
+const char *skipTemplate(const char *ptr, const char *end) {
+  while (ptr != end) {
+    char c = *ptr++;
+    if (c == '`')
+      return ptr;
+    if (c == '$' && ptr != end && *ptr == '{')
+      return ptr + 1;
+    if (c == '\\' && ptr != end)
+      ++ptr;
+  }
+  return nullptr;
+}
+
+/// Skip the regexp literal whose opening '/' is at \p ptr.
+/// \return the end of the literal, or nullptr if it is not terminated.
+const char *skipRegExp(const char *ptr, const char *end) {
+  bool inClass = false;
+  for (++ptr; ptr != end; ++ptr) {
+    char c = *ptr;
+    if (isLineTerminator(c))
+      return nullptr;
+    if (c == '\\') {
+      if (++ptr == end || isLineTerminator(*ptr))
+        return nullptr;
+    } else if (c == '[') {
+      inClass = true;
+    } else if (c == ']') {
+      inClass = false;
+    } else if (c == '/' && !inClass) {
+      // The flags.
+      for (++ptr; ptr != end && isWordChar(*ptr); ++ptr) {
+      }
+      return ptr;
+    }
+  }
+  return nullptr;
+}
+
+/// Skip the numeric literal starting at \p ptr. Anything that could follow
+/// an 'e' in it is skipped, which is harmless for a hexadecimal number, since
+/// '+' and '-' are followed by an expression either way.
+const char *skipNumber(const char *ptr, const char *end) {
+  while (ptr != end) {
+    char c = *ptr;
+    if (isWordChar(c) || c == '.') {
+      ++ptr;
+    } else if ((c == '+' || c == '-') && (ptr[-1] == 'e' || ptr[-1] == 'E')) {
+      ++ptr;
+    } else {
+      break;
+    }
+  }
+  return ptr;
+}
+
+/// \return the end of the JSX element name, or attribute name, at \p ptr.
+const char *skipJSXName(const char *ptr, const char *end) {
+  while (ptr != end &&
+         (isWordChar(*ptr) || *ptr == '-' || *ptr == ':' || *ptr == '.'))
+    ++ptr;
+  return ptr;
+}
+
+/// Skip the JSX at \p ptr, which is in the tag or among the children of the
+/// element that is open on top of \p brackets, whose names are on top of
+/// \p names. Stop after a `{` that starts an expression, which is pushed on
+/// \p brackets, or after the end of the outermost element.
+/// \return where to continue, or nullptr if the JSX can't be skipped.
+const char *skipJSX(
+    const char *ptr,
+    const char *end,
+    llvh::SmallVectorImpl<Bracket> &brackets,
+    llvh::SmallVectorImpl<llvh::StringRef> &names) {
+  // Pop the element on top, and \return whether it was the outermost one.
+  auto closeElement = [&]() {
+    brackets.pop_back();
+    names.pop_back();
+    return brackets.empty() || brackets.back() != Bracket::JSXChildren;
+  };
+
+  for (;;) {
+    if (brackets.back() == Bracket::JSXTag) {
+      ptr = skipSpace(ptr, end);
+      if (!ptr || ptr == end)
+        return nullptr;
+      char c = *ptr;
+      if (c == '{') {
+        brackets.push_back(Bracket::JSXExpression);
+        return ptr + 1;
+      } else if (c == '"' || c == '\'') {
+        // Attribute strings have no escapes, and may span lines.
+        ptr = std::find(ptr + 1, end, c);
+        if (ptr == end)
+          return nullptr;
+        ++ptr;
+      } else if (c == '>') {
+        brackets.back() = Bracket::JSXChildren;
+        ++ptr;
+      } else if (c == '/' && end - ptr > 1 && ptr[1] == '>') {
+        ptr += 2;
+        if (closeElement())
+          return ptr;
+      } else if (c == '=') {
+        ++ptr;
+      } else {
+        const char *nameEnd = skipJSXName(ptr, end);
+        if (nameEnd == ptr)
+          return nullptr;
+        ptr = nameEnd;
+      }
+      continue;
+    }
+
+    // Text, up to an expression or a tag.
+    while (ptr != end && *ptr != '{' && *ptr != '<')
+      ++ptr;
+    if (ptr == end)
+      return nullptr;
+    if (*ptr == '{') {
+      brackets.push_back(Bracket::JSXExpression);
+      return ptr + 1;
+    }
+    ptr = skipSpace(ptr + 1, end);
+    if (!ptr || ptr == end)
+      return nullptr;
+    if (*ptr != '/') {
+      // A child element.
+      const char *nameEnd = skipJSXName(ptr, end);
+      names.push_back(llvh::StringRef(ptr, nameEnd - ptr));
+      brackets.push_back(Bracket::JSXTag);
+      ptr = nameEnd;
+      continue;
+    }
+    // The closing tag, which must match.
+    ptr = skipSpace(ptr + 1, end);
+    if (!ptr)
+      return nullptr;
+    const char *nameEnd = skipJSXName(ptr, end);
+    if (llvh::StringRef(ptr, nameEnd - ptr) != names.back())
+      return nullptr;
+    ptr = skipSpace(nameEnd, end);
+    if (!ptr || ptr == end || *ptr != '>')
+      return nullptr;
+    ++ptr;
+    if (closeElement())
+      return ptr;
+  }
+}
+
+} // namespace
+
+bool JSParserImpl::scanDependencySource() {
+  const char *const start = lexer_.getBufferStart();
+  const char *const end = lexer_.getBufferEnd();
+  const char *ptr = start;
+
+  // A byte order mark, and a hashbang line, which the lexer skips as well.
+  if (end - ptr >= 3 && llvh::StringRef(ptr, 3) == "\xEF\xBB\xBF")
+    ptr += 3;
+  if (end - ptr >= 2 && ptr[0] == '#' && ptr[1] == '!') {
+    while (ptr != end && !isLineTerminator(*ptr))
+      ++ptr;
+  }
+
+  llvh::SmallVector<Bracket, 32> brackets{};
+  // The names of the open JSX elements.
+  llvh::SmallVector<llvh::StringRef, 8> jsxNames{};
+  After after = After::Operator;
+  // Whether the current token follows `.` or `?.`, so a word is a property
+  // name.
+  bool afterDot = false;
+  // Whether the current token follows `if`, `for`, `while` or `with`.
+  bool afterHead = false;
+  // Whether the current token follows `new`, so `require(` is not a call.
+  bool afterNew = false;
+  // How far the current token is into `require(` or `import(` followed by a
+  // string literal: 1 after the name, 2 after the parenthesis.
+  unsigned callStage = 0;
+  ModuleDependency::Kind callKind = ModuleDependency::Kind::Require;
+  unsigned tokenCount = 0;
+
+  // Parse a production at \p at with \p parse, and continue after it.
+  auto parseAt = [this, &ptr](const char *at, auto parse) -> bool {
+    seek(SMLoc::getFromPointer(at));
+    if (!parse())
+      return false;
+    ptr = tok_->getStartLoc().getPointer();
+    return true;
+  };
+
+  for (;;) {
+    if (!brackets.empty() && brackets.back() >= Bracket::JSXTag) {
+      ptr = skipJSX(ptr, end, brackets, jsxNames);
+      if (!ptr)
+        return false;
+      // Either an expression starts, or the outermost element ended.
+      after = brackets.empty() || brackets.back() != Bracket::JSXExpression
+          ? After::Operand
+          : After::Operator;
+      afterDot = afterHead = afterNew = false;
+      callStage = 0;
+      continue;
+    }
+
+    ptr = skipSpace(ptr, end);
+    if (!ptr)
+      return false;
+    if (ptr == end)
+      return brackets.empty();
+    // Nothing is lexed, so poll the interrupt here instead.
+    if (LLVM_UNLIKELY(++tokenCount % 1024 == 0) && interruptCheck())
+      return false;
+
+    const char *tokStart = ptr;
+    char c = *ptr;
+    After next = After::Operator;
+    bool dot = false;
+    bool head = false;
+    bool isNew = false;
+    unsigned stage = 0;
+
+    if (isWordChar(c) && !isDigit(c)) {
+      while (ptr != end && isWordChar(*ptr))
+        ++ptr;
+      // Escapes and non-ASCII characters are left to the lexer, as is any
+      // whitespace that isn't ASCII.
+      if (ptr != end && (*ptr == '\\' || (unsigned char)*ptr >= 0x80))
+        return false;
+      Word word = afterDot
+          ? Word::Name
+          : classifyWord(llvh::StringRef(tokStart, ptr - tokStart));
+      switch (word) {
+        case Word::Name:
+          next = After::Operand;
+          break;
+        case Word::Operator:
+          isNew = ptr - tokStart == 3 && llvh::StringRef(tokStart, 3) == "new";
+          break;
+        case Word::Head:
+          head = true;
+          break;
+        case Word::Ambiguous:
+          next = After::Unknown;
+          // `for await (`.
+          head = afterHead;
+          break;
+        case Word::Require:
+          // `new require('m')` constructs, and is not a dependency.
+          if (!afterNew) {
+            callKind = ModuleDependency::Kind::Require;
+            stage = 1;
+          }
+          next = After::Operand;
+          break;
+        case Word::Import: {
+          const char *following = skipSpace(ptr, end);
+          if (!following)
+            return false;
+          if (following != end && *following == '(') {
+            callKind = ModuleDependency::Kind::DynamicImport;
+            stage = 1;
+            break;
+          }
+          if (following != end && *following == '.') {
+            // `import.meta`.
+            next = After::Operand;
+            break;
+          }
+          // An import declaration, which may only be at the top level.
+          if (!brackets.empty())
+            return false;
+          if (!parseAt(tokStart, [this]() {
+                return parseImportExport([this]() -> Optional<ESTree::Node *> {
+                  auto decl = parseImportDeclaration();
+                  if (!decl)
+                    return None;
+                  return *decl;
+                });
+              }))
+            return false;
+          after = After::Operator;
+          afterDot = afterHead = afterNew = false;
+          callStage = 0;
+          continue;
+        }
+        case Word::Export: {
+          // Only the declarations that can name a module are parsed, the
+          // others are scanned like any other statement.
+          const char *following = skipSpace(ptr, end);
+          if (!following)
+            return false;
+          if (following != end && following[0] == 't' &&
+              llvh::StringRef(following, end - following).startswith("type") &&
+              !(end - following > 4 && isWordChar(following[4]))) {
+            // `export type {T} from 'm'`, or `export type * from 'm'`.
+            following = skipSpace(following + 4, end);
+            if (!following)
+              return false;
+          }
+          if (following == end || (*following != '*' && *following != '{'))
+            break;
+          if (!brackets.empty())
+            return false;
+          if (!parseAt(tokStart, [this]() {
+                return parseImportExport(
+                    [this]() { return parseExportDeclaration(); });
+              }))
+            return false;
+          after = After::Operator;
+          afterDot = afterHead = afterNew = false;
+          callStage = 0;
+          continue;
+        }
+      }
+    } else if (isDigit(c) || (c == '.' && end - ptr > 1 && isDigit(ptr[1]))) {
+      ptr = skipNumber(ptr, end);
+      next = After::Operand;
+    } else {
+      switch (c) {
+        case '"':
+        case '\'': {
+          ptr = skipString(ptr, end);
+          if (!ptr)
+            return false;
+          const char *following = skipSpace(ptr, end);
+          if (!following)
+            return false;
+          // `import()` may have options after the specifier.
+          if (callStage == 2 && following != end &&
+              (*following == ')' ||
+               (*following == ',' &&
+                callKind == ModuleDependency::Kind::DynamicImport))) {
+            // Let the lexer decode the string.
+            seek(SMLoc::getFromPointer(tokStart));
+            lexer_.storeDependency(
+                callKind,
+                false,
+                tok_->getStringLiteral(),
+                tok_->getSourceRange());
+          }
+          next = After::Operand;
+          break;
+        }
+        case '`':
+          ptr = skipTemplate(ptr + 1, end);
+          if (!ptr)
+            return false;
+          if (ptr[-1] == '{')
+            brackets.push_back(Bracket::Substitution);
+          else
+            next = After::Operand;
+          break;
+
+        case '/':
+          if (after == After::Unknown)
+            return false;
+          if (after == After::Operator) {
+            ptr = skipRegExp(ptr, end);
+            if (!ptr)
+              return false;
+            next = After::Operand;
+          } else {
+            ++ptr;
+          }
+          break;
+
+        case '(':
+          brackets.push_back(afterHead ? Bracket::HeadParen : Bracket::Paren);
+          if (callStage == 1)
+            stage = 2;
+          ++ptr;
+          break;
+        case ')':
+          if (brackets.empty() || brackets.back() > Bracket::HeadParen)
+            return false;
+          if (brackets.back() == Bracket::Paren)
+            next = After::Operand;
+          brackets.pop_back();
+          ++ptr;
+          break;
+        case '[':
+          brackets.push_back(Bracket::Square);
+          ++ptr;
+          break;
+        case ']':
+          if (brackets.empty() || brackets.back() != Bracket::Square)
+            return false;
+          brackets.pop_back();
+          next = After::Operand;
+          ++ptr;
+          break;
+        case '{':
+          brackets.push_back(Bracket::Brace);
+          ++ptr;
+          break;
+        case '}':
+          if (brackets.empty())
+            return false;
+          if (brackets.back() == Bracket::Substitution) {
+            ptr = skipTemplate(ptr + 1, end);
+            if (!ptr)
+              return false;
+            if (ptr[-1] != '{') {
+              brackets.pop_back();
+              next = After::Operand;
+            }
+            break;
+          }
+          if (brackets.back() == Bracket::JSXExpression) {
+            // Back to the JSX around it.
+            brackets.pop_back();
+            ++ptr;
+            break;
+          }
+          if (brackets.back() != Bracket::Brace)
+            return false;
+          brackets.pop_back();
+          // The end of a block or of an object literal.
+          next = After::Unknown;
+          ++ptr;
+          break;
+
+        case '.':
+          if (end - ptr > 2 && ptr[1] == '.' && ptr[2] == '.') {
+            ptr += 3;
+          } else {
+            dot = true;
+            ++ptr;
+          }
+          break;
+        case '?':
+          if (end - ptr > 1 && ptr[1] == '.' &&
+              !(end - ptr > 2 && isDigit(ptr[2]))) {
+            dot = true;
+            ptr += 2;
+          } else {
+            ++ptr;
+          }
+          break;
+        case '+':
+        case '-':
+          if (end - ptr > 1 && ptr[1] == c) {
+            next = After::Operand;
+            ptr += 2;
+          } else {
+            ++ptr;
+          }
+          break;
+        case '!':
+          ++ptr;
+          // A TypeScript non-null assertion, `x! / y`, or `!/re/`.
+          if (getParseTS() && !(ptr != end && *ptr == '='))
+            next = After::Unknown;
+          break;
+        case '#':
+          // A private name.
+          ++ptr;
+          while (ptr != end && isWordChar(*ptr))
+            ++ptr;
+          next = After::Operand;
+          break;
+
+#if HERMES_PARSE_JSX
+        case '<':
+          if (after == After::Unknown && getParseJSX())
+            return false;
+          ++ptr;
+          if (after == After::Operator && getParseJSX()) {
+            // An element, or a Flow type parameter list, which is taken for
+            // an element whose closing tag never comes.
+            ptr = skipSpace(ptr, end);
+            if (!ptr)
+              return false;
+            const char *nameEnd = skipJSXName(ptr, end);
+            jsxNames.push_back(llvh::StringRef(ptr, nameEnd - ptr));
+            brackets.push_back(Bracket::JSXTag);
+            ptr = nameEnd;
+          }
+          break;
+#endif
+
+        default:
+          if (c == '\\' || (unsigned char)c >= 0x80)
+            return false;
+          ++ptr;
+          break;
+      }
+    }
+
+    after = next;
+    afterDot = dot;
+    afterHead = head;
+    afterNew = isNew;
+    callStage = stage;
+  }
+}
+
+} // namespace detail
+} // namespace parser
+} // namespace hermes
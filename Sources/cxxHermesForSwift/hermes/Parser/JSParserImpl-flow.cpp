@@ -22,12 +22,11 @@ Optional<ESTree::Node *> JSParserImpl::parseFlowDeclaration() {
   assert(checkDeclaration());
   SMLoc start = tok_->getStartLoc();
 
-  if (context_.getParseFlowComponentSyntax() &&
-      checkComponentDeclarationFlow()) {
+  if (getParseFlowComponentSyntax() && checkComponentDeclarationFlow()) {
     return parseComponentDeclarationFlow(start, /* declare */ false);
   }
 
-  if (context_.getParseFlowComponentSyntax() && checkHookDeclarationFlow()) {
+  if (getParseFlowComponentSyntax() && checkHookDeclarationFlow()) {
     return parseHookDeclarationFlow(start);
   }
 
@@ -97,12 +96,11 @@ Optional<ESTree::Node *> JSParserImpl::parseDeclareFLow(SMLoc start) {
     return parseDeclareFunctionFlow(start);
   }
 
-  if (context_.getParseFlowComponentSyntax() && checkHookDeclarationFlow()) {
+  if (getParseFlowComponentSyntax() && checkHookDeclarationFlow()) {
     return parseDeclareHookFlow(start);
   }
 
-  if (context_.getParseFlowComponentSyntax() &&
-      checkComponentDeclarationFlow()) {
+  if (getParseFlowComponentSyntax() && checkComponentDeclarationFlow()) {
     return parseComponentDeclarationFlow(start, /* declare */ true);
   }
   if (check(TokenKind::rw_enum)) {
@@ -1378,7 +1376,7 @@ Optional<ESTree::Node *> JSParserImpl::parseDeclareExportFlow(SMLoc start) {
           new (context_) ESTree::DeclareExportDeclarationNode(
               *optFunc, {}, nullptr, true));
     }
-    if (context_.getParseFlowComponentSyntax() && checkHookDeclarationFlow()) {
+    if (getParseFlowComponentSyntax() && checkHookDeclarationFlow()) {
       auto optFunc = parseDeclareHookFlow(declareStart);
       if (!optFunc)
         return None;
@@ -1388,8 +1386,7 @@ Optional<ESTree::Node *> JSParserImpl::parseDeclareExportFlow(SMLoc start) {
           new (context_) ESTree::DeclareExportDeclarationNode(
               *optFunc, {}, nullptr, true));
     }
-    if (context_.getParseFlowComponentSyntax() &&
-        checkComponentDeclarationFlow()) {
+    if (getParseFlowComponentSyntax() && checkComponentDeclarationFlow()) {
       auto optComponent =
           parseComponentDeclarationFlow(start, /* declare */ true);
       if (!optComponent)
@@ -1433,7 +1430,7 @@ Optional<ESTree::Node *> JSParserImpl::parseDeclareExportFlow(SMLoc start) {
             ESTree::DeclareExportDeclarationNode(*optFunc, {}, nullptr, false));
   }
 
-  if (context_.getParseFlowComponentSyntax() && checkHookDeclarationFlow()) {
+  if (getParseFlowComponentSyntax() && checkHookDeclarationFlow()) {
     auto optFunc = parseDeclareHookFlow(declareStart);
     if (!optFunc)
       return None;
@@ -1455,8 +1452,7 @@ Optional<ESTree::Node *> JSParserImpl::parseDeclareExportFlow(SMLoc start) {
             *optClass, {}, nullptr, false));
   }
 
-  if (context_.getParseFlowComponentSyntax() &&
-      checkComponentDeclarationFlow()) {
+  if (getParseFlowComponentSyntax() && checkComponentDeclarationFlow()) {
     auto optComponent =
         parseComponentDeclarationFlow(start, /* declare */ true);
     if (!optComponent)
@@ -1603,6 +1599,15 @@ Optional<ESTree::Node *> JSParserImpl::parseReturnTypeAnnotationFlow(
     Optional<SMLoc> wrappedStart,
     AllowAnonFunctionType allowAnonFunctionType) {
   SMLoc start = tok_->getStartLoc();
+  if (LLVM_UNLIKELY(shouldSkipType())) {
+    return skipType(
+        wrappedStart ? *wrappedStart : start,
+        SkippedType::Kind::Annotation,
+        [&] {
+          return parseReturnTypeAnnotationFlow(
+              wrappedStart, allowAnonFunctionType);
+        });
+  }
   ESTree::Node *returnType = nullptr;
   if (check(assertsIdent_)) {
     // TypePredicate (asserts = true) or TypeAnnotation:
@@ -1730,8 +1735,7 @@ Optional<ESTree::Node *> JSParserImpl::parseReturnTypeAnnotationFlow(
 Optional<ESTree::Node *> JSParserImpl::parseTypeAnnotationBeforeColonFlow() {
   // If the identifier name is a known keyword we need to lookahead to see if
   // its a type or an identifier otherwise it could fail to parse.
-  if (check(TokenKind::identifier) &&
-      (context_.getParseFlowComponentSyntax())) {
+  if (check(TokenKind::identifier) && getParseFlowComponentSyntax()) {
     if ((tok_->getResWordOrIdentifier() == componentIdent_) ||
         (tok_->getResWordOrIdentifier() == hookIdent_) ||
         (tok_->getResWordOrIdentifier() == rendersIdent_ &&
@@ -1797,6 +1801,14 @@ Optional<ESTree::Node *> JSParserImpl::parseTypeAnnotationBeforeColonFlow() {
 Optional<ESTree::Node *> JSParserImpl::parseTypeAnnotationFlow(
     Optional<SMLoc> wrappedStart,
     AllowAnonFunctionType allowAnonFunctionType) {
+  if (LLVM_UNLIKELY(shouldSkipType())) {
+    return skipType(
+        wrappedStart ? *wrappedStart : tok_->getStartLoc(),
+        SkippedType::Kind::Annotation,
+        [&] {
+          return parseTypeAnnotationFlow(wrappedStart, allowAnonFunctionType);
+        });
+  }
   llvh::SaveAndRestore<bool> saveParam(
       allowAnonFunctionType_,
       allowAnonFunctionType == AllowAnonFunctionType::Yes);
@@ -2118,7 +2130,7 @@ Optional<ESTree::Node *> JSParserImpl::parsePrimaryTypeAnnotationFlow() {
             getPrevTokenEndLoc(),
             new (context_) ESTree::KeyofTypeAnnotationNode(*optBody));
       }
-      if (context_.getParseFlowComponentSyntax() &&
+      if (getParseFlowComponentSyntax() &&
           tok_->getResWordOrIdentifier() == rendersIdent_) {
         auto optTypeOperator = parseRenderTypeOperator();
         auto optBody = parsePrefixTypeAnnotationFlow();
@@ -2130,14 +2142,14 @@ Optional<ESTree::Node *> JSParserImpl::parsePrimaryTypeAnnotationFlow() {
             new (context_)
                 ESTree::TypeOperatorNode(*optTypeOperator, *optBody));
       }
-      if (context_.getParseFlowComponentSyntax() &&
+      if (getParseFlowComponentSyntax() &&
           tok_->getResWordOrIdentifier() == componentIdent_) {
         auto optComponent = parseComponentTypeAnnotationFlow();
         if (!optComponent)
           return None;
         return *optComponent;
       }
-      if (context_.getParseFlowComponentSyntax() &&
+      if (getParseFlowComponentSyntax() &&
           tok_->getResWordOrIdentifier() == hookIdent_) {
         auto optHook = parseHookTypeAnnotationFlow();
         if (!optHook)
@@ -2175,7 +2187,7 @@ Optional<ESTree::Node *> JSParserImpl::parsePrimaryTypeAnnotationFlow() {
           //
           // We don't know, so we assume it's part of the infer type for now,
           // and later backtrack if the assumption is wrong.
-          JSLexer::SavePoint savePoint{&lexer_};
+          SpeculationPoint savePoint{this};
           advance(JSLexer::GrammarContext::Type);
           auto parsedBound = parseUnionTypeAnnotationFlow();
           if ((allowConditionalType_ && check(TokenKind::question)) ||
@@ -3374,6 +3386,12 @@ Optional<ESTree::Node *> JSParserImpl::parseTypeCallPropertyFlow(
 
 Optional<ESTree::Node *> JSParserImpl::parseTypeParamsFlow() {
   assert(check(TokenKind::less));
+  if (LLVM_UNLIKELY(shouldSkipType())) {
+    return skipType(
+        tok_->getStartLoc(), SkippedType::Kind::TypeParameters, [this] {
+          return parseTypeParamsFlow();
+        });
+  }
   SMLoc start = advance(JSLexer::GrammarContext::Type).Start;
 
   ESTree::NodeList params{};
@@ -3461,6 +3479,12 @@ Optional<ESTree::Node *> JSParserImpl::parseTypeParamFlow() {
 
 Optional<ESTree::Node *> JSParserImpl::parseTypeArgsFlow() {
   assert(check(TokenKind::less));
+  if (LLVM_UNLIKELY(shouldSkipType())) {
+    return skipType(
+        tok_->getStartLoc(), SkippedType::Kind::TypeArguments, [this] {
+          return parseTypeArgsFlow();
+        });
+  }
   SMLoc start = advance(JSLexer::GrammarContext::Type).Start;
 
   ESTree::NodeList params{};
@@ -3720,8 +3744,15 @@ JSParserImpl::parseClassImplementsFlow() {
       new (context_) ESTree::ClassImplementsNode(id, typeParams));
 }
 
-Optional<ESTree::Node *> JSParserImpl::parsePredicateFlow() {
+Optional<ESTree::Node *> JSParserImpl::parsePredicateFlow(
+    Optional<SMLoc> colonStart) {
   assert(check(checksIdent_));
+  if (LLVM_UNLIKELY(shouldSkipType())) {
+    return skipType(
+        colonStart ? *colonStart : tok_->getStartLoc(),
+        SkippedType::Kind::Annotation,
+        [this] { return parsePredicateFlow(); });
+  }
   SMRange checksRng = advance(JSLexer::GrammarContext::Type);
   if (checkAndEat(TokenKind::l_paren, JSLexer::GrammarContext::AllowRegExp)) {
     auto optCond = parseConditionalExpression();
@@ -218,6 +218,7 @@ Optional<ESTree::Node *> JSParserImpl::parseJSXChildren(
       // Using a JSXFragment as a child node appears to be disallowed by the
       // spec, but code frequently uses this pattern and all parsers appear to
       // support it.
+      CHECK_RECURSION;
       auto optElem = check(TokenKind::greater) ? parseJSXFragment(start)
                                                : parseJSXElement(start);
       if (!optElem)
@@ -0,0 +1,505 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "JSParserImpl.h"
+
+#include "hermes/Support/PerfSection.h"
+
+#include "llvh/ADT/SmallVector.h"
+
+using llvh::cast;
+using llvh::dyn_cast;
+using llvh::isa;
+
+namespace hermes {
+namespace parser {
+namespace detail {
+
+namespace {
+
+/// A statement list whose statements can be parsed again on their own, with
+/// the state the parser was in when it parsed them.
+struct StatementListInfo {
+  ESTree::NodeList *list;
+  /// The first character inside the list, and the end of the list: its '}',
+  /// or the end of the buffer for the program.
+  const char *start;
+  const char *end;
+  bool isProgram;
+  /// Whether the list may start with directives.
+  bool directives;
+  bool strict;
+  /// Whether the list is in a function, where `return` is allowed.
+  bool inFunction;
+  bool paramYield;
+  bool paramAwait;
+};
+
+/// \return whether \p stmt is a directive.
+bool isDirective(const ESTree::Node *stmt) {
+  auto *exprStmt = dyn_cast<ESTree::ExpressionStatementNode>(stmt);
+  return exprStmt && exprStmt->_directive;
+}
+
+/// Finds the statement lists around an edit. Only the nodes around the edit
+/// are visited, from the program down, and the parser state is followed along
+/// the way: strict mode, and the generator and async functions the lists are
+/// in.
+class StatementListFinder {
+ public:
+  StatementListFinder(
+      const char *editStart,
+      const char *editEnd,
+      llvh::StringRef source,
+      bool strict,
+      UniqueString *useStrictIdent)
+      : editStart_(editStart),
+        editEnd_(editEnd),
+        source_(source),
+        useStrictIdent_(useStrictIdent) {
+    frames_.push_back(Frame{nullptr, strict, false, false, false, true});
+  }
+
+  /// \return the lists around the edit, from the outermost to the innermost.
+  llvh::ArrayRef<StatementListInfo> getLists() const {
+    return lists_;
+  }
+
+  bool shouldVisit(ESTree::Node *node) {
+    // The edit may be in the comments before or after the program.
+    return isa<ESTree::ProgramNode>(node) ||
+        (node->getStartLoc().getPointer() <= editStart_ &&
+         editEnd_ <= node->getEndLoc().getPointer());
+  }
+
+  void enter(ESTree::Node *node) {
+    ESTree::Node *parent = path_.empty() ? nullptr : path_.back();
+    path_.push_back(node);
+
+    switch (node->getKind()) {
+      case ESTree::NodeKind::Program: {
+        auto *program = cast<ESTree::ProgramNode>(node);
+        frames_.back().strict |= hasUseStrict(program->_body);
+        addList(
+            &program->_body, source_.begin(), source_.end(), true, true);
+        break;
+      }
+
+      case ESTree::NodeKind::BlockStatement: {
+        auto *block = cast<ESTree::BlockStatementNode>(node);
+        const char *start = block->getStartLoc().getPointer() + 1;
+        const char *end = block->getEndLoc().getPointer() - 1;
+        bool paramYield, paramAwait;
+        if (isFunctionBody(parent, block, paramYield, paramAwait)) {
+          // The body of a function is parsed in a state of its own, while its
+          // parameters are parsed in the state around it.
+          const Frame &outer = frames_.back();
+          frames_.push_back(Frame{
+              node,
+              outer.strict || hasUseStrict(block->_body),
+              true,
+              paramYield,
+              paramAwait,
+              outer.known});
+          addList(&block->_body, start, end, false, true);
+        } else if (canHoldBlock(parent)) {
+          addList(&block->_body, start, end, false, false);
+        }
+        break;
+      }
+
+      case ESTree::NodeKind::ClassDeclaration:
+      case ESTree::NodeKind::ClassExpression: {
+        // A class is strict mode code.
+        Frame frame = frames_.back();
+        frame.owner = node;
+        frame.strict = true;
+        frames_.push_back(frame);
+        break;
+      }
+
+#if HERMES_PARSE_FLOW
+      case ESTree::NodeKind::ComponentDeclaration:
+      case ESTree::NodeKind::HookDeclaration:
+      case ESTree::NodeKind::DeclareModule:
+      case ESTree::NodeKind::DeclareNamespace:
+#endif
+#if HERMES_PARSE_TS
+      case ESTree::NodeKind::TSModuleDeclaration:
+#endif
+        // These are parsed in a state of their own that isn't followed here,
+        // so their statements are only parsed again as part of them.
+        frames_.push_back(Frame{node, false, false, false, false, false});
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  void leave(ESTree::Node *node) {
+    path_.pop_back();
+    if (frames_.back().owner == node)
+      frames_.pop_back();
+  }
+
+ private:
+  /// The parser state in a part of the program.
+  struct Frame {
+    /// The node that the state starts at.
+    ESTree::Node *owner;
+    bool strict;
+    bool inFunction;
+    bool paramYield;
+    bool paramAwait;
+    /// Cleared in parts of the program whose state isn't followed.
+    bool known;
+  };
+
+  /// \return whether \p body is the body of the function \p parent, and set
+  ///   \p paramYield and \p paramAwait to the state the body is parsed in.
+  static bool isFunctionBody(
+      ESTree::Node *parent,
+      ESTree::Node *body,
+      bool &paramYield,
+      bool &paramAwait) {
+    if (!parent)
+      return false;
+    if (auto *decl = dyn_cast<ESTree::FunctionDeclarationNode>(parent)) {
+      paramYield = decl->_generator;
+      paramAwait = decl->_async;
+      return decl->_body == body;
+    }
+    if (auto *expr = dyn_cast<ESTree::FunctionExpressionNode>(parent)) {
+      paramYield = expr->_generator;
+      paramAwait = expr->_async;
+      return expr->_body == body;
+    }
+    if (auto *arrow = dyn_cast<ESTree::ArrowFunctionExpressionNode>(parent)) {
+      paramYield = false;
+      paramAwait = arrow->_async;
+      return arrow->_body == body;
+    }
+    return false;
+  }
+
+  /// \return whether \p parent is a statement that a block in it is parsed
+  ///   as a statement of, or a statement list.
+  static bool canHoldBlock(ESTree::Node *parent) {
+    if (!parent)
+      return false;
+    switch (parent->getKind()) {
+      case ESTree::NodeKind::Program:
+      case ESTree::NodeKind::BlockStatement:
+      case ESTree::NodeKind::IfStatement:
+      case ESTree::NodeKind::WhileStatement:
+      case ESTree::NodeKind::DoWhileStatement:
+      case ESTree::NodeKind::ForStatement:
+      case ESTree::NodeKind::ForInStatement:
+      case ESTree::NodeKind::ForOfStatement:
+      case ESTree::NodeKind::WithStatement:
+      case ESTree::NodeKind::LabeledStatement:
+      case ESTree::NodeKind::TryStatement:
+      case ESTree::NodeKind::CatchClause:
+      case ESTree::NodeKind::SwitchCase:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /// \return whether the directives at the start of \p body include
+  ///   "use strict".
+  bool hasUseStrict(ESTree::NodeList &body) const {
+    for (ESTree::Node &stmt : body) {
+      if (!isDirective(&stmt))
+        return false;
+      if (cast<ESTree::ExpressionStatementNode>(stmt)._directive ==
+          useStrictIdent_)
+        return true;
+    }
+    return false;
+  }
+
+  /// Record \p list if it contains the edit.
+  void addList(
+      ESTree::NodeList *list,
+      const char *start,
+      const char *end,
+      bool isProgram,
+      bool directives) {
+    const Frame &frame = frames_.back();
+    if (!frame.known || editStart_ < start || end < editEnd_)
+      return;
+    lists_.push_back(StatementListInfo{
+        list,
+        start,
+        end,
+        isProgram,
+        directives,
+        frame.strict,
+        frame.inFunction,
+        frame.paramYield,
+        frame.paramAwait});
+  }
+
+  const char *const editStart_;
+  const char *const editEnd_;
+  const llvh::StringRef source_;
+  UniqueString *const useStrictIdent_;
+
+  /// The nodes from the program to the one being visited.
+  llvh::SmallVector<ESTree::Node *, 16> path_{};
+  llvh::SmallVector<Frame, 8> frames_{};
+  llvh::SmallVector<StatementListInfo, 8> lists_{};
+};
+
+/// Moves the source locations of the nodes it visits from one buffer to
+/// another. Locations that are not in the old buffer, including the ones
+/// already moved, are left as they are. Nodes that end before \c visitFrom
+/// are not visited, for a buffer edited in place where they did not move.
+template <typename Move>
+class LocationMover {
+ public:
+  LocationMover(llvh::StringRef oldSource, const char *visitFrom, Move move)
+      : oldSource_(oldSource), visitFrom_(visitFrom), move_(move) {}
+
+  bool shouldVisit(ESTree::Node *node) {
+    return !visitFrom_ || node->getEndLoc().getPointer() >= visitFrom_;
+  }
+
+  void enter(ESTree::Node *node) {
+    node->setSourceRange(
+        SMRange{moveLoc(node->getStartLoc()), moveLoc(node->getEndLoc())});
+    node->setDebugLoc(moveLoc(node->getDebugLoc()));
+  }
+
+  void leave(ESTree::Node *) {}
+
+  SMLoc moveLoc(SMLoc loc) const {
+    const char *ptr = loc.getPointer();
+    if (ptr < oldSource_.begin() || ptr > oldSource_.end())
+      return loc;
+    return SMLoc::getFromPointer(move_(ptr));
+  }
+
+ private:
+  const llvh::StringRef oldSource_;
+  const char *const visitFrom_;
+  Move move_;
+};
+
+} // namespace
+
+Optional<ESTree::ProgramNode *> JSParserImpl::reparse(
+    ESTree::ProgramNode *program,
+    llvh::StringRef oldSource,
+    const SourceEdit &edit,
+    llvh::ArrayRef<SkippedType> oldSkippedTypes) {
+  reparsedIncrementally_ = false;
+
+  // An edit that does not describe the change can't tell which statements
+  // changed, so the whole buffer is parsed. Comparing the text around it
+  // costs much less than parsing it.
+  llvh::StringRef newSource{
+      lexer_.getBufferStart(),
+      (size_t)(lexer_.getBufferEnd() - lexer_.getBufferStart())};
+  // A buffer edited in place no longer has the old text to compare.
+  bool edited = oldSource.begin() == newSource.begin()
+      ? edit.offset <= oldSource.size() &&
+          edit.removed <= oldSource.size() - edit.offset &&
+          oldSource.size() - edit.removed + edit.inserted == newSource.size()
+      : isEditOf(oldSource, newSource, edit);
+  bool canReparse = program && edited &&
+      pass_ == FullParse &&
+      !lexer_.getStoreComments() && !lexer_.getStoreTokens() &&
+      !collectDependencies_;
+  if (canReparse) {
+    PerfSection reparsing("Reparsing JavaScript");
+    reparsing.addArg("bytes", edit.inserted);
+    if (reparseStatementsAroundEdit(
+            program, oldSource, edit, oldSkippedTypes)) {
+      reparsedIncrementally_ = true;
+      return program;
+    }
+    // Start over at the beginning of the buffer.
+    lexer_.seek(SMLoc::getFromPointer(lexer_.getBufferStart()));
+    lexer_.truncateSkippedTypes(0);
+  }
+
+  return parse();
+}
+
+bool JSParserImpl::reparseStatementsAroundEdit(
+    ESTree::ProgramNode *program,
+    llvh::StringRef oldSource,
+    const SourceEdit &edit,
+    llvh::ArrayRef<SkippedType> oldSkippedTypes) {
+  const char *editStart = oldSource.begin() + edit.offset;
+  const char *editEnd = editStart + edit.removed;
+  const char *newEditStart = lexer_.getBufferStart() + edit.offset;
+
+  // Where a location in the old source is in the new buffer. The removed
+  // text is only in the statements parsed again, whose old nodes are dropped.
+  auto toNewBuffer = [&](const char *ptr) -> const char * {
+    size_t offset = ptr - oldSource.begin();
+    if (offset < edit.offset)
+      return lexer_.getBufferStart() + offset;
+    if (offset < edit.offset + edit.removed)
+      return newEditStart + edit.inserted;
+    return lexer_.getBufferStart() + (offset - edit.removed + edit.inserted);
+  };
+
+  StatementListFinder finder{
+      editStart, editEnd, oldSource, isStrictMode(), useStrictIdent_};
+  ESTreeVisit(finder, program);
+
+  // Find the innermost list with a statement that starts before the edit,
+  // which is the first one to parse again. Those before it are unaffected by
+  // the edit, since its first token is.
+  const StatementListInfo *info = nullptr;
+  ESTree::Node *first = nullptr;
+  bool afterDirectives = false;
+  for (const StatementListInfo &list : llvh::reverse(finder.getLists())) {
+    ESTree::Node *prev = nullptr;
+    for (ESTree::Node &stmt : *list.list) {
+      if (stmt.getStartLoc().getPointer() >= editStart)
+        break;
+      prev = first;
+      first = &stmt;
+    }
+    if (first) {
+      info = &list;
+      afterDirectives = !list.directives || (prev && !isDirective(prev));
+      break;
+    }
+  }
+  // A directive may change the meaning of everything after it.
+  if (!info || isDirective(first))
+    return false;
+
+  // The statements up to the first one that starts after the edit are parsed
+  // again, and the ones from there on are kept.
+  ESTree::NodeList &list = *info->list;
+  ESTree::NodeList::iterator next = std::next(first->getIterator());
+  while (next != list.end() && next->getStartLoc().getPointer() <= editEnd)
+    ++next;
+  const char *oldNext =
+      next != list.end() ? next->getStartLoc().getPointer() : info->end;
+  const char *newNext = toNewBuffer(oldNext);
+
+  // Errors only mean that the statements could not be parsed on their own,
+  // and are reported by the full parse if they are errors there too.
+  CollectMessagesRAII collectMessages{&sm_, true};
+  unsigned errorsBefore = sm_.getErrorCount();
+  SaveStrictModeAndSeenDirectives saveStrictModeAndSeenDirectives{this};
+  setStrictMode(info->strict);
+  llvh::SaveAndRestore<bool> saveParamYield(paramYield_, info->paramYield);
+  llvh::SaveAndRestore<bool> saveParamAwait(paramAwait_, info->paramAwait);
+
+  auto &allocator = context_.getAllocator();
+  allocator.pushScope();
+  ESTree::NodeList stmtList;
+  auto parseStatements = [&]() -> bool {
+    seek(SMLoc::getFromPointer(toNewBuffer(first->getStartLoc().getPointer())));
+    // The statement before the first one ended where it did because of the
+    // token that starts the first one, which must not have changed. A string
+    // may now be a directive.
+    if (tok_->getEndLoc().getPointer() >= newEditStart ||
+        (!afterDirectives && check(TokenKind::string_literal))) {
+      return false;
+    }
+    Param param = info->inFunction ? ParamReturn : Param{};
+    AllowImportExport allowImportExport =
+        info->isProgram ? AllowImportExport::Yes : AllowImportExport::No;
+    while (tok_->getStartLoc().getPointer() < newNext &&
+           !checkN(TokenKind::eof, TokenKind::r_brace)) {
+      if (interruptCheck() ||
+          !parseStatementListItem(param, allowImportExport, stmtList)) {
+        return false;
+      }
+    }
+    // The statements must end where the old ones did, right before the ones
+    // that are kept or at the end of the list.
+    if (tok_->getStartLoc().getPointer() != newNext)
+      return false;
+    if (next == list.end() &&
+        !check(info->isProgram ? TokenKind::eof : TokenKind::r_brace)) {
+      return false;
+    }
+    return !collectMessages.hasErrors() && sm_.getErrorCount() == errorsBefore;
+  };
+  if (!parseStatements()) {
+    stmtList.clear();
+    lexer_.popAllocationScope();
+    return false;
+  }
+  allocator.commitScope();
+  collectMessages.setDiscardMessages(false);
+
+  // Drop the old statements, move the rest of the AST to the new buffer and
+  // put the new statements in place of the old ones. In a buffer edited in
+  // place, the nodes that end before the edit are where they were.
+  const char *oldFirst = first->getStartLoc().getPointer();
+  list.erase(first->getIterator(), next);
+  bool inPlace = oldSource.begin() == lexer_.getBufferStart();
+  LocationMover<decltype(toNewBuffer)> mover{
+      oldSource, inPlace ? editStart : nullptr, toNewBuffer};
+  ESTreeVisit(mover, program);
+  list.splice(next, stmtList);
+  if (info->isProgram && next == list.end()) {
+    program->setEndLoc(
+        list.empty() ? program->getStartLoc() : list.back().getEndLoc());
+  }
+
+  // The types skipped before and after the statements are moved, and those
+  // in them replaced.
+  std::vector<SkippedType> newSkippedTypes = lexer_.moveSkippedTypes();
+  size_t i = 0;
+  for (; i != oldSkippedTypes.size(); ++i) {
+    SMRange range = oldSkippedTypes[i].getSourceRange();
+    if (range.Start.getPointer() >= oldFirst)
+      break;
+    lexer_.storeSkippedType(
+        oldSkippedTypes[i].getKind(),
+        SMRange{mover.moveLoc(range.Start), mover.moveLoc(range.End)});
+  }
+  for (const SkippedType &type : newSkippedTypes)
+    lexer_.storeSkippedType(type.getKind(), type.getSourceRange());
+  for (; i != oldSkippedTypes.size(); ++i) {
+    SMRange range = oldSkippedTypes[i].getSourceRange();
+    if (range.Start.getPointer() < oldNext)
+      continue;
+    lexer_.storeSkippedType(
+        oldSkippedTypes[i].getKind(),
+        SMRange{mover.moveLoc(range.Start), mover.moveLoc(range.End)});
+  }
+
+  return true;
+}
+
+} // namespace detail
+
+bool isEditOf(
+    llvh::StringRef oldSource,
+    llvh::StringRef newSource,
+    const SourceEdit &edit) {
+  if (edit.offset > oldSource.size() ||
+      edit.removed > oldSource.size() - edit.offset)
+    return false;
+  size_t kept = oldSource.size() - edit.removed;
+  if (edit.inserted > newSource.size() ||
+      newSource.size() - edit.inserted != kept)
+    return false;
+  size_t keptAfter = kept - edit.offset;
+  return oldSource.take_front(edit.offset) ==
+      newSource.take_front(edit.offset) &&
+      oldSource.take_back(keptAfter) == newSource.take_back(keptAfter);
+}
+
+} // namespace parser
+} // namespace hermes
@@ -20,6 +20,12 @@ namespace detail {
 
 Optional<ESTree::Node *> JSParserImpl::parseTypeAnnotationTS(
     Optional<SMLoc> wrappedStart) {
+  if (LLVM_UNLIKELY(shouldSkipType())) {
+    return skipType(
+        wrappedStart ? *wrappedStart : tok_->getStartLoc(),
+        SkippedType::Kind::Annotation,
+        [&] { return parseTypeAnnotationTS(wrappedStart); });
+  }
   llvh::SaveAndRestore<bool> saveParam(allowAnonFunctionType_, true);
 
   SMLoc start = tok_->getStartLoc();
@@ -800,6 +806,12 @@ Optional<ESTree::Node *> JSParserImpl::parseTSNamespaceDeclaration() {
 
 Optional<ESTree::Node *> JSParserImpl::parseTSTypeParameters() {
   assert(check(TokenKind::less));
+  if (LLVM_UNLIKELY(shouldSkipType())) {
+    return skipType(
+        tok_->getStartLoc(), SkippedType::Kind::TypeParameters, [this] {
+          return parseTSTypeParameters();
+        });
+  }
   SMLoc start = advance(JSLexer::GrammarContext::Type).Start;
 
   ESTree::NodeList params{};
@@ -1159,6 +1171,12 @@ Optional<ESTree::Node *> JSParserImpl::parseTSTypeQuery() {
 
 Optional<ESTree::Node *> JSParserImpl::parseTSTypeArguments() {
   assert(check(TokenKind::less));
+  if (LLVM_UNLIKELY(shouldSkipType())) {
+    return skipType(
+        tok_->getStartLoc(), SkippedType::Kind::TypeArguments, [this] {
+          return parseTSTypeArguments();
+        });
+  }
   SMLoc start = advance(JSLexer::GrammarContext::Type).Start;
 
   ESTree::NodeList params{};
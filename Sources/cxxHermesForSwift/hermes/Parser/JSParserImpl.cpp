@@ -20,6 +20,44 @@ namespace hermes {
 namespace parser {
 namespace detail {
 
+namespace {
+
+/// When destroyed, adds the arena and string table usage since its
+/// construction to \p stats. Does nothing if \p stats is null.
+class ParseStatsScope {
+  Context &context_;
+  ParseStats *const stats_;
+  uint64_t bytesAllocated_;
+  uint64_t bytesWasted_;
+  uint64_t lookups_;
+  uint64_t hits_;
+
+ public:
+  ParseStatsScope(Context &context, ParseStats *stats)
+      : context_(context),
+        stats_(stats),
+        bytesAllocated_(context.getAllocator().getBytesAllocated()),
+        bytesWasted_(context.getAllocator().getBytesWasted()),
+        lookups_(context.getStringTable().getLookupCount()),
+        hits_(context.getStringTable().getHitCount()) {}
+
+  ~ParseStatsScope() {
+    if (!stats_)
+      return;
+    auto &allocator = context_.getAllocator();
+    stats_->arenaBytesAllocated +=
+        allocator.getBytesAllocated() - bytesAllocated_;
+    stats_->arenaBytesWasted += allocator.getBytesWasted() - bytesWasted_;
+    stats_->arenaBytesReserved = allocator.getBytesReserved();
+    StringTable &strTab = context_.getStringTable();
+    stats_->stringTableSize = strTab.size();
+    stats_->stringTableLookups += strTab.getLookupCount() - lookups_;
+    stats_->stringTableHits += strTab.getHitCount() - hits_;
+  }
+};
+
+} // namespace
+
 JSParserImpl::JSParserImpl(
     Context &context,
     std::unique_ptr<llvh::MemoryBuffer> input)
@@ -33,6 +71,21 @@ JSParserImpl::JSParserImpl(
           context.isStrictMode()),
       pass_(FullParse) {
   initializeIdentifiers();
+  interrupt_ = context.getParseInterrupt();
+  if (interrupt_)
+    interrupt_->setMemoryBudget(&context.getMemoryBudget());
+  lexer_.setInterrupt(interrupt_);
+  lexer_.setMemoryBudget(&context.getMemoryBudget());
+  stats_ = context.getParseStats();
+  skipTypes_ = context.getSkipTypes();
+  parseJSX_ = context.getParseJSX();
+  parseFlow_ = context.getParseFlowSetting();
+  parseFlowComponentSyntax_ = context.getParseFlowComponentSyntax();
+  parseTS_ = context.getParseTS();
+  lexer_.setStats(stats_);
+  if (context.getMaxParseDepth())
+    maxRecursionDepth_ = context.getMaxParseDepth();
+  stackLimit_ = context.getParseStackLimit();
 }
 
 JSParserImpl::JSParserImpl(Context &context, uint32_t bufferId, ParserPass pass)
@@ -47,106 +100,142 @@ JSParserImpl::JSParserImpl(Context &context, uint32_t bufferId, ParserPass pass)
       pass_(pass) {
   preParsed_ = context.getPreParsedBufferInfo(bufferId);
   initializeIdentifiers();
+  interrupt_ = context.getParseInterrupt();
+  if (interrupt_)
+    interrupt_->setMemoryBudget(&context.getMemoryBudget());
+  lexer_.setInterrupt(interrupt_);
+  lexer_.setMemoryBudget(&context.getMemoryBudget());
+  stats_ = context.getParseStats();
+  skipTypes_ = context.getSkipTypes();
+  parseJSX_ = context.getParseJSX();
+  parseFlow_ = context.getParseFlowSetting();
+  parseFlowComponentSyntax_ = context.getParseFlowComponentSyntax();
+  parseTS_ = context.getParseTS();
+  lexer_.setStats(stats_);
+  if (context.getMaxParseDepth())
+    maxRecursionDepth_ = context.getMaxParseDepth();
+  stackLimit_ = context.getParseStackLimit();
 }
 
-void JSParserImpl::initializeIdentifiers() {
-  getIdent_ = lexer_.getIdentifier("get");
-  setIdent_ = lexer_.getIdentifier("set");
-  initIdent_ = lexer_.getIdentifier("init");
-  useStrictIdent_ = lexer_.getIdentifier("use strict");
-  showSourceIdent_ = lexer_.getIdentifier("show source");
-  hideSourceIdent_ = lexer_.getIdentifier("hide source");
-  sensitiveIdent_ = lexer_.getIdentifier("sensitive");
-  useStaticBuiltinIdent_ = lexer_.getIdentifier("use static builtin");
-  letIdent_ = lexer_.getIdentifier("let");
-  ofIdent_ = lexer_.getIdentifier("of");
-  fromIdent_ = lexer_.getIdentifier("from");
-  asIdent_ = lexer_.getIdentifier("as");
-  implementsIdent_ = lexer_.getIdentifier("implements");
-  interfaceIdent_ = lexer_.getIdentifier("interface");
-  packageIdent_ = lexer_.getIdentifier("package");
-  privateIdent_ = lexer_.getIdentifier("private");
-  protectedIdent_ = lexer_.getIdentifier("protected");
-  publicIdent_ = lexer_.getIdentifier("public");
-  staticIdent_ = lexer_.getIdentifier("static");
-  methodIdent_ = lexer_.getIdentifier("method");
-  constructorIdent_ = lexer_.getIdentifier("constructor");
-  yieldIdent_ = lexer_.getIdentifier("yield");
-  newIdent_ = lexer_.getIdentifier("new");
-  targetIdent_ = lexer_.getIdentifier("target");
-  importIdent_ = lexer_.getIdentifier("import");
-  metaIdent_ = lexer_.getIdentifier("meta");
-  valueIdent_ = lexer_.getIdentifier("value");
-  typeIdent_ = lexer_.getIdentifier("type");
-  asyncIdent_ = lexer_.getIdentifier("async");
-  awaitIdent_ = lexer_.getIdentifier("await");
-  assertIdent_ = lexer_.getIdentifier("assert");
+void KnownIdentifiers::intern(StringTable &strTab) {
+  getIdent_ = strTab.getString("get");
+  setIdent_ = strTab.getString("set");
+  initIdent_ = strTab.getString("init");
+  useStrictIdent_ = strTab.getString("use strict");
+  showSourceIdent_ = strTab.getString("show source");
+  hideSourceIdent_ = strTab.getString("hide source");
+  sensitiveIdent_ = strTab.getString("sensitive");
+  useStaticBuiltinIdent_ = strTab.getString("use static builtin");
+  letIdent_ = strTab.getString("let");
+  ofIdent_ = strTab.getString("of");
+  fromIdent_ = strTab.getString("from");
+  asIdent_ = strTab.getString("as");
+  implementsIdent_ = strTab.getString("implements");
+  interfaceIdent_ = strTab.getString("interface");
+  packageIdent_ = strTab.getString("package");
+  privateIdent_ = strTab.getString("private");
+  protectedIdent_ = strTab.getString("protected");
+  publicIdent_ = strTab.getString("public");
+  staticIdent_ = strTab.getString("static");
+  methodIdent_ = strTab.getString("method");
+  constructorIdent_ = strTab.getString("constructor");
+  yieldIdent_ = strTab.getString("yield");
+  newIdent_ = strTab.getString("new");
+  targetIdent_ = strTab.getString("target");
+  importIdent_ = strTab.getString("import");
+  metaIdent_ = strTab.getString("meta");
+  valueIdent_ = strTab.getString("value");
+  typeIdent_ = strTab.getString("type");
+  asyncIdent_ = strTab.getString("async");
+  awaitIdent_ = strTab.getString("await");
+  assertIdent_ = strTab.getString("assert");
+  requireIdent_ = strTab.getString("require");
 
 #if HERMES_PARSE_FLOW
 
-  typeofIdent_ = lexer_.getIdentifier("typeof");
-  keyofIdent_ = lexer_.getIdentifier("keyof");
-  declareIdent_ = lexer_.getIdentifier("declare");
-  protoIdent_ = lexer_.getIdentifier("proto");
-  opaqueIdent_ = lexer_.getIdentifier("opaque");
-  plusIdent_ = lexer_.getIdentifier("plus");
-  minusIdent_ = lexer_.getIdentifier("minus");
-  moduleIdent_ = lexer_.getIdentifier("module");
-  exportsIdent_ = lexer_.getIdentifier("exports");
-  esIdent_ = lexer_.getIdentifier("ES");
-  commonJSIdent_ = lexer_.getIdentifier("CommonJS");
-  mixinsIdent_ = lexer_.getIdentifier("mixins");
-  thisIdent_ = lexer_.getIdentifier("this");
-
-  anyIdent_ = lexer_.getIdentifier("any");
-  mixedIdent_ = lexer_.getIdentifier("mixed");
-  emptyIdent_ = lexer_.getIdentifier("empty");
-  booleanIdent_ = lexer_.getIdentifier("boolean");
-  boolIdent_ = lexer_.getIdentifier("bool");
-  numberIdent_ = lexer_.getIdentifier("number");
-  stringIdent_ = lexer_.getIdentifier("string");
-  voidIdent_ = lexer_.getIdentifier("void");
-  nullIdent_ = lexer_.getIdentifier("null");
-  symbolIdent_ = lexer_.getIdentifier("symbol");
-  bigintIdent_ = lexer_.getIdentifier("bigint");
-
-  mappedTypeOptionalIdent_ = lexer_.getIdentifier("Optional");
-  mappedTypePlusOptionalIdent_ = lexer_.getIdentifier("PlusOptional");
-  mappedTypeMinusOptionalIdent_ = lexer_.getIdentifier("MinusOptional");
-
-  checksIdent_ = lexer_.getIdentifier("%checks");
-  assertsIdent_ = lexer_.getIdentifier("asserts");
-  impliesIdent_ = lexer_.getIdentifier("implies");
+  typeofIdent_ = strTab.getString("typeof");
+  keyofIdent_ = strTab.getString("keyof");
+  declareIdent_ = strTab.getString("declare");
+  protoIdent_ = strTab.getString("proto");
+  opaqueIdent_ = strTab.getString("opaque");
+  plusIdent_ = strTab.getString("plus");
+  minusIdent_ = strTab.getString("minus");
+  moduleIdent_ = strTab.getString("module");
+  exportsIdent_ = strTab.getString("exports");
+  esIdent_ = strTab.getString("ES");
+  commonJSIdent_ = strTab.getString("CommonJS");
+  mixinsIdent_ = strTab.getString("mixins");
+  thisIdent_ = strTab.getString("this");
+
+  anyIdent_ = strTab.getString("any");
+  mixedIdent_ = strTab.getString("mixed");
+  emptyIdent_ = strTab.getString("empty");
+  booleanIdent_ = strTab.getString("boolean");
+  boolIdent_ = strTab.getString("bool");
+  numberIdent_ = strTab.getString("number");
+  stringIdent_ = strTab.getString("string");
+  voidIdent_ = strTab.getString("void");
+  nullIdent_ = strTab.getString("null");
+  symbolIdent_ = strTab.getString("symbol");
+  bigintIdent_ = strTab.getString("bigint");
+
+  mappedTypeOptionalIdent_ = strTab.getString("Optional");
+  mappedTypePlusOptionalIdent_ = strTab.getString("PlusOptional");
+  mappedTypeMinusOptionalIdent_ = strTab.getString("MinusOptional");
+
+  checksIdent_ = strTab.getString("%checks");
+  assertsIdent_ = strTab.getString("asserts");
+  impliesIdent_ = strTab.getString("implies");
 
   // Flow Component syntax
-  componentIdent_ = lexer_.getIdentifier("component");
-  rendersIdent_ = lexer_.getIdentifier("renders");
-  rendersMaybeOperator_ = lexer_.getIdentifier("renders?");
-  rendersStarOperator_ = lexer_.getIdentifier("renders*");
-  hookIdent_ = lexer_.getIdentifier("hook");
+  componentIdent_ = strTab.getString("component");
+  rendersIdent_ = strTab.getString("renders");
+  rendersMaybeOperator_ = strTab.getString("renders?");
+  rendersStarOperator_ = strTab.getString("renders*");
+  hookIdent_ = strTab.getString("hook");
 #endif
 
 #if HERMES_PARSE_TS
-  readonlyIdent_ = lexer_.getIdentifier("readonly");
-  neverIdent_ = lexer_.getIdentifier("never");
-  undefinedIdent_ = lexer_.getIdentifier("undefined");
-  unknownIdent_ = lexer_.getIdentifier("unknown");
+  readonlyIdent_ = strTab.getString("readonly");
+  neverIdent_ = strTab.getString("never");
+  undefinedIdent_ = strTab.getString("undefined");
+  unknownIdent_ = strTab.getString("unknown");
 #endif
 
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-  namespaceIdent_ = lexer_.getIdentifier("namespace");
-  isIdent_ = lexer_.getIdentifier("is");
-  inferIdent_ = lexer_.getIdentifier("infer");
-  constIdent_ = lexer_.getIdentifier("const");
+  namespaceIdent_ = strTab.getString("namespace");
+  isIdent_ = strTab.getString("is");
+  inferIdent_ = strTab.getString("infer");
+  constIdent_ = strTab.getString("const");
 #endif
 
   // Generate the string representation of all tokens.
   for (unsigned i = 0; i != NUM_JS_TOKENS; ++i)
-    tokenIdent_[i] = lexer_.getIdentifier(tokenKindStr((TokenKind)i));
+    tokenIdent_[i] = strTab.getString(tokenKindStr((TokenKind)i));
+}
+
+void JSParserImpl::initializeIdentifiers() {
+  std::shared_ptr<const KnownIdentifiers> known =
+      context_.getKnownIdentifiers();
+  if (!known) {
+    auto interned = std::make_shared<KnownIdentifiers>();
+    interned->intern(context_.getStringTable());
+    context_.setKnownIdentifiers(interned);
+    known = std::move(interned);
+  }
+  static_cast<KnownIdentifiers &>(*this) = *known;
 }
 
 Optional<ESTree::ProgramNode *> JSParserImpl::parse() {
   PerfSection parsing("Parsing JavaScript");
+  parsing.addArg(
+      "pass",
+      pass_ == PreParse        ? "pre-parse"
+          : pass_ == LazyParse ? "lazy"
+                               : "full");
+  parsing.addArg(
+      "bytes", (size_t)(lexer_.getBufferEnd() - lexer_.getBufferStart()));
+  ParseStatsScope statsScope{context_, stats_};
   tok_ = lexer_.advance();
   auto res = parseProgram();
   if (!res)
@@ -156,6 +245,36 @@ Optional<ESTree::ProgramNode *> JSParserImpl::parse() {
   return res.getValue();
 }
 
+Optional<ESTree::ProgramNode *> JSParserImpl::parseStreaming(
+    StatementCallback callback) {
+  llvh::SaveAndRestore<StatementCallback> saveCallback(
+      statementCallback_, callback);
+  return parse();
+}
+
+bool JSParserImpl::scanDependencies() {
+  llvh::SaveAndRestore<bool> saveCollect(collectDependencies_, true);
+  // Nothing parsed while scanning is kept.
+  AllocationScope scope(context_.getAllocator());
+  unsigned errorsBefore = sm_.getErrorCount();
+  {
+    PerfSection scanning("Scanning dependencies");
+    scanning.addArg(
+        "bytes", (size_t)(lexer_.getBufferEnd() - lexer_.getBufferStart()));
+    ParseStatsScope statsScope{context_, stats_};
+    bool scanned = scanDependencySource();
+    // Errors can't be told from a scan that went wrong, and are only reported
+    // once, so they end the scan either way.
+    if (scanned || sm_.getErrorCount() != errorsBefore)
+      return scanned && sm_.getErrorCount() == errorsBefore;
+  }
+
+  // The program could not be scanned without the grammar, so parse it.
+  lexer_.truncateDependencies(0);
+  lexer_.seek(SMLoc::getFromPointer(lexer_.getBufferStart()));
+  return parse().hasValue();
+}
+
 void JSParserImpl::errorExpected(
     ArrayRef<TokenKind> toks,
     const char *where,
@@ -335,19 +454,98 @@ bool JSParserImpl::recursionDepthExceeded() {
   return true;
 }
 
+bool JSParserImpl::recursionLimitCheck() {
+  if (recursionDepth_ >= maxRecursionDepth_)
+    return recursionDepthExceeded();
+  if (!stackLimit_)
+    return false;
+  char here;
+  uintptr_t sp = reinterpret_cast<uintptr_t>(&here);
+  if (recursionDepth_ <= 1) {
+    // The outermost level: measure the stack use from here.
+    stackBase_ = sp;
+    return false;
+  }
+  if ((stackBase_ > sp ? stackBase_ - sp : sp - stackBase_) > stackLimit_)
+    return recursionDepthExceeded();
+  return false;
+}
+
+bool JSParserImpl::isTypeOnlyImportExport(const ESTree::Node *decl) const {
+  if (auto *import = dyn_cast<ESTree::ImportDeclarationNode>(decl)) {
+    if (import->_importKind != valueIdent_)
+      return true;
+    // `import {type A, typeof B} from 'm'` imports nothing at run time either.
+    if (import->_specifiers.empty())
+      return false;
+    for (const ESTree::Node &specifier : import->_specifiers) {
+      auto *named = dyn_cast<ESTree::ImportSpecifierNode>(&specifier);
+      if (!named || named->_importKind == valueIdent_)
+        return false;
+    }
+    return true;
+  }
+  if (auto *exportAll = dyn_cast<ESTree::ExportAllDeclarationNode>(decl))
+    return exportAll->_exportKind == typeIdent_;
+  if (auto *exportNamed = dyn_cast<ESTree::ExportNamedDeclarationNode>(decl)) {
+    if (exportNamed->_exportKind == typeIdent_)
+      return true;
+#if HERMES_PARSE_TS
+    const ESTree::Node *inner = exportNamed->_declaration;
+    return inner &&
+        (isa<ESTree::TSTypeAliasDeclarationNode>(inner) ||
+         isa<ESTree::TSInterfaceDeclarationNode>(inner));
+#endif
+  }
+  return false;
+}
+
+void JSParserImpl::storeDependencies(const ESTree::Node *decl) {
+  ESTree::Node *source = nullptr;
+  ModuleDependency::Kind kind = ModuleDependency::Kind::Export;
+  bool typeOnly = false;
+  if (auto *import = dyn_cast<ESTree::ImportDeclarationNode>(decl)) {
+    source = import->_source;
+    kind = ModuleDependency::Kind::Import;
+    typeOnly = isTypeOnlyImportExport(decl);
+  } else if (
+      auto *exportAll = dyn_cast<ESTree::ExportAllDeclarationNode>(decl)) {
+    source = exportAll->_source;
+    typeOnly = exportAll->_exportKind == typeIdent_;
+  } else if (
+      auto *exportNamed = dyn_cast<ESTree::ExportNamedDeclarationNode>(decl)) {
+    source = exportNamed->_source;
+    typeOnly = exportNamed->_exportKind == typeIdent_;
+  }
+  if (auto *str = llvh::dyn_cast_or_null<ESTree::StringLiteralNode>(source))
+    lexer_.storeDependency(kind, typeOnly, str->_value, str->getSourceRange());
+}
+
+bool JSParserImpl::pollInterrupt() {
+  ParseInterrupt::Reason reason = interrupt_->poll();
+  if (LLVM_LIKELY(reason == ParseInterrupt::Reason::None))
+    return false;
+  lexer_.stopForInterrupt(reason);
+  return true;
+}
+
 Optional<ESTree::ProgramNode *> JSParserImpl::parseProgram() {
   SMLoc startLoc = tok_->getStartLoc();
   SaveStrictModeAndSeenDirectives saveStrictModeAndSeenDirectives{this};
   ESTree::NodeList stmtList;
-
-  if (!parseStatementList(
-          Param{}, TokenKind::eof, true, AllowImportExport::Yes, stmtList))
-    return None;
-
   SMLoc endLoc = startLoc;
-  if (!stmtList.empty()) {
-    endLoc = stmtList.back().getEndLoc();
+
+  if (LLVM_UNLIKELY(statementCallback_)) {
+    if (!parseStreamingStatementList(stmtList, endLoc))
+      return None;
+  } else {
+    if (!parseStatementList(
+            Param{}, TokenKind::eof, true, AllowImportExport::Yes, stmtList))
+      return None;
+    if (!stmtList.empty())
+      endLoc = stmtList.back().getEndLoc();
   }
+
   auto *program = setLocation(
       startLoc,
       endLoc,
@@ -355,6 +553,54 @@ Optional<ESTree::ProgramNode *> JSParserImpl::parseProgram() {
   return program;
 }
 
+Optional<bool> JSParserImpl::parseStreamingStatementList(
+    ESTree::NodeList &stmtList,
+    SMLoc &endLoc) {
+  auto &allocator = context_.getAllocator();
+  // Hand the statement parsed in the current scope, if any, to the callback,
+  // and keep or free it.
+  auto finishStatement = [&](ESTree::NodeList &parsed) {
+    if (parsed.empty()) {
+      lexer_.popAllocationScope();
+      return;
+    }
+    ESTree::Node *stmt = &parsed.back();
+    parsed.pop_back();
+    endLoc = stmt->getEndLoc();
+    if (statementCallback_(stmt) == StatementAction::Keep) {
+      allocator.commitScope();
+      stmtList.push_back(*stmt);
+    } else {
+      lexer_.popAllocationScope();
+    }
+  };
+
+  bool parseDirectives = true;
+  while (!check(TokenKind::eof)) {
+    if (interruptCheck())
+      return None;
+    ESTree::NodeList parsed{};
+    allocator.pushScope();
+    if (parseDirectives && check(TokenKind::string_literal)) {
+      if (ESTree::ExpressionStatementNode *dirStmt = parseDirective()) {
+        parsed.push_back(*dirStmt);
+        finishStatement(parsed);
+        continue;
+      }
+    }
+    parseDirectives = false;
+    if (!parseStatementListItem(Param{}, AllowImportExport::Yes, parsed)) {
+      parsed.clear();
+      lexer_.popAllocationScope();
+      return None;
+    }
+    assert(parsed.size() <= 1 && "a statement list item is one statement");
+    finishStatement(parsed);
+  }
+
+  return true;
+}
+
 Optional<ESTree::FunctionDeclarationNode *>
 JSParserImpl::parseFunctionDeclaration(Param param, bool forceEagerly) {
   auto optRes = parseFunctionHelper(param, true, forceEagerly);
@@ -412,7 +658,7 @@ Optional<ESTree::FunctionLikeNode *> JSParserImpl::parseFunctionHelper(
   ESTree::Node *typeParams = nullptr;
 
 #if HERMES_PARSE_FLOW
-  if (context_.getParseFlow() && check(TokenKind::less)) {
+  if (getParseFlow() && check(TokenKind::less)) {
     auto optTypeParams = parseTypeParamsFlow();
     if (!optTypeParams)
       return None;
@@ -421,7 +667,7 @@ Optional<ESTree::FunctionLikeNode *> JSParserImpl::parseFunctionHelper(
 #endif
 
 #if HERMES_PARSE_TS
-  if (context_.getParseTS() && check(TokenKind::less)) {
+  if (getParseTS() && check(TokenKind::less)) {
     auto optTypeParams = parseTSTypeParameters();
     if (!optTypeParams)
       return None;
@@ -451,9 +697,10 @@ Optional<ESTree::FunctionLikeNode *> JSParserImpl::parseFunctionHelper(
   ESTree::Node *returnType = nullptr;
   ESTree::Node *predicate = nullptr;
 #if HERMES_PARSE_FLOW
-  if (context_.getParseFlow() && check(TokenKind::colon)) {
+  if (getParseFlow() && check(TokenKind::colon)) {
     SMLoc annotStart = advance(JSLexer::GrammarContext::Type).Start;
-    if (!check(checksIdent_)) {
+    bool startsWithPredicate = check(checksIdent_);
+    if (!startsWithPredicate) {
       auto optRet = parseReturnTypeAnnotationFlow(annotStart);
       if (!optRet)
         return None;
@@ -461,7 +708,8 @@ Optional<ESTree::FunctionLikeNode *> JSParserImpl::parseFunctionHelper(
     }
 
     if (check(checksIdent_)) {
-      auto optPred = parsePredicateFlow();
+      auto optPred = parsePredicateFlow(
+          startsWithPredicate ? Optional<SMLoc>(annotStart) : None);
       if (!optPred)
         return None;
       predicate = *optPred;
@@ -469,7 +717,7 @@ Optional<ESTree::FunctionLikeNode *> JSParserImpl::parseFunctionHelper(
   }
 #endif
 #if HERMES_PARSE_TS
-  if (context_.getParseTS() && check(TokenKind::colon)) {
+  if (getParseTS() && check(TokenKind::colon)) {
     SMLoc annotStart = advance(JSLexer::GrammarContext::Type).Start;
     if (!check(checksIdent_)) {
       auto optRet = parseTypeAnnotationTS(annotStart);
@@ -512,6 +760,7 @@ Optional<ESTree::FunctionLikeNode *> JSParserImpl::parseFunctionHelper(
           isAsync);
       // Initialize the node with a blank body.
       decl->_body = new (context_) ESTree::BlockStatementNode({});
+      countNewNode(decl->_body);
       node = decl;
     } else {
       auto *expr = new (context_) ESTree::FunctionExpressionNode(
@@ -525,6 +774,7 @@ Optional<ESTree::FunctionLikeNode *> JSParserImpl::parseFunctionHelper(
           isAsync);
       // Initialize the node with a blank body.
       expr->_body = new (context_) ESTree::BlockStatementNode({});
+      countNewNode(expr->_body);
       node = expr;
     }
 
@@ -589,29 +839,47 @@ bool JSParserImpl::parseFormalParameters(
 
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
   // The first parameter can be 'this' in Flow and TypeScript.
-  if (context_.getParseTypes() && check(TokenKind::rw_this)) {
-    auto *name = tok_->getResWordIdentifier();
-    SMLoc thisParamStart = advance().Start;
+  if (getParseTypes() && check(TokenKind::rw_this)) {
+    auto parseThisParam = [this]() -> Optional<ESTree::Node *> {
+      auto *name = tok_->getResWordIdentifier();
+      SMLoc thisParamStart = advance().Start;
 
-    SMLoc annotStart = tok_->getStartLoc();
-    if (!eat(
-            TokenKind::colon,
-            JSLexer::GrammarContext::Type,
-            "in 'this' type annotation",
-            "start of 'this'",
-            thisParamStart))
-      return false;
+      SMLoc annotStart = tok_->getStartLoc();
+      if (!eat(
+              TokenKind::colon,
+              JSLexer::GrammarContext::Type,
+              "in 'this' type annotation",
+              "start of 'this'",
+              thisParamStart))
+        return None;
 
-    auto optType = parseTypeAnnotation(annotStart);
-    if (!optType)
-      return false;
-    ESTree::Node *type = *optType;
-    paramList.push_back(*setLocation(
-        thisParamStart,
-        getPrevTokenEndLoc(),
-        new (context_) ESTree::IdentifierNode(name, type, false)));
+      auto optType = parseTypeAnnotation(annotStart);
+      if (!optType)
+        return None;
+      ESTree::Node *type = *optType;
+      ESTree::Node *thisParam = setLocation(
+          thisParamStart,
+          getPrevTokenEndLoc(),
+          new (context_) ESTree::IdentifierNode(name, type, false));
 
-    checkAndEat(TokenKind::comma);
+      checkAndEat(TokenKind::comma);
+      return thisParam;
+    };
+
+    if (LLVM_UNLIKELY(shouldSkipType())) {
+      // Without its type the 'this' parameter is not part of the program, so
+      // it is skipped as a whole, with the comma after it.
+      if (!skipType(
+              tok_->getStartLoc(),
+              SkippedType::Kind::Annotation,
+              parseThisParam))
+        return false;
+    } else {
+      auto optThisParam = parseThisParam();
+      if (!optThisParam)
+        return false;
+      paramList.push_back(**optThisParam);
+    }
   }
 #endif
 
@@ -713,6 +981,9 @@ Optional<ESTree::BlockStatementNode *> JSParserImpl::parseFunctionBody(
     bool paramAwait,
     JSLexer::GrammarContext grammarContext,
     bool parseDirectives) {
+  if (interruptCheck())
+    return None;
+
   if (pass_ == LazyParse && !eagerly) {
     auto startLoc = tok_->getStartLoc();
     assert(
@@ -737,11 +1008,14 @@ Optional<ESTree::BlockStatementNode *> JSParserImpl::parseFunctionBody(
             ESTree::StringLiteralNode(lexer_.getIdentifier(directive));
         auto *dirStmt = new (context_)
             ESTree::ExpressionStatementNode(strLit, strLit->_value);
+        countNewNode(strLit);
+        countNewNode(dirStmt);
         stmtList.push_back(*dirStmt);
       }
 
       auto *body =
           new (context_) ESTree::BlockStatementNode(std::move(stmtList));
+      countNewNode(body);
       body->isLazyFunctionBody = true;
       // Set params based on what they were at the _start_ of the function's
       // source, not what they are now, because they might have changed.
@@ -798,7 +1072,7 @@ Optional<ESTree::Node *> JSParserImpl::parseDeclaration(Param param) {
   }
 
 #if HERMES_PARSE_FLOW
-  if (context_.getParseFlow()) {
+  if (getParseFlow()) {
     auto optDecl = parseFlowDeclaration();
     if (!optDecl)
       return None;
@@ -807,7 +1081,7 @@ Optional<ESTree::Node *> JSParserImpl::parseDeclaration(Param param) {
 #endif
 
 #if HERMES_PARSE_TS
-  if (context_.getParseTS()) {
+  if (getParseTS()) {
     auto optDecl = parseTSDeclaration();
     if (!optDecl)
       return None;
@@ -823,6 +1097,24 @@ bool JSParserImpl::parseStatementListItem(
     Param param,
     AllowImportExport allowImportExport,
     ESTree::NodeList &stmtList) {
+#if HERMES_PARSE_FLOW || HERMES_PARSE_TS
+  if (LLVM_UNLIKELY(shouldSkipType()) && checkTypeDeclaration()) {
+    // Parse the declaration as usual and drop it.
+    ESTree::NodeList skipped{};
+    auto optSkipped = skipType(
+        tok_->getStartLoc(),
+        SkippedType::Kind::Declaration,
+        [&]() -> Optional<bool> {
+          if (!parseStatementListItem(param, allowImportExport, skipped))
+            return None;
+          return true;
+        });
+    // The nodes have been freed.
+    skipped.clear();
+    return optSkipped.hasValue();
+  }
+#endif
+
   if (checkDeclaration()) {
     auto decl = parseDeclaration(Param{});
     if (!decl)
@@ -830,7 +1122,7 @@ bool JSParserImpl::parseStatementListItem(
 
     stmtList.push_back(*decl.getValue());
 #if HERMES_PARSE_FLOW
-  } else if (context_.getParseFlow() && checkDeclareType()) {
+  } else if (getParseFlow() && checkDeclareType()) {
     // declare var, declare function, declare interface, etc.
     SMLoc start = advance(JSLexer::GrammarContext::Type).Start;
     auto decl = parseDeclareFLow(start);
@@ -852,30 +1144,44 @@ bool JSParserImpl::parseStatementListItem(
 
       stmtList.push_back(*stmt.getValue());
     } else {
-      auto importDecl = parseImportDeclaration();
+      auto importDecl =
+          parseImportExport([&]() -> Optional<ESTree::Node *> {
+            auto importDecl = parseImportDeclaration();
+            if (!importDecl) {
+              return None;
+            }
+            if (allowImportExport == AllowImportExport::No) {
+              error(
+                  importDecl.getValue()->getSourceRange(),
+                  "import declaration must be at top level of module");
+            }
+            return *importDecl;
+          });
       if (!importDecl) {
         return false;
       }
 
-      stmtList.push_back(*importDecl.getValue());
-      if (allowImportExport == AllowImportExport::No) {
-        error(
-            importDecl.getValue()->getSourceRange(),
-            "import declaration must be at top level of module");
-      }
+      // Null if it was skipped.
+      if (*importDecl)
+        stmtList.push_back(**importDecl);
     }
   } else if (tok_->getKind() == TokenKind::rw_export) {
-    auto exportDecl = parseExportDeclaration();
+    auto exportDecl = parseImportExport([&]() {
+      auto exportDecl = parseExportDeclaration();
+      if (exportDecl && allowImportExport == AllowImportExport::No) {
+        error(
+            exportDecl.getValue()->getSourceRange(),
+            "export declaration must be at top level of module");
+      }
+      return exportDecl;
+    });
     if (!exportDecl) {
       return false;
     }
 
-    if (allowImportExport == AllowImportExport::Yes) {
+    // Null if it was skipped.
+    if (*exportDecl && allowImportExport == AllowImportExport::Yes) {
       stmtList.push_back(**exportDecl);
-    } else {
-      error(
-          exportDecl.getValue()->getSourceRange(),
-          "export declaration must be at top level of module");
     }
   } else {
     auto stmt = parseStatement(param.get(ParamReturn));
@@ -905,7 +1211,8 @@ Optional<bool> JSParserImpl::parseStatementList(
   }
 
   while (!check(TokenKind::eof) && !checkN(until, otherUntil...)) {
-    if (!parseStatementListItem(param, allowImportExport, stmtList)) {
+    if (interruptCheck() ||
+        !parseStatementListItem(param, allowImportExport, stmtList)) {
       return None;
     }
   }
@@ -1006,10 +1313,10 @@ Optional<ESTree::IdentifierNode *> JSParserImpl::parseBindingIdentifier(
   ESTree::Node *type = nullptr;
   bool optional = false;
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-  if (context_.getParseTypes()) {
+  if (getParseTypes()) {
     if (check(TokenKind::question)) {
       optional = true;
-      advance(JSLexer::GrammarContext::Type);
+      skipTypeModifier(advance(JSLexer::GrammarContext::Type));
     }
 
     if (check(TokenKind::colon)) {
@@ -1232,7 +1539,7 @@ Optional<ESTree::ArrayPatternNode *> JSParserImpl::parseArrayBindingPattern(
 
   ESTree::Node *type = nullptr;
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-  if (context_.getParseTypes()) {
+  if (getParseTypes()) {
     if (check(TokenKind::colon)) {
       SMLoc annotStart = advance(JSLexer::GrammarContext::Type).Start;
       auto optType = parseTypeAnnotation(annotStart);
@@ -1363,7 +1670,7 @@ Optional<ESTree::ObjectPatternNode *> JSParserImpl::parseObjectBindingPattern(
 
   ESTree::Node *type = nullptr;
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-  if (context_.getParseTypes()) {
+  if (getParseTypes()) {
     if (check(TokenKind::colon)) {
       SMLoc annotStart = advance(JSLexer::GrammarContext::Type).Start;
       auto optType = parseTypeAnnotation(annotStart);
@@ -2437,7 +2744,7 @@ Optional<ESTree::Node *> JSParserImpl::parsePrimaryExpression() {
       }
 
 #if HERMES_PARSE_FLOW
-      if (context_.getParseFlow()) {
+      if (getParseFlow()) {
         // In both these cases, we set the location to encompass the `()`.
         // (x: T)
         // ^^^^^^
@@ -2451,17 +2758,22 @@ Optional<ESTree::Node *> JSParserImpl::parsePrimaryExpression() {
                 tok_,
                 new (context_) ESTree::TypeCastExpressionNode(
                     cover->_left, cover->_right));
+          } else if (!cover->_optional) {
+            // The type was skipped, only the expression is left.
+            expr = cover->_left;
           }
         } else if (check(TokenKind::colon)) {
           SMLoc annotStart = advance(JSLexer::GrammarContext::Type).Start;
           auto optType = parseTypeAnnotationFlow(annotStart);
           if (!optType)
             return None;
-          ESTree::Node *type = *optType;
-          expr = setLocation(
-              startLoc,
-              tok_,
-              new (context_) ESTree::TypeCastExpressionNode(expr, type));
+          // The type is null if it was skipped.
+          if (ESTree::Node *type = *optType) {
+            expr = setLocation(
+                startLoc,
+                tok_,
+                new (context_) ESTree::TypeCastExpressionNode(expr, type));
+          }
         }
       }
 #endif
@@ -2503,7 +2815,7 @@ Optional<ESTree::Node *> JSParserImpl::parsePrimaryExpression() {
 
 #if HERMES_PARSE_JSX
     case TokenKind::less:
-      if (context_.getParseJSX()) {
+      if (getParseJSX()) {
         auto optJSX = parseJSX();
         if (!optJSX)
           return None;
@@ -2658,7 +2970,7 @@ Optional<ESTree::Node *> JSParserImpl::parsePropertyAssignment(bool eagerly) {
           identRng,
           new (context_) ESTree::IdentifierNode(ident, nullptr, false));
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-    } else if (context_.getParseTypes() && check(TokenKind::less)) {
+    } else if (getParseTypes() && check(TokenKind::less)) {
       // This is a method definition.
       method = true;
       key = setLocation(
@@ -2706,7 +3018,7 @@ Optional<ESTree::Node *> JSParserImpl::parsePropertyAssignment(bool eagerly) {
 
       ESTree::Node *returnType = nullptr;
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-      if (context_.getParseTypes() && check(TokenKind::colon)) {
+      if (getParseTypes() && check(TokenKind::colon)) {
         SMLoc annotStart = advance(JSLexer::GrammarContext::Type).Start;
         auto optRet = parseReturnTypeAnnotation(annotStart);
         if (!optRet)
@@ -2762,7 +3074,7 @@ Optional<ESTree::Node *> JSParserImpl::parsePropertyAssignment(bool eagerly) {
           identRng,
           new (context_) ESTree::IdentifierNode(ident, nullptr, false));
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-    } else if (context_.getParseTypes() && check(TokenKind::less)) {
+    } else if (getParseTypes() && check(TokenKind::less)) {
       // This is a method definition.
       method = true;
       key = setLocation(
@@ -2819,7 +3131,7 @@ Optional<ESTree::Node *> JSParserImpl::parsePropertyAssignment(bool eagerly) {
 
       ESTree::Node *returnType = nullptr;
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-      if (context_.getParseTypes() && check(TokenKind::colon)) {
+      if (getParseTypes() && check(TokenKind::colon)) {
         SMLoc annotStart = advance(JSLexer::GrammarContext::Type).Start;
         auto optRet = parseReturnTypeAnnotation(annotStart);
         if (!optRet)
@@ -2873,7 +3185,7 @@ Optional<ESTree::Node *> JSParserImpl::parsePropertyAssignment(bool eagerly) {
           identRng,
           new (context_) ESTree::IdentifierNode(ident, nullptr, false));
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-    } else if (context_.getParseTypes() && check(TokenKind::less)) {
+    } else if (getParseTypes() && check(TokenKind::less)) {
       // This is a method definition.
       method = true;
       key = setLocation(
@@ -2979,7 +3291,7 @@ Optional<ESTree::Node *> JSParserImpl::parsePropertyAssignment(bool eagerly) {
 
     ESTree::Node *typeParams = nullptr;
 #if HERMES_PARSE_FLOW
-    if (context_.getParseFlow() && check(TokenKind::less)) {
+    if (getParseFlow() && check(TokenKind::less)) {
       auto optTypeParams = parseTypeParamsFlow();
       if (!optTypeParams)
         return None;
@@ -2987,7 +3299,7 @@ Optional<ESTree::Node *> JSParserImpl::parsePropertyAssignment(bool eagerly) {
     }
 #endif
 #if HERMES_PARSE_TS
-    if (context_.getParseTS() && check(TokenKind::less)) {
+    if (getParseTS() && check(TokenKind::less)) {
       auto optTypeParams = parseTSTypeParameters();
       if (!optTypeParams)
         return None;
@@ -3009,7 +3321,7 @@ Optional<ESTree::Node *> JSParserImpl::parsePropertyAssignment(bool eagerly) {
 
     ESTree::Node *returnType = nullptr;
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-    if (context_.getParseTypes() && check(TokenKind::colon)) {
+    if (getParseTypes() && check(TokenKind::colon)) {
       SMLoc annotStart = advance(JSLexer::GrammarContext::Type).Start;
       auto optRet = parseReturnTypeAnnotation(annotStart);
       if (!optRet)
@@ -3301,6 +3613,7 @@ Optional<ESTree::Node *> JSParserImpl::parseOptionalExpressionExceptNew(
           startLoc,
           endLoc,
           new (context_) ESTree::ImportExpressionNode(source, attributes));
+      storeDependency(ModuleDependency::Kind::DynamicImport, source);
     }
   } else {
     auto primExpr = parsePrimaryExpression();
@@ -3472,7 +3785,7 @@ Optional<ESTree::Node *> JSParserImpl::parseMemberSelect(
       checkAndEat(TokenKind::period) ||
       (optional &&
        !(check(TokenKind::l_paren) ||
-         (context_.getParseFlow() && check(TokenKind::less))))) {
+         (getParseFlow() && check(TokenKind::less))))) {
     if (!check(TokenKind::identifier, TokenKind::private_identifier) &&
         !tok_->isResWord()) {
       // Just use the pattern here, even though we know it will fail.
@@ -3516,7 +3829,7 @@ Optional<ESTree::Node *> JSParserImpl::parseMemberSelect(
     assert(
         optional &&
         (check(TokenKind::l_paren) ||
-         (context_.getParseFlow() && check(TokenKind::less))) &&
+         (getParseFlow() && check(TokenKind::less))) &&
         "must be ?.() at this point");
     // ?. Arguments :
     // ?. ( ArgumentList )
@@ -3525,7 +3838,7 @@ Optional<ESTree::Node *> JSParserImpl::parseMemberSelect(
 
     ESTree::NodePtr typeArgs = nullptr;
 #if HERMES_PARSE_FLOW
-    if (context_.getParseFlow() && check(TokenKind::less)) {
+    if (getParseFlow() && check(TokenKind::less)) {
       auto optTypeArgs = parseTypeArgsFlow();
       if (!optTypeArgs) {
         return None;
@@ -3542,7 +3855,7 @@ Optional<ESTree::Node *> JSParserImpl::parseMemberSelect(
     }
 #endif
 #if HERMES_PARSE_TS
-    if (context_.getParseTS() && check(TokenKind::less)) {
+    if (getParseTS() && check(TokenKind::less)) {
       auto optTypeArgs = parseTSTypeArguments();
       if (!optTypeArgs) {
         return None;
@@ -3590,16 +3903,16 @@ Optional<ESTree::Node *> JSParserImpl::parseCallExpression(
 
   for (;;) {
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-    if ((context_.getParseFlowAmbiguous() || context_.getParseTS()) &&
+    if ((getParseFlowAmbiguous() || getParseTS()) &&
         !typeArgs && check(TokenKind::less)) {
-      JSLexer::SavePoint savePoint{&lexer_};
+      SpeculationPoint savePoint{this};
       // Each call in a chain may have type arguments.
       // As such, we must attempt to parse them upon encountering '<',
       // but roll back if it just ended up being a comparison operator.
       SourceErrorManager::SaveAndSuppressMessages suppress{
           &sm_, Subsystem::Parser};
       auto optTypeArgs =
-          context_.getParseTS() ? parseTSTypeArguments() : parseTypeArgsFlow();
+          getParseTS() ? parseTSTypeArguments() : parseTypeArgsFlow();
       if (optTypeArgs && check(TokenKind::l_paren)) {
         // Call expression with type arguments.
         typeArgs = *optTypeArgs;
@@ -3629,6 +3942,12 @@ Optional<ESTree::Node *> JSParserImpl::parseCallExpression(
             new (context_) ESTree::OptionalCallExpressionNode(
                 expr, typeArgs, std::move(argList), optional));
       } else {
+        if (LLVM_UNLIKELY(collectDependencies_) && !argList.empty() &&
+            &argList.front() == &argList.back()) {
+          auto *callee = dyn_cast<ESTree::IdentifierNode>(expr);
+          if (callee && callee->_name == requireIdent_)
+            storeDependency(ModuleDependency::Kind::Require, &argList.front());
+        }
         expr = setLocation(
             startLoc,
             endLoc,
@@ -3739,15 +4058,14 @@ Optional<ESTree::Node *> JSParserImpl::parseNewExpressionOrOptionalExpression(
 
   ESTree::Node *typeArgs = nullptr;
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-  if ((context_.getParseFlowAmbiguous() || context_.getParseTS()) &&
-      check(TokenKind::less)) {
-    JSLexer::SavePoint savePoint{&lexer_};
+  if ((getParseFlowAmbiguous() || getParseTS()) && check(TokenKind::less)) {
+    SpeculationPoint savePoint{this};
     // Attempt to parse type args upon encountering '<',
     // but roll back if it just ended up being a comparison operator.
     SourceErrorManager::SaveAndSuppressMessages suppress{
         &sm_, Subsystem::Parser};
     auto optTypeArgs =
-        context_.getParseTS() ? parseTSTypeArguments() : parseTypeArgsFlow();
+        getParseTS() ? parseTSTypeArguments() : parseTypeArgsFlow();
     if (optTypeArgs) {
       // New expression with type arguments.
       typeArgs = *optTypeArgs;
@@ -3814,16 +4132,15 @@ Optional<ESTree::Node *> JSParserImpl::parseLeftHandSideExpression() {
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
   // If the less than sign is immediately following a question dot then it
   // cannot be a binary expression and is unambiguously Flow type syntax.
-  if (((optional ? context_.getParseFlow()
-                 : context_.getParseFlowAmbiguous()) ||
-       context_.getParseTS()) &&
+  if (((optional ? getParseFlow() : getParseFlowAmbiguous()) ||
+       getParseTS()) &&
       check(TokenKind::less)) {
-    JSLexer::SavePoint savePoint{&lexer_};
+    SpeculationPoint savePoint{this};
     // Suppress messages from the parser while still displaying lexer messages.
     SourceErrorManager::SaveAndSuppressMessages suppress{
         &sm_, Subsystem::Parser};
     auto optTypeArgs =
-        context_.getParseTS() ? parseTSTypeArguments() : parseTypeArgsFlow();
+        getParseTS() ? parseTSTypeArguments() : parseTypeArgsFlow();
     if (optTypeArgs && check(TokenKind::l_paren)) {
       // Call expression with type arguments.
       typeArgs = *optTypeArgs;
@@ -3872,8 +4189,9 @@ Optional<ESTree::Node *> JSParserImpl::parsePostfixExpression() {
 }
 
 Optional<ESTree::Node *> JSParserImpl::parseUnaryExpression() {
-  SMLoc startLoc = tok_->getStartLoc();
-
+  // Most operands have no prefix operator. Don't give them the larger frame
+  // of parseUnaryOperators(), which is on the stack of every nested
+  // expression.
   switch (tok_->getKind()) {
     case TokenKind::rw_delete:
     case TokenKind::rw_void:
@@ -3881,89 +4199,21 @@ Optional<ESTree::Node *> JSParserImpl::parseUnaryExpression() {
     case TokenKind::plus:
     case TokenKind::minus:
     case TokenKind::tilde:
-    case TokenKind::exclaim: {
-      UniqueString *op = getTokenIdent(tok_->getKind());
-      advance();
-      CHECK_RECURSION;
-      auto expr = parseUnaryExpression();
-      if (!expr)
-        return None;
-
-      if (check(TokenKind::starstar)) {
-        // ExponentiationExpression only allows UpdateExpressionNode on the
-        // left. The simplest way to enforce that the left operand is not
-        // an unparenthesized UnaryExpression is to check here.
-        error(
-            {startLoc, tok_->getEndLoc()},
-            "Unary operator before ** must use parens to disambiguate");
-      }
-
-      return setLocation(
-          startLoc,
-          getPrevTokenEndLoc(),
-          new (context_)
-              ESTree::UnaryExpressionNode(op, expr.getValue(), true));
-    }
-
+    case TokenKind::exclaim:
     case TokenKind::plusplus:
-    case TokenKind::minusminus: {
-      UniqueString *op = getTokenIdent(tok_->getKind());
-      advance();
-      CHECK_RECURSION;
-      auto expr = parseUnaryExpression();
-      if (!expr)
-        return None;
-
-      return setLocation(
-          startLoc,
-          getPrevTokenEndLoc(),
-          new (context_)
-              ESTree::UpdateExpressionNode(op, expr.getValue(), true));
-    }
+    case TokenKind::minusminus:
+      return parseUnaryOperators();
 
 #if HERMES_PARSE_TS
     case TokenKind::less:
-      if (context_.getParseTS() && !context_.getParseJSX()) {
-        // TSTypeAssertions are only parsed if JSX is disabled,
-        // so there's no backtracking necessary here.
-        // < Type > UnaryExpression
-        // ^
-        advance(JSLexer::GrammarContext::Type);
-        auto optType = parseTypeAnnotationTS();
-        if (!optType)
-          return None;
-        if (!eat(
-                TokenKind::greater,
-                JSLexer::GrammarContext::AllowRegExp,
-                "in type assertion",
-                "start of assertion",
-                startLoc))
-          return None;
-        CHECK_RECURSION;
-        auto optExpr = parseUnaryExpression();
-        if (!optExpr)
-          return None;
-        return setLocation(
-            startLoc,
-            getPrevTokenEndLoc(),
-            new (context_) ESTree::TSTypeAssertionNode(*optType, *optExpr));
-      }
+      if (getParseTS() && !getParseJSX())
+        return parseUnaryOperators();
       break;
 #endif
 
     case TokenKind::identifier:
-      if (check(awaitIdent_) && paramAwait_) {
-        advance();
-        CHECK_RECURSION;
-        auto optExpr = parseUnaryExpression();
-        if (!optExpr)
-          return None;
-        return setLocation(
-            startLoc,
-            getPrevTokenEndLoc(),
-            new (context_) ESTree::AwaitExpressionNode(optExpr.getValue()));
-      }
-      // Default for all other identifiers.
+      if (check(awaitIdent_) && paramAwait_)
+        return parseUnaryOperators();
       break;
 
     default:
@@ -3972,6 +4222,145 @@ Optional<ESTree::Node *> JSParserImpl::parseUnaryExpression() {
   return parsePostfixExpression();
 }
 
+Optional<ESTree::Node *> JSParserImpl::parseUnaryOperators() {
+  /// A prefix operator waiting for its operand. Chains of them, such as `!!x`
+  /// or `- - x`, are parsed in a loop rather than recursively, and applied
+  /// innermost first once the operand has been parsed.
+  struct Prefix {
+    enum Kind { Unary, Update, Await, TypeAssertion } kind;
+    SMLoc startLoc;
+    UniqueString *op;
+    /// The asserted type of a TypeAssertion, nullptr if it was skipped.
+    ESTree::Node *type;
+  };
+  llvh::SmallVector<Prefix, 2> prefixes;
+  // Every operator still counts as a level of nesting.
+  llvh::SaveAndRestore<unsigned> savedRecursionDepth{
+      recursionDepth_, recursionDepth_};
+
+  for (;;) {
+    SMLoc startLoc = tok_->getStartLoc();
+    bool isPrefix = true;
+
+    switch (tok_->getKind()) {
+      case TokenKind::rw_delete:
+      case TokenKind::rw_void:
+      case TokenKind::rw_typeof:
+      case TokenKind::plus:
+      case TokenKind::minus:
+      case TokenKind::tilde:
+      case TokenKind::exclaim:
+        prefixes.push_back(
+            {Prefix::Unary, startLoc, getTokenIdent(tok_->getKind()), nullptr});
+        advance();
+        break;
+
+      case TokenKind::plusplus:
+      case TokenKind::minusminus:
+        prefixes.push_back(
+            {Prefix::Update, startLoc, getTokenIdent(tok_->getKind()), nullptr});
+        advance();
+        break;
+
+#if HERMES_PARSE_TS
+      case TokenKind::less:
+        if (getParseTS() && !getParseJSX()) {
+          // TSTypeAssertions are only parsed if JSX is disabled,
+          // so there's no backtracking necessary here.
+          // < Type > UnaryExpression
+          // ^
+          auto parseAssertedType = [this,
+                                    startLoc]() -> Optional<ESTree::Node *> {
+            advance(JSLexer::GrammarContext::Type);
+            auto optType = parseTypeAnnotationTS();
+            if (!optType)
+              return None;
+            if (!eat(
+                    TokenKind::greater,
+                    JSLexer::GrammarContext::AllowRegExp,
+                    "in type assertion",
+                    "start of assertion",
+                    startLoc))
+              return None;
+            return *optType;
+          };
+          auto optType = LLVM_UNLIKELY(shouldSkipType())
+              ? skipType(startLoc, SkippedType::Kind::Cast, parseAssertedType)
+              : parseAssertedType();
+          if (!optType)
+            return None;
+          prefixes.push_back(
+              {Prefix::TypeAssertion, startLoc, nullptr, *optType});
+          break;
+        }
+        isPrefix = false;
+        break;
+#endif
+
+      case TokenKind::identifier:
+        if (check(awaitIdent_) && paramAwait_) {
+          prefixes.push_back({Prefix::Await, startLoc, nullptr, nullptr});
+          advance();
+          break;
+        }
+        // Default for all other identifiers.
+        isPrefix = false;
+        break;
+
+      default:
+        isPrefix = false;
+        break;
+    }
+
+    if (!isPrefix)
+      break;
+    ++recursionDepth_;
+    if (LLVM_UNLIKELY(recursionDepthCheck()))
+      return None;
+  }
+
+  auto optExpr = parsePostfixExpression();
+  if (!optExpr)
+    return None;
+  ESTree::Node *expr = *optExpr;
+
+  for (auto it = prefixes.rbegin(), e = prefixes.rend(); it != e; ++it) {
+    ESTree::Node *node;
+    switch (it->kind) {
+      case Prefix::Unary:
+        if (check(TokenKind::starstar)) {
+          // ExponentiationExpression only allows UpdateExpressionNode on the
+          // left. The simplest way to enforce that the left operand is not
+          // an unparenthesized UnaryExpression is to check here.
+          error(
+              {it->startLoc, tok_->getEndLoc()},
+              "Unary operator before ** must use parens to disambiguate");
+        }
+        node = new (context_) ESTree::UnaryExpressionNode(it->op, expr, true);
+        break;
+      case Prefix::Update:
+        node = new (context_) ESTree::UpdateExpressionNode(it->op, expr, true);
+        break;
+      case Prefix::Await:
+        node = new (context_) ESTree::AwaitExpressionNode(expr);
+        break;
+      case Prefix::TypeAssertion:
+#if HERMES_PARSE_TS
+        if (!it->type) {
+          // The assertion was skipped.
+          continue;
+        }
+        node = new (context_) ESTree::TSTypeAssertionNode(it->type, expr);
+        break;
+#else
+        llvm_unreachable("type assertions are only parsed with TS");
+#endif
+    }
+    expr = setLocation(it->startLoc, getPrevTokenEndLoc(), node);
+  }
+  return expr;
+}
+
 namespace {
 
 /// Associates precedence levels with binary operators. Higher precedences are
@@ -4014,7 +4403,7 @@ inline unsigned getPrecedenceExcept(const Token *token, TokenKind except) {
 inline void JSParserImpl::convertIdentOpIfPossible() {
 #if HERMES_PARSE_TS || HERMES_PARSE_FLOW
   if (LLVM_UNLIKELY(tok_->getKind() == TokenKind::identifier) &&
-      context_.getParseTypes()) {
+      getParseTypes()) {
     if (tok_->getIdentifier() == asIdent_)
       lexer_.convertCurTokenToIdentOp(TokenKind::as_operator);
   }
@@ -4022,6 +4411,27 @@ inline void JSParserImpl::convertIdentOpIfPossible() {
 };
 
 Optional<ESTree::Node *> JSParserImpl::parseBinaryExpression(Param param) {
+  // Most binary expressions are a single operand. Parse it here, and leave
+  // the operator stack, which makes for a large frame on the stack of every
+  // nested expression, to parseBinaryExpressionRest().
+  if (LLVM_UNLIKELY(check(TokenKind::private_identifier)))
+    return parseBinaryExpressionRest(param, tok_->getStartLoc(), nullptr);
+  SMLoc startLoc = tok_->getStartLoc();
+  auto optExpr = parseUnaryExpression();
+  if (!optExpr)
+    return None;
+  convertIdentOpIfPossible();
+  const TokenKind exceptKind =
+      !param.has(ParamIn) ? TokenKind::rw_in : TokenKind::none;
+  if (!getPrecedenceExcept(tok_, exceptKind))
+    return *optExpr;
+  return parseBinaryExpressionRest(param, startLoc, *optExpr);
+}
+
+Optional<ESTree::Node *> JSParserImpl::parseBinaryExpressionRest(
+    Param param,
+    SMLoc topExprStartLoc,
+    ESTree::Node *topExpr) {
   // The stack can never go deeper than the number of precedence levels,
   // unless we have a right-associative operator.
   // We have 10 precedence levels.
@@ -4080,13 +4490,17 @@ Optional<ESTree::Node *> JSParserImpl::parseBinaryExpression(Param param) {
           new (context_) ESTree::LogicalExpressionNode(left, right, opIdent));
 #if HERMES_PARSE_TS || HERMES_PARSE_FLOW
     } else if (LLVM_UNLIKELY(opKind == TokenKind::as_operator)) {
-      if (context_.getParseTS()) {
+      if (!right) {
+        // The type was skipped.
+        return left;
+      }
+      if (getParseTS()) {
         return setLocation(
             startLoc,
             endLoc,
             new (context_) ESTree::TSAsExpressionNode(left, right));
       } else {
-        assert(context_.getParseFlow() && "must be parsing types");
+        assert(getParseFlow() && "must be parsing types");
         if (auto *gen =
                 llvh::dyn_cast<ESTree::GenericTypeAnnotationNode>(right);
             gen && !gen->_typeParameters && gen->getParens() == 0) {
@@ -4145,18 +4559,11 @@ Optional<ESTree::Node *> JSParserImpl::parseBinaryExpression(Param param) {
   const TokenKind exceptKind =
       !param.has(ParamIn) ? TokenKind::rw_in : TokenKind::none;
 
-  SMLoc topExprStartLoc = tok_->getStartLoc();
-  ESTree::Node *topExpr = nullptr;
-  if (LLVM_UNLIKELY(check(TokenKind::private_identifier))) {
+  if (!topExpr) {
     topExpr = consumePrivateIdentifier();
-  } else {
-    auto optExpr = parseUnaryExpression();
-    if (!optExpr)
-      return None;
-    topExpr = optExpr.getValue();
+    convertIdentOpIfPossible();
   }
   SMLoc topExprEndLoc = getPrevTokenEndLoc();
-  convertIdentOpIfPossible();
 
   // While the current token is a binary operator.
   while (unsigned precedence = getPrecedenceExcept(tok_, exceptKind)) {
@@ -4190,9 +4597,14 @@ Optional<ESTree::Node *> JSParserImpl::parseBinaryExpression(Param param) {
 
 #if HERMES_PARSE_TS || HERMES_PARSE_FLOW
     if (LLVM_UNLIKELY(stack.back().opKind == TokenKind::as_operator)) {
-      advance(JSLexer::GrammarContext::Type);
+      SMLoc asStart = advance(JSLexer::GrammarContext::Type).Start;
       topExprStartLoc = tok_->getStartLoc();
-      auto optRightExpr = parseTypeAnnotation();
+      auto optRightExpr = LLVM_UNLIKELY(shouldSkipType())
+          ? skipType(
+                asStart,
+                SkippedType::Kind::Cast,
+                [this] { return parseTypeAnnotation(); })
+          : parseTypeAnnotation();
       if (!optRightExpr)
         return None;
       topExpr = optRightExpr.getValue();
@@ -4249,8 +4661,7 @@ Optional<ESTree::Node *> JSParserImpl::parseConditionalExpression(
     // TS doesn't have type casts with this syntax, but we must still
     // cover the typed identifier node for when it turns into an arrow function.
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-    if (context_.getParseTypes() &&
-        coverTypedParameters == CoverTypedParameters::Yes) {
+    if (getParseTypes() && coverTypedParameters == CoverTypedParameters::Yes) {
       auto optCover = tryParseCoverTypedIdentifierNode(test, false);
       if (!optCover)
         return None;
@@ -4263,112 +4674,184 @@ Optional<ESTree::Node *> JSParserImpl::parseConditionalExpression(
     return test;
   }
 
-  ESTree::Node *consequent = nullptr;
-  SMRange questionRange = tok_->getSourceRange();
+  return parseConditionalExpressionRest(
+      param, coverTypedParameters, startLoc, test);
+}
+
+Optional<ESTree::Node *> JSParserImpl::parseConditionalExpressionRest(
+    Param param,
+    CoverTypedParameters coverTypedParameters,
+    SMLoc startLoc,
+    ESTree::Node *test) {
+  /// A conditional expression waiting for its alternate. When the alternate
+  /// is itself a conditional expression, as in `a ? b : c ? d : e`, it is
+  /// parsed by the next iteration of the loop below instead of recursively.
+  struct Pending {
+    SMLoc startLoc;
+    ESTree::Node *test;
+    ESTree::Node *consequent;
+  };
+  llvh::SmallVector<Pending, 2> pending;
+  // Every conditional in a chain still counts as a level of nesting.
+  llvh::SaveAndRestore<unsigned> savedRecursionDepth{
+      recursionDepth_, recursionDepth_};
+  ESTree::Node *alternate;
+
+  for (;;) {
+    ESTree::Node *consequent = nullptr;
+    SMRange questionRange = tok_->getSourceRange();
 
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-  if (context_.getParseTypes()) {
-    // Save here to save the question mark (we can only save on punctuators).
-    // Early returns will happen if we find anything that leads to
-    // short-circuiting out of the traditional conditional expression.
-    JSLexer::SavePoint savePoint{&lexer_};
-    advance();
+    if (getParseTypes()) {
+      // Save here to save the question mark (we can only save on
+      // punctuators). Early returns will happen if we find anything that
+      // leads to short-circuiting out of the traditional conditional
+      // expression.
+      SpeculationPoint savePoint{this};
+      advance();
 
-    // If CoverTypedParameters::Yes, we still need to account for this
-    // being formal parameters, so try that,
-    // in which case the '?' was part of an optional parameter, not a
-    // conditional expression.
-    if (coverTypedParameters == CoverTypedParameters::Yes) {
-      auto optCover = tryParseCoverTypedIdentifierNode(test, true);
-      if (!optCover)
-        return None;
-      if (*optCover)
-        return *optCover;
+      // If CoverTypedParameters::Yes, we still need to account for this
+      // being formal parameters, so try that,
+      // in which case the '?' was part of an optional parameter, not a
+      // conditional expression.
+      if (coverTypedParameters == CoverTypedParameters::Yes) {
+        auto optCover = tryParseCoverTypedIdentifierNode(test, true);
+        if (!optCover)
+          return None;
+        if (*optCover) {
+          skipTypeModifier(questionRange);
+          return *optCover;
+        }
+      }
+
+      // It is also possible to have a '?' without ':' but not be a
+      // conditional expression, in the case of typed arrow parameters that
+      // didn't have a type annotation. For example:
+      // (foo?) => 1
+      //      ^
+      // The tokens which can come here are limited to ',', '=', and ')'.
+      if (coverTypedParameters == CoverTypedParameters::Yes &&
+          checkN(TokenKind::comma, TokenKind::r_paren, TokenKind::equal)) {
+        skipTypeModifier(questionRange);
+        return setLocation(
+            startLoc,
+            questionRange,
+            new (context_)
+                ESTree::CoverTypedIdentifierNode(test, nullptr, true));
+      }
+
+      // Now we're in the real backtracking stage.
+      // First, parse with AllowTypedArrowFunction::Yes to allow for the
+      // possibility of a concise arrow function with return types. However,
+      // we want to avoid the possibility of eating the ':' that we'll need
+      // for the conditional expression's alternate. For example:
+      // a ? b1 => (c1) : b2 => (c2)
+      // We want to account for b2 incorrectly being parsed as the returnType
+      // of an arrow function returned by the arrow function with param b1.
+      // Thus, after parsing with AllowTypedArrowFunction::Yes, we check to
+      // see if there is a ':' afterwards. If there isn't, failure is assured,
+      // so we restore to the '?' and try again below, with
+      // AllowTypedArrowFunction::No.
+      SourceErrorManager::SaveAndSuppressMessages suppress{
+          &sm_, Subsystem::Parser};
+      CHECK_RECURSION;
+      auto optConsequent = parseAssignmentExpression(
+          ParamIn, AllowTypedArrowFunction::Yes, CoverTypedParameters::No);
+      if (optConsequent && check(TokenKind::colon)) {
+        consequent = *optConsequent;
+      } else {
+        // Parsing with typed arrow functions failed because we don't have a
+        // :, so reset and try again.
+        savePoint.restore();
+      }
     }
+#endif
 
-    // It is also possible to have a '?' without ':' but not be a conditional
-    // expression, in the case of typed arrow parameters that didn't have a type
-    // annotation. For example:
-    // (foo?) => 1
-    //      ^
-    // The tokens which can come here are limited to ',', '=', and ')'.
-    if (coverTypedParameters == CoverTypedParameters::Yes &&
-        checkN(TokenKind::comma, TokenKind::r_paren, TokenKind::equal)) {
-      return setLocation(
-          startLoc,
-          questionRange,
-          new (context_) ESTree::CoverTypedIdentifierNode(test, nullptr, true));
-    }
-
-    // Now we're in the real backtracking stage.
-    // First, parse with AllowTypedArrowFunction::Yes to allow for the
-    // possibility of a concise arrow function with return types. However, we
-    // want to avoid the possibility of eating the ':' that we'll need for the
-    // conditional expression's alternate. For example:
-    // a ? b1 => (c1) : b2 => (c2)
-    // We want to account for b2 incorrectly being parsed as the returnType
-    // of an arrow function returned by the arrow function with param b1.
-    // Thus, after parsing with AllowTypedArrowFunction::Yes, we check to
-    // see if there is a ':' afterwards. If there isn't, failure is assured,
-    // so we restore to the '?' and try again below, with
-    // AllowTypedArrowFunction::No.
-    SourceErrorManager::SaveAndSuppressMessages suppress{
-        &sm_, Subsystem::Parser};
-    CHECK_RECURSION;
-    auto optConsequent = parseAssignmentExpression(
-        ParamIn, AllowTypedArrowFunction::Yes, CoverTypedParameters::No);
-    if (optConsequent && check(TokenKind::colon)) {
+    // Calls to parseAssignmentExpression may recursively invoke
+    // parseConditionalExpression.
+    ++recursionDepth_;
+    if (LLVM_UNLIKELY(recursionDepthCheck()))
+      return None;
+
+    // Only try with AllowTypedArrowFunction::No if we haven't already set
+    // up the consequent using AllowTypedArrowFunction::Yes.
+    if (!consequent) {
+      // Consume the '?' (either for the first time or after
+      // savePoint.restore()).
+      advance();
+      auto optConsequent = parseAssignmentExpression(
+          ParamIn, AllowTypedArrowFunction::No, CoverTypedParameters::No);
+      if (!optConsequent)
+        return None;
       consequent = *optConsequent;
-    } else {
-      // Parsing with typed arrow functions failed because we don't have a :,
-      // so reset and try again.
-      savePoint.restore();
     }
-  }
-#endif
 
-  // Calls to parseAssignmentExpression may recursively invoke
-  // parseConditionalExpression.
-  CHECK_RECURSION;
+    if (!eat(
+            TokenKind::colon,
+            JSLexer::AllowRegExp,
+            "in conditional expression after '... ? ...'",
+            "location of '?'",
+            questionRange.Start))
+      return None;
+    pending.push_back({startLoc, test, consequent});
+
+    // The alternate is an AssignmentExpression. Unless it starts with one of
+    // the tokens that parseAssignmentExpression() looks at before parsing a
+    // ConditionalExpression, parse its test here: if a '?' follows, the
+    // alternate is another conditional expression.
+    bool maybeConditional =
+        !(paramYield_ && check(TokenKind::rw_yield, TokenKind::identifier) &&
+          tok_->getResWordOrIdentifier() == yieldIdent_) &&
+        !check(asyncIdent_);
+#if HERMES_PARSE_FLOW
+    if (getParseFlow() && check(TokenKind::less))
+      maybeConditional = false;
+#endif
+    if (!maybeConditional) {
+      auto optAlternate = parseAssignmentExpression(
+          param, AllowTypedArrowFunction::Yes, CoverTypedParameters::No);
+      if (!optAlternate)
+        return None;
+      alternate = *optAlternate;
+      break;
+    }
 
-  // Only try with AllowTypedArrowFunction::No if we haven't already set
-  // up the consequent using AllowTypedArrowFunction::Yes.
-  if (!consequent) {
-    // Consume the '?' (either for the first time or after savePoint.restore()).
-    advance();
-    auto optConsequent = parseAssignmentExpression(
-        ParamIn, AllowTypedArrowFunction::No, CoverTypedParameters::No);
-    if (!optConsequent)
+    ParsedConditionalTest parsed{
+        tok_->getStartLoc(), lexer_.isNewLineBeforeCurrentToken(), nullptr};
+    auto optTest = parseBinaryExpression(param);
+    if (!optTest)
       return None;
-    consequent = *optConsequent;
+    if (!check(TokenKind::question)) {
+      // The alternate is not a conditional expression. Parse the rest of it.
+      parsed.test = *optTest;
+      parsedConditionalTest_ = &parsed;
+      auto optAlternate = parseAssignmentExpression(
+          param, AllowTypedArrowFunction::Yes, CoverTypedParameters::No);
+      if (!optAlternate)
+        return None;
+      alternate = *optAlternate;
+      break;
+    }
+    startLoc = parsed.startLoc;
+    test = *optTest;
+    coverTypedParameters = CoverTypedParameters::No;
   }
 
-  if (!eat(
-          TokenKind::colon,
-          JSLexer::AllowRegExp,
-          "in conditional expression after '... ? ...'",
-          "location of '?'",
-          questionRange.Start))
-    return None;
-
-  auto optAlternate = parseAssignmentExpression(
-      param, AllowTypedArrowFunction::Yes, CoverTypedParameters::No);
-  if (!optAlternate)
-    return None;
-  ESTree::Node *alternate = *optAlternate;
-
-  return setLocation(
-      startLoc,
-      getPrevTokenEndLoc(),
-      new (context_)
-          ESTree::ConditionalExpressionNode(test, alternate, consequent));
+  for (auto it = pending.rbegin(), e = pending.rend(); it != e; ++it) {
+    alternate = setLocation(
+        it->startLoc,
+        getPrevTokenEndLoc(),
+        new (context_) ESTree::ConditionalExpressionNode(
+            it->test, alternate, it->consequent));
+  }
+  return alternate;
 }
 
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
 Optional<ESTree::Node *> JSParserImpl::tryParseCoverTypedIdentifierNode(
     ESTree::Node *test,
     bool optional) {
-  assert(context_.getParseTypes() && "must be parsing types");
+  assert(getParseTypes() && "must be parsing types");
   // In the case of flow types in arrow function parameters, we may have
   // optional parameters which look like:
   // Identifier ? : TypeAnnotation
@@ -4468,7 +4951,7 @@ Optional<ESTree::ClassDeclarationNode *> JSParserImpl::parseClassDeclaration(
   }
 
 #if HERMES_PARSE_FLOW
-  if (context_.getParseFlow() && check(TokenKind::less)) {
+  if (getParseFlow() && check(TokenKind::less)) {
     auto optParams = parseTypeParamsFlow();
     if (!optParams)
       return None;
@@ -4476,7 +4959,7 @@ Optional<ESTree::ClassDeclarationNode *> JSParserImpl::parseClassDeclaration(
   }
 #endif
 #if HERMES_PARSE_TS
-  if (context_.getParseTS() && check(TokenKind::less)) {
+  if (getParseTS() && check(TokenKind::less)) {
     auto optParams = parseTSTypeParameters();
     if (!optParams)
       return None;
@@ -4503,9 +4986,8 @@ Optional<ESTree::ClassExpressionNode *> JSParserImpl::parseClassExpression() {
   ESTree::Node *typeParams = nullptr;
 
   if (!check(TokenKind::rw_extends, TokenKind::l_brace) &&
-      !(context_.getParseFlow() &&
-        check(TokenKind::rw_implements, TokenKind::less)) &&
-      !(context_.getParseTS() && check(TokenKind::less))) {
+      !(getParseFlow() && check(TokenKind::rw_implements, TokenKind::less)) &&
+      !(getParseTS() && check(TokenKind::less))) {
     // Try to parse a BindingIdentifier if we did not see a ClassHeritage
     // or a '{'.
     auto optName = parseBindingIdentifier(Param{});
@@ -4521,7 +5003,7 @@ Optional<ESTree::ClassExpressionNode *> JSParserImpl::parseClassExpression() {
   }
 
 #if HERMES_PARSE_FLOW
-  if (context_.getParseFlow() && check(TokenKind::less)) {
+  if (getParseFlow() && check(TokenKind::less)) {
     auto optParams = parseTypeParamsFlow();
     if (!optParams)
       return None;
@@ -4529,7 +5011,7 @@ Optional<ESTree::ClassExpressionNode *> JSParserImpl::parseClassExpression() {
   }
 #endif
 #if HERMES_PARSE_TS
-  if (context_.getParseTS() && check(TokenKind::less)) {
+  if (getParseTS() && check(TokenKind::less)) {
     auto optParams = parseTSTypeParameters();
     if (!optParams)
       return None;
@@ -4560,7 +5042,7 @@ Optional<ESTree::Node *> JSParserImpl::parseClassTail(
       return None;
     superClass = *optSuperClass;
 #if HERMES_PARSE_FLOW
-    if (context_.getParseFlow() && check(TokenKind::less)) {
+    if (getParseFlow() && check(TokenKind::less)) {
       auto optParams = parseTypeArgsFlow();
       if (!optParams)
         return None;
@@ -4568,7 +5050,7 @@ Optional<ESTree::Node *> JSParserImpl::parseClassTail(
     }
 #endif
 #if HERMES_PARSE_TS
-    if (context_.getParseTS() && check(TokenKind::less)) {
+    if (getParseTS() && check(TokenKind::less)) {
       auto optParams = parseTSTypeArguments();
       if (!optParams)
         return None;
@@ -4579,9 +5061,10 @@ Optional<ESTree::Node *> JSParserImpl::parseClassTail(
 
   ESTree::NodeList implements{};
 #if HERMES_PARSE_FLOW
-  if (context_.getParseFlow()) {
-    if (checkAndEat(TokenKind::rw_implements) ||
-        checkAndEat(implementsIdent_)) {
+  if (getParseFlow() &&
+      (check(TokenKind::rw_implements) || check(implementsIdent_))) {
+    auto parseImplements = [this, startLoc, &implements]() -> Optional<bool> {
+      advance();
       while (!check(TokenKind::l_brace)) {
         if (!need(
                 TokenKind::identifier,
@@ -4597,6 +5080,18 @@ Optional<ESTree::Node *> JSParserImpl::parseClassTail(
           break;
         }
       }
+      return true;
+    };
+
+    if (LLVM_UNLIKELY(shouldSkipType())) {
+      auto optSkipped = skipType(
+          tok_->getStartLoc(), SkippedType::Kind::Implements, parseImplements);
+      // The nodes have been freed.
+      implements.clear();
+      if (!optSkipped)
+        return None;
+    } else if (!parseImplements()) {
+      return None;
     }
   }
 #endif
@@ -4657,7 +5152,7 @@ Optional<ESTree::ClassBodyNode *> JSParserImpl::parseClassBody(SMLoc startLoc) {
     ESTree::NodeLabel accessibility = nullptr;
 
 #if HERMES_PARSE_FLOW
-    if (context_.getParseFlow() && check(declareIdent_)) {
+    if (getParseFlow() && check(declareIdent_)) {
       // Check for "declare" class properties.
       auto optNext = lexer_.lookahead1(llvh::None);
       if (optNext.hasValue() &&
@@ -4671,7 +5166,7 @@ Optional<ESTree::ClassBodyNode *> JSParserImpl::parseClassBody(SMLoc startLoc) {
 #endif
 
 #if HERMES_PARSE_TS
-    if (context_.getParseTS()) {
+    if (getParseTS()) {
       // In TS, modifiers may appear in this order: accessibility - static -
       // readonly. And all of them can be used as identifier.
       if (checkN(
@@ -4680,7 +5175,7 @@ Optional<ESTree::ClassBodyNode *> JSParserImpl::parseClassBody(SMLoc startLoc) {
               TokenKind::rw_public)) {
         if (canFollowModifierTS(lexer_.lookahead1(llvh::None))) {
           accessibility = tok_->getResWordIdentifier();
-          advance();
+          skipTypeModifier(advance());
         }
       }
 
@@ -4694,7 +5189,7 @@ Optional<ESTree::ClassBodyNode *> JSParserImpl::parseClassBody(SMLoc startLoc) {
       if (check(readonlyIdent_)) {
         if (canFollowModifierTS(lexer_.lookahead1(llvh::None))) {
           readonly = true;
-          advance();
+          skipTypeModifier(advance());
         }
       }
     }
@@ -4706,7 +5201,7 @@ Optional<ESTree::ClassBodyNode *> JSParserImpl::parseClassBody(SMLoc startLoc) {
         break;
 
       case TokenKind::rw_static:
-        if (context_.getParseTS() && (readonly || isStatic)) {
+        if (getParseTS() && (readonly || isStatic)) {
           // Don't advance() when `readonly` or `static` is already seen,
           // so the current one can be regarded as an identifier.
           // `static` modifier cannot come after `readonly` in TS.
@@ -4719,6 +5214,16 @@ Optional<ESTree::ClassBodyNode *> JSParserImpl::parseClassBody(SMLoc startLoc) {
         LLVM_FALLTHROUGH;
       default: {
         // ClassElement
+        if (LLVM_UNLIKELY(declare && shouldSkipType())) {
+          // A declared field only has a type.
+          if (!skipType(
+                  startRange.Start, SkippedType::Kind::Declaration, [&] {
+                    return parseClassElement(
+                        isStatic, startRange, declare, readonly, accessibility);
+                  }))
+            return None;
+          break;
+        }
         auto optElem = parseClassElement(
             isStatic, startRange, declare, readonly, accessibility);
         if (!optElem)
@@ -4816,7 +5321,7 @@ Optional<ESTree::Node *> JSParserImpl::parseClassElement(
       return true;
     }
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-    if (context_.getParseTypes() && check(TokenKind::less, TokenKind::colon)) {
+    if (getParseTypes() && check(TokenKind::less, TokenKind::colon)) {
       return true;
     }
 #endif
@@ -4898,13 +5403,13 @@ Optional<ESTree::Node *> JSParserImpl::parseClassElement(
 
   ESTree::Node *variance = nullptr;
 #if HERMES_PARSE_FLOW
-  if (context_.getParseFlow() && check(TokenKind::plus, TokenKind::minus)) {
+  if (getParseFlow() && check(TokenKind::plus, TokenKind::minus)) {
     variance = setLocation(
         tok_,
         tok_,
         new (context_) ESTree::VarianceNode(
             check(TokenKind::plus) ? plusIdent_ : minusIdent_));
-    advance(JSLexer::GrammarContext::Type);
+    skipTypeModifier(advance(JSLexer::GrammarContext::Type));
   }
 #endif
 
@@ -4947,12 +5452,13 @@ Optional<ESTree::Node *> JSParserImpl::parseClassElement(
     //                 ^
     ESTree::Node *typeAnnotation = nullptr;
 #if HERMES_PARSE_TS
-    if (context_.getParseTS() && checkAndEat(TokenKind::question)) {
+    if (getParseTS() && check(TokenKind::question)) {
       optional = true;
+      skipTypeModifier(advance());
     }
 #endif
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-    if (context_.getParseTypes() && check(TokenKind::colon)) {
+    if (getParseTypes() && check(TokenKind::colon)) {
       SMLoc annotStart = advance(JSLexer::GrammarContext::Type).Start;
       auto optType = parseTypeAnnotation(annotStart);
       if (!optType)
@@ -4989,8 +5495,9 @@ Optional<ESTree::Node *> JSParserImpl::parseClassElement(
       }
       ESTree::Node *modifiers = nullptr;
 #if HERMES_PARSE_TS
-      if (context_.getParseTS()) {
+      if (getParseTS()) {
         modifiers = new (context_) ESTree::TSModifiersNode(nullptr, readonly);
+        countNewNode(modifiers);
       }
 #endif
       return setLocation(
@@ -5008,9 +5515,10 @@ Optional<ESTree::Node *> JSParserImpl::parseClassElement(
     }
     ESTree::Node *modifiers = nullptr;
 #if HERMES_PARSE_TS
-    if (context_.getParseTS()) {
+    if (getParseTS()) {
       modifiers =
           new (context_) ESTree::TSModifiersNode(accessibility, readonly);
+      countNewNode(modifiers);
     }
 #endif
     return setLocation(
@@ -5036,7 +5544,7 @@ Optional<ESTree::Node *> JSParserImpl::parseClassElement(
 
   ESTree::Node *typeParams = nullptr;
 #if HERMES_PARSE_FLOW
-  if (context_.getParseFlow() && check(TokenKind::less)) {
+  if (getParseFlow() && check(TokenKind::less)) {
     auto optTypeParams = parseTypeParamsFlow();
     if (!optTypeParams)
       return None;
@@ -5067,7 +5575,7 @@ Optional<ESTree::Node *> JSParserImpl::parseClassElement(
 
   ESTree::Node *returnType = nullptr;
 #if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-  if (context_.getParseTypes() && check(TokenKind::colon)) {
+  if (getParseTypes() && check(TokenKind::colon)) {
     SMLoc annotStart = advance(JSLexer::GrammarContext::Type).Start;
     auto optRet = parseReturnTypeAnnotation(annotStart);
     if (!optRet)
@@ -5260,9 +5768,11 @@ bool JSParserImpl::reparseArrowParameters(
       // which means that Rest elements are parsed as SpreadElement.
       if (it != e)
         error(expr->getSourceRange(), "rest parameter must be last");
-      else
-        paramList.push_back(*new (context_)
-                                ESTree::RestElementNode(spread->_argument));
+      else {
+        auto *rest = new (context_) ESTree::RestElementNode(spread->_argument);
+        countNewNode(rest);
+        paramList.push_back(*rest);
+      }
       continue;
     }
 
@@ -5597,6 +6107,7 @@ Optional<ESTree::Node *> JSParserImpl::reparseObjectAssignmentPattern(
         auto *ident = cast<ESTree::IdentifierNode>(propNode->_key);
         value = new (context_) ESTree::IdentifierNode(
             ident->_name, ident->_typeAnnotation, ident->_optional);
+        countNewNode(value);
         value->copyLocationFrom(propNode->_key);
 
         init = coverInitializer->_init;
@@ -5624,6 +6135,7 @@ Optional<ESTree::Node *> JSParserImpl::reparseObjectAssignmentPattern(
 
   auto *OP =
       new (context_) ESTree::ObjectPatternNode(std::move(elements), nullptr);
+  countNewNode(OP);
   OP->copyLocationFrom(OEN);
   return OP;
 }
@@ -5631,9 +6143,9 @@ Optional<ESTree::Node *> JSParserImpl::reparseObjectAssignmentPattern(
 #if HERMES_PARSE_FLOW
 Optional<ESTree::Node *> JSParserImpl::tryParseTypedAsyncArrowFunction(
     Param param) {
-  assert(context_.getParseFlow());
+  assert(getParseFlow());
   assert(check(asyncIdent_));
-  JSLexer::SavePoint savePoint{&lexer_};
+  SpeculationPoint savePoint{this};
   SMLoc start = advance().Start;
 
   ESTree::Node *leftExpr = nullptr;
@@ -5669,7 +6181,8 @@ Optional<ESTree::Node *> JSParserImpl::tryParseTypedAsyncArrowFunction(
 
     if (check(TokenKind::colon)) {
       SMLoc annotStart = advance(JSLexer::GrammarContext::Type).Start;
-      if (!check(checksIdent_)) {
+      bool startsWithPredicate = check(checksIdent_);
+      if (!startsWithPredicate) {
         auto optType = parseReturnTypeAnnotationFlow(
             annotStart, AllowAnonFunctionType::No);
         if (!optType) {
@@ -5679,7 +6192,8 @@ Optional<ESTree::Node *> JSParserImpl::tryParseTypedAsyncArrowFunction(
         returnType = *optType;
       }
       if (check(checksIdent_)) {
-        auto optPredicate = parsePredicateFlow();
+        auto optPredicate = parsePredicateFlow(
+            startsWithPredicate ? Optional<SMLoc>(annotStart) : None);
         if (!optPredicate) {
           savePoint.restore();
           return None;
@@ -5712,6 +6226,9 @@ Optional<ESTree::Node *> JSParserImpl::parseAssignmentExpression(
     AllowTypedArrowFunction allowTypedArrowFunction,
     CoverTypedParameters coverTypedParameters,
     ESTree::Node *typeParams) {
+  const ParsedConditionalTest *parsedTest = parsedConditionalTest_;
+  parsedConditionalTest_ = nullptr;
+
   struct State {
     SMLoc leftStartLoc = {};
     Optional<ESTree::Node *> optLeftExpr = llvh::None;
@@ -5727,10 +6244,13 @@ Optional<ESTree::Node *> JSParserImpl::parseAssignmentExpression(
                          Param param,
                          AllowTypedArrowFunction allowTypedArrowFunction,
                          CoverTypedParameters coverTypedParameters,
-                         ESTree::Node *typeParams) -> Optional<ESTree::Node *> {
+                         ESTree::Node *typeParams,
+                         const ParsedConditionalTest *parsedTest)
+      -> Optional<ESTree::Node *> {
     // Check for yield, which may be lexed as a reserved word, but only in
     // strict mode.
-    if (paramYield_ && check(TokenKind::rw_yield, TokenKind::identifier) &&
+    if (!parsedTest && paramYield_ &&
+        check(TokenKind::rw_yield, TokenKind::identifier) &&
         tok_->getResWordOrIdentifier() == yieldIdent_) {
       auto optYieldExpr = parseYieldExpression(param.get(ParamIn));
       if (!optYieldExpr)
@@ -5743,15 +6263,15 @@ Optional<ESTree::Node *> JSParserImpl::parseAssignmentExpression(
       return yieldExpr;
     }
 
-    SMLoc startLoc = tok_->getStartLoc();
+    SMLoc startLoc = parsedTest ? parsedTest->startLoc : tok_->getStartLoc();
     bool forceAsync = false;
-    if (check(asyncIdent_)) {
+    if (!parsedTest && check(asyncIdent_)) {
       OptValue<TokenKind> optNext = lexer_.lookahead1(TokenKind::identifier);
       if (optNext.hasValue() && *optNext == TokenKind::identifier) {
         forceAsync = true;
       }
 #if HERMES_PARSE_FLOW
-      if (context_.getParseFlow() && optNext.hasValue() &&
+      if (getParseFlow() && optNext.hasValue() &&
           (*optNext == TokenKind::less || *optNext == TokenKind::l_paren)) {
         auto optAsyncArrow = tryParseTypedAsyncArrowFunction(param);
         if (optAsyncArrow.hasValue()) {
@@ -5762,10 +6282,10 @@ Optional<ESTree::Node *> JSParserImpl::parseAssignmentExpression(
     }
 
 #if HERMES_PARSE_FLOW
-    if (context_.getParseFlow() &&
+    if (getParseFlow() && !parsedTest &&
         allowTypedArrowFunction == AllowTypedArrowFunction::Yes &&
         !typeParams && check(TokenKind::less)) {
-      JSLexer::SavePoint savePoint{&lexer_};
+      SpeculationPoint savePoint{this};
       // Suppress messages from the parser while still displaying lexer
       // messages.
       CollectMessagesRAII collect{&sm_, true};
@@ -5812,21 +6332,28 @@ Optional<ESTree::Node *> JSParserImpl::parseAssignmentExpression(
     }
 #endif
 
-    state.leftStartLoc = tok_->getStartLoc();
-    state.hasNewLine = lexer_.isNewLineBeforeCurrentToken();
-    state.optLeftExpr = parseConditionalExpression(param, coverTypedParameters);
-    if (!state.optLeftExpr)
-      return None;
+    if (parsedTest) {
+      state.leftStartLoc = parsedTest->startLoc;
+      state.hasNewLine = parsedTest->hasNewLine;
+      state.optLeftExpr = parsedTest->test;
+    } else {
+      state.leftStartLoc = tok_->getStartLoc();
+      state.hasNewLine = lexer_.isNewLineBeforeCurrentToken();
+      state.optLeftExpr =
+          parseConditionalExpression(param, coverTypedParameters);
+      if (!state.optLeftExpr)
+        return None;
+    }
 
     ESTree::Node *returnType = nullptr;
     ESTree::Node *predicate = nullptr;
 #if HERMES_PARSE_FLOW
-    if (context_.getParseFlow()) {
+    if (getParseFlow()) {
       if (allowTypedArrowFunction == AllowTypedArrowFunction::Yes &&
           ((*state.optLeftExpr)->getParens() != 0 ||
            isa<ESTree::CoverEmptyArgsNode>(*state.optLeftExpr)) &&
           check(TokenKind::colon)) {
-        JSLexer::SavePoint savePoint{&lexer_};
+        SpeculationPoint savePoint{this};
         // Defer our decision on whether to show or suppress messages for this
         // next section.
         // If we are unsuccessful during the parse, it can mean that we need to
@@ -5857,7 +6384,8 @@ Optional<ESTree::Node *> JSParserImpl::parseAssignmentExpression(
             // Successful parse, show any messages that the lexer emitted.
             collect.setDiscardMessages(false);
           } else if (check(checksIdent_)) {
-            auto optPred = parsePredicateFlow();
+            auto optPred = parsePredicateFlow(
+                startsWithPredicate ? Optional<SMLoc>(annotStart) : None);
             if (optPred && check(TokenKind::equalgreater)) {
               // Done parsing the return type and predicate.
               predicate = *optPred;
@@ -5865,9 +6393,11 @@ Optional<ESTree::Node *> JSParserImpl::parseAssignmentExpression(
               collect.setDiscardMessages(false);
             } else {
               savePoint.restore();
+              returnType = nullptr;
             }
           } else {
             savePoint.restore();
+            returnType = nullptr;
           }
         } else {
           savePoint.restore();
@@ -5877,14 +6407,14 @@ Optional<ESTree::Node *> JSParserImpl::parseAssignmentExpression(
 #endif
 
 #if HERMES_PARSE_TS
-    if (context_.getParseTS()) {
+    if (getParseTS()) {
       // Separate logic for TS parsing here, because the semantics don't
       // require as much complexity as Flow due to a lack of predicates.
       if (allowTypedArrowFunction == AllowTypedArrowFunction::Yes &&
           ((*state.optLeftExpr)->getParens() != 0 ||
            isa<ESTree::CoverEmptyArgsNode>(*state.optLeftExpr)) &&
           check(TokenKind::colon)) {
-        JSLexer::SavePoint savePoint{&lexer_};
+        SpeculationPoint savePoint{this};
         // Defer our decision on whether to show or suppress messages for this
         // next section.
         // If we are unsuccessful during the parse, it can mean that we need to
@@ -5910,6 +6440,7 @@ Optional<ESTree::Node *> JSParserImpl::parseAssignmentExpression(
             collect.setDiscardMessages(false);
           } else {
             savePoint.restore();
+            returnType = nullptr;
           }
         } else {
           savePoint.restore();
@@ -5974,7 +6505,8 @@ Optional<ESTree::Node *> JSParserImpl::parseAssignmentExpression(
       param,
       allowTypedArrowFunction,
       coverTypedParameters,
-      typeParams);
+      typeParams,
+      parsedTest);
 
   for (;;) {
     if (!optRes)
@@ -5993,6 +6525,7 @@ Optional<ESTree::Node *> JSParserImpl::parseAssignmentExpression(
         param,
         AllowTypedArrowFunction::Yes,
         CoverTypedParameters::No,
+        nullptr,
         nullptr);
   }
 
@@ -6257,7 +6790,7 @@ Optional<UniqueString *> JSParserImpl::parseImportClause(
   UniqueString *kind = valueIdent_;
   SMRange kindRange{};
 #if HERMES_PARSE_FLOW
-  if (context_.getParseFlow()) {
+  if (getParseFlow()) {
     if (checkN(typeIdent_, TokenKind::rw_typeof)) {
       kind = tok_->getResWordOrIdentifier();
       kindRange = advance();
@@ -6265,7 +6798,7 @@ Optional<UniqueString *> JSParserImpl::parseImportClause(
   }
 #endif
 #if HERMES_PARSE_TS
-  if (context_.getParseTS()) {
+  if (getParseTS()) {
     if (checkN(typeIdent_)) {
       kind = tok_->getResWordOrIdentifier();
       kindRange = advance();
@@ -6373,6 +6906,7 @@ bool JSParserImpl::parseNamedImports(ESTree::NodeList &specifiers) {
   llvh::DenseMap<UniqueString *, ESTree::IdentifierNode *> boundNames{};
 
   while (!check(TokenKind::r_brace)) {
+    SMLoc specifierStart = tok_->getStartLoc();
     auto optSpecifier = parseImportSpecifier(startLoc);
     if (!optSpecifier) {
       return false;
@@ -6393,7 +6927,15 @@ bool JSParserImpl::parseNamedImports(ESTree::NodeList &specifiers) {
           insertRes.first->second->getSourceRange(), "first usage of name");
     }
 
-    if (!checkAndEat(TokenKind::comma)) {
+    bool more = checkAndEat(TokenKind::comma);
+    if (LLVM_UNLIKELY(shouldSkipType()) &&
+        optSpecifier.getValue()->_importKind != valueIdent_) {
+      // Skip a `type` or `typeof` specifier together with its comma.
+      lexer_.storeSkippedType(
+          SkippedType::Kind::Declaration,
+          SMRange{specifierStart, getPrevTokenEndLoc()});
+    }
+    if (!more) {
       break;
     }
   }
@@ -6422,7 +6964,7 @@ Optional<ESTree::ImportSpecifierNode *> JSParserImpl::parseImportSpecifier(
   TokenKind localKind;
 
 #if HERMES_PARSE_FLOW
-  if (context_.getParseFlow() && checkAndEat(TokenKind::rw_typeof)) {
+  if (getParseFlow() && checkAndEat(TokenKind::rw_typeof)) {
     kind = typeofIdent_;
   }
 #endif
@@ -6430,7 +6972,7 @@ Optional<ESTree::ImportSpecifierNode *> JSParserImpl::parseImportSpecifier(
   // This isn't wrapped in #if HERMES_PARSE_FLOW, as it is entangled
   // in the rest of the import specifier parsing code and doesn't actually
   // depend on JSParserImpl-flow specific code at all.
-  if (HERMES_PARSE_FLOW && context_.getParseFlow() && check(typeIdent_) &&
+  if (HERMES_PARSE_FLOW && getParseFlow() && check(typeIdent_) &&
       kind == valueIdent_) {
     // Consume 'type', but make no assumptions about what it means yet.
     SMRange typeRange = advance();
@@ -6600,7 +7142,7 @@ Optional<ESTree::Node *> JSParserImpl::parseExportDeclaration() {
   SMLoc startLoc = advance().Start;
 
 #if HERMES_PARSE_FLOW
-  if (context_.getParseFlow() && check(typeIdent_)) {
+  if (getParseFlow() && check(typeIdent_)) {
     return parseExportTypeDeclarationFlow(startLoc);
   }
 #endif
@@ -6677,7 +7219,7 @@ Optional<ESTree::Node *> JSParserImpl::parseExportDeclaration() {
           new (context_) ESTree::ExportDefaultDeclarationNode(*optClassDecl));
 #if HERMES_PARSE_FLOW
     } else if (
-        context_.getParseFlow() && context_.getParseFlowComponentSyntax() &&
+        getParseFlow() && getParseFlowComponentSyntax() &&
         checkComponentDeclarationFlow()) {
       auto optComponent = parseComponentDeclarationFlow(
           tok_->getStartLoc(), /* declare */ false);
@@ -6689,7 +7231,7 @@ Optional<ESTree::Node *> JSParserImpl::parseExportDeclaration() {
           *optComponent,
           new (context_) ESTree::ExportDefaultDeclarationNode(*optComponent));
     } else if (
-        context_.getParseFlow() && context_.getParseFlowComponentSyntax() &&
+        getParseFlow() && getParseFlowComponentSyntax() &&
         checkHookDeclarationFlow()) {
       auto optHook = parseHookDeclarationFlow(tok_->getStartLoc());
       if (!optHook) {
@@ -6699,7 +7241,7 @@ Optional<ESTree::Node *> JSParserImpl::parseExportDeclaration() {
           startLoc,
           *optHook,
           new (context_) ESTree::ExportDefaultDeclarationNode(*optHook));
-    } else if (context_.getParseFlow() && check(TokenKind::rw_enum)) {
+    } else if (getParseFlow() && check(TokenKind::rw_enum)) {
       auto optEnum =
           parseEnumDeclarationFlow(tok_->getStartLoc(), /* declare */ false);
       if (!optEnum) {
@@ -6970,6 +7512,8 @@ Optional<ESTree::NodePtr> JSParserImpl::parseLazyFunction(
     bool paramYield,
     bool paramAwait,
     SMLoc start) {
+  PerfSection parsing("Lazy-Parsing JavaScript function");
+  ParseStatsScope statsScope{context_, stats_};
   seek(start);
 
   paramYield_ = paramYield;
@@ -7000,5 +7544,10 @@ Optional<ESTree::NodePtr> JSParserImpl::parseLazyFunction(
   }
 }
 } // namespace detail
+
+bool ParseStats::isSupported() {
+  return HERMES_PARSE_STATS;
+}
+
 } // namespace parser
 } // namespace hermes
@@ -21,6 +21,7 @@
 #include "llvh/ADT/SmallVector.h"
 #include "llvh/ADT/StringRef.h"
 #include "llvh/Support/DataTypes.h"
+#include "llvh/Support/SaveAndRestore.h"
 
 #include <utility>
 
@@ -76,6 +77,107 @@ static constexpr Param ParamReturn{1 << 1};
 static constexpr Param ParamDefault{1 << 2};
 static constexpr Param ParamTagged{1 << 3};
 
+/// Certain known identifiers which we need to use when constructing the
+/// ESTree or when parsing. They are interned once per Context and cached
+/// there, see Context::getKnownIdentifiers().
+struct KnownIdentifiers {
+  UniqueString *getIdent_;
+  UniqueString *setIdent_;
+  UniqueString *initIdent_;
+  UniqueString *useStrictIdent_;
+  UniqueString *showSourceIdent_;
+  UniqueString *hideSourceIdent_;
+  UniqueString *sensitiveIdent_;
+  UniqueString *useStaticBuiltinIdent_;
+  UniqueString *letIdent_;
+  UniqueString *ofIdent_;
+  UniqueString *fromIdent_;
+  UniqueString *asIdent_;
+  UniqueString *implementsIdent_;
+  UniqueString *interfaceIdent_;
+  UniqueString *packageIdent_;
+  UniqueString *privateIdent_;
+  UniqueString *protectedIdent_;
+  UniqueString *publicIdent_;
+  UniqueString *staticIdent_;
+  UniqueString *methodIdent_;
+  UniqueString *constructorIdent_;
+  UniqueString *yieldIdent_;
+  UniqueString *newIdent_;
+  UniqueString *importIdent_;
+  UniqueString *targetIdent_;
+  UniqueString *metaIdent_;
+  UniqueString *valueIdent_;
+  UniqueString *typeIdent_;
+  UniqueString *asyncIdent_;
+  UniqueString *awaitIdent_;
+  UniqueString *assertIdent_;
+  UniqueString *requireIdent_;
+
+#if HERMES_PARSE_FLOW
+
+  UniqueString *typeofIdent_;
+  UniqueString *keyofIdent_;
+  UniqueString *declareIdent_;
+  UniqueString *protoIdent_;
+  UniqueString *opaqueIdent_;
+  UniqueString *plusIdent_;
+  UniqueString *minusIdent_;
+  UniqueString *moduleIdent_;
+  UniqueString *exportsIdent_;
+  UniqueString *esIdent_;
+  UniqueString *commonJSIdent_;
+  UniqueString *mixinsIdent_;
+  UniqueString *thisIdent_;
+
+  UniqueString *anyIdent_;
+  UniqueString *mixedIdent_;
+  UniqueString *emptyIdent_;
+  UniqueString *booleanIdent_;
+  UniqueString *boolIdent_;
+  UniqueString *numberIdent_;
+  UniqueString *stringIdent_;
+  UniqueString *voidIdent_;
+  UniqueString *nullIdent_;
+  UniqueString *symbolIdent_;
+  UniqueString *bigintIdent_;
+
+  UniqueString *mappedTypeOptionalIdent_;
+  UniqueString *mappedTypePlusOptionalIdent_;
+  UniqueString *mappedTypeMinusOptionalIdent_;
+
+  UniqueString *checksIdent_;
+  UniqueString *assertsIdent_;
+  UniqueString *impliesIdent_;
+
+  UniqueString *componentIdent_;
+  UniqueString *hookIdent_;
+  UniqueString *rendersIdent_;
+  UniqueString *rendersMaybeOperator_;
+  UniqueString *rendersStarOperator_;
+#endif
+
+#if HERMES_PARSE_TS
+  UniqueString *readonlyIdent_;
+  UniqueString *neverIdent_;
+  UniqueString *undefinedIdent_;
+  UniqueString *unknownIdent_;
+#endif
+
+#if HERMES_PARSE_FLOW || HERMES_PARSE_TS
+  UniqueString *namespaceIdent_;
+  UniqueString *isIdent_;
+  UniqueString *inferIdent_;
+  UniqueString *constIdent_;
+#endif
+
+  /// String representation of all tokens.
+  UniqueString *tokenIdent_[NUM_JS_TOKENS];
+
+  /// Intern all of the identifiers in \p strTab.
+  void intern(StringTable &strTab);
+};
+
 /// An EcmaScript 5.1 parser.
 /// It is a standard recursive descent LL(1) parser with no tricks. The only
 /// complication, is the need to communicate information to the lexer whether
@@ -83,7 +185,7 @@ static constexpr Param ParamTagged{1 << 3};
 /// We go to some effort to avoid the need for more than one token lookahead
 /// for performance. Some things (like recognizing a label) would have been
 /// simplified with larger lookahead.
-class JSParserImpl {
+class JSParserImpl : private KnownIdentifiers {
  public:
   explicit JSParserImpl(
       Context &context,
@@ -125,6 +227,40 @@ class JSParserImpl {
 
   Optional<ESTree::ProgramNode *> parse();
 
+  /// Record the modules the program depends on as they are parsed, in the
+  /// lexer (see JSLexer::getDependencies()).
+  void setCollectDependencies(bool collect) {
+    collectDependencies_ = collect;
+  }
+
+  /// Find the modules the program depends on, without keeping an AST. Import
+  /// and export declarations are parsed, and the rest of the program is
+  /// skipped a character at a time, matching brackets and telling strings,
+  /// templates, comments and regexps apart, to find `import()` and `require()`
+  /// calls. If something can't be skipped without knowing the grammar around
+  /// it, such as a '/' after a '}', the program is parsed in full instead.
+  /// \return false if the program has errors. Syntax errors in the skipped
+  ///   parts are not necessarily found.
+  bool scanDependencies();
+
+  /// Parse the program like parse(), and pass every top-level statement to
+  /// \p callback as soon as it is complete (see JSParser::parseStreaming()).
+  Optional<ESTree::ProgramNode *> parseStreaming(StatementCallback callback);
+
+  /// Update \p program to the edited source in this parser's buffer, parsing
+  /// only the statements around \p edit if possible (see JSParser::reparse()).
+  Optional<ESTree::ProgramNode *> reparse(
+      ESTree::ProgramNode *program,
+      llvh::StringRef oldSource,
+      const SourceEdit &edit,
+      llvh::ArrayRef<SkippedType> oldSkippedTypes);
+
+  /// \return whether the last reparse() only parsed the statements around
+  ///   the edit.
+  bool wasReparsedIncrementally() const {
+    return reparsedIncrementally_;
+  }
+
   void seek(SMLoc startPos) {
     lexer_.seek(startPos);
     tok_ = lexer_.advance();
@@ -163,7 +299,7 @@ class JSParserImpl {
 
   /// Called during construction to initialize Identifiers used for parsing,
   /// such as "var". The lexer and parser uses these to avoid passing strings
-  /// around.
+  /// around. They are copied from the Context when it already has them.
   void initializeIdentifiers();
 
   /// Current compilation context.
@@ -185,7 +321,60 @@ class JSParserImpl {
   /// every possible recursion cycle.
   unsigned recursionDepth_{0};
 
-  /// Self-explanatory: the maximum depth of parser recursion.
+  /// If set, polled at statement and function boundaries to find out whether
+  /// the parse should stop early.
+  ParseInterrupt *interrupt_{nullptr};
+
+  /// If set, the statistics of the Context, updated as we parse.
+  ParseStats *stats_{nullptr};
+
+  /// Set when types are left out of the AST (see TypeSyntaxSetting::SKIP).
+  /// Cleared while a skipped type is parsed, so that the types nested in it
+  /// are parsed normally.
+  bool skipTypes_{false};
+
+  /// The dialects set in the Context, copied when the parser is created so
+  /// that the checks below do not go through the Context. They cannot change
+  /// during a parse.
+  bool parseJSX_{false};
+  ParseFlowSetting parseFlow_{ParseFlowSetting::NONE};
+  bool parseFlowComponentSyntax_{false};
+  bool parseTS_{false};
+
+  /// The dialect checks used while parsing. Each one is constant false if
+  /// the parser is built without the dialect, so that the code for it is
+  /// left out of the other paths.
+  bool getParseJSX() const {
+    return HERMES_PARSE_JSX && parseJSX_;
+  }
+  bool getParseFlow() const {
+    return HERMES_PARSE_FLOW && parseFlow_ != ParseFlowSetting::NONE;
+  }
+  bool getParseFlowAmbiguous() const {
+    return HERMES_PARSE_FLOW && parseFlow_ == ParseFlowSetting::ALL;
+  }
+  bool getParseFlowComponentSyntax() const {
+    return HERMES_PARSE_FLOW && parseFlowComponentSyntax_;
+  }
+  bool getParseTS() const {
+    return HERMES_PARSE_TS && parseTS_;
+  }
+  /// \return true if either TS or Flow is being parsed.
+  bool getParseTypes() const {
+    return getParseFlow() || getParseTS();
+  }
+
+  /// Set when module dependencies are recorded (see setCollectDependencies()).
+  bool collectDependencies_{false};
+
+  /// If set, called with every top-level statement by parseProgram(), which
+  /// frees the statements it releases (see parseStreaming()).
+  StatementCallback statementCallback_{};
+
+  /// Set by reparse() when it did not have to parse the whole buffer.
+  bool reparsedIncrementally_{false};
+
+  /// The maximum depth of parser recursion, unless the Context sets another.
   static constexpr unsigned MAX_RECURSION_DEPTH =
 #ifdef HERMES_LIMIT_STACK_DEPTH
       128
@@ -198,6 +387,17 @@ class JSParserImpl {
 #endif
       ;
 
+  /// The maximum depth of parser recursion (see Context::setMaxParseDepth()).
+  unsigned maxRecursionDepth_{MAX_RECURSION_DEPTH};
+
+  /// The bytes of native stack the parser may use, or 0 for no limit (see
+  /// Context::setParseStackLimit()).
+  size_t stackLimit_{0};
+
+  /// The stack pointer at the outermost level of recursion, from which the
+  /// stack use is measured.
+  uintptr_t stackBase_{0};
+
   /// Set when the parser sees the 'use static builtin' directive in any scope.
   bool useStaticBuiltin_{false};
 
@@ -230,109 +430,28 @@ class JSParserImpl {
   bool allowConditionalType_{false};
 #endif
 
-  // Certain known identifiers which we need to use when constructing the
-  // ESTree or when parsing;
-  UniqueString *getIdent_;
-  UniqueString *setIdent_;
-  UniqueString *initIdent_;
-  UniqueString *useStrictIdent_;
-  UniqueString *showSourceIdent_;
-  UniqueString *hideSourceIdent_;
-  UniqueString *sensitiveIdent_;
-  UniqueString *useStaticBuiltinIdent_;
-  UniqueString *letIdent_;
-  UniqueString *ofIdent_;
-  UniqueString *fromIdent_;
-  UniqueString *asIdent_;
-  UniqueString *implementsIdent_;
-  UniqueString *interfaceIdent_;
-  UniqueString *packageIdent_;
-  UniqueString *privateIdent_;
-  UniqueString *protectedIdent_;
-  UniqueString *publicIdent_;
-  UniqueString *staticIdent_;
-  UniqueString *methodIdent_;
-  UniqueString *constructorIdent_;
-  UniqueString *yieldIdent_;
-  UniqueString *newIdent_;
-  UniqueString *importIdent_;
-  UniqueString *targetIdent_;
-  UniqueString *metaIdent_;
-  UniqueString *valueIdent_;
-  UniqueString *typeIdent_;
-  UniqueString *asyncIdent_;
-  UniqueString *awaitIdent_;
-  UniqueString *assertIdent_;
-
-#if HERMES_PARSE_FLOW
-
-  UniqueString *typeofIdent_;
-  UniqueString *keyofIdent_;
-  UniqueString *declareIdent_;
-  UniqueString *protoIdent_;
-  UniqueString *opaqueIdent_;
-  UniqueString *plusIdent_;
-  UniqueString *minusIdent_;
-  UniqueString *moduleIdent_;
-  UniqueString *exportsIdent_;
-  UniqueString *esIdent_;
-  UniqueString *commonJSIdent_;
-  UniqueString *mixinsIdent_;
-  UniqueString *thisIdent_;
-
-  UniqueString *anyIdent_;
-  UniqueString *mixedIdent_;
-  UniqueString *emptyIdent_;
-  UniqueString *booleanIdent_;
-  UniqueString *boolIdent_;
-  UniqueString *numberIdent_;
-  UniqueString *stringIdent_;
-  UniqueString *voidIdent_;
-  UniqueString *nullIdent_;
-  UniqueString *symbolIdent_;
-  UniqueString *bigintIdent_;
-
-  UniqueString *mappedTypeOptionalIdent_;
-  UniqueString *mappedTypePlusOptionalIdent_;
-  UniqueString *mappedTypeMinusOptionalIdent_;
-
-  UniqueString *checksIdent_;
-  UniqueString *assertsIdent_;
-  UniqueString *impliesIdent_;
-
-  UniqueString *componentIdent_;
-  UniqueString *hookIdent_;
-  UniqueString *rendersIdent_;
-  UniqueString *rendersMaybeOperator_;
-  UniqueString *rendersStarOperator_;
-#endif
-
-#if HERMES_PARSE_TS
-  UniqueString *readonlyIdent_;
-  UniqueString *neverIdent_;
-  UniqueString *undefinedIdent_;
-  UniqueString *unknownIdent_;
-#endif
-
-#if HERMES_PARSE_FLOW || HERMES_PARSE_TS
-  UniqueString *namespaceIdent_;
-  UniqueString *isIdent_;
-  UniqueString *inferIdent_;
-  UniqueString *constIdent_;
-#endif
-
-  /// String representation of all tokens.
-  UniqueString *tokenIdent_[NUM_JS_TOKENS];
 
   UniqueString *getTokenIdent(TokenKind kind) const {
     return tokenIdent_[(unsigned)kind];
   }
 
+  /// Count \p node in the statistics if it is new, i.e. has no location yet.
+  /// Nodes that are only moved keep their location and are counted once.
+  void countNewNode(ESTree::Node *node) {
+#if HERMES_PARSE_STATS
+    if (LLVM_UNLIKELY(stats_) && !node->getStartLoc().isValid())
+      stats_->countNode((unsigned)node->getKind());
+#else
+    (void)node;
+#endif
+  }
+
   /// Allocate an ESTree node of a certain type with supplied location and
   /// construction arguments. All nodes are allocated using the supplied
   /// allocator.
   template <class Node, class StartLoc, class EndLoc>
   Node *setLocation(StartLoc start, EndLoc end, Node *node) {
+    countNewNode(node);
     node->setStartLoc(getStartLoc(start));
     node->setEndLoc(getEndLoc(end));
     node->setDebugLoc(getStartLoc(start));
@@ -342,6 +461,7 @@ class JSParserImpl {
   /// Sets staart, end and debug lcoations of an ast node.
   template <class Node, class StartLoc, class EndLoc, class DebugLoc>
   Node *setLocation(StartLoc start, EndLoc end, DebugLoc debugLoc, Node *node) {
+    countNewNode(node);
     node->setStartLoc(getStartLoc(start));
     node->setEndLoc(getEndLoc(end));
     node->setDebugLoc(getStartLoc(debugLoc));
@@ -532,12 +652,12 @@ class JSParserImpl {
     }
 
 #if HERMES_PARSE_FLOW
-    if (context_.getParseFlow()) {
-      if (context_.getParseFlowComponentSyntax() &&
+    if (getParseFlow()) {
+      if (getParseFlowComponentSyntax() &&
           checkComponentDeclarationFlow()) {
         return true;
       }
-      if (context_.getParseFlowComponentSyntax() &&
+      if (getParseFlowComponentSyntax() &&
           checkHookDeclarationFlow()) {
         return true;
       }
@@ -559,7 +679,7 @@ class JSParserImpl {
 #endif
 
 #if HERMES_PARSE_TS
-    if (context_.getParseTS()) {
+    if (getParseTS()) {
       if (checkN(typeIdent_, interfaceIdent_, namespaceIdent_)) {
         auto optNext = lexer_.lookahead1(llvh::None);
         return optNext.hasValue() && *optNext == TokenKind::identifier;
@@ -592,6 +712,30 @@ class JSParserImpl {
     return false;
   }
 
+  /// Check whether the current token begins a statement that only declares
+  /// types, which is skipped as a whole when types are skipped.
+  bool checkTypeDeclaration() {
+#if HERMES_PARSE_FLOW
+    if (getParseFlow()) {
+      if (checkDeclareType())
+        return true;
+      if (checkN(
+              typeIdent_,
+              opaqueIdent_,
+              interfaceIdent_,
+              TokenKind::rw_interface))
+        return checkDeclaration();
+    }
+#endif
+#if HERMES_PARSE_TS
+    if (getParseTS() &&
+        checkN(typeIdent_, interfaceIdent_, TokenKind::rw_interface)) {
+      return checkDeclaration();
+    }
+#endif
+    return false;
+  }
+
   /// Check whether the current token begins a template literal.
   bool checkTemplateLiteral() const {
     return check(TokenKind::no_substitution_template, TokenKind::template_head);
@@ -629,15 +773,122 @@ class JSParserImpl {
   /// NOTE: This is intended to stay inline to avoid a function call unless the
   /// depth was actually exceeded.
   inline bool recursionDepthCheck() {
-    if (LLVM_LIKELY(recursionDepth_ < MAX_RECURSION_DEPTH)) {
+    if (LLVM_LIKELY(recursionDepth_ < maxRecursionDepth_) &&
+        LLVM_LIKELY(!stackLimit_)) {
       return false;
     }
-    return recursionDepthExceeded();
+    return recursionLimitCheck();
   }
 
+  /// The rest of recursionDepthCheck(), which also checks the stack use when
+  /// there is a stack limit. It is kept out of line so that the recursive
+  /// functions calling recursionDepthCheck() don't get larger frames.
+  bool recursionLimitCheck();
+
   /// Generate an error and return true.
   bool recursionDepthExceeded();
 
+  /// Poll the interrupt of the Context, if there is one. If it fired, report
+  /// why and make the lexer return EOF from now on.
+  /// NOTE: This is intended to stay inline to avoid a function call unless
+  /// there is an interrupt to poll.
+  /// \return true if parsing should stop.
+  inline bool interruptCheck() {
+    if (LLVM_LIKELY(interrupt_ == nullptr)) {
+      return false;
+    }
+    return pollInterrupt();
+  }
+
+  /// Poll interrupt_ and, if it fired, stop the lexer and return true.
+  bool pollInterrupt();
+
+  /// \return true if the type that starts at the current token should be
+  ///   skipped with skipType() rather than added to the AST.
+  bool shouldSkipType() const {
+    return skipTypes_;
+  }
+
+  /// Parse a type with \p parse, which is called with skipping disabled, and
+  /// leave it out of the AST. The nodes it allocates are freed, and the range
+  /// from \p start to the end of the previous token is recorded in the lexer.
+  /// \return nullptr, or None if \p parse failed.
+  template <typename ParseFn>
+  Optional<ESTree::Node *>
+  skipType(SMLoc start, SkippedType::Kind kind, ParseFn parse) {
+    assert(skipTypes_ && "types are not being skipped");
+    llvh::SaveAndRestore<bool> saveSkipTypes(skipTypes_, false);
+    context_.getAllocator().pushScope();
+    bool parsed = parse().hasValue();
+    lexer_.popAllocationScope();
+    if (!parsed)
+      return None;
+    lexer_.storeSkippedType(kind, SMRange{start, getPrevTokenEndLoc()});
+    return nullptr;
+  }
+
+  /// If types are skipped, record \p range, which only means something to the
+  /// type checker, as a skipped modifier.
+  void skipTypeModifier(SMRange range) {
+    if (LLVM_UNLIKELY(shouldSkipType()))
+      lexer_.storeSkippedType(SkippedType::Kind::Modifier, range);
+  }
+
+  /// If dependencies are collected and \p source, the argument of `import()`
+  /// or `require()`, is a string literal, record it as a dependency of
+  /// \p kind.
+  void storeDependency(ModuleDependency::Kind kind, ESTree::Node *source) {
+    if (LLVM_LIKELY(!collectDependencies_))
+      return;
+    if (auto *str = llvh::dyn_cast<ESTree::StringLiteralNode>(source))
+      lexer_.storeDependency(kind, false, str->_value, str->getSourceRange());
+  }
+
+  /// Record the module that \p decl, an import or export declaration,
+  /// depends on, if any.
+  void storeDependencies(const ESTree::Node *decl);
+
+  /// Find the dependencies of the program, as described in
+  /// scanDependencies().
+  /// \return false if the program needs to be parsed instead.
+  bool scanDependencySource();
+
+  /// Parse an import or export declaration with \p parse. If dependencies
+  /// are collected, record the module it depends on. If types are
+  /// skipped and the declaration only imports or exports types, it is freed
+  /// and recorded as a skipped declaration instead.
+  /// \return the declaration, nullptr if it was skipped, or None if \p parse
+  ///   failed.
+  template <typename ParseFn>
+  Optional<ESTree::Node *> parseImportExport(ParseFn parse) {
+    if (LLVM_LIKELY(!shouldSkipType())) {
+      Optional<ESTree::Node *> optDecl = parse();
+      if (optDecl && LLVM_UNLIKELY(collectDependencies_))
+        storeDependencies(*optDecl);
+      return optDecl;
+    }
+    SMLoc start = tok_->getStartLoc();
+    size_t numSkipped = lexer_.getSkippedTypes().size();
+    context_.getAllocator().pushScope();
+    Optional<ESTree::Node *> optDecl = parse();
+    if (optDecl && LLVM_UNLIKELY(collectDependencies_))
+      storeDependencies(*optDecl);
+    if (!optDecl || !isTypeOnlyImportExport(*optDecl)) {
+      context_.getAllocator().commitScope();
+      return optDecl;
+    }
+    lexer_.popAllocationScope();
+    // The types skipped inside the declaration are part of it.
+    lexer_.truncateSkippedTypes(numSkipped);
+    lexer_.storeSkippedType(
+        SkippedType::Kind::Declaration, SMRange{start, getPrevTokenEndLoc()});
+    return nullptr;
+  }
+
+  /// \return whether \p decl, an import or export declaration, only imports
+  ///   or exports types.
+  bool isTypeOnlyImportExport(const ESTree::Node *decl) const;
+
   // Parser functions. All of these correspond more or less directly to grammar
   // productions, except in cases where the grammar is ambiguous, but even then
   // the name should be self-explanatory.
@@ -695,6 +946,26 @@ class JSParserImpl {
       AllowImportExport allowImportExport,
       ESTree::NodeList &stmtList);
 
+  /// Parse the statements around \p edit again, in the innermost statement
+  /// list of \p program that can be resumed at a statement before the edit,
+  /// and splice them into \p program if they end where the old ones did.
+  /// \return false, with \p program unchanged, if the statements could not be
+  ///   parsed on their own.
+  bool reparseStatementsAroundEdit(
+      ESTree::ProgramNode *program,
+      llvh::StringRef oldSource,
+      const SourceEdit &edit,
+      llvh::ArrayRef<SkippedType> oldSkippedTypes);
+
+  /// Parse the statements of the program into \p stmtList, passing each to
+  /// statementCallback_ and parsing it in its own allocation scope, which is
+  /// popped if the callback releases the statement.
+  /// \param[out] endLoc set to the end of the last statement, kept or not.
+  /// \return a dummy value for consistency.
+  Optional<bool> parseStreamingStatementList(
+      ESTree::NodeList &stmtList,
+      SMLoc &endLoc);
+
   /// Parse a statement block.
   /// \param param [Yield, Return]
   /// \param grammarContext context to be used when consuming the closing brace.
@@ -903,6 +1174,8 @@ class JSParserImpl {
   Optional<ESTree::Node *> parseLeftHandSideExpression();
   Optional<ESTree::Node *> parsePostfixExpression();
   Optional<ESTree::Node *> parseUnaryExpression();
+  /// Parse a UnaryExpression that starts with a prefix operator.
+  Optional<ESTree::Node *> parseUnaryOperators();
 
   /// Convert identifiers to the operator they represent.
   /// Called after each parseUnaryExpression to change identifiers that might be
@@ -912,6 +1185,14 @@ class JSParserImpl {
   /// Parse a binary expression using a precedence table, in order to decrease
   /// recursion depth.
   Optional<ESTree::Node *> parseBinaryExpression(Param param);
+  /// Parse the rest of a binary expression, whose first operand \p topExpr,
+  /// starting at \p topExprStartLoc, has been parsed and is followed by a
+  /// binary operator. If \p topExpr is nullptr, the first operand is a
+  /// private name, which is parsed here.
+  Optional<ESTree::Node *> parseBinaryExpressionRest(
+      Param param,
+      SMLoc topExprStartLoc,
+      ESTree::Node *topExpr);
 
   /// Whether to allow a typed arrow function in the assignment expression.
   enum class AllowTypedArrowFunction { No, Yes };
@@ -923,6 +1204,13 @@ class JSParserImpl {
   Optional<ESTree::Node *> parseConditionalExpression(
       Param param = ParamIn,
       CoverTypedParameters coverTypedParameters = CoverTypedParameters::Yes);
+  /// Parse the rest of a ConditionalExpression, from the '?' that follows
+  /// \p test, which starts at \p startLoc.
+  Optional<ESTree::Node *> parseConditionalExpressionRest(
+      Param param,
+      CoverTypedParameters coverTypedParameters,
+      SMLoc startLoc,
+      ESTree::Node *test);
   Optional<ESTree::YieldExpressionNode *> parseYieldExpression(
       Param param = ParamIn);
 
@@ -1017,6 +1305,22 @@ class JSParserImpl {
       ESTree::Node *node,
       bool inDecl);
 
+  /// The start of an AssignmentExpression, parsed by
+  /// parseConditionalExpression() as the test of a ConditionalExpression that
+  /// it turned out not to be.
+  struct ParsedConditionalTest {
+    SMLoc startLoc;
+    /// Whether there was a newline before the first token.
+    bool hasNewLine;
+    ESTree::Node *test;
+  };
+
+  /// If set, the start of the next AssignmentExpression, which has already
+  /// been parsed. It is passed this way rather than as a parameter so that
+  /// the many callers of parseAssignmentExpression() don't need larger stack
+  /// frames.
+  const ParsedConditionalTest *parsedConditionalTest_{nullptr};
+
   Optional<ESTree::Node *> parseAssignmentExpression(
       Param param = ParamIn,
       AllowTypedArrowFunction allowTypedArrowFunction =
@@ -1097,9 +1401,9 @@ class JSParserImpl {
       Optional<SMLoc> wrappedStart = None,
       AllowAnonFunctionType allowAnonFunctionType =
           AllowAnonFunctionType::Yes) {
-    assert(context_.getParseFlow() || context_.getParseTS());
+    assert(getParseFlow() || getParseTS());
 #if HERMES_PARSE_FLOW
-    if (context_.getParseFlow())
+    if (getParseFlow())
       return parseTypeAnnotationFlow(wrappedStart, allowAnonFunctionType);
 #endif
 #if HERMES_PARSE_TS
@@ -1111,9 +1415,9 @@ class JSParserImpl {
       Optional<SMLoc> wrappedStart = None,
       AllowAnonFunctionType allowAnonFunctionType =
           AllowAnonFunctionType::Yes) {
-    assert(context_.getParseFlow() || context_.getParseTS());
+    assert(getParseFlow() || getParseTS());
 #if HERMES_PARSE_FLOW
-    if (context_.getParseFlow())
+    if (getParseFlow())
       return parseReturnTypeAnnotationFlow(wrappedStart, allowAnonFunctionType);
 #endif
 #if HERMES_PARSE_TS
@@ -1329,7 +1633,10 @@ class JSParserImpl {
   Optional<ESTree::FunctionTypeAnnotationNode *>
   parseMethodishTypeAnnotationFlow(SMLoc start, ESTree::Node *typeParams);
 
-  Optional<ESTree::Node *> parsePredicateFlow();
+  /// \param colonStart if the predicate is the whole annotation, the start
+  ///   of the colon before it, which is skipped with it.
+  Optional<ESTree::Node *> parsePredicateFlow(
+      Optional<SMLoc> colonStart = None);
 
   /// Process a TypeAnnotation node and validate it matches the parsing rules
   /// for an identifier.
@@ -1481,12 +1788,43 @@ class JSParserImpl {
    public:
     TrackRecursion(JSParserImpl *parser) : parser_(parser) {
       ++parser_->recursionDepth_;
+#if HERMES_PARSE_STATS
+      if (LLVM_UNLIKELY(parser_->stats_) &&
+          parser_->recursionDepth_ > parser_->stats_->maxRecursionDepth)
+        parser_->stats_->maxRecursionDepth = parser_->recursionDepth_;
+#endif
     }
     ~TrackRecursion() {
       --parser_->recursionDepth_;
     }
   };
 
+  /// A JSLexer::SavePoint for a speculative parse, which also frees the nodes
+  /// allocated after it when it is restored. The nodes allocated since the
+  /// last restore() are kept when it is destroyed. Nothing allocated after
+  /// it may be used once it is restored.
+  class SpeculationPoint {
+    JSParserImpl *const parser_;
+    JSLexer::SavePoint savePoint_;
+
+   public:
+    explicit SpeculationPoint(JSParserImpl *parser)
+        : parser_(parser), savePoint_(&parser->lexer_) {
+      parser_->context_.getAllocator().pushScope();
+    }
+    ~SpeculationPoint() {
+      parser_->context_.getAllocator().commitScope();
+    }
+
+    /// Restore the lexer to the save point and free the nodes allocated
+    /// since then.
+    void restore() {
+      savePoint_.restore();
+      parser_->lexer_.popAllocationScope();
+      parser_->context_.getAllocator().pushScope();
+    }
+  };
+
 /// Declare a RAII recursion tracker. Check whether the recursion limit has
 /// been exceeded, and if so generate an error and return an empty
 /// llvh::Optional<>.
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Parser/SourceDialect.h"
+
+#include "hermes/AST/Context.h"
+#include "hermes/Parser/DocBlock.h"
+#include "llvh/ADT/StringExtras.h"
+#include "llvh/Support/ErrorHandling.h"
+#include "llvh/Support/MathExtras.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HERMES_DIALECT_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define HERMES_DIALECT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace hermes {
+namespace parser {
+
+namespace {
+
+/// \return a mask of the offsets i of the 16 bytes at \p p for which
+///   p[i] == a and p[i + 1] == b. 17 bytes must be readable at \p p.
+inline unsigned pairMask16(const char *p, char a, char b) {
+#if defined(HERMES_DIALECT_SSE2)
+  __m128i first = _mm_loadu_si128((const __m128i *)p);
+  __m128i second = _mm_loadu_si128((const __m128i *)(p + 1));
+  return (unsigned)_mm_movemask_epi8(_mm_and_si128(
+      _mm_cmpeq_epi8(first, _mm_set1_epi8(a)),
+      _mm_cmpeq_epi8(second, _mm_set1_epi8(b))));
+#elif defined(HERMES_DIALECT_NEON)
+  static const uint8_t kBits[16] = {
+      1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t first = vld1q_u8((const uint8_t *)p);
+  uint8x16_t second = vld1q_u8((const uint8_t *)p + 1);
+  uint8x16_t both = vandq_u8(
+      vceqq_u8(first, vdupq_n_u8((uint8_t)a)),
+      vceqq_u8(second, vdupq_n_u8((uint8_t)b)));
+  uint8x16_t masked = vandq_u8(both, vld1q_u8(kBits));
+  return (unsigned)vaddv_u8(vget_low_u8(masked)) |
+      ((unsigned)vaddv_u8(vget_high_u8(masked)) << 8);
+#else
+  unsigned mask = 0;
+  for (unsigned i = 0; i != 16; ++i)
+    mask |= (unsigned)(p[i] == a && p[i + 1] == b) << i;
+  return mask;
+#endif
+}
+
+/// Call \p found with the offset of every \p a followed by \p b in \p text,
+/// in order, until it returns true.
+/// \return whether \p found returned true.
+template <typename Fn>
+bool findPair(llvh::StringRef text, char a, char b, Fn found) {
+  const char *p = text.data();
+  size_t size = text.size();
+  size_t i = 0;
+  for (; i + 17 <= size; i += 16) {
+    for (unsigned mask = pairMask16(p + i, a, b); mask; mask &= mask - 1) {
+      if (found(i + llvh::countTrailingZeros(mask)))
+        return true;
+    }
+  }
+  for (; i + 1 < size; ++i) {
+    if (p[i] == a && p[i + 1] == b && found(i))
+      return true;
+  }
+  return false;
+}
+
+/// \return whether \p source may contain JSX: every element has a closing
+///   tag or is self-closing, and so contains "</" or "/>".
+bool mayContainJSX(llvh::StringRef source) {
+  auto any = [](size_t) { return true; };
+  return findPair(source, '<', '/', any) || findPair(source, '/', '>', any);
+}
+
+/// \return whether \p source contains syntax that only TypeScript has, as far
+///   as a search for words can tell.
+bool mayContainTS(llvh::StringRef source) {
+  static const llvh::StringLiteral kMarkers[] = {
+      ": string",
+      ": number",
+      ": boolean",
+      " satisfies ",
+      " as const",
+      "abstract class ",
+      "readonly ",
+  };
+  for (llvh::StringRef marker : kMarkers) {
+    if (findPair(source, marker[0], marker[1], [&](size_t offset) {
+          return source.substr(offset).startswith(marker) &&
+              (offset == 0 || marker[0] == ' ' || marker[0] == ':' ||
+               !(llvh::isAlnum(source[offset - 1]) ||
+                 source[offset - 1] == '_' || source[offset - 1] == '$'));
+        }))
+      return true;
+  }
+  return false;
+}
+
+} // namespace
+
+const char *sourceDialectName(SourceDialect dialect) {
+  switch (dialect) {
+    case SourceDialect::JS:
+      return "js";
+    case SourceDialect::JSX:
+      return "jsx";
+    case SourceDialect::Flow:
+      return "flow";
+    case SourceDialect::FlowJSX:
+      return "flow-jsx";
+    case SourceDialect::TS:
+      return "ts";
+    case SourceDialect::TSX:
+      return "tsx";
+  }
+  llvm_unreachable("invalid SourceDialect");
+}
+
+SourceDialect detectSourceDialect(Context &context, uint32_t bufferId) {
+  SourceErrorManager &sm = context.getSourceErrorManager();
+  return detectSourceDialect(
+      sm.getBufferFileName(bufferId),
+      sm.getSourceBuffer(bufferId)->getBuffer());
+}
+
+SourceDialect detectSourceDialect(
+    llvh::StringRef name,
+    llvh::StringRef source) {
+  if (name.endswith(".tsx"))
+    return SourceDialect::TSX;
+  if (name.endswith(".ts") || name.endswith(".mts") || name.endswith(".cts"))
+    return SourceDialect::TS;
+
+  bool jsx = name.endswith(".jsx") || mayContainJSX(source);
+  if (name.endswith(".flow") ||
+      scanDocBlock(source).hasPragma(DocBlockFlow))
+    return jsx ? SourceDialect::FlowJSX : SourceDialect::Flow;
+
+  bool javaScriptName = name.endswith(".js") || name.endswith(".mjs") ||
+      name.endswith(".cjs") || name.endswith(".jsx");
+  if (!javaScriptName && mayContainTS(source))
+    return jsx ? SourceDialect::TSX : SourceDialect::TS;
+  return jsx ? SourceDialect::JSX : SourceDialect::JS;
+}
+
+void applySourceDialect(Context &context, SourceDialect dialect) {
+  context.setParseJSX(
+      dialect == SourceDialect::JSX || dialect == SourceDialect::FlowJSX ||
+      dialect == SourceDialect::TSX);
+  context.setParseFlow(
+      dialect == SourceDialect::Flow || dialect == SourceDialect::FlowJSX
+          ? ParseFlowSetting::ALL
+          : ParseFlowSetting::NONE);
+  context.setParseTS(
+      dialect == SourceDialect::TS || dialect == SourceDialect::TSX);
+}
+
+} // namespace parser
+} // namespace hermes
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Parser/TypeStripper.h"
+
+#include "hermes/AST/Context.h"
+#include "hermes/Parser/JSParser.h"
+#include "hermes/Support/Allocator.h"
+#include "hermes/Support/JSONEmitter.h"
+#include "hermes/Support/SourceErrorManager.h"
+
+#include "llvh/ADT/Optional.h"
+#include "llvh/Support/raw_ostream.h"
+
+#include <algorithm>
+
+namespace hermes {
+namespace parser {
+
+namespace {
+
+/// \return whether \p c can be part of an identifier, keyword or number.
+bool isWordChar(unsigned char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+      (c >= '0' && c <= '9') || c == '_' || c == '$' || c == '\\' || c >= 0x80;
+}
+
+/// \return whether \p left directly followed by \p right would be read as a
+/// single token or as the start of a comment, rather than as two tokens.
+bool wouldJoin(char left, char right) {
+  if (isWordChar(left) && isWordChar(right))
+    return true;
+  if ((left == '+' || left == '-') && right == left)
+    return true;
+  return left == '/' && (right == '/' || right == '*');
+}
+
+/// \return whether a statement starting with \p c continues the statement
+/// before it if only a line break separates them.
+bool continuesStatement(char c) {
+  return c == '(' || c == '[' || c == '`' || c == '+' || c == '-' || c == '/';
+}
+
+bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/// A line and column, in UTF-16 code units as source maps count them.
+struct Position {
+  uint32_t line = 0;
+  uint32_t column = 0;
+
+  /// Move past the byte \p c of UTF-8 text.
+  void advance(unsigned char c) {
+    if (c == '\n') {
+      ++line;
+      column = 0;
+    } else if ((c & 0xC0) != 0x80) {
+      // Code points that take four bytes take two UTF-16 code units.
+      column += c >= 0xF0 ? 2 : 1;
+    }
+  }
+};
+
+/// Appends segments to the "mappings" field of a source map with one source.
+class MappingsEncoder {
+ public:
+  explicit MappingsEncoder(std::string &out) : out_(out) {}
+
+  /// Map \p generated in the output to \p original in the source. Segments
+  /// must be added in output order.
+  void addSegment(Position generated, Position original) {
+    assert(generated.line >= line_ && "segments out of order");
+    if (generated.line != line_) {
+      out_.append(generated.line - line_, ';');
+      line_ = generated.line;
+      column_ = 0;
+    } else if (!out_.empty() && out_.back() != ';') {
+      out_ += ',';
+    }
+    encode((int64_t)generated.column - column_);
+    encode(0);
+    encode((int64_t)original.line - originalLine_);
+    encode((int64_t)original.column - originalColumn_);
+    column_ = generated.column;
+    originalLine_ = original.line;
+    originalColumn_ = original.column;
+  }
+
+ private:
+  /// Append \p value as a base64 VLQ.
+  void encode(int64_t value) {
+    static const char kDigits[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    uint64_t vlq =
+        value < 0 ? ((uint64_t)-value << 1) | 1 : (uint64_t)value << 1;
+    do {
+      unsigned digit = vlq & 31;
+      vlq >>= 5;
+      if (vlq)
+        digit |= 32;
+      out_ += kDigits[digit];
+    } while (vlq);
+  }
+
+  std::string &out_;
+  uint32_t line_ = 0;
+  uint32_t column_ = 0;
+  uint32_t originalLine_ = 0;
+  uint32_t originalColumn_ = 0;
+};
+
+/// Copies a source to the output, and replaces the types in it, in a single
+/// forward pass.
+class Writer {
+ public:
+  /// \param mappings where to build a source map, or nullptr.
+  Writer(llvh::StringRef source, std::string &output, std::string *mappings)
+      : pos_(source.begin()), end_(source.end()), output_(output) {
+    if (mappings)
+      mappings_.emplace(*mappings);
+  }
+
+  /// \return the first byte of the source that has not been written.
+  const char *getPos() const {
+    return pos_;
+  }
+
+  /// Copy the source up to \p to.
+  void copyTo(const char *to) {
+    if (!mappings_) {
+      output_.append(pos_, to);
+      pos_ = to;
+      return;
+    }
+    // Map the start of the copy, and the start of every line in it.
+    bool lineStart = true;
+    for (; pos_ != to; ++pos_) {
+      if (lineStart)
+        mappings_->addSegment(generated_, original_);
+      original_.advance(*pos_);
+      put(*pos_);
+      lineStart = *pos_ == '\n';
+    }
+  }
+
+  /// Replace the source up to \p to, which holds a type of \p kind.
+  void skipTo(const char *to, SkippedType::Kind kind, StripMode mode) {
+    // With a type declaration gone, the statement after it might continue
+    // the one before it, so end that one explicitly.
+    bool terminate =
+        kind == SkippedType::Kind::Declaration && needsTerminator(to);
+    if (terminate)
+      put(';');
+    // In Blank mode, the ';' takes the place of the first character.
+    bool replaced = terminate;
+    bool lineBreak = false;
+    for (; pos_ != to; ++pos_) {
+      unsigned char c = *pos_;
+      if (mappings_)
+        original_.advance(c);
+      if (c == '\n' || c == '\r') {
+        put(c);
+        lineBreak = true;
+      } else if (mode == StripMode::Blank && (c & 0xC0) != 0x80) {
+        if (!replaced)
+          put(' ');
+        replaced = false;
+        if (c >= 0xF0)
+          put(' ');
+      }
+    }
+    if (mode == StripMode::Remove && !lineBreak && !output_.empty() &&
+        pos_ != end_ && wouldJoin(output_.back(), *pos_)) {
+      put(' ');
+    }
+  }
+
+ private:
+  /// \return whether a ';' is needed in place of a declaration that ends at
+  ///   \p to.
+  bool needsTerminator(const char *to) const {
+    auto last = std::find_if_not(output_.rbegin(), output_.rend(), isSpace);
+    if (last == output_.rend() || *last == ';' || *last == '{')
+      return false;
+    const char *next = std::find_if_not(to, end_, isSpace);
+    return next != end_ && continuesStatement(*next);
+  }
+
+  void put(char c) {
+    output_ += c;
+    if (mappings_)
+      generated_.advance(c);
+  }
+
+  const char *pos_;
+  const char *const end_;
+  std::string &output_;
+  llvh::Optional<MappingsEncoder> mappings_{};
+  /// The position of pos_ in the source, and of the end of the output. Only
+  /// tracked for the source map.
+  Position original_{};
+  Position generated_{};
+};
+
+} // namespace
+
+bool TypeStripper::strip(Context &context, uint32_t bufferId) {
+  output_.clear();
+  mappings_.clear();
+
+  SourceErrorManager &sm = context.getSourceErrorManager();
+  unsigned errorsBefore = sm.getErrorCount();
+  TypeSyntaxSetting typeSyntax = context.getTypeSyntax();
+  context.setTypeSyntax(TypeSyntaxSetting::SKIP);
+  bool parsed;
+  std::vector<SkippedType> skipped;
+  {
+    // Only the skipped ranges are needed, so free the AST right away.
+    AllocationScope scope{context.getAllocator()};
+    JSParser parser{context, bufferId, FullParse};
+    parsed = parser.parse().hasValue();
+    skipped = parser.moveSkippedTypes();
+  }
+  context.setTypeSyntax(typeSyntax);
+  if (!parsed || sm.getErrorCount() != errorsBefore)
+    return false;
+
+  strip(sm.getSourceBuffer(bufferId)->getBuffer(), skipped);
+  return true;
+}
+
+void TypeStripper::strip(
+    llvh::StringRef source,
+    llvh::ArrayRef<SkippedType> skipped) {
+  output_.clear();
+  mappings_.clear();
+  output_.reserve(source.size());
+
+  Writer writer{source, output_, buildSourceMap_ ? &mappings_ : nullptr};
+  for (const SkippedType &type : skipped) {
+    const char *start = type.getSourceRange().Start.getPointer();
+    const char *end = type.getSourceRange().End.getPointer();
+    assert(
+        source.begin() <= start && start <= end && end <= source.end() &&
+        "skipped type outside of the source");
+    // Skipped types do not overlap, but make sure the pass stays forward.
+    if (end <= writer.getPos())
+      continue;
+    writer.copyTo(std::max(start, writer.getPos()));
+    writer.skipTo(end, type.getKind(), mode_);
+  }
+  writer.copyTo(source.end());
+}
+
+std::string TypeStripper::getSourceMap(llvh::StringRef sourceName) const {
+  std::string result{};
+  if (!buildSourceMap_)
+    return result;
+
+  llvh::raw_string_ostream os{result};
+  JSONEmitter json{os};
+  json.openDict();
+  json.emitKeyValue("version", 3);
+  json.emitKey("sources");
+  json.openArray();
+  json.emitValue(sourceName);
+  json.closeArray();
+  json.emitKey("names");
+  json.openArray();
+  json.closeArray();
+  json.emitKeyValue("mappings", llvh::StringRef(mappings_));
+  json.closeDict();
+  os.flush();
+  return result;
+}
+
+} // namespace parser
+} // namespace hermes
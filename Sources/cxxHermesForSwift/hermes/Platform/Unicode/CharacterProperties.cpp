@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Platform/Unicode/CharacterProperties.h"
+
+#include "llvh/ADT/ArrayRef.h"
+
+#include <algorithm>
+
+namespace hermes {
+
+namespace {
+
+/// An inclusive range of code points.
+struct UnicodeRange {
+  uint32_t first;
+  uint32_t last;
+};
+
+#include "hermes/Platform/Unicode/UnicodeData.inc"
+
+/// \return whether \p cp is in one of the sorted, disjoint \p ranges.
+bool lookup(llvh::ArrayRef<UnicodeRange> ranges, uint32_t cp) {
+  auto it = std::lower_bound(
+      ranges.begin(), ranges.end(), cp, [](const UnicodeRange &r, uint32_t cp) {
+        return r.last < cp;
+      });
+  return it != ranges.end() && it->first <= cp;
+}
+
+} // namespace
+
+bool isUnicodeOnlyLetter(uint32_t cp) {
+  return cp > 127 && lookup(UNICODE_LETTERS, cp);
+}
+
+bool isUnicodeOnlySpace(uint32_t cp) {
+  return cp > 127 && lookup(UNICODE_SPACES, cp);
+}
+
+bool isUnicodeCombiningMark(uint32_t cp) {
+  return lookup(UNICODE_COMBINING_MARK, cp);
+}
+
+bool isUnicodeDigit(uint32_t cp) {
+  return lookup(UNICODE_DIGIT, cp);
+}
+
+bool isUnicodeConnectorPunctuation(uint32_t cp) {
+  return lookup(UNICODE_CONNECTOR_PUNCTUATION, cp);
+}
+
+} // namespace hermes
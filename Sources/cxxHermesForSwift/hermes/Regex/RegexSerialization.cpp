@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Regex/RegexSerialization.h"
+
+// The regexp compiler is not vendored: the parser never validates regexp
+// literals, so only the members needed by AST::Context are defined here.
+
+namespace hermes {
+
+CompiledRegExp::CompiledRegExp(
+    std::vector<uint8_t> bytecode,
+    std::string pattern,
+    std::string flags,
+    std::deque<llvh::SmallVector<char16_t, 5>> &&orderedGroupNames,
+    regex::ParsedGroupNamesMapping &&mapping)
+    : bytecode_(std::move(bytecode)),
+      pattern_(std::move(pattern)),
+      flags_(std::move(flags)),
+      orderedGroupNames_(std::move(orderedGroupNames)),
+      mapping_(std::move(mapping)) {}
+
+CompiledRegExp::~CompiledRegExp() = default;
+CompiledRegExp::CompiledRegExp(CompiledRegExp &&) = default;
+CompiledRegExp &CompiledRegExp::operator=(CompiledRegExp &&) = default;
+
+llvh::ArrayRef<uint8_t> CompiledRegExp::getBytecode() const {
+  return bytecode_;
+}
+
+} // namespace hermes
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/Allocator.h"
+
+namespace hermes {
+
+void *BacktrackingBumpPtrAllocator::allocateNewSlab(
+    size_t size,
+    size_t alignment) {
+  if (size > SlabSize)
+    return allocateHuge(size);
+
+  state_->slab++;
+  state_->offset = 0;
+  if (state_->slab >= slabs_.size())
+    slabs_.push_back(std::make_unique<Slab>());
+
+  // Allocate at the start of the new slab. Allocate() has already counted
+  // the request, so it is not called again.
+  auto currentSlab =
+      reinterpret_cast<uintptr_t>(&slabs_[state_->slab].get()->data);
+  uintptr_t offset = alignOffset(currentSlab, 0, alignment);
+  assert(offset + size <= SlabSize && "alignment too large for a slab");
+  bytesWasted_ += offset;
+  state_->offset = offset + size;
+  return (void *)(currentSlab + offset);
+}
+
+} // namespace hermes
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/Conversions.h"
+
+#include "dtoa/dtoa.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace hermes {
+
+size_t numberToString(double m, char *dest, size_t destSize) {
+  assert(destSize >= NUMBER_TO_STRING_BUF_SIZE && "buffer is too small");
+  (void)destSize;
+
+  if (std::isnan(m)) {
+    strcpy(dest, "NaN");
+    return 3;
+  }
+  if (m == 0) {
+    // Both +0 and -0 print as "0".
+    strcpy(dest, "0");
+    return 1;
+  }
+  if (std::isinf(m)) {
+    strcpy(dest, m > 0 ? "Infinity" : "-Infinity");
+    return m > 0 ? 8 : 9;
+  }
+
+  // ES5.1 9.8.1: s is the shortest digit string that rounds back to m, k is
+  // its length, and n is the position of the decimal point.
+  DECL_DTOA_ALLOC_MEM(mem, DTOA_ALLOC_DEFAULT_SIZE);
+  dtoa_alloc *dalloc = dtoa_alloc_init(&mem, DTOA_ALLOC_DEFAULT_SIZE);
+  int n, sign;
+  char *sEnd;
+  char *s = g_dtoa(dalloc, m, 0, 0, &n, &sign, &sEnd);
+  const int k = sEnd - s;
+
+  char *d = dest;
+  if (sign)
+    *d++ = '-';
+
+  if (k <= n && n <= 21) {
+    // The digits, followed by n-k zeros.
+    memcpy(d, s, k);
+    d += k;
+    memset(d, '0', n - k);
+    d += n - k;
+  } else if (0 < n && n <= 21) {
+    // The first n digits, a dot and the remaining k-n digits.
+    memcpy(d, s, n);
+    d += n;
+    *d++ = '.';
+    memcpy(d, s + n, k - n);
+    d += k - n;
+  } else if (-6 < n && n <= 0) {
+    // "0.", -n zeros and the digits.
+    *d++ = '0';
+    *d++ = '.';
+    memset(d, '0', -n);
+    d += -n;
+    memcpy(d, s, k);
+    d += k;
+  } else {
+    // Exponential notation.
+    *d++ = s[0];
+    if (k > 1) {
+      *d++ = '.';
+      memcpy(d, s + 1, k - 1);
+      d += k - 1;
+    }
+    *d++ = 'e';
+    int e = n - 1;
+    *d++ = e < 0 ? '-' : '+';
+    d += sprintf(d, "%d", e < 0 ? -e : e);
+  }
+  *d = 0;
+
+  g_freedtoa(dalloc, s);
+  dtoa_alloc_done(dalloc);
+  return d - dest;
+}
+
+} // namespace hermes
+
+extern "C" size_t
+hermes_numberToString(double m, char *dest, size_t destSize) {
+  return hermes::numberToString(m, dest, destSize);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/ErrorHandling.h"
+
+#include "llvh/ADT/Twine.h"
+
+namespace hermes {
+
+namespace {
+
+class OOMErrorCategory final : public std::error_category {
+ public:
+  const char *name() const noexcept override {
+    return "vm_allocate_category";
+  }
+
+  std::string message(int condition) const override {
+    switch (static_cast<OOMError>(condition)) {
+      case OOMError::None:
+        return "None";
+      case OOMError::MaxHeapReached:
+        return "Max heap size was exceeded";
+      case OOMError::MaxStorageReached:
+        return "Max storage size was exceeded";
+      case OOMError::Effective:
+        return "Effective OOM";
+      case OOMError::SuperSegmentAlloc:
+        return "Allocation larger than segment size";
+      case OOMError::CopyableVectorCapacityIntegerOverflow:
+        return "CopyableVector capacity overflow";
+      case OOMError::TestVMLimitReached:
+        return "Test VM limit reached";
+    }
+    return "Unknown OOM error";
+  }
+};
+
+} // namespace
+
+const std::error_category &oom_category() {
+  static OOMErrorCategory category;
+  return category;
+}
+
+std::error_code make_error_code(OOMError err) {
+  return std::error_code(static_cast<int>(err), oom_category());
+}
+
+std::string convert_error_to_message(std::error_code code) {
+  return code.category().name() + std::string(": ") + code.message();
+}
+
+void hermes_fatal(const char *msg) {
+  llvh::report_fatal_error(msg, /* gen_crash_diag */ false);
+}
+
+void hermes_fatal(const std::string &msg) {
+  hermes_fatal(msg.c_str());
+}
+
+void hermes_fatal(llvh::StringRef prefix, std::error_code code) {
+  std::string message = prefix.str() + ": " + convert_error_to_message(code);
+  hermes_fatal(message);
+}
+
+} // namespace hermes
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/JSONEmitter.h"
+
+#include "hermes/Support/Conversions.h"
+#include "hermes/Support/ErrorHandling.h"
+#include "hermes/Support/UTF8.h"
+
+#include "llvh/Support/Format.h"
+
+#include <cmath>
+
+namespace hermes {
+
+JSONEmitter::JSONEmitter(JSONEmitter &&) = default;
+
+void JSONEmitter::emitValue(bool val) {
+  willEmitValue();
+  OS << (val ? "true" : "false");
+}
+
+void JSONEmitter::emitValue(short val) {
+  willEmitValue();
+  OS << val;
+}
+
+void JSONEmitter::emitValue(int val) {
+  willEmitValue();
+  OS << val;
+}
+
+void JSONEmitter::emitValue(long val) {
+  willEmitValue();
+  OS << val;
+}
+
+void JSONEmitter::emitValue(long long val) {
+  willEmitValue();
+  OS << val;
+}
+
+void JSONEmitter::emitValue(unsigned short val) {
+  willEmitValue();
+  OS << val;
+}
+
+void JSONEmitter::emitValue(unsigned int val) {
+  willEmitValue();
+  OS << val;
+}
+
+void JSONEmitter::emitValue(unsigned long val) {
+  willEmitValue();
+  OS << val;
+}
+
+void JSONEmitter::emitValue(unsigned long long val) {
+  willEmitValue();
+  OS << val;
+}
+
+void JSONEmitter::emitValue(double val) {
+  willEmitValue();
+  if (!std::isfinite(val)) {
+    OS << "null";
+    return;
+  }
+  char buf[NUMBER_TO_STRING_BUF_SIZE];
+  size_t len = numberToString(val, buf, sizeof(buf));
+  OS << llvh::StringRef(buf, len);
+}
+
+void JSONEmitter::emitValue(llvh::StringRef val) {
+  willEmitValue();
+  primitiveEmitString(val);
+}
+
+void JSONEmitter::emitNullValue() {
+  willEmitValue();
+  OS << "null";
+}
+
+void JSONEmitter::emitKey(llvh::StringRef key) {
+  assert(inDict() && "Not emitting a dictionary");
+  State &state = states_.back();
+  assert(state.needsKey && "Not expecting a key");
+  if (state.needsComma)
+    OS << ',';
+  prettyNewLine();
+  primitiveEmitString(key);
+  OS << (pretty_ ? ": " : ":");
+  state.needsKey = false;
+  state.needsValue = true;
+  state.needsComma = false;
+  state.isEmpty = false;
+}
+
+void JSONEmitter::openDict() {
+  willEmitValue();
+  states_.push_back(State::Dict);
+  OS << '{';
+  indentMore();
+}
+
+void JSONEmitter::closeDict() {
+  assert(inDict() && "Not emitting a dictionary");
+  assert(!states_.back().needsValue && "Dictionary key has no value");
+  bool isEmpty = states_.back().isEmpty;
+  states_.pop_back();
+  indentLess();
+  if (!isEmpty)
+    prettyNewLine();
+  OS << '}';
+}
+
+void JSONEmitter::openArray() {
+  willEmitValue();
+  states_.push_back(State::Array);
+  OS << '[';
+  indentMore();
+}
+
+void JSONEmitter::closeArray() {
+  assert(inArray() && "Not emitting an array");
+  bool isEmpty = states_.back().isEmpty;
+  states_.pop_back();
+  indentLess();
+  if (!isEmpty)
+    prettyNewLine();
+  OS << ']';
+}
+
+void JSONEmitter::endJSONL() {
+  assert(states_.empty() && "JSON Lines record is not complete");
+  OS << '\n';
+}
+
+void JSONEmitter::primitiveEmitString(llvh::StringRef str) {
+  OS << '"';
+  const char *cur = str.begin();
+  const char *end = str.end();
+  while (cur < end) {
+    char c = *cur;
+    if (LLVM_LIKELY(
+            (unsigned char)c >= 0x20 && (unsigned char)c < 0x80 && c != '"' &&
+            c != '\\')) {
+      // Copy the run of characters that need no escaping in one go.
+      const char *runStart = cur;
+      do {
+        ++cur;
+      } while (cur < end && (unsigned char)*cur >= 0x20 &&
+               (unsigned char)*cur < 0x80 && *cur != '"' && *cur != '\\');
+      OS.write(runStart, cur - runStart);
+      continue;
+    }
+
+    switch (c) {
+      case '"':
+        OS << "\\\"";
+        ++cur;
+        continue;
+      case '\\':
+        OS << "\\\\";
+        ++cur;
+        continue;
+      case '\b':
+        OS << "\\b";
+        ++cur;
+        continue;
+      case '\f':
+        OS << "\\f";
+        ++cur;
+        continue;
+      case '\n':
+        OS << "\\n";
+        ++cur;
+        continue;
+      case '\r':
+        OS << "\\r";
+        ++cur;
+        continue;
+      case '\t':
+        OS << "\\t";
+        ++cur;
+        continue;
+      default:
+        break;
+    }
+
+    if ((unsigned char)c < 0x20) {
+      OS << llvh::format("\\u%04x", (unsigned)c);
+      ++cur;
+      continue;
+    }
+
+    // A non-ASCII code point: emit it as one or two \u escapes. Lone
+    // surrogates, which JS strings may contain, are escaped individually.
+    uint32_t cp = decodeUTF8<true>(cur, [](const llvh::Twine &msg) {
+      hermes_fatal(msg.str());
+    });
+    if (cp <= 0xFFFF) {
+      OS << llvh::format("\\u%04x", cp);
+    } else {
+      cp -= 0x10000;
+      OS << llvh::format("\\u%04x", UTF16_HIGH_SURROGATE + (cp >> 10));
+      OS << llvh::format("\\u%04x", UTF16_LOW_SURROGATE + (cp & 0x3FF));
+    }
+  }
+  OS << '"';
+}
+
+void JSONEmitter::willEmitValue() {
+  if (states_.empty())
+    return;
+  State &state = states_.back();
+  if (state.type == State::Dict) {
+    assert(state.needsValue && "Not expecting a value");
+    state.needsValue = false;
+    state.needsKey = true;
+    state.needsComma = true;
+    return;
+  }
+  if (state.needsComma)
+    OS << ',';
+  prettyNewLine();
+  state.needsComma = true;
+  state.isEmpty = false;
+}
+
+void JSONEmitter::prettyNewLine() {
+  if (pretty_) {
+    OS << '\n';
+    OS.indent(indent_);
+  }
+}
+
+void JSONEmitter::indentMore() {
+  if (pretty_)
+    indent_ += 2;
+}
+
+void JSONEmitter::indentLess() {
+  if (pretty_) {
+    assert(indent_ >= 2 && "unbalanced indentation");
+    indent_ -= 2;
+  }
+}
+
+} // namespace hermes
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/PerfSection.h"
+
+#include "hermes/Support/JSONEmitter.h"
+
+#include "llvh/Support/raw_ostream.h"
+
+#include <limits>
+
+namespace hermes {
+
+std::atomic<bool> PerfTrace::enabled_{false};
+
+namespace {
+
+/// A completed section.
+struct Event {
+  const char *name = nullptr;
+  const char *category = nullptr;
+  uint64_t start = 0;
+  uint64_t duration = 0;
+  std::vector<PerfTrace::Arg> args{};
+};
+
+/// A fixed-size block of events. Only the owning thread writes to it; it
+/// publishes each event by incrementing size, so the events before size can
+/// be read from any thread.
+struct Chunk {
+  static constexpr size_t kCapacity = 256;
+
+  std::atomic<size_t> size{0};
+  std::atomic<Chunk *> next{nullptr};
+  Event events[kCapacity];
+};
+
+/// The events recorded by one thread, in a list of chunks.
+struct ThreadBuffer {
+  explicit ThreadBuffer(uint32_t tid) : tid(tid) {}
+
+  const uint32_t tid;
+  Chunk *const first = new Chunk();
+  /// The chunk events are appended to. Only used by the owning thread.
+  Chunk *last = first;
+  /// The next buffer in the list of all buffers.
+  ThreadBuffer *nextBuffer = nullptr;
+
+  void append(Event &&event) {
+    size_t size = last->size.load(std::memory_order_relaxed);
+    if (size == Chunk::kCapacity) {
+      Chunk *chunk = new Chunk();
+      last->next.store(chunk, std::memory_order_release);
+      last = chunk;
+      size = 0;
+    }
+    last->events[size] = std::move(event);
+    last->size.store(size + 1, std::memory_order_release);
+  }
+};
+
+/// Every thread buffer ever created, most recent first. Buffers are only
+/// ever added, with a CAS, so the list can be walked without locking.
+std::atomic<ThreadBuffer *> allBuffers{nullptr};
+std::atomic<uint32_t> nextTid{1};
+
+ThreadBuffer &getThreadBuffer() {
+  static thread_local ThreadBuffer *buffer = nullptr;
+  if (LLVM_LIKELY(buffer))
+    return *buffer;
+  buffer = new ThreadBuffer(nextTid.fetch_add(1, std::memory_order_relaxed));
+  buffer->nextBuffer = allBuffers.load(std::memory_order_relaxed);
+  while (!allBuffers.compare_exchange_weak(
+      buffer->nextBuffer, buffer, std::memory_order_release)) {
+  }
+  return *buffer;
+}
+
+/// Call \p f on every event published so far.
+template <typename F>
+void forEachEvent(F f) {
+  for (ThreadBuffer *buffer = allBuffers.load(std::memory_order_acquire);
+       buffer;
+       buffer = buffer->nextBuffer) {
+    for (Chunk *chunk = buffer->first; chunk;
+         chunk = chunk->next.load(std::memory_order_acquire)) {
+      size_t size = chunk->size.load(std::memory_order_acquire);
+      for (size_t i = 0; i < size; ++i)
+        f(buffer->tid, chunk->events[i]);
+    }
+  }
+}
+
+} // namespace
+
+void PerfTrace::record(
+    const char *name,
+    const char *category,
+    uint64_t start,
+    std::vector<Arg> &&args) {
+  getThreadBuffer().append(
+      Event{name, category, start, now() - start, std::move(args)});
+}
+
+void PerfTrace::clear() {
+  for (ThreadBuffer *buffer = allBuffers.load(std::memory_order_acquire);
+       buffer;
+       buffer = buffer->nextBuffer) {
+    Chunk *chunk = buffer->first->next.exchange(nullptr);
+    while (chunk) {
+      Chunk *next = chunk->next.load(std::memory_order_relaxed);
+      delete chunk;
+      chunk = next;
+    }
+    size_t size = buffer->first->size.exchange(0);
+    for (size_t i = 0; i < size; ++i)
+      buffer->first->events[i] = Event{};
+    buffer->last = buffer->first;
+  }
+}
+
+void PerfTrace::exportChromeTrace(llvh::raw_ostream &os) {
+  // Timestamps are relative to the earliest section, in microseconds.
+  uint64_t origin = std::numeric_limits<uint64_t>::max();
+  forEachEvent([&origin](uint32_t, const Event &event) {
+    origin = std::min(origin, event.start);
+  });
+
+  JSONEmitter json{os};
+  json.openDict();
+  json.emitKeyValue("displayTimeUnit", "ms");
+  json.emitKey("traceEvents");
+  json.openArray();
+  forEachEvent([&json, origin](uint32_t tid, const Event &event) {
+    json.openDict();
+    json.emitKeyValue("name", event.name);
+    json.emitKeyValue("cat", event.category ? event.category : "hermes");
+    json.emitKeyValue("ph", "X");
+    json.emitKeyValue("ts", (event.start - origin) / 1000.0);
+    json.emitKeyValue("dur", event.duration / 1000.0);
+    json.emitKeyValue("pid", 1);
+    json.emitKeyValue("tid", tid);
+    if (!event.args.empty()) {
+      json.emitKey("args");
+      json.openDict();
+      for (const Arg &arg : event.args) {
+        json.emitKey(arg.name);
+        switch (arg.type) {
+          case Arg::Type::Size:
+            json.emitValue((unsigned long long)arg.size);
+            break;
+          case Arg::Type::Double:
+            json.emitValue(arg.d);
+            break;
+          case Arg::Type::String:
+            json.emitValue(arg.str);
+            break;
+        }
+      }
+      json.closeDict();
+    }
+    json.closeDict();
+  });
+  json.closeArray();
+  json.closeDict();
+}
+
+std::string PerfTrace::getChromeTrace() {
+  std::string result;
+  llvh::raw_string_ostream os{result};
+  exportChromeTrace(os);
+  return os.str();
+}
+
+} // namespace hermes
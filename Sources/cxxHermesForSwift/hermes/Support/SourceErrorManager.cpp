@@ -0,0 +1,485 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/SourceErrorManager.h"
+#include "hermes/Support/UTF8.h"
+
+#include "llvh/Support/MemoryBuffer.h"
+#include "llvh/Support/raw_ostream.h"
+
+namespace hermes {
+
+SourceErrorManager::ICoordTranslator::~ICoordTranslator() = default;
+
+void SourceErrorManager::BufferedMessage::addNote(
+    std::vector<MessageData> &bufferedNotes,
+    DiagKind dk,
+    SMLoc loc,
+    SMRange sm,
+    std::string &&msg) {
+  // Notes of one message are always contiguous, because a note is attached to
+  // the last buffered message.
+  if (!noteCount_)
+    firstNote_ = bufferedNotes.size();
+  else
+    assert(
+        firstNote_ + noteCount_ == bufferedNotes.size() &&
+        "notes must be added contiguously");
+  bufferedNotes.emplace_back(dk, loc, sm, std::move(msg));
+  ++noteCount_;
+}
+
+llvh::iterator_range<const SourceErrorManager::MessageData *>
+SourceErrorManager::BufferedMessage::notes(
+    const std::vector<MessageData> &bufferedNotes) const {
+  if (!noteCount_)
+    return {nullptr, nullptr};
+  const MessageData *first = bufferedNotes.data() + firstNote_;
+  return {first, first + noteCount_};
+}
+
+SourceErrorManager::SourceErrorManager()
+    : warningStatuses_((unsigned)Warning::_NumWarnings, true),
+      warningsAreErrors_((unsigned)Warning::_NumWarnings, false) {
+  sm_.setDiagHandler(SourceErrorManager::printDiagnostic, this);
+}
+
+void SourceErrorManager::enableBuffering() {
+  ++bufferingEnabled_;
+}
+
+void SourceErrorManager::disableBuffering() {
+  assert(bufferingEnabled_ > 0 && "unbalanced disableBuffering()");
+  if (--bufferingEnabled_ != 0)
+    return;
+
+  // Decode the location of every message, then print them in source order.
+  // Messages at the same location keep the order in which they were reported.
+  std::vector<std::pair<SourceCoords, const BufferedMessage *>> sorted;
+  sorted.reserve(bufferedMessages_.size());
+  for (const BufferedMessage &bm : bufferedMessages_) {
+    SourceCoords coords;
+    findBufferLineAndLoc(bm.loc, coords);
+    sorted.emplace_back(coords, &bm);
+  }
+  std::stable_sort(
+      sorted.begin(),
+      sorted.end(),
+      [](const std::pair<SourceCoords, const BufferedMessage *> &a,
+         const std::pair<SourceCoords, const BufferedMessage *> &b) {
+        return a.first.less(b.first);
+      });
+
+  for (const auto &p : sorted) {
+    const BufferedMessage *bm = p.second;
+    doPrintMessage(bm->dk, bm->loc, bm->sm, bm->msg);
+    for (const MessageData &note : bm->notes(bufferedNotes_))
+      doPrintMessage(note.dk, note.loc, note.sm, note.msg);
+  }
+
+  bufferedMessages_.clear();
+  bufferedNotes_.clear();
+}
+
+unsigned SourceErrorManager::addNewSourceBuffer(
+    std::unique_ptr<llvh::MemoryBuffer> f) {
+  unsigned bufId = sm_.AddNewSourceBuffer(std::move(f), SMLoc{});
+  assert(!isVirtualBufferId(bufId) && "too many source buffers");
+  return bufId;
+}
+
+unsigned SourceErrorManager::addNewVirtualSourceBuffer(
+    llvh::StringRef fileName) {
+  return indexToVirtualBufferId(virtualBufferNames_.insert(fileName));
+}
+
+llvh::StringRef SourceErrorManager::getBufferFileName(unsigned bufId) const {
+  if (isVirtualBufferId(bufId))
+    return virtualBufferNames_[virtualBufferIdToIndex(bufId)];
+  return sm_.getMemoryBuffer(bufId)->getBufferIdentifier();
+}
+
+uint32_t SourceErrorManager::findBufferIdForLoc(SMLoc loc) const {
+  return sm_.FindBufferContainingLoc(loc);
+}
+
+llvh::Optional<SourceErrorManager::LineCoord>
+SourceErrorManager::findBufferAndLine(SMLoc loc) const {
+  if (!loc.isValid())
+    return llvh::None;
+
+  unsigned bufId = sm_.FindBufferContainingLoc(loc);
+  if (!bufId)
+    return llvh::None;
+
+  auto lineRefAndNo = sm_.FindLine(loc, bufId);
+  return LineCoord{bufId, lineRefAndNo.second, lineRefAndNo.first};
+}
+
+void SourceErrorManager::FindLineCache::fillCoords(
+    SMLoc loc,
+    SourceCoords &result) {
+  result.bufId = bufferId;
+  result.line = lineNo;
+  result.col = loc.getPointer() - lineRef.data() + 1;
+}
+
+bool SourceErrorManager::findBufferLineAndLoc(SMLoc loc, SourceCoords &result) {
+  return findBufferLineAndLoc(loc, result, true);
+}
+
+bool SourceErrorManager::findBufferLineAndLoc(
+    SMLoc loc,
+    SourceCoords &result,
+    bool translate) {
+  const char *ptr = loc.getPointer();
+
+  // Check whether the location is in the cached line.
+  if (findLineCache_.bufferId &&
+      ptr >= findLineCache_.lineRef.begin() &&
+      ptr < findLineCache_.lineRef.end()) {
+    findLineCache_.fillCoords(loc, result);
+  } else if (
+      findLineCache_.bufferId &&
+      ptr >= findLineCache_.nextLineRef.begin() &&
+      ptr < findLineCache_.nextLineRef.end()) {
+    // It is in the following line: slide the cache forward by one line.
+    ++findLineCache_.lineNo;
+    findLineCache_.lineRef = findLineCache_.nextLineRef;
+    findLineCache_.nextLineRef = sm_.getLineRef(
+        findLineCache_.lineNo + 1, findLineCache_.bufferId);
+    findLineCache_.fillCoords(loc, result);
+  } else {
+    auto coord = findBufferAndLine(loc);
+    if (!coord) {
+      result.bufId = 0;
+      return false;
+    }
+    findLineCache_.bufferId = coord->bufId;
+    findLineCache_.lineNo = coord->lineNo;
+    findLineCache_.lineRef = coord->lineRef;
+    findLineCache_.nextLineRef =
+        sm_.getLineRef(coord->lineNo + 1, coord->bufId);
+    findLineCache_.fillCoords(loc, result);
+  }
+
+  if (translate && translator_)
+    translator_->translate(result);
+  return true;
+}
+
+const llvh::MemoryBuffer *SourceErrorManager::findBufferForLoc(
+    SMLoc loc) const {
+  unsigned bufId = sm_.FindBufferContainingLoc(loc);
+  if (!bufId)
+    return nullptr;
+  return sm_.getMemoryBuffer(bufId);
+}
+
+SMLoc SourceErrorManager::findSMLocFromCoords(SourceCoords coords) {
+  if (!coords.isValid() || isVirtualBufferId(coords.bufId) ||
+      coords.bufId > sm_.getNumBuffers())
+    return {};
+
+  llvh::StringRef lineRef = sm_.getLineRef(coords.line, coords.bufId);
+  if (lineRef.empty() || coords.col == 0 || coords.col > lineRef.size())
+    return {};
+  return SMLoc::getFromPointer(lineRef.data() + coords.col - 1);
+}
+
+SMLoc SourceErrorManager::convertEndToLocation(SMRange range) {
+  if (!range.End.isValid() ||
+      range.End.getPointer() <= range.Start.getPointer())
+    return range.Start;
+  return SMLoc::getFromPointer(range.End.getPointer() - 1);
+}
+
+/// \return the number of columns taken by the UTF-8 sequence starting with
+/// \p c: continuation bytes take no column.
+static inline unsigned columnWidth(char c) {
+  return isUTF8ContinuationByte(c) ? 0 : 1;
+}
+
+std::pair<std::string, std::string>
+SourceErrorManager::buildSourceAndCaretLine(
+    const llvh::SMDiagnostic &diag,
+    SourceErrorOutputOptions opts) {
+  const llvh::StringRef lineContents = diag.getLineContents();
+  const size_t len = lineContents.size();
+
+  // Mark the characters covered by the ranges and the caret, one entry per
+  // byte of the source line.
+  std::string marks(len + 1, ' ');
+  for (const auto &range : diag.getRanges()) {
+    size_t start = std::min<size_t>(range.first, len);
+    size_t end = std::min<size_t>(range.second, len);
+    std::fill(marks.begin() + start, marks.begin() + end, '~');
+  }
+  size_t caretPos = 0;
+  if (diag.getColumnNo() >= 0) {
+    caretPos = std::min<size_t>(diag.getColumnNo(), len);
+    marks[caretPos] = '^';
+  }
+
+  // Pick the window of bytes to display. Show everything if it fits, or else
+  // keep the caret and some context around the marked area.
+  size_t begin = 0;
+  size_t end = len;
+  if (opts.preferredMaxErrorWidth != SourceErrorOutputOptions::UnlimitedWidth &&
+      len > opts.preferredMaxErrorWidth) {
+    size_t markBegin = marks.find_first_not_of(' ');
+    size_t markEnd = marks.find_last_not_of(' ');
+    if (markBegin == std::string::npos) {
+      markBegin = markEnd = caretPos;
+    }
+    const size_t context = SourceErrorOutputOptions::MinimumSourceContext;
+    size_t width = std::max(
+        opts.preferredMaxErrorWidth, markEnd - markBegin + 1 + 2 * context);
+    begin = markBegin > context ? markBegin - context : 0;
+    if (caretPos < begin)
+      begin = caretPos;
+    end = std::min(len, begin + width);
+    // Never start in the middle of a UTF-8 sequence.
+    while (begin > 0 && isUTF8ContinuationByte(lineContents[begin]))
+      --begin;
+  }
+
+  std::string sourceLine;
+  std::string caretLine;
+  if (begin > 0) {
+    sourceLine += "...";
+    caretLine += "   ";
+  }
+
+  size_t column = 0;
+  for (size_t i = begin; i < end; ++i) {
+    char c = lineContents[i];
+    if (c == '\t') {
+      // Expand tabs so that the caret line stays aligned.
+      size_t spaces =
+          SourceErrorOutputOptions::TabStop - column % SourceErrorOutputOptions::TabStop;
+      sourceLine.append(spaces, ' ');
+      caretLine.append(spaces, marks[i]);
+      column += spaces;
+      continue;
+    }
+    if (c == '\r' || c == '\n')
+      break;
+    sourceLine += c;
+    if (columnWidth(c)) {
+      caretLine += marks[i];
+      ++column;
+    }
+  }
+  if (end < len && lineContents[end] != '\r' && lineContents[end] != '\n')
+    sourceLine += "...";
+  else if (end == len && marks[len] == '^')
+    caretLine += '^';
+
+  // Remove trailing whitespace from the caret line.
+  caretLine.erase(caretLine.find_last_not_of(' ') + 1);
+  return {std::move(sourceLine), std::move(caretLine)};
+}
+
+void SourceErrorManager::dumpCoords(
+    llvh::raw_ostream &OS,
+    const SourceCoords &coords) {
+  if (coords.isValid()) {
+    OS << getSourceUrl(coords.bufId) << ":" << coords.line << ":"
+       << coords.col;
+  } else {
+    OS << "<invalid>";
+  }
+}
+
+void SourceErrorManager::dumpCoords(llvh::raw_ostream &OS, SMLoc loc) {
+  SourceCoords coords;
+  findBufferLineAndLoc(loc, coords);
+  dumpCoords(OS, coords);
+}
+
+void SourceErrorManager::message(
+    DiagKind dk,
+    SMLoc loc,
+    SMRange sm,
+    const Twine &msg,
+    Warning w,
+    Subsystem subsystem) {
+  assert(dk == DK_Warning && "only warnings have a Warning code");
+  if (!isWarningEnabled(w)) {
+    lastMessageSuppressed_ = true;
+    return;
+  }
+  if (isWarningAnError(w))
+    dk = DK_Error;
+  message(dk, loc, sm, msg, subsystem);
+}
+
+void SourceErrorManager::message(
+    DiagKind dk,
+    SMLoc loc,
+    SMRange sm,
+    const Twine &msg,
+    Subsystem subsystem) {
+  // Notes belong to the preceding message and share its fate.
+  if (dk == DK_Note && lastMessageSuppressed_)
+    return;
+
+  if (suppressMessages_ &&
+      (*suppressMessages_ == Subsystem::Unspecified ||
+       *suppressMessages_ == subsystem)) {
+    lastMessageSuppressed_ = true;
+    return;
+  }
+  lastMessageSuppressed_ = false;
+
+  if (externalMessageBuffer_) {
+    externalMessageBuffer_->addMessage(dk, loc, sm, msg);
+    return;
+  }
+  countAndGenMessage(dk, loc, sm, msg);
+}
+
+void SourceErrorManager::message(
+    DiagKind dk,
+    SMRange sm,
+    const Twine &msg,
+    Subsystem subsystem) {
+  message(dk, sm.Start, sm, msg, subsystem);
+}
+
+void SourceErrorManager::message(
+    DiagKind dk,
+    SMLoc loc,
+    const Twine &msg,
+    Subsystem subsystem) {
+  message(dk, loc, SMRange{}, msg, subsystem);
+}
+
+void SourceErrorManager::countAndGenMessage(
+    DiagKind dk,
+    SMLoc loc,
+    SMRange sm,
+    const Twine &msg) {
+  if (errorLimitReached_)
+    return;
+
+  ++messageCount_[dk];
+  doGenMessage(dk, loc, sm, msg);
+
+  if (dk == DK_Error && messageCount_[DK_Error] >= errorLimit_) {
+    errorLimitReached_ = true;
+    doGenMessage(DK_Error, {}, {}, "too many errors emitted");
+  }
+}
+
+void SourceErrorManager::doGenMessage(
+    DiagKind dk,
+    SMLoc loc,
+    SMRange sm,
+    const Twine &msg) {
+  if (!bufferingEnabled_) {
+    doPrintMessage(dk, loc, sm, msg);
+    return;
+  }
+
+  // Notes are attached to the last message, so they are printed with it
+  // after sorting.
+  if (dk == DK_Note && !bufferedMessages_.empty()) {
+    bufferedMessages_.back().addNote(
+        bufferedNotes_, dk, loc, sm, msg.str());
+    return;
+  }
+  bufferedMessages_.emplace_back(dk, loc, sm, msg.str());
+}
+
+void SourceErrorManager::doPrintMessage(
+    DiagKind dk,
+    SMLoc loc,
+    SMRange sm,
+    const Twine &msg) {
+  // SourceMgr::PrintMessage can only use ranges in the buffer of the location.
+  llvh::ArrayRef<SMRange> ranges{};
+  if (sm.isValid() && loc.isValid())
+    ranges = sm;
+  sm_.PrintMessage(
+      loc,
+      static_cast<llvh::SourceMgr::DiagKind>(dk),
+      msg,
+      ranges,
+      llvh::None,
+      outputOptions_.showColors);
+}
+
+void SourceErrorManager::printDiagnostic(
+    const llvh::SMDiagnostic &diag,
+    void *ctx) {
+  using llvh::raw_ostream;
+
+  const SourceErrorManager *self = static_cast<SourceErrorManager *>(ctx);
+  const SourceErrorOutputOptions opts = self->outputOptions_;
+  raw_ostream &S = llvh::errs();
+  const bool showColors = opts.showColors && S.has_colors();
+
+  if (showColors)
+    S.changeColor(raw_ostream::SAVEDCOLOR, true);
+
+  if (!diag.getFilename().empty()) {
+    S << diag.getFilename();
+    if (diag.getLineNo() > 0) {
+      S << ':' << diag.getLineNo();
+      if (diag.getColumnNo() >= 0)
+        S << ':' << (diag.getColumnNo() + 1);
+    }
+    S << ": ";
+  }
+
+  switch (diag.getKind()) {
+    case llvh::SourceMgr::DK_Error:
+      if (showColors)
+        S.changeColor(raw_ostream::RED, true);
+      S << "error: ";
+      break;
+    case llvh::SourceMgr::DK_Warning:
+      if (showColors)
+        S.changeColor(raw_ostream::MAGENTA, true);
+      S << "warning: ";
+      break;
+    case llvh::SourceMgr::DK_Note:
+      if (showColors)
+        S.changeColor(raw_ostream::BLACK, true);
+      S << "note: ";
+      break;
+    case llvh::SourceMgr::DK_Remark:
+      if (showColors)
+        S.changeColor(raw_ostream::BLUE, true);
+      S << "remark: ";
+      break;
+  }
+
+  if (showColors) {
+    S.resetColor();
+    S.changeColor(raw_ostream::SAVEDCOLOR, true);
+  }
+  S << diag.getMessage() << '\n';
+  if (showColors)
+    S.resetColor();
+
+  if (diag.getLineNo() == -1 || diag.getColumnNo() == -1)
+    return;
+
+  auto sourceAndCaret = buildSourceAndCaretLine(diag, opts);
+  S << sourceAndCaret.first << '\n';
+  if (showColors)
+    S.changeColor(raw_ostream::GREEN, true);
+  S << sourceAndCaret.second << '\n';
+  if (showColors)
+    S.resetColor();
+  S.flush();
+}
+
+} // namespace hermes
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/UTF8.h"
+
+#include <cstring>
+
+namespace hermes {
+
+void encodeUTF8(char *&dst, uint32_t cp) {
+  char *d = dst;
+  if (cp <= 0x7F) {
+    *d = (char)cp;
+    ++d;
+  } else if (cp <= 0x7FF) {
+    d[1] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[0] = (cp & 0x1F) | 0xC0;
+    d += 2;
+  } else if (cp <= 0xFFFF) {
+    d[2] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[1] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[0] = (cp & 0x0F) | 0xE0;
+    d += 3;
+  } else if (cp <= 0x1FFFFF) {
+    d[3] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[2] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[1] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[0] = (cp & 0x07) | 0xF0;
+    d += 4;
+  } else if (cp <= 0x3FFFFFF) {
+    d[4] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[3] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[2] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[1] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[0] = (cp & 0x03) | 0xF8;
+    d += 5;
+  } else {
+    d[5] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[4] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[3] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[2] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[1] = (cp & 0x3F) | 0x80;
+    cp >>= 6;
+    d[0] = (cp & 0x01) | 0xFC;
+    d += 6;
+  }
+  dst = d;
+}
+
+bool isAllASCII(const uint8_t *start, const uint8_t *end) {
+  const uint8_t *cursor = start;
+  size_t len = end - start;
+  static_assert(sizeof(uint32_t) == 4, "uint32_t must be 4 bytes");
+  // Check a word at a time; the high bit of every byte must be clear.
+  const uint32_t highBits = 0x80808080u;
+  while (len >= sizeof(uint32_t)) {
+    uint32_t word;
+    std::memcpy(&word, cursor, sizeof(word));
+    if (word & highBits)
+      return false;
+    cursor += sizeof(uint32_t);
+    len -= sizeof(uint32_t);
+  }
+  for (; cursor < end; ++cursor) {
+    if (*cursor & 0x80)
+      return false;
+  }
+  return true;
+}
+
+void convertUTF16ToUTF8WithSingleSurrogates(
+    std::string &dest,
+    llvh::ArrayRef<char16_t> input) {
+  dest.clear();
+  dest.reserve(input.size());
+  for (char16_t c : input) {
+    // ASCII fast-path.
+    if (LLVM_LIKELY(c <= 0x7F)) {
+      dest.push_back(static_cast<char>(c));
+      continue;
+    }
+    char buff[UTF8CodepointMaxBytes];
+    char *ptr = buff;
+    encodeUTF8(ptr, c);
+    dest.insert(dest.end(), buff, ptr);
+  }
+}
+
+bool convertUTF16ToUTF8WithReplacements(
+    std::string &out,
+    llvh::ArrayRef<char16_t> input,
+    size_t maxCharacters) {
+  out.clear();
+  out.reserve(input.size());
+  // Stop early if we've reached currNumCharacters worth of UTF-8 characters.
+  size_t currNumCharacters = 0;
+  for (auto cur = input.begin(), end = input.end(); cur < end; ++cur) {
+    if (maxCharacters != 0 && currNumCharacters++ >= maxCharacters) {
+      // Truncated.
+      return false;
+    }
+    char16_t c = cur[0];
+    // ASCII fast-path.
+    if (LLVM_LIKELY(c <= 0x7F)) {
+      out.push_back(static_cast<char>(c));
+      continue;
+    }
+
+    char32_t c32;
+    if (isLowSurrogate(cur[0])) {
+      // Unpaired low surrogate.
+      c32 = UNICODE_REPLACEMENT_CHARACTER;
+    } else if (isHighSurrogate(cur[0])) {
+      // Leading high surrogate. See if the next character is a low surrogate.
+      if (cur + 1 == end || !isLowSurrogate(cur[1])) {
+        // Trailing or unpaired high surrogate.
+        c32 = UNICODE_REPLACEMENT_CHARACTER;
+      } else {
+        // Decode surrogate pair and increment, because we consumed two chars.
+        c32 = utf16SurrogatePairToCodePoint(cur[0], cur[1]);
+        ++cur;
+      }
+    } else {
+      // Not a surrogate.
+      c32 = c;
+    }
+
+    char buff[UTF8CodepointMaxBytes];
+    char *ptr = buff;
+    encodeUTF8(ptr, c32);
+    out.insert(out.end(), buff, ptr);
+  }
+  return true;
+}
+
+std::pair<uint32_t, uint32_t> convertUTF16ToUTF8BufferWithReplacements(
+    llvh::MutableArrayRef<uint8_t> outBuffer,
+    llvh::ArrayRef<char16_t> input) {
+  uint8_t *curOutBuffer = outBuffer.data();
+  size_t outBufferLength = outBuffer.size();
+  uint32_t numCharsConverted = 0;
+  for (auto cur = input.begin(), end = input.end(); cur < end; ++cur) {
+    char16_t c = cur[0];
+    // ASCII fast-path.
+    if (LLVM_LIKELY(c <= 0x7F)) {
+      if (outBufferLength == 0)
+        break;
+      *curOutBuffer++ = static_cast<uint8_t>(c);
+      --outBufferLength;
+      ++numCharsConverted;
+      continue;
+    }
+
+    char32_t c32;
+    uint32_t consumed = 1;
+    if (isLowSurrogate(cur[0])) {
+      // Unpaired low surrogate.
+      c32 = UNICODE_REPLACEMENT_CHARACTER;
+    } else if (isHighSurrogate(cur[0])) {
+      // Leading high surrogate. See if the next character is a low surrogate.
+      if (cur + 1 == end || !isLowSurrogate(cur[1])) {
+        // Trailing or unpaired high surrogate.
+        c32 = UNICODE_REPLACEMENT_CHARACTER;
+      } else {
+        // Decode surrogate pair.
+        c32 = utf16SurrogatePairToCodePoint(cur[0], cur[1]);
+        consumed = 2;
+      }
+    } else {
+      // Not a surrogate.
+      c32 = c;
+    }
+
+    char buff[UTF8CodepointMaxBytes];
+    char *ptr = buff;
+    encodeUTF8(ptr, c32);
+    size_t encodedLength = ptr - buff;
+    // Stop before a character that doesn't fit.
+    if (encodedLength > outBufferLength)
+      break;
+    std::memcpy(curOutBuffer, buff, encodedLength);
+    curOutBuffer += encodedLength;
+    outBufferLength -= encodedLength;
+    numCharsConverted += consumed;
+    cur += consumed - 1;
+  }
+  return {numCharsConverted, (uint32_t)(curOutBuffer - outBuffer.data())};
+}
+
+void convertUTF8WithSurrogatesToUTF8WithReplacements(
+    std::string &output,
+    llvh::StringRef input) {
+  output.reserve(output.size() + input.size());
+  for (const char *cur = input.begin(), *end = input.end(); cur < end;) {
+    unsigned char c = *cur;
+    // ASCII fast-path.
+    if (LLVM_LIKELY(c <= 0x7F)) {
+      output.push_back(c);
+      ++cur;
+      continue;
+    }
+
+    // Decode the code point, which may itself be a surrogate half.
+    auto invalidUTF8 = [](const llvh::Twine &) {
+      llvm_unreachable("invalid UTF-8");
+    };
+    uint32_t cp = _decodeUTF8SlowPath<true>(cur, invalidUTF8);
+
+    if (isHighSurrogate(cp)) {
+      // A high surrogate followed by an encoded low surrogate is a pair.
+      const char *next = cur;
+      if (next < end && isUTF8Start(*next)) {
+        const char *afterNext = next;
+        uint32_t low = _decodeUTF8SlowPath<true>(afterNext, invalidUTF8);
+        if (isLowSurrogate(low)) {
+          cp = utf16SurrogatePairToCodePoint(cp, low);
+          cur = afterNext;
+        } else {
+          cp = UNICODE_REPLACEMENT_CHARACTER;
+        }
+      } else {
+        cp = UNICODE_REPLACEMENT_CHARACTER;
+      }
+    } else if (isLowSurrogate(cp)) {
+      // Unpaired low surrogate.
+      cp = UNICODE_REPLACEMENT_CHARACTER;
+    }
+
+    char buff[UTF8CodepointMaxBytes];
+    char *ptr = buff;
+    encodeUTF8(ptr, cp);
+    output.append(buff, ptr);
+  }
+}
+
+} // namespace hermes
@@ -0,0 +1,76 @@
+//===-- Debug.cpp - An easy way to add debug output to your code ----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a handy way of adding debugging information to your
+// code, without it being enabled all of the time, and without having to add
+// command line options to enable it.  The command line options of upstream
+// LLVM are not vendored: the debug types are set programmatically and dbgs()
+// always writes straight to errs().
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvh/Support/Debug.h"
+#include "llvh/Support/raw_ostream.h"
+
+#include <string>
+#include <vector>
+
+#undef isCurrentDebugType
+#undef setCurrentDebugType
+#undef setCurrentDebugTypes
+
+using namespace llvh;
+
+// Even though LLVM might be built with NDEBUG, define symbols that the code
+// built without NDEBUG can depend on via the llvm/Support/Debug.h header.
+namespace llvh {
+/// Exported boolean set by the -debug option.
+bool DebugFlag = false;
+
+/// The debug types enabled by setCurrentDebugType(s).
+static std::vector<std::string> &currentDebugTypes() {
+  static std::vector<std::string> Types;
+  return Types;
+}
+
+/// Return true if the specified string is the debug type
+/// specified on the command line, or if none was specified on the command line
+/// with the -debug-only=X option.
+bool isCurrentDebugType(const char *DebugType) {
+  if (currentDebugTypes().empty())
+    return true;
+  // See if DebugType is in list. Note: do not use find() as that forces us to
+  // unnecessarily create an std::string instance.
+  for (auto &d : currentDebugTypes()) {
+    if (d == DebugType)
+      return true;
+  }
+  return false;
+}
+
+/// Set the current debug types, as if the -debug-only=X,Y,Z option were
+/// specified.  Note that DebugFlag also needs to be set to true for debug
+/// output to be produced.
+void setCurrentDebugTypes(const char **Types, unsigned Count) {
+  currentDebugTypes().clear();
+  for (size_t T = 0; T < Count; ++T)
+    currentDebugTypes().push_back(Types[T]);
+}
+
+void setCurrentDebugType(const char *Type) {
+  setCurrentDebugTypes(&Type, 1);
+}
+} // namespace llvh
+
+bool llvh::EnableDebugBuffering = false;
+
+/// dbgs - Return the debug stream.  Debug buffering is not vendored.
+raw_ostream &llvh::dbgs() {
+  return errs();
+}
@@ -0,0 +1,67 @@
+//===-- ManagedStatic.cpp - Static Global wrapper -------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the ManagedStatic class and llvm_shutdown().
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvh/Support/ManagedStatic.h"
+
+#include <cassert>
+#include <mutex>
+
+using namespace llvh;
+
+static const ManagedStaticBase *StaticList = nullptr;
+
+static std::recursive_mutex &getManagedStaticMutex() {
+  static std::recursive_mutex ManagedStaticMutex;
+  return ManagedStaticMutex;
+}
+
+void ManagedStaticBase::RegisterManagedStatic(void *(*Creator)(),
+                                              void (*Deleter)(void*)) const {
+  assert(Creator);
+  std::lock_guard<std::recursive_mutex> Lock(getManagedStaticMutex());
+
+  if (!Ptr.load(std::memory_order_relaxed)) {
+    void *Tmp = Creator();
+
+    Ptr.store(Tmp, std::memory_order_release);
+    DeleterFn = Deleter;
+
+    // Add to list of managed statics.
+    Next = StaticList;
+    StaticList = this;
+  }
+}
+
+void ManagedStaticBase::destroy() const {
+  assert(DeleterFn && "ManagedStatic not initialized correctly!");
+  assert(StaticList == this &&
+         "Not destroyed in reverse order of construction?");
+  // Unlink from list.
+  StaticList = Next;
+  Next = nullptr;
+
+  // Destroy memory.
+  DeleterFn(Ptr);
+
+  // Cleanup.
+  Ptr = nullptr;
+  DeleterFn = nullptr;
+}
+
+/// llvm_shutdown - Deallocate and destroy all ManagedStatic variables.
+void llvh::llvm_shutdown() {
+  std::lock_guard<std::recursive_mutex> Lock(getManagedStaticMutex());
+
+  while (StaticList)
+    StaticList->destroy();
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// The docblock of a source, as found by hermes::parser::scanDocBlock().
+struct HermesDocBlock {
+  /// The comments of the docblock, with their delimiters.
+  std::vector<std::string> comments;
+  /// The names of the pragmas in the comments, in order.
+  std::vector<std::string> pragmas;
+  /// The offset of the first token that is not part of the directive
+  /// prologue, or the size of the source if there is none.
+  size_t end = 0;
+  /// Whether hermes::parser::hasFlowPragma() finds @flow in the comments.
+  bool hasFlowPragma = false;
+};
+
+/// Scan the docblock of the \p size bytes at \p data, which need not be
+/// zero terminated.
+HermesDocBlock hermesScanDocBlock(const char *data, size_t size);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "hermes/AST/ESTree.h"
+
+#include <cstddef>
+
+/// Accessors used by the generated Swift view of the AST (ESTree.swift).
+///
+/// Nodes, lists and strings are passed as untyped pointers so that Swift never
+/// has to import the node classes themselves, which cannot be copied. Fields
+/// are addressed by their index in the ESTree.def entry of the node, which is
+/// how the generator refers to them.
+
+/// The bytes of a NodeLabel or NodeString. data is nullptr if the field is
+/// empty.
+struct HermesStringRef {
+  const char *data;
+  size_t size;
+};
+
+/// The source range of a node, as pointers into its buffer.
+struct HermesSourceRange {
+  const char *start;
+  const char *end;
+};
+
+hermes::ESTree::NodeKind hermesNodeKind(const void *node);
+
+/// \return the name of the node kind with value \p kind, or nullptr if it is
+/// not the kind of a node.
+const char *hermesNodeKindName(unsigned kind);
+
+HermesSourceRange hermesNodeSourceRange(const void *node);
+
+/// \return the NodePtr field \p index of \p node, which may be nullptr.
+const void *hermesNodeGetNode(const void *node, unsigned index);
+
+/// \return the NodeList field \p index of \p node.
+const void *hermesNodeGetList(const void *node, unsigned index);
+
+/// \return the NodeLabel or NodeString field \p index of \p node.
+HermesStringRef hermesNodeGetString(const void *node, unsigned index);
+
+/// \return the NodeBoolean field \p index of \p node.
+bool hermesNodeGetBoolean(const void *node, unsigned index);
+
+/// \return the NodeNumber field \p index of \p node.
+double hermesNodeGetNumber(const void *node, unsigned index);
+
+/// \return the first node of \p list, or nullptr if it is empty.
+const void *hermesNodeListFirst(const void *list);
+
+/// \return the node following \p node in \p list, or nullptr at the end.
+const void *hermesNodeListNext(const void *list, const void *node);
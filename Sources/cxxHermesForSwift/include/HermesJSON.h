@@ -0,0 +1,51 @@
+#pragma once
+
+#include "hermes/Parser/JSONLinesReader.h"
+#include "hermes/Parser/JSONParser.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// Parse the \p size bytes at \p data as JSON with \p engine, and print the
+/// value back as compact JSON. data[size] must be '\0', as for
+/// HermesParseSession::parseBuffer().
+/// \return the printed value, or an empty string if \p data is not valid
+///   JSON.
+std::string hermesFormatJSON(
+    const char *data,
+    size_t size,
+    hermes::parser::JSONParserEngine engine);
+
+/// Find the property \p name of the object in the \p size bytes at \p data
+/// with a hermes::parser::JSONCursor, which skips the properties before it,
+/// and print its value back as compact JSON. data[size] must be '\0'.
+/// \return the printed value, or an empty string if there is no such
+///   property or the cursor reported an error.
+std::string hermesFindJSONField(
+    const char *data,
+    size_t size,
+    const std::string &name);
+
+/// The records read by hermesReadJSONLines(), in delivery order.
+struct HermesJSONLines {
+  /// The byte offset of the line of each record.
+  std::vector<size_t> offsets;
+  /// Each record printed back as compact JSON, or "error: " followed by the
+  /// message for a line that failed to parse.
+  std::vector<std::string> records;
+  /// See hermes::parser::JSONLinesReader::getPeakChunksInFlight().
+  size_t peakChunksInFlight = 0;
+  /// The result of hermes::parser::JSONLinesReader::read().
+  bool ok = false;
+};
+
+/// Read the \p size bytes at \p data as JSON Lines with a
+/// hermes::parser::JSONLinesReader, sleeping for \p recordDelayUs
+/// microseconds in the callback of every record to make it slower than
+/// parsing. data[size] must be '\0'.
+HermesJSONLines hermesReadJSONLines(
+    const char *data,
+    size_t size,
+    const hermes::parser::JSONLinesOptions &options,
+    unsigned recordDelayUs);
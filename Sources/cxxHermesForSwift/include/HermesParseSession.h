@@ -0,0 +1,281 @@
+#pragma once
+
+#include "hermes/AST/Context.h"
+#include "hermes/AST/ESTree.h"
+#include "hermes/Parser/JSLexer.h"
+#include "hermes/Parser/SourceDialect.h"
+#include "hermes/Parser/TypeStripper.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#if defined(__has_attribute) && __has_attribute(swift_attr)
+#define HERMES_SWIFT_SENDABLE __attribute__((swift_attr("@Sendable")))
+#else
+#define HERMES_SWIFT_SENDABLE
+#endif
+
+/// Parser settings applied to the Context of a HermesParseSession.
+struct HermesParseOptions {
+  bool strictMode = false;
+  bool parseJSX = false;
+  hermes::ParseFlowSetting parseFlow = hermes::ParseFlowSetting::NONE;
+  bool parseFlowComponentSyntax = false;
+  bool parseTS = false;
+  /// If set, the dialect of every source is detected from its name and text,
+  /// and it is parsed as that instead of with parseJSX, parseFlow and parseTS
+  /// (see hermes::parser::detectSourceDialect()).
+  bool detectDialect = false;
+  /// With SKIP, Flow and TypeScript types are left out of the AST, and only
+  /// their source ranges are kept (see HermesParseSession::getSkippedTypeCount).
+  hermes::TypeSyntaxSetting typeSyntax = hermes::TypeSyntaxSetting::BUILD;
+  /// If not 0, a parse that takes longer than this many microseconds stops
+  /// with an error.
+  uint64_t timeLimitMicroseconds = 0;
+  /// If not 0, a parse stops with an error after this many steps, counted
+  /// at statements, function bodies and every few hundred tokens.
+  uint64_t stepBudget = 0;
+  /// If not 0, a parse stops with an error once the session holds more than
+  /// this many bytes of AST, identifiers and lexer storage.
+  uint64_t memoryLimitBytes = 0;
+  /// If not 0, a parse stops with an error when code is nested deeper than
+  /// this, instead of the parser's default of 1024 levels.
+  unsigned maxNestingDepth = 0;
+  /// If not 0, a parse stops with an error once the parser uses more than
+  /// this many bytes of the calling thread's stack.
+  uint64_t stackLimitBytes = 0;
+  /// Whether to collect hermes::parser::ParseStats. The arena and string
+  /// table figures are always collected, the other counters only if the
+  /// parser is built with HERMES_PARSE_STATS.
+  bool collectStats = false;
+};
+
+/// Cancels the parses of a HermesParseSession. It may be copied to, and used
+/// from, any thread.
+class HERMES_SWIFT_SENDABLE HermesParseCanceller {
+public:
+  /// Make the current parse of the session, or the next one if it is not
+  /// parsing, stop with an error as soon as possible. The session stays
+  /// cancelled until it is reset().
+  void cancel() const;
+
+private:
+  friend class HermesParseSession;
+  explicit HermesParseCanceller(
+      std::shared_ptr<hermes::parser::ParseInterrupt> interrupt)
+      : interrupt_(std::move(interrupt)) {}
+
+  std::shared_ptr<hermes::parser::ParseInterrupt> interrupt_;
+};
+
+/// A Context and the AST parsed in it, in a form that can be used from Swift.
+///
+/// Copies share the same Context, which is destroyed with the last copy. AST
+/// nodes are allocated in the Context, so they remain valid as long as any
+/// copy of the session is alive, until reset() or a reparseBuffer() that
+/// parses the whole buffer.
+///
+/// The source text is not copied: parseBuffer() registers the caller's bytes
+/// with the SourceErrorManager in place, and the AST (identifiers, string
+/// literals, source ranges) may refer to them. The caller must keep the bytes
+/// alive until the session parses another buffer or is reset().
+///
+/// A session can be reset() and reused, which keeps the allocator slabs and
+/// the identifiers every parser needs, so that the setup cost of a parse is
+/// close to zero. HermesParseSessionPool keeps sessions ready for that.
+class HermesParseSession {
+public:
+  explicit HermesParseSession(const HermesParseOptions &options = {});
+
+  /// Parse the \p size bytes at \p data as JavaScript. data[size] must be
+  /// '\0', which the lexer relies on to detect the end of input; it is not
+  /// part of the source.
+  /// \param name the name of the buffer used in error messages.
+  /// \return true if the program was parsed without errors.
+  bool parseBuffer(const char *data, size_t size, const std::string &name);
+
+  /// Parse like parseBuffer(), but pass every top-level statement to \p keep
+  /// as soon as it has been parsed, and free it unless \p keep returns true
+  /// (see hermes::parser::JSParser::parseStreaming()). The program only has
+  /// the statements that were kept.
+  /// \param keepContext passed to \p keep.
+  bool parseBufferStreaming(
+      const char *data,
+      size_t size,
+      const std::string &name,
+      bool (*keep)(void *keepContext, hermes::ESTree::Node *statement),
+      void *keepContext);
+
+  /// Parse the \p size bytes at \p data, which must be the source of the last
+  /// parseBuffer() or reparseBuffer() with the \p removed bytes at \p offset
+  /// replaced by \p inserted bytes; if it is not, the whole buffer is parsed.
+  /// If the last parse succeeded, only the statements around the edit are
+  /// parsed again when possible, and the rest of the program is kept, see
+  /// hermes::parser::JSParser::reparse(). The program is updated in place,
+  /// so it must not be read meanwhile. The source of the last parse must
+  /// still be alive. The session parses a copy of the \p size bytes, and
+  /// keeps no reference to \p data afterwards; the edits that follow are
+  /// applied to the copy in place. Once the statements replaced since the
+  /// last full parse may take more memory than the program, the whole buffer
+  /// is parsed again to free them.
+  /// \return true if the program was parsed without errors.
+  bool reparseBuffer(
+      const char *data,
+      size_t size,
+      const std::string &name,
+      size_t offset,
+      size_t removed,
+      size_t inserted);
+
+  /// \return whether the last reparseBuffer() only parsed the statements
+  ///   around its edit.
+  bool wasReparsedIncrementally() const;
+
+  /// \return whether the dialect of the last parse was detected, see
+  ///   HermesParseOptions::detectDialect.
+  bool wasDialectDetected() const;
+
+  /// \return the dialect detected for the last parse, if
+  ///   wasDialectDetected().
+  hermes::parser::SourceDialect getDetectedDialect() const;
+
+  /// Parse the file at \p path, which is memory-mapped when possible. The
+  /// mapping is owned by the session.
+  /// \return true if the program was parsed without errors.
+  bool parseFile(const std::string &path);
+
+  /// Parse the \p size bytes at \p data as Flow or TypeScript, as set in the
+  /// options, and turn them into JavaScript by leaving out the types, see
+  /// hermes::parser::TypeStripper. data[size] must be '\0', as for
+  /// parseBuffer(). No AST is kept, so getProgram() returns nullptr after it.
+  /// \param buildSourceMap whether to build a source map of the output.
+  /// \return true if the source was parsed without errors.
+  bool stripTypes(
+      const char *data,
+      size_t size,
+      const std::string &name,
+      hermes::parser::StripMode mode,
+      bool buildSourceMap);
+
+  /// Find the modules that the \p size bytes at \p data depend on, without
+  /// building an AST, see hermes::parser::JSParser::scanDependencies().
+  /// data[size] must be '\0', as for parseBuffer(). getProgram() returns
+  /// nullptr after it.
+  /// \return true if the source was scanned without errors.
+  bool scanDependencies(
+      const char *data,
+      size_t size,
+      const std::string &name);
+
+  /// \return the number of dependencies found by the last call to
+  ///   scanDependencies(). They are in source order.
+  size_t getDependencyCount() const;
+
+  /// \return the kind of the dependency at \p index.
+  hermes::parser::ModuleDependency::Kind getDependencyKind(size_t index) const;
+
+  /// \return whether only types are imported from the dependency at \p index.
+  bool isDependencyTypeOnly(size_t index) const;
+
+  /// \return the module specifier of the dependency at \p index.
+  std::string getDependencySpecifier(size_t index) const;
+
+  /// \return the byte offset of the start of the string literal that names
+  ///   the dependency at \p index.
+  size_t getDependencyStart(size_t index) const;
+
+  /// \return the byte offset of the end of that string literal.
+  size_t getDependencyEnd(size_t index) const;
+
+  /// \return the JavaScript produced by the last call to stripTypes().
+  std::string getStrippedCode() const;
+
+  /// \return the source map of the last call to stripTypes(), or an empty
+  ///   string if it did not build one.
+  std::string getStrippedSourceMap() const;
+
+  /// \return the program parsed by the last call to parseBuffer() or
+  ///   parseFile(), or nullptr if it could not be parsed.
+  hermes::ESTree::ProgramNode *getProgram() const;
+
+  /// \return the program as ESTree JSON, with the byte range of every node in
+  ///   its source, or an empty string if there is none. Two programs dump the
+  ///   same if they have the same nodes at the same offsets, whether they
+  ///   were reparsed or not.
+  std::string dumpProgram() const;
+
+  /// \return the number of errors reported by the last parse, reparse, strip
+  ///   or scan.
+  unsigned getErrorCount() const;
+
+  /// \return the errors reported by the last parse, reparse, strip or scan,
+  ///   one per line, formatted as "name:line:column: message".
+  std::string getErrors() const;
+
+  hermes::Context &getContext() const;
+
+  /// \return a canceller for the parses of this session.
+  HermesParseCanceller getCanceller() const;
+
+  /// \return whether the last parse was cancelled, or exceeded its time
+  ///   limit, step budget or memory limit.
+  bool wasInterrupted() const;
+
+  /// \return the number of types left out of the AST by the last parse, if
+  ///   HermesParseOptions::typeSyntax is SKIP. They are in source order.
+  size_t getSkippedTypeCount() const;
+
+  /// \return the kind of the skipped type at \p index.
+  hermes::parser::SkippedType::Kind getSkippedTypeKind(size_t index) const;
+
+  /// \return the byte offset of the start of the skipped type at \p index in
+  ///   the source of the last parse.
+  size_t getSkippedTypeStart(size_t index) const;
+
+  /// \return the byte offset of the end of the skipped type at \p index.
+  size_t getSkippedTypeEnd(size_t index) const;
+
+  /// \return the most memory the session held at any time since it was
+  ///   created or reset(), in bytes, as counted for the memory limit.
+  uint64_t getPeakMemoryBytes() const;
+
+  /// \return the statistics of the parses since the session was created or
+  ///   reset(), all 0 unless HermesParseOptions::collectStats was set.
+  const hermes::parser::ParseStats &getParseStats() const;
+
+  /// Forget the parsed program, the source buffers, the errors and the
+  /// statistics, free the AST and clear any cancellation, so that the session
+  /// can parse something else. Nothing obtained from the session before may
+  /// be used afterwards.
+  void reset();
+
+private:
+  struct Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+/// A thread-safe pool of reusable sessions that share the same options.
+class HermesParseSessionPool {
+public:
+  /// \param maxIdle the number of idle sessions kept; sessions released
+  ///   beyond that are destroyed.
+  explicit HermesParseSessionPool(
+      const HermesParseOptions &options = {},
+      size_t maxIdle = 64);
+
+  /// \return an idle session, or a new one if there is none.
+  HermesParseSession acquire() const;
+
+  /// Reset \p session and keep it for a later acquire(). The caller must not
+  /// use \p session, any copy of it, or anything it parsed afterwards.
+  void release(HermesParseSession session) const;
+
+  /// \return the number of sessions ready to be acquired.
+  size_t getIdleCount() const;
+
+private:
+  struct Impl;
+  std::shared_ptr<Impl> impl_;
+};
@@ -32,4 +32,13 @@
 #endif
 #endif
 
+// Whether the parser can collect parser::ParseStats.
+#if !defined(HERMES_PARSE_STATS)
+#if defined(NDEBUG)
+#define HERMES_PARSE_STATS 0
+#else
+#define HERMES_PARSE_STATS 1
+#endif
+#endif
+
 #endif
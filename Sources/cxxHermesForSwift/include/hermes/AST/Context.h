@@ -8,9 +8,12 @@
 #ifndef HERMES_AST_CONTEXT_H
 #define HERMES_AST_CONTEXT_H
 
+#include "hermes/Parser/ParseInterrupt.h"
+#include "hermes/Parser/ParseStats.h"
 #include "hermes/Parser/PreParser.h"
 #include "hermes/Regex/RegexSerialization.h"
 #include "hermes/Support/Allocator.h"
+#include "hermes/Support/MemoryBudget.h"
 #include "hermes/Support/SourceErrorManager.h"
 #include "hermes/Support/StringTable.h"
 
@@ -23,6 +26,12 @@ namespace hbc {
 class BackendContext;
 }
 
+namespace parser {
+namespace detail {
+struct KnownIdentifiers;
+} // namespace detail
+} // namespace parser
+
 #ifdef HERMES_RUN_WASM
 class EmitWasmIntrinsicsContext;
 #endif // HERMES_RUN_WASM
@@ -127,6 +136,18 @@ enum class ParseFlowSetting {
   UNAMBIGUOUS,
 };
 
+/// What the parser does with the Flow or TypeScript types it parses.
+enum class TypeSyntaxSetting {
+  /// Build AST nodes for types, like for the rest of the program.
+  BUILD,
+
+  /// Parse types with the same grammar, but leave them out of the AST and
+  /// only record their source ranges (see parser::SkippedType). Statements
+  /// that only declare types, like type aliases and interfaces, are skipped
+  /// as a whole. Has no effect unless Flow or TypeScript is parsed.
+  SKIP,
+};
+
 /// An enum to track the "source visibility" of functions. This notion is coined
 /// to implement "directives" such as 'hide source' and 'sensitive' defined by
 /// https://github.com/tc39/proposal-function-implementation-hiding, as well as
@@ -167,13 +188,17 @@ class Context {
   using ResolutionTable = llvh::DenseMap<llvh::StringRef, ResolutionTableEntry>;
 
  private:
+  /// The memory held by the allocators below and by the token and comment
+  /// storage of the lexer. It is declared first so that it outlives them.
+  MemoryBudget memoryBudget_{};
+
   /// The allocator for AST nodes, which may be rolled back to parse subtrees
   /// during pre-parsing (for lazy parsing).
-  Allocator allocator_{};
+  Allocator allocator_{&memoryBudget_};
 
   /// String/identifier table allocator. It's separate from the AST allocator
   /// because we don't want to revert the strings when we revert subtrees.
-  Allocator identifierAllocator_{};
+  Allocator identifierAllocator_{&memoryBudget_};
 
   /// Preparsed function spans and similar used during lazy parsing.
   std::unique_ptr<parser::PreParsedData> preParsed_{};
@@ -184,6 +209,29 @@ class Context {
   std::map<std::pair<UniqueString *, UniqueString *>, CompiledRegExp>
       compiledRegExps_{};
 
+  /// Identifiers interned by every parser, cached by the first one. We use a
+  /// shared pointer to avoid any dependencies on its destructor.
+  std::shared_ptr<const parser::detail::KnownIdentifiers> knownIdentifiers_{};
+
+  /// Whether setStringTableCheckpoint() has been called.
+  bool hasStringTableCheckpoint_{false};
+
+  /// Whether knownIdentifiers_ were interned before the string table
+  /// checkpoint, so that they survive resetParseState().
+  bool knownIdentifiersBeforeCheckpoint_{false};
+
+  /// If set, polled by the parser to find out whether it should stop early.
+  std::shared_ptr<parser::ParseInterrupt> parseInterrupt_{};
+
+  /// If set, updated by every parse in this Context.
+  parser::ParseStats *parseStats_{nullptr};
+
+  /// The deepest nesting the parser accepts, or 0 for its default.
+  unsigned maxParseDepth_{0};
+
+  /// The bytes of native stack the parser may use, or 0 for no limit.
+  size_t parseStackLimit_{0};
+
   /// If an external SourceErrorManager was not supplied to us, we allocate out
   /// private one here.
   std::unique_ptr<SourceErrorManager> ownSm_;
@@ -231,6 +279,9 @@ class Context {
   /// Whether to parse TypeScript syntax.
   bool parseTS_{false};
 
+  /// What to do with the Flow or TypeScript types that are parsed.
+  TypeSyntaxSetting typeSyntax_{TypeSyntaxSetting::BUILD};
+
   /// Whether to convert ES6 classes to ES5 functions
   bool convertES6Classes_{false};
 
@@ -296,6 +347,127 @@ class Context {
     return stringTable_;
   }
 
+  const std::shared_ptr<const parser::detail::KnownIdentifiers> &
+  getKnownIdentifiers() const {
+    return knownIdentifiers_;
+  }
+
+  void setKnownIdentifiers(
+      std::shared_ptr<const parser::detail::KnownIdentifiers> known) {
+    knownIdentifiers_ = std::move(known);
+  }
+
+  /// \return the interrupt polled by the parser, or nullptr.
+  parser::ParseInterrupt *getParseInterrupt() const {
+    return parseInterrupt_.get();
+  }
+
+  /// Make parses in this Context poll \p interrupt, which may be shared with
+  /// a thread that cancels them.
+  void setParseInterrupt(std::shared_ptr<parser::ParseInterrupt> interrupt) {
+    parseInterrupt_ = std::move(interrupt);
+  }
+
+  /// \return the statistics updated by the parser, or nullptr.
+  parser::ParseStats *getParseStats() const {
+    return parseStats_;
+  }
+
+  /// Make parses in this Context add to \p stats, which must outlive them.
+  /// Pass nullptr to stop collecting statistics.
+  void setParseStats(parser::ParseStats *stats) {
+    parseStats_ = stats;
+  }
+
+  /// \return the deepest nesting of expressions, statements and types that
+  ///   the parser accepts, or 0 if it uses its default.
+  unsigned getMaxParseDepth() const {
+    return maxParseDepth_;
+  }
+
+  /// Make parses fail with a "too many nested expressions" error when code
+  /// is nested deeper than \p depth, or restore the default (1024 in most
+  /// builds) if \p depth is 0. Chains that the parser handles in a loop,
+  /// such as `a ? b : c ? d : e`, `!!x` and `a.b.c`, count one level per
+  /// link but don't use more native stack for longer chains. Recursive
+  /// visitors of the AST may need a larger stack for deeper trees.
+  void setMaxParseDepth(unsigned depth) {
+    maxParseDepth_ = depth;
+  }
+
+  /// \return the bytes of native stack the parser may use, or 0.
+  size_t getParseStackLimit() const {
+    return parseStackLimit_;
+  }
+
+  /// Make parses fail with a "too many nested expressions" error once the
+  /// parser uses more than \p bytes of native stack, counted from the first
+  /// nested construct, or remove the limit if \p bytes is 0. With a limit
+  /// below the size of the thread's stack, a high setMaxParseDepth() can be
+  /// used on any thread without risking a stack overflow.
+  void setParseStackLimit(size_t bytes) {
+    parseStackLimit_ = bytes;
+  }
+
+  /// \return the budget charged for the memory of the AST and identifier
+  ///   allocators and of the lexer's token and comment storage. Its peak is
+  ///   the high-water mark of the Context.
+  MemoryBudget &getMemoryBudget() {
+    return memoryBudget_;
+  }
+
+  /// Make a parse fail with a "memory budget exceeded" error once the
+  /// Context holds more than \p bytes, or remove the limit if \p bytes is 0.
+  /// The memory includes the first slab of each allocator and the slabs kept
+  /// from earlier parses. It is checked when the ParseInterrupt is polled, so
+  /// a parse may exceed the limit by what a few hundred tokens allocate; an
+  /// interrupt is created if none was set.
+  void setMemoryLimit(uint64_t bytes) {
+    memoryBudget_.setLimit(bytes);
+    if (bytes != 0 && !parseInterrupt_)
+      parseInterrupt_ = std::make_shared<parser::ParseInterrupt>();
+  }
+
+  /// Make the current contents of the string table permanent: later calls to
+  /// resetParseState() only remove the strings added after this point. It is
+  /// normally called once, after JSParser::initializeKnownIdentifiers().
+  void setStringTableCheckpoint() {
+    if (hasStringTableCheckpoint_) {
+      stringTable_.clearCheckpoint();
+      identifierAllocator_.commitScope();
+    }
+    identifierAllocator_.pushScope();
+    stringTable_.setCheckpoint();
+    hasStringTableCheckpoint_ = true;
+    knownIdentifiersBeforeCheckpoint_ = knownIdentifiers_ != nullptr;
+  }
+
+  /// Prepare the Context for another, unrelated parse. All AST nodes are
+  /// freed, but the allocator keeps its slabs, unless the memory limit was
+  /// exceeded; pre-parsed data and compiled regexps are dropped; the parse
+  /// interrupt is cleared; and if there is a string table checkpoint, the
+  /// strings added after it are removed. Settings are kept.
+  /// Nothing allocated by the previous parses may be used afterwards.
+  void resetParseState() {
+    allocator_.reset();
+    preParsed_.reset();
+    compiledRegExps_.clear();
+    if (parseInterrupt_)
+      parseInterrupt_->clear();
+    if (hasStringTableCheckpoint_) {
+      stringTable_.rollbackToCheckpoint();
+      identifierAllocator_.popScope();
+      identifierAllocator_.pushScope();
+      if (!knownIdentifiersBeforeCheckpoint_)
+        knownIdentifiers_.reset();
+    }
+    // Don't let one oversized parse make every later one fail.
+    if (memoryBudget_.isExceeded()) {
+      allocator_.releaseUnusedSlabs();
+      identifierAllocator_.releaseUnusedSlabs();
+    }
+  }
+
   void addCompiledRegExp(
       UniqueString *pattern,
       UniqueString *flags,
@@ -406,6 +578,9 @@ class Context {
   bool getParseFlowAmbiguous() const {
     return parseFlow_ == ParseFlowSetting::ALL;
   }
+  ParseFlowSetting getParseFlowSetting() const {
+    return parseFlow_;
+  }
 
   void setParseFlowComponentSyntax(bool parseFlowComponentSyntax) {
     parseFlowComponentSyntax_ = parseFlowComponentSyntax;
@@ -438,6 +613,17 @@ class Context {
     return getParseFlow() || getParseTS();
   }
 
+  void setTypeSyntax(TypeSyntaxSetting typeSyntax) {
+    typeSyntax_ = typeSyntax;
+  }
+  TypeSyntaxSetting getTypeSyntax() const {
+    return typeSyntax_;
+  }
+  /// \return true if types are parsed but left out of the AST.
+  bool getSkipTypes() const {
+    return getParseTypes() && typeSyntax_ == TypeSyntaxSetting::SKIP;
+  }
+
   bool isLazyCompilation() const {
     return lazyCompilation_;
   }
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_PARSER_DOCBLOCK_H
+#define HERMES_PARSER_DOCBLOCK_H
+
+#include "hermes/Parser/JSLexer.h"
+#include "llvh/ADT/STLExtras.h"
+#include "llvh/ADT/StringRef.h"
+
+#include <cstdint>
+
+namespace hermes {
+namespace parser {
+
+/// A pragma recognized by scanDocBlock(), such as "@flow".
+enum DocBlockPragma : uint8_t {
+  /// @flow
+  DocBlockFlow = 1 << 0,
+  /// @noflow
+  DocBlockNoFlow = 1 << 1,
+  /// @format
+  DocBlockFormat = 1 << 2,
+  /// @generated
+  DocBlockGenerated = 1 << 3,
+};
+
+/// A comment of a docblock, pointing into the source.
+struct DocBlockComment {
+  StoredComment::Kind kind;
+  /// The comment with its delimiters (//, /*, */, #!).
+  llvh::StringRef text;
+
+  /// \return the comment without its delimiters, as
+  ///   StoredComment::getString() does.
+  llvh::StringRef getString() const {
+    llvh::StringRef string = text.drop_front(2);
+    // An unterminated block comment has no "*/".
+    if (kind == StoredComment::Kind::Block)
+      string.consume_back("*/");
+    return string;
+  }
+};
+
+/// The result of scanDocBlock().
+struct DocBlock {
+  /// The number of comments in the docblock.
+  unsigned numComments = 0;
+  /// The offset of the first token that is not part of the directive
+  /// prologue, or the size of the source if there is none.
+  size_t end = 0;
+  /// The DocBlockPragma flags of the pragmas in the comments.
+  uint8_t pragmas = 0;
+
+  bool hasPragma(DocBlockPragma pragma) const {
+    return pragmas & pragma;
+  }
+};
+
+/// Scan the docblock of \p source: the comments before its first token that
+/// is not a directive, as JSLexer would store them. Nothing is allocated,
+/// and only the docblock and directives are read, so this can run on many
+/// sources at once, in any number of threads.
+/// \param onComment if set, called with every comment of the docblock, in
+///   order.
+/// \param onPragma if set, called with every pragma of the docblock, in
+///   order: the name after an '@' in a comment other than the hashbang,
+///   made of letters, digits and '_', such as "flow" or "format". The name
+///   points into \p source.
+/// \return the number of comments, their end, and the pragmas recognized.
+DocBlock scanDocBlock(
+    llvh::StringRef source,
+    llvh::function_ref<void(const DocBlockComment &comment)> onComment =
+        nullptr,
+    llvh::function_ref<void(
+        llvh::StringRef name,
+        const DocBlockComment &comment)> onPragma = nullptr);
+
+/// Find the pragmas in \p comment, see scanDocBlock().
+/// \return the DocBlockPragma flags of the recognized ones.
+uint8_t scanPragmas(
+    const DocBlockComment &comment,
+    llvh::function_ref<void(
+        llvh::StringRef name,
+        const DocBlockComment &comment)> onPragma = nullptr);
+
+} // namespace parser
+} // namespace hermes
+
+#endif
@@ -21,7 +21,8 @@ class Context;
 namespace hermes {
 namespace parser {
 
-/// \return the comments in the \p bufferId file in the context.
+/// \return the comments in the docblock of the \p bufferId file in the
+/// context, see scanDocBlock().
 /// Each StoredComment contains pointers directly into the buffer.
 std::vector<StoredComment> getCommentsInDocBlock(
     Context &context,
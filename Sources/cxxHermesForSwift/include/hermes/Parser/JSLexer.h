@@ -9,7 +9,10 @@
 #define HERMES_PARSER_JSLEXER_H
 
 #include "hermes/AST/Config.h"
+#include "hermes/Parser/ParseInterrupt.h"
+#include "hermes/Parser/ParseStats.h"
 #include "hermes/Support/Allocator.h"
+#include "hermes/Support/MemoryBudget.h"
 #include "hermes/Support/OptValue.h"
 #include "hermes/Support/SourceErrorManager.h"
 #include "hermes/Support/StringTable.h"
@@ -734,6 +737,101 @@ class StoredToken {
   SMRange range_;
 };
 
+/// The source range of Flow or TypeScript syntax that the parser recognized
+/// and left out of the AST, because the Context skips types. Removing every
+/// range from the source leaves plain JavaScript.
+class SkippedType {
+ public:
+  enum class Kind : uint8_t {
+    /// A type annotation, including its colon: `: T`, a return type, a
+    /// predicate, the type of a Flow type cast, or a `this` parameter with
+    /// its comma.
+    Annotation,
+    /// Type parameters of a declaration: `<T>`.
+    TypeParameters,
+    /// Type arguments of a call, `new`, superclass or JSX element: `<T>`.
+    TypeArguments,
+    /// A cast or assertion: `as T`, or `<T>` before an expression.
+    Cast,
+    /// The `implements` clause of a class.
+    Implements,
+    /// A statement or class member that only declares types: type aliases,
+    /// interfaces, `declare`, and type imports and exports. Also a `type` or
+    /// `typeof` import specifier, with its comma.
+    Declaration,
+    /// A marker that only means something to the type checker: the `?` of an
+    /// optional parameter or property, a Flow variance sigil, or a
+    /// TypeScript accessibility or `readonly` modifier.
+    Modifier,
+  };
+
+  SkippedType(Kind kind, SMRange range) : kind_(kind), range_(range) {}
+
+  Kind getKind() const {
+    return kind_;
+  }
+
+  SMRange getSourceRange() const {
+    return range_;
+  }
+
+ private:
+  Kind kind_;
+  SMRange range_;
+};
+
+/// A module that the program depends on, recorded by the parser when it
+/// collects dependencies (see JSParser::scanDependencies()).
+class ModuleDependency {
+ public:
+  enum class Kind : uint8_t {
+    /// `import ... from 'm'` or `import 'm'`.
+    Import,
+    /// `export ... from 'm'`.
+    Export,
+    /// `import('m')`.
+    DynamicImport,
+    /// `require('m')`.
+    Require,
+  };
+
+  ModuleDependency(
+      Kind kind,
+      bool typeOnly,
+      UniqueString *specifier,
+      SMRange range)
+      : kind_(kind),
+        typeOnly_(typeOnly),
+        specifier_(specifier),
+        range_(range) {}
+
+  Kind getKind() const {
+    return kind_;
+  }
+
+  /// \return whether only types are imported or exported from the module,
+  ///   as in `import type {T} from 'm'`.
+  bool isTypeOnly() const {
+    return typeOnly_;
+  }
+
+  /// \return the module specifier, the value of the string literal.
+  UniqueString *getSpecifier() const {
+    return specifier_;
+  }
+
+  /// \return the range of the string literal, including its quotes.
+  SMRange getSourceRange() const {
+    return range_;
+  }
+
+ private:
+  Kind kind_;
+  bool typeOnly_;
+  UniqueString *specifier_;
+  SMRange range_;
+};
+
 class JSLexer {
  public:
   using Allocator = hermes::BumpPtrAllocator;
@@ -764,6 +862,15 @@ class JSLexer {
   /// Whether to store the tokens as we lex.
   bool storeTokens_{false};
 
+  /// If set, polled every InterruptPollInterval tokens.
+  ParseInterrupt *interrupt_{nullptr};
+
+  /// The number of tokens until the next call to pollInterrupt().
+  uint32_t interruptCountdown_{InterruptPollInterval};
+
+  /// If set, counts tokens and save points.
+  ParseStats *stats_{nullptr};
+
   /// If true, when a surrogate pair sequence is encountered in a string literal
   /// in the source, convert that string literal to its canonical UTF-8
   /// sequence.
@@ -809,6 +916,17 @@ class JSLexer {
   /// Storage for tokens we store when storeTokens_ == true.
   std::vector<StoredToken> tokenStorage_{};
 
+  /// Types skipped by the parser. They are kept by the lexer, like stored
+  /// comments and tokens, so that a SavePoint can roll them back.
+  std::vector<SkippedType> skippedTypes_{};
+
+  /// Module dependencies recorded by the parser, kept for the same reason.
+  std::vector<ModuleDependency> dependencies_{};
+
+  /// The capacity of commentStorage_, tokenStorage_, skippedTypes_ and
+  /// dependencies_, as last charged to a memory budget by pollInterrupt().
+  MemoryBudget::Charge storageCharge_{};
+
  public:
   /// \param convertSurrogates See member variable \p convertSurrogates_.
   explicit JSLexer(
@@ -867,6 +985,21 @@ class JSLexer {
   Allocator &getAllocator() {
     return allocator_;
   }
+
+  /// Free what the allocator allocated since its last pushScope(). The
+  /// current token was usually lexed in that scope, so if it is a regexp
+  /// literal, the only kind of token that owns memory in the allocator, the
+  /// literal is copied out of the scope first.
+  void popAllocationScope() {
+    if (LLVM_LIKELY(token_.getKind() != TokenKind::regexp_literal)) {
+      allocator_.popScope();
+      return;
+    }
+    RegExpLiteral literal = *token_.getRegExpLiteral();
+    allocator_.popScope();
+    token_.setRegExpLiteral(
+        new (allocator_.Allocate<RegExpLiteral>(1)) RegExpLiteral(literal));
+  }
   StringTable &getStringTable() {
     return strTab_;
   }
@@ -879,6 +1012,10 @@ class JSLexer {
     strictMode_ = strictMode;
   }
 
+  bool getStoreComments() const {
+    return storeComments_;
+  }
+
   void setStoreComments(bool storeComments) {
     storeComments_ = storeComments;
   }
@@ -934,6 +1071,26 @@ class JSLexer {
     curCharPtr_ = bufferEnd_;
   }
 
+  /// Poll \p interrupt every few hundred tokens and stop when it fires.
+  void setInterrupt(ParseInterrupt *interrupt) {
+    interrupt_ = interrupt;
+  }
+
+  /// Count tokens and speculative parses in \p stats, if it is not null.
+  void setStats(ParseStats *stats) {
+    stats_ = stats;
+  }
+
+  /// Charge the token, comment and skipped type storage to \p budget, if it
+  /// is not null, whenever the interrupt is polled. \p budget must outlive the lexer.
+  void setMemoryBudget(MemoryBudget *budget) {
+    storageCharge_.setBudget(budget);
+  }
+
+  /// Report the reason the parse was interrupted as a fatal error at the
+  /// current token, and force an EOF at every following token.
+  void stopForInterrupt(ParseInterrupt::Reason reason);
+
   /// Grammar context to be passed to advance().
   /// - AllowRegExp: RegExp can follow
   /// - AllowDiv: "/" can follow
@@ -987,10 +1144,12 @@ class JSLexer {
   OptValue<TokenKind> lookahead1(OptValue<TokenKind> expectedToken);
 
   UniqueString *getIdentifier(llvh::StringRef name) {
+    pollAfterLargeString(name.size());
     return strTab_.getString(name);
   }
 
   UniqueString *getStringLiteral(llvh::StringRef str) {
+    pollAfterLargeString(str.size());
     if (LLVM_UNLIKELY(convertSurrogates_)) {
       return convertSurrogatesInString(str);
     }
@@ -1044,6 +1203,71 @@ class JSLexer {
     return commentStorage_;
   }
 
+  /// Record that the parser skipped the type at \p range.
+  void storeSkippedType(SkippedType::Kind kind, SMRange range) {
+    // Types are skipped in source order, except for a modifier, which may be
+    // found to be one after the type that follows it has been skipped.
+    auto pos = skippedTypes_.end();
+    while (LLVM_UNLIKELY(pos != skippedTypes_.begin()) &&
+           LLVM_UNLIKELY(
+               (pos - 1)->getSourceRange().Start.getPointer() >
+               range.Start.getPointer())) {
+      --pos;
+    }
+    skippedTypes_.emplace(pos, kind, range);
+  }
+
+  /// \return the types skipped to this point, in source order.
+  llvh::ArrayRef<SkippedType> getSkippedTypes() const {
+    return skippedTypes_;
+  }
+
+  /// Forget the skipped types after the first \p count.
+  void truncateSkippedTypes(size_t count) {
+    assert(count <= skippedTypes_.size() && "truncating past the end");
+    skippedTypes_.erase(skippedTypes_.begin() + count, skippedTypes_.end());
+  }
+
+  /// \return the skipped types, moving them out of the lexer.
+  std::vector<SkippedType> moveSkippedTypes() {
+    std::vector<SkippedType> result{};
+    std::swap(result, skippedTypes_);
+    return result;
+  }
+
+  /// Record that the program depends on a module. Dependencies are recorded
+  /// in source order, so when the parser goes back and parses the same source
+  /// again, the dependencies recorded from it the first time are replaced.
+  void storeDependency(
+      ModuleDependency::Kind kind,
+      bool typeOnly,
+      UniqueString *specifier,
+      SMRange range) {
+    while (!dependencies_.empty() &&
+           dependencies_.back().getSourceRange().Start.getPointer() >=
+               range.Start.getPointer())
+      dependencies_.pop_back();
+    dependencies_.emplace_back(kind, typeOnly, specifier, range);
+  }
+
+  /// \return the dependencies recorded to this point, in source order.
+  llvh::ArrayRef<ModuleDependency> getDependencies() const {
+    return dependencies_;
+  }
+
+  /// Forget the dependencies after the first \p count.
+  void truncateDependencies(size_t count) {
+    assert(count <= dependencies_.size() && "truncating past the end");
+    dependencies_.erase(dependencies_.begin() + count, dependencies_.end());
+  }
+
+  /// \return the dependencies, moving them out of the lexer.
+  std::vector<ModuleDependency> moveDependencies() {
+    std::vector<ModuleDependency> result{};
+    std::swap(result, dependencies_);
+    return result;
+  }
+
   /// \return any stored comments to this point.
   llvh::ArrayRef<StoredToken> getStoredTokens() const {
     return tokenStorage_;
@@ -1078,6 +1302,17 @@ class JSLexer {
     /// If we backtrack, we must also delete the previously stored tokens.
     size_t tokenStorageSize_;
 
+    /// The number of skipped types, which are removed as well.
+    size_t skippedTypesSize_;
+
+    /// The number of dependencies, which are removed as well.
+    size_t dependenciesSize_;
+
+    /// The number of tokens lexed before the save point, to count the tokens
+    /// that will be lexed again if it is restored. Declared whatever
+    /// HERMES_PARSE_STATS is, so that the layout is the same in every build.
+    uint64_t tokensLexed_{0};
+
    public:
     SavePoint(JSLexer *lexer)
         : lexer_(lexer),
@@ -1090,7 +1325,13 @@ class JSLexer {
           range_(lexer_->getCurToken()->getSourceRange()),
           prevTokenEndLoc_(lexer->getPrevTokenEndLoc()),
           commentStorageSize_(lexer->getStoredComments().size()),
-          tokenStorageSize_(lexer_->getStoredTokens().size()) {
+          tokenStorageSize_(lexer_->getStoredTokens().size()),
+          skippedTypesSize_(lexer_->skippedTypes_.size()),
+          dependenciesSize_(lexer_->dependencies_.size()) {
+#if HERMES_PARSE_STATS
+      tokensLexed_ = lexer_->stats_ ? lexer_->stats_->tokensLexed : 0;
+      HERMES_PARSE_STAT(lexer_->stats_, speculativeAttempts++);
+#endif
       assert(
           (isPunctuatorDbg(kind_) || kind_ == TokenKind::identifier ||
            kind_ == TokenKind::rw_extends) &&
@@ -1099,6 +1340,12 @@ class JSLexer {
 
     /// Restore the state of the lexer to the originally saved state.
     void restore() {
+#if HERMES_PARSE_STATS
+      if (ParseStats *stats = lexer_->stats_) {
+        ++stats->speculativeFailures;
+        stats->tokensRelexed += stats->tokensLexed - tokensLexed_;
+      }
+#endif
       if (kind_ == TokenKind::identifier) {
         lexer_->unsafeSetIdentifier(ident_, loc_, range_);
       } else if (kind_ == TokenKind::rw_extends) {
@@ -1121,6 +1368,18 @@ class JSLexer {
             lexer_->tokenStorage_.begin() + tokenStorageSize_,
             lexer_->tokenStorage_.end());
       }
+
+      if (LLVM_UNLIKELY(skippedTypesSize_ < lexer_->skippedTypes_.size())) {
+        lexer_->skippedTypes_.erase(
+            lexer_->skippedTypes_.begin() + skippedTypesSize_,
+            lexer_->skippedTypes_.end());
+      }
+
+      if (LLVM_UNLIKELY(dependenciesSize_ < lexer_->dependencies_.size())) {
+        lexer_->dependencies_.erase(
+            lexer_->dependencies_.begin() + dependenciesSize_,
+            lexer_->dependencies_.end());
+      }
     }
   };
 
@@ -1134,10 +1393,6 @@ class JSLexer {
     token_.setIdentOp(kind);
   }
 
- private:
-  /// Initialize the storage with the characters between \p begin and \p end.
-  inline void initStorageWith(const char *begin, const char *end);
-
   /// Encode a Unicode codepoint into a UTF8 sequence and append it to \p
   /// storage. Code points above 0xFFFF are encoded into UTF16, and the
   /// resulting surrogate pair values are encoded individually into UTF8.
@@ -1145,6 +1400,29 @@ class JSLexer {
       uint32_t cp,
       llvh::SmallVectorImpl<char> &storage);
 
+ private:
+  /// How many tokens are lexed between two polls of interrupt_.
+  static constexpr uint32_t InterruptPollInterval = 256;
+
+  /// Identifiers and literals at least this long are interned only after a
+  /// poll of interrupt_ has been scheduled.
+  static constexpr size_t LargeStringSize = 4096;
+
+  /// Charge the token, comment and skipped type storage to the memory budget,
+  /// poll interrupt_, if there is one, and restart the countdown.
+  void pollInterrupt();
+
+  /// Make the next advance() poll interrupt_ if a string of \p size bytes is
+  /// large, so that a single huge token cannot exceed the memory budget
+  /// unnoticed until the next regular poll, or the end of the input.
+  void pollAfterLargeString(size_t size) {
+    if (LLVM_UNLIKELY(size >= LargeStringSize))
+      interruptCountdown_ = 1;
+  }
+
+  /// Initialize the storage with the characters between \p begin and \p end.
+  inline void initStorageWith(const char *begin, const char *end);
+
   /// Encode a Unicode codepoint into a UTF8 sequence and append it to \ref
   /// tmpStorage_. Code points above 0xFFFF are encoded into UTF16, and the
   /// resulting surrogate pair values are encoded individually into UTF8.
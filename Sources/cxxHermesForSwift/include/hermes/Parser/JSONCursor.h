@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_PARSER_JSONCURSOR_H
+#define HERMES_PARSER_JSONCURSOR_H
+
+#include "hermes/Parser/JSONParser.h"
+#include "hermes/Support/SourceErrorManager.h"
+
+#include "llvh/ADT/Optional.h"
+#include "llvh/ADT/SmallVector.h"
+#include "llvh/ADT/StringRef.h"
+#include "llvh/Support/MemoryBuffer.h"
+
+#include <memory>
+
+namespace hermes {
+namespace parser {
+
+/// A forward-only, on-demand reader of a JSON document.
+///
+/// Unlike JSONParser, nothing is materialized up front: the cursor walks the
+/// text, and values are decoded only when one of the get*() methods is
+/// called. Subtrees that are not needed are passed over by skipValue(), which
+/// only balances brackets and steps over string literals, so skipped data is
+/// neither validated nor allocated.
+///
+/// Typical use:
+/// \code
+///   JSONCursor cur(buffer, sm);
+///   if (cur.enterObject() && cur.findField("version"))
+///     version = cur.getString(storage);
+/// \endcode
+///
+/// Containers are entered with enterObject()/enterArray() and iterated with
+/// nextKey()/findField() and nextElement(). A value that is reached but not
+/// consumed is skipped automatically by the next iteration call. A container
+/// that is abandoned before its end must be left with exitContainer() before
+/// the enclosing container can be iterated again.
+///
+/// Errors are reported to the SourceErrorManager. After the first error all
+/// operations fail.
+class JSONCursor {
+ public:
+  JSONCursor(std::unique_ptr<llvh::MemoryBuffer> input, SourceErrorManager &sm);
+
+  JSONCursor(llvh::StringRef input, SourceErrorManager &sm)
+      : JSONCursor(llvh::MemoryBuffer::getMemBuffer(input, "json"), sm) {}
+
+  /// \return true if an error has been reported.
+  bool hasError() const {
+    return hasError_;
+  }
+
+  /// \return the kind of the next value without consuming it, or None on
+  ///   error or at the end of a container.
+  llvh::Optional<JSONKind> peekKind();
+
+  /// Consume the '{' of the next value. It is an error if the next value is
+  /// not an object.
+  bool enterObject();
+
+  /// Consume the '[' of the next value. It is an error if the next value is
+  /// not an array.
+  bool enterArray();
+
+  /// Move to the next property of the current object, skipping the value of
+  /// the previous property if it was not consumed. On success the cursor is
+  /// positioned at the property value.
+  /// \param key set to the property name. It refers to the input when the
+  ///   name contains no escapes, otherwise to \p storage.
+  /// \return false at the end of the object (which is consumed) or on error.
+  bool nextKey(llvh::StringRef &key, llvh::SmallVectorImpl<char> &storage);
+
+  /// Skip properties of the current object until one named \p name is found,
+  /// leaving the cursor at its value. Only the properties that follow the
+  /// current position are examined.
+  /// \return false if the end of the object was reached (and consumed) first.
+  bool findField(llvh::StringRef name);
+
+  /// Move to the next element of the current array, skipping the previous
+  /// element if it was not consumed.
+  /// \return false at the end of the array (which is consumed) or on error.
+  bool nextElement();
+
+  /// Skip the remaining members of the current container and consume its
+  /// closing bracket.
+  bool exitContainer();
+
+  /// Skip the next value without decoding it.
+  bool skipValue();
+
+  /// Decode the next value as a string. The result refers to the input when
+  /// the string contains no escapes, otherwise to \p storage. Escaped
+  /// surrogate pairs are combined and unpaired surrogates are replaced with
+  /// U+FFFD, so the result is UTF-8 if the input is.
+  llvh::Optional<llvh::StringRef> getString(
+      llvh::SmallVectorImpl<char> &storage);
+
+  /// Decode the next value as a number.
+  llvh::Optional<double> getNumber();
+
+  /// Decode the next value as a boolean.
+  llvh::Optional<bool> getBoolean();
+
+  /// Consume the next value, which must be null.
+  bool getNull();
+
+  /// Materialize the next value and its whole subtree with \p factory,
+  /// parsing it in place in the input with
+  /// JSONParserEngine::StructuralIndex.
+  llvh::Optional<JSONValue *> getValue(JSONFactory &factory);
+
+ private:
+  /// A container that has been entered but not exited.
+  struct Level {
+    bool isObject;
+    /// No member has been reached yet, so no ',' is expected.
+    bool first;
+  };
+
+  SourceErrorManager &sm_;
+
+  /// Current position and end of the input. *end_ is '\0'.
+  const char *cur_;
+  const char *end_;
+
+  llvh::SmallVector<Level, 8> levels_{};
+
+  /// The cursor is at a value reached by nextKey() or nextElement() that has
+  /// not been consumed yet.
+  bool valuePending_ = false;
+
+  bool hasError_ = false;
+
+  /// Report \p msg at \p at and put the cursor in the error state.
+  bool error(const char *at, const llvh::Twine &msg);
+
+  /// Skip whitespace and \return the next character.
+  char skipWhitespace();
+
+  /// Called before consuming a value.
+  /// \return false if the cursor is in the error state.
+  bool beginValue();
+
+  /// Skip an unconsumed value and the ',' before the next member of the
+  /// current container.
+  /// \return false at the closing bracket (which is consumed) or on error.
+  bool advanceToMember();
+
+  /// Consume a property name and the following ':'. The name is decoded into
+  /// \p storage if necessary, or returned raw (with escapes) if \p storage is
+  /// null.
+  llvh::Optional<llvh::StringRef> scanKey(llvh::SmallVectorImpl<char> *storage);
+
+  /// Consume a string literal at the cursor. It is decoded into \p storage
+  /// if it contains escapes, or returned raw (with escapes) if \p storage is
+  /// null.
+  llvh::Optional<llvh::StringRef> scanString(
+      llvh::SmallVectorImpl<char> *storage);
+};
+
+} // namespace parser
+} // namespace hermes
+
+#endif // HERMES_PARSER_JSONCURSOR_H
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_PARSER_JSONLINESREADER_H
+#define HERMES_PARSER_JSONLINESREADER_H
+
+#include "hermes/Parser/JSONParser.h"
+
+#include "llvh/ADT/StringRef.h"
+#include "llvh/Support/MemoryBuffer.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace hermes {
+namespace parser {
+
+/// Options controlling JSONLinesReader.
+struct JSONLinesOptions {
+  /// Number of worker threads. Zero means one per hardware thread.
+  unsigned numThreads = 0;
+
+  /// The input is divided into chunks of about this many bytes. Each chunk
+  /// is extended to the end of the line it ends in.
+  size_t chunkSize = 4 * 1024 * 1024;
+
+  /// Maximum number of chunks that have been claimed by a worker but not yet
+  /// delivered. Workers wait when the limit is reached, which bounds the
+  /// memory used when the callback is slower than parsing. Zero means twice
+  /// the number of threads.
+  unsigned maxChunksInFlight = 0;
+
+  /// Deliver records in input order. Otherwise the records of a chunk are
+  /// delivered as soon as the chunk has been parsed, though records within a
+  /// chunk always stay in order.
+  bool ordered = true;
+
+  /// Replace surrogates in strings, as with JSONParser.
+  bool convertSurrogates = false;
+};
+
+/// Reads newline-delimited JSON (JSON Lines), such as the output of
+/// JSONEmitter::endJSONL(), in parallel.
+///
+/// The input is divided into chunks at line boundaries. Worker threads parse
+/// whole chunks with the structural-index engine, each chunk into its own
+/// arena and JSONFactory, and the records are handed back as JSONSharedValue,
+/// which keeps the arena of the chunk alive. Blank lines are ignored.
+///
+/// Callbacks are always invoked on the thread that called read(), one at a
+/// time, so they need no synchronization.
+class JSONLinesReader {
+ public:
+  /// Invoked for every record with the byte offset of its line in the input.
+  /// \return false to stop reading.
+  using RecordCallback =
+      std::function<bool(size_t offset, JSONSharedValue value)>;
+
+  /// Invoked for every line that fails to parse, with the byte offset of the
+  /// line and the error message.
+  /// \return false to stop reading.
+  using ErrorCallback =
+      std::function<bool(size_t offset, llvh::StringRef message)>;
+
+  explicit JSONLinesReader(JSONLinesOptions options = {});
+
+  /// Read the file at \p path, which is memory-mapped when possible.
+  /// \return false if the file could not be read, if reading was stopped by
+  ///   a callback, or if a line failed to parse and there is no
+  ///   \p onError callback.
+  bool readFile(
+      llvh::StringRef path,
+      const RecordCallback &onRecord,
+      const ErrorCallback &onError = nullptr);
+
+  /// Read \p buffer, which must be zero terminated.
+  /// \return false if reading was stopped by a callback, or if a line failed
+  ///   to parse and there is no \p onError callback.
+  bool read(
+      const llvh::MemoryBuffer &buffer,
+      const RecordCallback &onRecord,
+      const ErrorCallback &onError = nullptr);
+
+  /// \return the message explaining why the last read failed, if it failed
+  ///   before any line was parsed.
+  const std::string &getErrorMessage() const {
+    return errorMessage_;
+  }
+
+  /// \return the largest number of chunks that were in flight at once during
+  ///   the last read, which is at most JSONLinesOptions::maxChunksInFlight.
+  size_t getPeakChunksInFlight() const {
+    return peakChunksInFlight_;
+  }
+
+ private:
+  JSONLinesOptions options_;
+
+  /// See getErrorMessage().
+  std::string errorMessage_{};
+
+  /// See getPeakChunksInFlight().
+  size_t peakChunksInFlight_ = 0;
+};
+
+} // namespace parser
+} // namespace hermes
+
+#endif // HERMES_PARSER_JSONLINESREADER_H
@@ -22,7 +22,6 @@
 #include "hermes/Support/JSONEmitter.h"
 
 #include "llvh/ADT/DenseMap.h"
-#include "llvh/ADT/FoldingSet.h"
 #include "llvh/ADT/Optional.h"
 #include "llvh/ADT/StringRef.h"
 #include "llvh/Support/Casting.h"
@@ -114,7 +113,7 @@ class JSONBoolean : public JSONScalar {
   }
 };
 
-class JSONString : public JSONScalar, public llvh::FoldingSetNode {
+class JSONString : public JSONScalar {
   UniqueString *const value_;
 
  public:
@@ -135,20 +134,12 @@ class JSONString : public JSONScalar, public llvh::FoldingSetNode {
     return value_->c_str();
   }
 
-  static void Profile(llvh::FoldingSetNodeID &id, UniqueString *str) {
-    id.AddPointer(str);
-  }
-
-  void Profile(llvh::FoldingSetNodeID &id) {
-    JSONString::Profile(id, value_);
-  }
-
   static bool classof(const JSONValue *v) {
     return v->getKind() == JSONKind::String;
   }
 };
 
-class JSONNumber : public JSONScalar, public llvh::FoldingSetNode {
+class JSONNumber : public JSONScalar {
   double const value_;
 
  public:
@@ -162,14 +153,6 @@ class JSONNumber : public JSONScalar, public llvh::FoldingSetNode {
     return getValue();
   }
 
-  static void Profile(llvh::FoldingSetNodeID &id, double value) {
-    id.AddInteger(llvh::DoubleToBits(value));
-  }
-
-  void Profile(llvh::FoldingSetNodeID &id) {
-    JSONNumber::Profile(id, value_);
-  }
-
   static bool classof(const JSONValue *v) {
     return v->getKind() == JSONKind::Number;
   }
@@ -550,12 +533,59 @@ class JSONFactory {
   StringTable &strTab_;
 
   // Unique the strings and numbers as there are likely to be many duplicates.
-  llvh::FoldingSet<JSONString> strings_;
-  llvh::FoldingSet<JSONNumber> numbers_;
+
+  /// Strings keyed by the UniqueString they wrap, so the parser, which gets
+  /// its strings interned by the lexer, finds them without hashing their
+  /// text.
+  llvh::DenseMap<UniqueString *, JSONString *> strings_{};
+
+  /// Strings looked up by text, keyed by the bytes owned by their
+  /// UniqueString. A hit takes a single probe; the StringTable and
+  /// \c strings_ are only consulted on a miss.
+  llvh::DenseMap<llvh::StringRef, JSONString *> stringsByText_{};
+
+  /// An open-addressing table of numbers keyed on the bit pattern of their
+  /// value, with linear probing. Empty slots are null. Its capacity is always
+  /// a power of two.
+  std::unique_ptr<JSONNumber *[]> numbers_{};
+  uint32_t numbersCapacity_ = 0;
+  uint32_t numbersSize_ = 0;
+
+  /// Numbers for the small non-negative integers, which dominate most JSON
+  /// documents, indexed by value.
+  static constexpr unsigned kSmallIntCacheSize = 256;
+  JSONNumber *smallInts_[kSmallIntCacheSize] = {};
 
   std::map<HiddenClassKey, JSONHiddenClass *, LessHiddenClassKey>
       hiddenClasses_;
 
+  /// A node in the tree of key insertion orders. The path from the root to a
+  /// node spells the keys of an object in the order they were passed to
+  /// newObject(), so objects created with a previously seen key order find
+  /// their hidden class in one hop per key, without sorting.
+  struct Transition {
+    /// The first successor and the key leading to it. Most nodes have a
+    /// single successor, so it is stored inline; any others are in
+    /// \c transitions_.
+    JSONString *firstKey = nullptr;
+    Transition *firstNext = nullptr;
+    /// The hidden class of objects whose keys arrive in this order, or
+    /// nullptr if it hasn't been computed yet.
+    JSONHiddenClass *hiddenClass = nullptr;
+    /// For every key in insertion order, its index in \c hiddenClass.
+    uint32_t *slots = nullptr;
+    /// The keys leading to this node contain a duplicate.
+    bool hasDuplicate = false;
+  };
+
+  /// The transition for objects without keys.
+  Transition rootTransition_{};
+
+  /// Successors other than the first, keyed by the node they start from and
+  /// the key leading to them.
+  llvh::DenseMap<std::pair<Transition *, JSONString *>, Transition *>
+      transitions_{};
+
  public:
   explicit JSONFactory(Allocator &allocator, StringTable *strTab = nullptr);
 
@@ -583,16 +613,34 @@ class JSONFactory {
   /// Lookup or create a hidden class identified by the key \p key.
   JSONHiddenClass *getHiddenClass(const HiddenClassKey &key);
 
+ private:
+  /// \return the successor of \p from for \p key, creating it if needed.
+  Transition *getTransition(Transition *from, JSONString *key);
+
+  /// Compute the hidden class and slot mapping of \p node, which was reached
+  /// by the keys of [from, to).
+  void initTransition(Transition *node, const Prop *from, const Prop *to);
+
+  /// Find or create the number with bit pattern \p bits in \c numbers_.
+  JSONNumber *internNumber(double value, uint64_t bits);
+
+  /// Double the capacity of \c numbers_ and rehash.
+  void growNumbers();
+
+ public:
+
   /// Sort a sequence of properties in-place, so they can be passed directly
   /// to \c newObject(). If there are duplicates, return a pointer to the first
   /// duplicate name, otherwise return null.
   static JSONString *sortProps(Prop *from, Prop *to);
 
-  /// Create an object described by the sequence of properties. The properties
-  /// are sorted first, and if there are duplicates the operation aborts and
-  /// returns nullptr.
+  /// Create an object described by the sequence of properties. The hidden
+  /// class is found by following the transitions for the keys in the order
+  /// they are supplied, so the properties are not reordered. If there are
+  /// duplicates the operation aborts and returns nullptr.
   /// \param propsAreSorted indicates that the properties are already sorted
-  ///   and checked for duplicates, so it doesn't need to be done again.
+  ///   and checked for duplicates, so the hidden class can be looked up
+  ///   directly.
   JSONObject *newObject(Prop *from, Prop *to, bool propsAreSorted = false);
 
   /// Create a new object of a particular hidden class, initializing it with a
@@ -627,12 +675,31 @@ class JSONFactory {
   }
 };
 
+/// Selects the algorithm JSONParser uses. Both produce identical trees for
+/// valid JSON. Otherwise they may differ: the lexer-based parser also accepts
+/// JavaScript strings, numbers and comments, such as 'a', 0x10 or .5, which
+/// the structural index rejects. Both accept trailing commas and ignore the
+/// input after the value.
+enum class JSONParserEngine {
+  /// Tokenize the input with JSLexer and parse recursively.
+  Lexer,
+  /// Build a SIMD structural index of the whole input first (see
+  /// JSONStructuralIndex), then build the tree from it without recursion.
+  StructuralIndex,
+};
+
 class JSONParser {
  private:
   JSONFactory &factory_;
   JSLexer lexer_;
   SourceErrorManager &sm_;
 
+  /// The algorithm used by parse().
+  JSONParserEngine engine_ = JSONParserEngine::Lexer;
+
+  /// Whether to replace surrogates in strings, as JSLexer does.
+  bool const convertSurrogates_;
+
  public:
   JSONParser(
       JSONFactory &factory,
@@ -663,6 +730,14 @@ class JSONParser {
   /// would have been reported to the SourceMgr.
   llvh::Optional<JSONValue *> parse();
 
+  /// Select the algorithm used by subsequent calls to parse().
+  void setEngine(JSONParserEngine engine) {
+    engine_ = engine;
+  }
+  JSONParserEngine getEngine() const {
+    return engine_;
+  }
+
   void error(const llvh::Twine &msg) {
     sm_.error(lexer_.getCurToken()->getSourceRange(), msg, Subsystem::Parser);
   }
@@ -671,8 +746,25 @@ class JSONParser {
   llvh::Optional<JSONValue *> parseValue();
   llvh::Optional<JSONValue *> parseArray();
   llvh::Optional<JSONValue *> parseObject();
+
+  /// Parse the whole buffer with JSONParserEngine::StructuralIndex.
+  llvh::Optional<JSONValue *> parseWithStructuralIndex();
 };
 
+/// Parse a single JSON value in \p input with
+/// JSONParserEngine::StructuralIndex, without creating a JSONParser or a lexer,
+/// so that a value can be parsed in place in a larger buffer. The byte
+/// following \p input must be readable and must be '\0' or JSON whitespace,
+/// e.g. the newline ending a record in a JSON Lines file. If the brackets in
+/// \p input are balanced, it may also be ',', ':' or a bracket, e.g. the
+/// separator after a member that JSONCursor skipped. Errors are reported to
+/// \p sm at locations in \p input.
+llvh::Optional<JSONValue *> parseJSONWithStructuralIndex(
+    JSONFactory &factory,
+    llvh::StringRef input,
+    SourceErrorManager &sm,
+    bool convertSurrogates = false);
+
 /// A holder class for a JSONValue backed by a shared allocator.
 class JSONSharedValue {
  public:
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_PARSER_JSONSTRUCTURALINDEX_H
+#define HERMES_PARSER_JSONSTRUCTURALINDEX_H
+
+#include <cstdint>
+#include <vector>
+
+#include "llvh/ADT/ArrayRef.h"
+#include "llvh/ADT/StringRef.h"
+
+namespace hermes {
+namespace parser {
+
+/// The first stage of the structural-index JSON engine.
+///
+/// The input is classified 64 bytes at a time (with SSE2 or NEON when
+/// available, otherwise with a lookup table) into bitmasks of quotes,
+/// backslashes, operators and whitespace. Escaped quotes are removed, string
+/// interiors are masked out with a prefix XOR, and what remains is the offset
+/// of every structural character `{ } [ ] : ,` and of the first byte of every
+/// scalar (string, number, `true`, `false`, `null`). The same pass validates
+/// UTF-8 and rejects unescaped control characters inside strings, so the
+/// second stage never has to re-check either.
+///
+/// The offsets are consumed in order by the tree builder in JSONParser, which
+/// never has to scan for delimiters or count nesting by itself.
+class JSONStructuralIndex {
+ public:
+  /// Index \p input. The byte following the input must be readable (it is
+  /// normally the terminating '\0' of a MemoryBuffer) but is not examined.
+  /// \return true on success; on failure getErrorMessage() and
+  ///   getErrorOffset() describe the first problem that was found.
+  bool build(llvh::StringRef input);
+
+  /// \return the offsets of structurals and scalar starts, in increasing
+  /// order.
+  llvh::ArrayRef<uint32_t> getPositions() const {
+    return positions_;
+  }
+
+  /// \return a description of the error encountered by the last build().
+  const char *getErrorMessage() const {
+    return errorMessage_;
+  }
+
+  /// \return the input offset of the error encountered by the last build().
+  uint32_t getErrorOffset() const {
+    return errorOffset_;
+  }
+
+ private:
+  /// Record an error at \p offset and return false.
+  bool error(size_t offset, const char *msg) {
+    errorOffset_ = (uint32_t)offset;
+    errorMessage_ = msg;
+    return false;
+  }
+
+  /// Offsets of the structural characters and scalar starts.
+  std::vector<uint32_t> positions_{};
+
+  /// The error message of the last failed build(), or nullptr.
+  const char *errorMessage_ = nullptr;
+
+  /// The input offset of the last failed build().
+  uint32_t errorOffset_ = 0;
+};
+
+/// Scan for the end of a string body using the same block classifier as
+/// JSONStructuralIndex.
+/// \return a pointer to the first '"' or '\\' in [p, end), or \p end if there
+///   is none.
+const char *findQuoteOrBackslash(const char *p, const char *end);
+
+/// Scan for the next string or bracket while skipping a subtree.
+/// \return a pointer to the first '"', '{', '}', '[' or ']' in [p, end), or
+///   \p end if there is none.
+const char *findQuoteOrBracket(const char *p, const char *end);
+
+/// Scan a JSON number starting at \p p, which must be before \p end.
+/// \param[out] value set to the value of the number.
+/// \return a pointer past the number, or nullptr if the text at \p p does
+///   not match the JSON number grammar. The character after the number is
+///   not checked.
+const char *scanJSONNumber(const char *p, const char *end, double &value);
+
+} // namespace parser
+} // namespace hermes
+
+#endif // HERMES_PARSER_JSONSTRUCTURALINDEX_H
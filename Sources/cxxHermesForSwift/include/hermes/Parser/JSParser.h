@@ -13,6 +13,7 @@
 #include "hermes/Parser/JSLexer.h"
 
 #include "llvh/ADT/Optional.h"
+#include "llvh/ADT/STLExtras.h"
 #include "llvh/ADT/StringRef.h"
 
 namespace hermes {
@@ -35,6 +36,36 @@ enum ParserPass {
   FullParse
 };
 
+/// What JSParser::parseStreaming() does with a top-level statement once its
+/// callback returns.
+enum class StatementAction {
+  /// Add the statement to the program.
+  Keep,
+  /// Free the statement: the callback is done with it and keeps no pointer
+  /// into it.
+  Release,
+};
+
+/// Called with every top-level statement of a program as soon as it has been
+/// parsed, see JSParser::parseStreaming().
+using StatementCallback =
+    llvh::function_ref<StatementAction(ESTree::Node *statement)>;
+
+/// A change to a source: \c removed bytes at \c offset were replaced with
+/// \c inserted bytes.
+struct SourceEdit {
+  size_t offset;
+  size_t removed;
+  size_t inserted;
+};
+
+/// \return whether \p edit turns \p oldSource into \p newSource: the sizes
+///   agree, and the text before and after the edit is the same in both.
+bool isEditOf(
+    llvh::StringRef oldSource,
+    llvh::StringRef newSource,
+    const SourceEdit &edit);
+
 /// An EcmaScript 5.1 parser.
 class JSParser {
   explicit JSParser(std::shared_ptr<detail::JSParserImpl> &&impl)
@@ -91,6 +122,27 @@ class JSParser {
 
   llvh::ArrayRef<StoredToken> getStoredTokens() const;
 
+  /// \return the types left out of the AST, in source order, when the
+  ///   Context skips types.
+  llvh::ArrayRef<SkippedType> getSkippedTypes() const;
+
+  std::vector<SkippedType> moveSkippedTypes() const;
+
+  /// Record the modules the program depends on while it is parsed.
+  void setCollectDependencies(bool collect);
+
+  /// Find the modules the program depends on, from its import and export
+  /// declarations and its `import()` and `require()` calls with a string
+  /// literal, without building an AST for the rest of it.
+  /// \return false if the program has errors.
+  bool scanDependencies();
+
+  /// \return the dependencies recorded by scanDependencies(), or by parse()
+  ///   if setCollectDependencies() was set, in source order.
+  llvh::ArrayRef<ModuleDependency> getDependencies() const;
+
+  std::vector<ModuleDependency> moveDependencies() const;
+
   void setStoreComments(bool storeComments);
 
   void setStoreTokens(bool storeTokens);
@@ -101,6 +153,52 @@ class JSParser {
 
   llvh::Optional<ESTree::ProgramNode *> parse();
 
+  /// Parse the program, and call \p callback with every top-level statement,
+  /// directives included, as soon as it has been parsed. Each statement is
+  /// allocated in a scope of its own, which is freed if the callback returns
+  /// StatementAction::Release, so a program whose statements are all released
+  /// never holds more than its largest statement in memory. Identifiers and
+  /// string literals are interned in the Context and outlive the statement.
+  /// \return the program, which only has the statements that were kept, or
+  ///   None on error. Statements that failed to parse are not passed to
+  ///   \p callback.
+  llvh::Optional<ESTree::ProgramNode *> parseStreaming(
+      StatementCallback callback);
+
+  /// Bring \p program, which was parsed from \p oldSource without errors, up
+  /// to date with the buffer of this parser, which must be \p oldSource with
+  /// \p edit applied. Only the statements around the edit are parsed again,
+  /// in the innermost program or block body that has a statement starting
+  /// before the edit; they replace the old ones in \p program, and the rest of
+  /// the AST is kept, with its source locations moved to the new buffer. If
+  /// the new statements don't end exactly where the old ones did, because the
+  /// edit changed more than those statements, or if \p edit does not turn
+  /// \p oldSource into the buffer, the whole buffer is parsed instead and
+  /// \p program is left as it is.
+  ///
+  /// If the buffer starts where \p oldSource did, it is \p oldSource edited
+  /// in place, which the caller must have checked with isEditOf() before the
+  /// edit. Then only the sizes are compared, and the locations before the edit,
+  /// which did not move, are not visited.
+  ///
+  /// The replaced statements stay allocated in the Context until it is reset.
+  /// Comments, tokens and dependencies are not stored for the statements that
+  /// are parsed again, so the whole buffer is parsed if any of them is.
+  /// \param oldSkippedTypes the types skipped by the parse of \p program, when
+  ///   the Context skips types. getSkippedTypes() returns those of the whole
+  ///   new buffer afterwards.
+  /// \return \p program, a new program if the whole buffer was parsed, or
+  ///   None on error.
+  llvh::Optional<ESTree::ProgramNode *> reparse(
+      ESTree::ProgramNode *program,
+      llvh::StringRef oldSource,
+      const SourceEdit &edit,
+      llvh::ArrayRef<SkippedType> oldSkippedTypes = {});
+
+  /// \return whether the last reparse() only parsed the statements around
+  ///   the edit.
+  bool wasReparsedIncrementally() const;
+
   void seek(SMLoc startPos);
 
   /// Parse the given buffer id, indexing all functions and storing them in the
@@ -112,6 +210,13 @@ class JSParser {
       Context &context,
       uint32_t bufferId);
 
+  /// Intern the identifiers that every parser needs and cache them in
+  /// \p context, so that parsers created in it later copy them instead of
+  /// looking them up. The first parser in a Context does this by itself; it
+  /// only needs to be called explicitly to get them interned before
+  /// Context::setStringTableCheckpoint().
+  static void initializeKnownIdentifiers(Context &context);
+
   /// Parse the AST of a specified function type at a given starting point.
   /// This is used for lazy compilation to parse and compile the function on
   /// the first call.
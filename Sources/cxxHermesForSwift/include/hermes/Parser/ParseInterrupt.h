@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_PARSER_PARSEINTERRUPT_H
+#define HERMES_PARSER_PARSEINTERRUPT_H
+
+#include "hermes/Support/MemoryBudget.h"
+
+#include "llvh/Support/Compiler.h"
+#include "llvh/Support/ErrorHandling.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace hermes {
+namespace parser {
+
+/// Lets a parse be stopped before it completes: by cancelling it from another
+/// thread, by a deadline, by a budget of steps, or when the memory budget of
+/// the Context is exceeded.
+///
+/// The parser and the lexer call poll() at statement and function boundaries
+/// and every few hundred tokens. Once it reports a reason the parse reports a
+/// single error describing it, stops lexing and returns None. The reason is
+/// sticky until restart() or clear() is called, so a Context can be reused
+/// for the next parse.
+class ParseInterrupt {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Reason : uint8_t {
+    None,
+    /// cancel() was called.
+    Cancelled,
+    /// The deadline passed.
+    DeadlineExceeded,
+    /// More than the budgeted number of steps was taken.
+    StepBudgetExceeded,
+    /// More memory than the budget was in use.
+    MemoryBudgetExceeded,
+  };
+
+  ParseInterrupt() = default;
+  ParseInterrupt(const ParseInterrupt &) = delete;
+  void operator=(const ParseInterrupt &) = delete;
+
+  /// Ask the parse to stop. This is the only method that may be called while
+  /// another thread is parsing.
+  void cancel() {
+    cancelled_.store(true, std::memory_order_relaxed);
+  }
+
+  /// Stop parsing once \p deadline has passed.
+  void setDeadline(Clock::time_point deadline) {
+    deadline_ = deadline;
+    hasDeadline_ = true;
+  }
+
+  /// Stop parsing after \p steps calls to poll(). 0 means no limit.
+  void setStepBudget(uint64_t steps) {
+    stepBudget_ = steps;
+  }
+
+  /// Stop parsing once \p budget is exceeded. The parser sets this to the
+  /// budget of the Context it parses in. \p budget may be nullptr.
+  void setMemoryBudget(const MemoryBudget *budget) {
+    memoryBudget_ = budget;
+  }
+
+  /// Forget the reason, the cancellation, the deadline and the steps taken so
+  /// far, keeping the step and memory budgets, in preparation for another
+  /// parse.
+  void clear() {
+    cancelled_.store(false, std::memory_order_relaxed);
+    hasDeadline_ = false;
+    steps_ = 0;
+    reason_ = Reason::None;
+  }
+
+  /// Forget the reason, the deadline and the steps taken so far, keeping the
+  /// budgets, before another parse in the same Context. Unlike clear(), a
+  /// cancellation is kept.
+  void restart() {
+    hasDeadline_ = false;
+    steps_ = 0;
+    if (reason_ != Reason::Cancelled)
+      reason_ = Reason::None;
+  }
+
+  /// \return the reason the parse was interrupted, or None.
+  Reason getReason() const {
+    return reason_;
+  }
+
+  /// Count one step and check whether the parse should stop. The clock is
+  /// only read every ClockInterval steps.
+  /// \return the reason to stop, or None to continue.
+  Reason poll() {
+    ++steps_;
+    if (LLVM_LIKELY(
+            reason_ == Reason::None &&
+            !cancelled_.load(std::memory_order_relaxed) &&
+            (stepBudget_ == 0 || steps_ <= stepBudget_) &&
+            (!memoryBudget_ || !memoryBudget_->isExceeded()) &&
+            (!hasDeadline_ || (steps_ & (ClockInterval - 1)) != 0))) {
+      return Reason::None;
+    }
+    return pollSlow();
+  }
+
+  /// \return a description of \p reason suitable for a diagnostic.
+  static const char *describe(Reason reason) {
+    switch (reason) {
+      case Reason::None:
+        return "parsing was not interrupted";
+      case Reason::Cancelled:
+        return "parsing was cancelled";
+      case Reason::DeadlineExceeded:
+        return "parsing deadline exceeded";
+      case Reason::StepBudgetExceeded:
+        return "parsing step budget exceeded";
+      case Reason::MemoryBudgetExceeded:
+        return "parsing memory budget exceeded";
+    }
+    llvm_unreachable("invalid Reason");
+  }
+
+ private:
+  /// The number of steps between two readings of the clock.
+  static constexpr uint64_t ClockInterval = 64;
+
+  Reason pollSlow() {
+    if (reason_ != Reason::None)
+      return reason_;
+    if (cancelled_.load(std::memory_order_relaxed))
+      reason_ = Reason::Cancelled;
+    else if (stepBudget_ != 0 && steps_ > stepBudget_)
+      reason_ = Reason::StepBudgetExceeded;
+    else if (memoryBudget_ && memoryBudget_->isExceeded())
+      reason_ = Reason::MemoryBudgetExceeded;
+    else if (hasDeadline_ && Clock::now() >= deadline_)
+      reason_ = Reason::DeadlineExceeded;
+    return reason_;
+  }
+
+  std::atomic<bool> cancelled_{false};
+  bool hasDeadline_{false};
+  Reason reason_{Reason::None};
+  Clock::time_point deadline_{};
+  uint64_t stepBudget_{0};
+  const MemoryBudget *memoryBudget_{nullptr};
+  uint64_t steps_{0};
+};
+
+} // namespace parser
+} // namespace hermes
+
+#endif // HERMES_PARSER_PARSEINTERRUPT_H
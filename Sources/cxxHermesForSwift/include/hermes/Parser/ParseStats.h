@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_PARSER_PARSESTATS_H
+#define HERMES_PARSER_PARSESTATS_H
+
+#include "hermes/AST/Config.h"
+
+#include "llvh/Support/Compiler.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace hermes {
+namespace parser {
+
+/// Counters describing the work done by the parser, filled in by every parse
+/// in a Context that has them set with Context::setParseStats(). Counters
+/// accumulate across parses until clear() is called.
+///
+/// The arena and string table figures are kept by the allocator and the
+/// string table anyway and are reported in every build. Counting tokens,
+/// nodes, speculative parses and recursion costs a branch per token and node,
+/// so it is only compiled in if HERMES_PARSE_STATS is set, which is the
+/// default in builds with assertions. Otherwise those counters stay 0 and
+/// isSupported() returns false. The setting only changes code in the parser's
+/// own sources, never the layout of a class, so code built with and without
+/// it can be mixed.
+struct ParseStats {
+  /// Tokens produced by the lexer, including those lexed again.
+  uint64_t tokensLexed{0};
+  /// Tokens lexed again after a speculative parse was rolled back.
+  uint64_t tokensRelexed{0};
+
+  /// Speculative parses, i.e. lexer save points that were created.
+  uint64_t speculativeAttempts{0};
+  /// Speculative parses that were rolled back.
+  uint64_t speculativeFailures{0};
+
+  /// The deepest parser recursion seen, in the units of the recursion limit.
+  uint32_t maxRecursionDepth{0};
+
+  /// AST nodes constructed by the parser, indexed by ESTree::NodeKind. Nodes
+  /// discarded by a rolled back speculative parse are included.
+  std::vector<uint64_t> nodesByKind{};
+
+  /// Bytes requested from the AST arena.
+  uint64_t arenaBytesAllocated{0};
+  /// Arena bytes lost to alignment and to the unused ends of slabs.
+  uint64_t arenaBytesWasted{0};
+  /// The size of the arena's slabs after the last parse.
+  uint64_t arenaBytesReserved{0};
+
+  /// The number of strings in the string table after the last parse.
+  uint64_t stringTableSize{0};
+  /// Identifiers and strings looked up in the string table.
+  uint64_t stringTableLookups{0};
+  /// Lookups that found an existing string.
+  uint64_t stringTableHits{0};
+
+  /// \return whether the parser was built to count tokens, nodes,
+  /// speculative parses and recursion. This is
+  /// the setting of the parser's own build, which may differ from the
+  /// HERMES_PARSE_STATS seen by the caller.
+  static bool isSupported();
+
+  /// \return the total number of nodes constructed.
+  uint64_t getNodeCount() const {
+    uint64_t count = 0;
+    for (uint64_t n : nodesByKind)
+      count += n;
+    return count;
+  }
+
+  /// \return the fraction of string table lookups that were hits.
+  double getStringTableHitRate() const {
+    return stringTableLookups
+        ? (double)stringTableHits / (double)stringTableLookups
+        : 0.0;
+  }
+
+  /// Reset every counter to 0.
+  void clear() {
+    *this = ParseStats{};
+  }
+
+  /// Count a node of kind \p kind.
+  void countNode(unsigned kind) {
+    if (LLVM_UNLIKELY(kind >= nodesByKind.size()))
+      nodesByKind.resize(kind + 1);
+    ++nodesByKind[kind];
+  }
+
+};
+
+} // namespace parser
+} // namespace hermes
+
+#if HERMES_PARSE_STATS
+/// Evaluate \p expr, which updates the statistics, if \p stats is not null.
+#define HERMES_PARSE_STAT(stats, expr) \
+  do {                                 \
+    if (LLVM_UNLIKELY(stats))          \
+      (stats)->expr;                   \
+  } while (0)
+#else
+#define HERMES_PARSE_STAT(stats, expr) \
+  do {                                 \
+  } while (0)
+#endif
+
+#endif // HERMES_PARSER_PARSESTATS_H
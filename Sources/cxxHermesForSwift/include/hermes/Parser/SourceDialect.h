@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_PARSER_SOURCEDIALECT_H
+#define HERMES_PARSER_SOURCEDIALECT_H
+
+#include "llvh/ADT/StringRef.h"
+
+#include <cstdint>
+
+namespace hermes {
+class Context;
+}
+
+namespace hermes {
+namespace parser {
+
+/// A dialect of JavaScript, which selects the parser settings of a Context
+/// (see applySourceDialect()).
+enum class SourceDialect : uint8_t {
+  /// Standard JavaScript.
+  JS,
+  /// JavaScript with JSX.
+  JSX,
+  /// Flow, including the syntax that could also be standard JavaScript
+  /// (ParseFlowSetting::ALL).
+  Flow,
+  /// Flow with JSX.
+  FlowJSX,
+  /// TypeScript.
+  TS,
+  /// TypeScript with JSX.
+  TSX,
+};
+
+/// \return the name of \p dialect: "js", "jsx", "flow", "flow-jsx", "ts" or
+///   "tsx".
+const char *sourceDialectName(SourceDialect dialect);
+
+/// Find the dialect that the buffer \p bufferId of \p context is cheapest to
+/// parse as, without parsing it:
+/// - TypeScript if the buffer name ends with .ts, .mts or .cts, TSX with .tsx.
+/// - Flow if it ends with .flow, or if the docblock has an @flow pragma (see
+///   scanDocBlock()).
+/// - TypeScript if the name has none of the JavaScript extensions (.js, .mjs,
+///   .cjs, .jsx) and the source contains syntax that only TypeScript has,
+///   such as `satisfies` or `: string`.
+/// - Standard JavaScript otherwise.
+/// JSX is added, except to TypeScript chosen by extension, if the source
+/// contains "</" or "/>", one of which every JSX element has. Flow syntax in
+/// a source without an @flow pragma is not detected.
+SourceDialect detectSourceDialect(Context &context, uint32_t bufferId);
+
+/// Find the dialect of the source \p source named \p name, as above. This
+/// uses no Context, so it can run on many sources at once, in any number of
+/// threads.
+SourceDialect detectSourceDialect(llvh::StringRef name, llvh::StringRef source);
+
+/// Set the JSX, Flow and TypeScript settings of \p context to parse
+/// \p dialect.
+void applySourceDialect(Context &context, SourceDialect dialect);
+
+} // namespace parser
+} // namespace hermes
+
+#endif
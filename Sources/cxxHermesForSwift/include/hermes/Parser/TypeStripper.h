@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_PARSER_TYPESTRIPPER_H
+#define HERMES_PARSER_TYPESTRIPPER_H
+
+#include "hermes/Parser/JSLexer.h"
+
+#include "llvh/ADT/ArrayRef.h"
+#include "llvh/ADT/StringRef.h"
+
+#include <cstdint>
+#include <string>
+
+namespace hermes {
+class Context;
+}
+
+namespace hermes {
+namespace parser {
+
+/// What TypeStripper puts in place of the types it removes.
+enum class StripMode {
+  /// Replace every character of a type with a space, keeping its line breaks,
+  /// so that every token of the output is at the same line and column as in
+  /// the source.
+  Blank,
+  /// Remove the types but keep their line breaks, so that every token is on
+  /// the same line as in the source. A space is kept where two tokens would
+  /// otherwise run together.
+  Remove,
+};
+
+/// Turns Flow or TypeScript into JavaScript by copying the source and leaving
+/// out the types, the way flow-remove-types does.
+///
+/// The source is parsed with TypeSyntaxSetting::SKIP, so no AST is built for
+/// the types, and the ranges the parser skipped are applied to the source in a
+/// single forward pass. The AST of the JavaScript is freed as soon as the
+/// parse is done. Constructs that mean something at run time are kept as they
+/// are: TypeScript enums, namespaces and parameter properties, and Flow enums.
+class TypeStripper {
+ public:
+  /// \param buildSourceMap whether to build a source map from the output to
+  ///   the source, which is only needed with StripMode::Remove.
+  explicit TypeStripper(
+      StripMode mode = StripMode::Blank,
+      bool buildSourceMap = false)
+      : mode_(mode), buildSourceMap_(buildSourceMap) {}
+
+  /// Parse the buffer \p bufferId of \p context as Flow or TypeScript, as the
+  /// context is set up to, and strip its types.
+  /// \return false if the source could not be parsed; the errors are reported
+  ///   to the SourceErrorManager of \p context and the output is empty.
+  bool strip(Context &context, uint32_t bufferId);
+
+  /// Strip the \p skipped ranges, which must point into \p source and be in
+  /// source order, from \p source.
+  void strip(llvh::StringRef source, llvh::ArrayRef<SkippedType> skipped);
+
+  /// \return the JavaScript produced by the last strip().
+  const std::string &getOutput() const {
+    return output_;
+  }
+
+  /// \return the "mappings" field of a version 3 source map from the output
+  ///   to the source, or an empty string if no source map was requested.
+  const std::string &getMappings() const {
+    return mappings_;
+  }
+
+  /// \return a version 3 source map from the output to the source, which is
+  ///   called \p sourceName in it, or an empty string if no source map was
+  ///   requested.
+  std::string getSourceMap(llvh::StringRef sourceName) const;
+
+ private:
+  StripMode mode_;
+  bool buildSourceMap_;
+  std::string output_{};
+  std::string mappings_{};
+};
+
+} // namespace parser
+} // namespace hermes
+
+#endif // HERMES_PARSER_TYPESTRIPPER_H
@@ -9,6 +9,7 @@
 #define HERMES_SUPPORT_ALLOCATOR_H
 
 #include "hermes/Support/CheckedMalloc.h"
+#include "hermes/Support/MemoryBudget.h"
 
 #include "llvh/ADT/STLExtras.h"
 #include "llvh/Support/Compiler.h"
@@ -16,6 +17,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <utility>
 #include <vector>
 #pragma GCC diagnostic push
 
@@ -53,6 +55,8 @@ class BacktrackingBumpPtrAllocator {
     uintptr_t offset;
     /// A place to store allocations that can't fit into the slabs, if any.
     llvh::SmallVector<std::unique_ptr<void, decltype(free) *>, 0> hugeAllocs{};
+    /// The total size of hugeAllocs.
+    size_t hugeBytes{0};
     /// The state of the previous scope.
     State *previous;
 
@@ -66,14 +70,49 @@ class BacktrackingBumpPtrAllocator {
   /// The current state of the bump pointer.
   State *state_;
 
+  /// Popped states, linked through State::previous, which pushScope() reuses
+  /// so that speculative parses don't allocate a State each.
+  State *freeStates_{nullptr};
+
+  /// If set, charged for the slabs and huge allocations.
+  MemoryBudget *budget_{nullptr};
+
+  /// The total size of the huge allocations of all scopes.
+  size_t hugeBytes_{0};
+
+  /// The bytes requested since the allocator was created.
+  uint64_t bytesAllocated_{0};
+  /// The bytes skipped for alignment or left at the end of a slab.
+  uint64_t bytesWasted_{0};
+
   /// Allocate memory that can't fit within a single slab.
   void *allocateHuge(size_t size) {
     auto *ptr = checkedMalloc(size);
     state_->hugeAllocs.push_back(
         std::unique_ptr<void, decltype(free) *>(ptr, free));
+    state_->hugeBytes += size;
+    hugeBytes_ += size;
+    if (budget_)
+      budget_->charge(size);
     return ptr;
   }
 
+  /// Free the huge allocations of \p state.
+  void freeHuge(State *state) {
+    state->hugeAllocs.clear();
+    hugeBytes_ -= state->hugeBytes;
+    if (budget_)
+      budget_->release(state->hugeBytes);
+    state->hugeBytes = 0;
+  }
+
+  /// Put \p state, whose huge allocations have been freed, on freeStates_.
+  void recycle(State *state) {
+    assert(state->hugeAllocs.empty() && "huge allocations not freed");
+    state->previous = freeStates_;
+    freeStates_ = state;
+  }
+
   /// Align an offset from a base pointer.
   static uintptr_t
   alignOffset(uintptr_t base, uintptr_t offset, uintptr_t alignment) {
@@ -84,19 +123,37 @@ class BacktrackingBumpPtrAllocator {
   void *allocateNewSlab(size_t size, size_t alignment = sizeof(double));
 
  public:
-  explicit BacktrackingBumpPtrAllocator() {
+  /// \param budget if not null, charged for the memory the allocator holds
+  ///   until it is destroyed. It must outlive the allocator.
+  explicit BacktrackingBumpPtrAllocator(MemoryBudget *budget = nullptr)
+      : budget_(budget) {
     state_ = new State();
     slabs_.push_back(std::make_unique<Slab>());
+    if (budget_)
+      budget_->charge(SlabSize);
   }
   ~BacktrackingBumpPtrAllocator() {
     while (state_)
       popScope();
+    while (freeStates_)
+      delete std::exchange(freeStates_, freeStates_->previous);
+    if (budget_)
+      budget_->release(getBytesReserved());
   }
 
   /// Create and push a new scope on the stack. All allocations made after this
   /// can be unallocated with a corresponding popScope().
   void pushScope() {
-    state_ = new State(state_);
+    State *state = freeStates_;
+    if (LLVM_UNLIKELY(!state)) {
+      state_ = new State(state_);
+      return;
+    }
+    freeStates_ = state->previous;
+    state->slab = state_->slab;
+    state->offset = state_->offset;
+    state->previous = state_;
+    state_ = state;
   }
 
   /// Remove all allocations since the last pushScope().
@@ -104,9 +161,71 @@ class BacktrackingBumpPtrAllocator {
     assert(state_ && "No previous allocation scope pushed");
     auto *top = state_;
     state_ = state_->previous;
-    delete top;
+    freeHuge(top);
+    recycle(top);
     // We could also clean up unnecessary slabs, but we're likely to need
-    // then again so don't bother.
+    // then again so don't bother. See releaseUnusedSlabs().
+  }
+
+  /// Keep all allocations since the last pushScope() but remove the scope,
+  /// so that they belong to the enclosing scope.
+  void commitScope() {
+    assert(
+        state_ && state_->previous && "No previous allocation scope pushed");
+    auto *top = state_;
+    state_ = top->previous;
+    state_->slab = top->slab;
+    state_->offset = top->offset;
+    for (auto &huge : top->hugeAllocs)
+      state_->hugeAllocs.push_back(std::move(huge));
+    state_->hugeBytes += top->hugeBytes;
+    top->hugeAllocs.clear();
+    top->hugeBytes = 0;
+    recycle(top);
+  }
+
+  /// Remove all scopes and all allocations. The slabs are kept and reused by
+  /// later allocations.
+  void reset() {
+    while (state_->previous)
+      popScope();
+    state_->slab = 0;
+    state_->offset = 0;
+    freeHuge(state_);
+  }
+
+  /// Free the slabs after the one in use, which the allocator otherwise keeps
+  /// for later allocations, e.g. after reset() if a parse used much more
+  /// memory than the next ones are expected to.
+  void releaseUnusedSlabs() {
+    // Enclosing scopes never use a later slab than the current one.
+    size_t used = state_->slab + 1;
+    if (budget_)
+      budget_->release((slabs_.size() - used) * SlabSize);
+    slabs_.resize(used);
+  }
+
+  /// \return the bytes requested since the allocator was created.
+  uint64_t getBytesAllocated() const {
+    return bytesAllocated_;
+  }
+
+  /// \return the bytes lost to alignment and to unused slab ends since the
+  /// allocator was created.
+  uint64_t getBytesWasted() const {
+    return bytesWasted_;
+  }
+
+  /// \return the size of the slabs, which are kept until destruction or
+  ///   releaseUnusedSlabs().
+  size_t getBytesReserved() const {
+    return slabs_.size() * SlabSize;
+  }
+
+  /// \return the memory held by the allocator: the slabs and the allocations
+  ///   too big for a slab.
+  size_t getBytesHeld() const {
+    return getBytesReserved() + hugeBytes_;
   }
 
   /// Allocate space for N elements of type T.
@@ -126,10 +245,21 @@ class BacktrackingBumpPtrAllocator {
       size_t alignment = kDefaultPlatformAlignment) {
     auto currentSlab =
         reinterpret_cast<uintptr_t>(&slabs_[state_->slab].get()->data);
-    state_->offset = alignOffset(currentSlab, state_->offset, alignment);
+    uintptr_t offset = alignOffset(currentSlab, state_->offset, alignment);
+    bytesAllocated_ += size;
+    bytesWasted_ += offset - state_->offset;
+    state_->offset = offset;
 
     if (LLVM_UNLIKELY(size > SlabSize || state_->offset + size > SlabSize)) {
-      return allocateNewSlab(size, alignment);
+      // The rest of the slab is abandoned, unless the allocation is too big
+      // for any slab and gets its own memory.
+      if (size <= SlabSize)
+        bytesWasted_ += SlabSize - state_->offset;
+      size_t numSlabs = slabs_.size();
+      void *ptr = allocateNewSlab(size, alignment);
+      if (budget_ && slabs_.size() != numSlabs)
+        budget_->charge((slabs_.size() - numSlabs) * SlabSize);
+      return ptr;
     }
 
     auto *ptr = (void *)(currentSlab + state_->offset);
@@ -69,8 +69,8 @@ class JSONEmitter {
   void emitValue(unsigned long long val);
 
   /// Emit a double value \p val.
-  /// Note that only finite values may be so emitted. Infinities and NaNs are
-  /// an error.
+  /// JSON cannot represent infinities and NaNs, so they are emitted as null,
+  /// as JSON.stringify() does.
   void emitValue(double val);
 
   /// Emit a string \p val. This is not used to emit dictionary keys: use
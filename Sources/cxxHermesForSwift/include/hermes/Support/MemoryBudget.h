@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_SUPPORT_MEMORYBUDGET_H
+#define HERMES_SUPPORT_MEMORYBUDGET_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace hermes {
+
+/// Accounts for the memory held by the allocators and containers of one
+/// owner, such as a Context, and records its high-water mark.
+///
+/// Memory is charged in coarse units (allocator slabs, container capacity),
+/// so the count tracks the memory actually obtained from the system rather
+/// than the bytes requested. The budget does not refuse anything by itself:
+/// whoever owns it polls isExceeded() at convenient points and stops. It is
+/// not thread safe.
+class MemoryBudget {
+ public:
+  /// Memory charged to a budget on behalf of a single container, released
+  /// when the charge is destroyed.
+  class Charge {
+   public:
+    Charge() = default;
+    Charge(const Charge &) = delete;
+    void operator=(const Charge &) = delete;
+    ~Charge() {
+      setBudget(nullptr);
+    }
+
+    /// Move the charge to \p budget, which may be nullptr.
+    void setBudget(MemoryBudget *budget) {
+      if (budget_)
+        budget_->release(bytes_);
+      budget_ = budget;
+      if (budget_)
+        budget_->charge(bytes_);
+    }
+
+    /// Set the charged amount to \p bytes.
+    void update(size_t bytes) {
+      if (budget_ && bytes != bytes_) {
+        budget_->release(bytes_);
+        budget_->charge(bytes);
+      }
+      bytes_ = bytes;
+    }
+
+   private:
+    MemoryBudget *budget_{nullptr};
+    size_t bytes_{0};
+  };
+
+  MemoryBudget() = default;
+  MemoryBudget(const MemoryBudget &) = delete;
+  void operator=(const MemoryBudget &) = delete;
+
+  /// Set the number of bytes that may be used. 0 means no limit.
+  void setLimit(uint64_t bytes) {
+    limit_ = bytes;
+  }
+
+  /// \return the limit, or 0 if there is none.
+  uint64_t getLimit() const {
+    return limit_;
+  }
+
+  /// \return whether more memory than the limit is in use.
+  bool isExceeded() const {
+    return limit_ != 0 && used_ > limit_;
+  }
+
+  /// \return the bytes currently in use.
+  uint64_t getUsed() const {
+    return used_;
+  }
+
+  /// \return the most bytes in use at any time since the budget was created
+  ///   or resetPeak() was called.
+  uint64_t getPeak() const {
+    return peak_;
+  }
+
+  /// Start recording the high-water mark from the current use.
+  void resetPeak() {
+    peak_ = used_;
+  }
+
+  /// Record that \p bytes more are in use.
+  void charge(uint64_t bytes) {
+    used_ += bytes;
+    if (used_ > peak_)
+      peak_ = used_;
+  }
+
+  /// Record that \p bytes are no longer in use.
+  void release(uint64_t bytes) {
+    assert(bytes <= used_ && "releasing more memory than was charged");
+    used_ -= bytes;
+  }
+
+ private:
+  uint64_t limit_{0};
+  uint64_t used_{0};
+  uint64_t peak_{0};
+};
+
+} // namespace hermes
+
+#endif // HERMES_SUPPORT_MEMORYBUDGET_H
@@ -10,8 +10,17 @@
 
 #include "llvh/ADT/DenseMap.h"
 #include "llvh/ADT/StringRef.h"
+#include "llvh/Support/Compiler.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <string>
+#include <vector>
+
+namespace llvh {
+class raw_ostream;
+} // namespace llvh
 
 #if defined(HERMES_FACEBOOK_BUILD) && !defined(_WINDOWS) &&      \
     !defined(__EMSCRIPTEN__) && !defined(HERMES_FBCODE_BUILD) && \
@@ -21,6 +30,70 @@
 
 namespace hermes {
 
+/// The portable tracing backend of PerfSection, used when neither systrace nor
+/// platform logging is available. Tracing is off until setEnabled(true); while
+/// it is off a PerfSection costs one relaxed atomic load.
+///
+/// Each thread appends the sections it completes to its own buffer, without
+/// locking. The buffers can be exported at any time in the Chrome Trace Event
+/// format, which chrome://tracing and Perfetto load. A thread's buffer is kept
+/// after the thread exits so its sections can still be exported.
+class PerfTrace {
+ public:
+  /// An argument attached to a section by PerfSection::addArg().
+  struct Arg {
+    enum class Type : uint8_t { Size, Double, String };
+
+    const char *name;
+    Type type;
+    union {
+      size_t size;
+      double d;
+    };
+    std::string str{};
+  };
+
+  /// \return whether sections are being recorded.
+  static bool isEnabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /// Start or stop recording sections. Sections that are open when tracing
+  /// is disabled are still recorded when they end.
+  static void setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  /// Discard the recorded sections. This must not be called while a thread
+  /// may complete a section, e.g. while another thread is parsing.
+  static void clear();
+
+  /// Write the recorded sections to \p os as a Chrome Trace Event JSON
+  /// object. Sections completed concurrently may or may not be included.
+  static void exportChromeTrace(llvh::raw_ostream &os);
+
+  /// \return the recorded sections as a Chrome Trace Event JSON object.
+  static std::string getChromeTrace();
+
+  /// \return the current time, in nanoseconds of the steady clock.
+  static uint64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /// Append a section that started at \p start and ends now to the buffer of
+  /// the current thread.
+  static void record(
+      const char *name,
+      const char *category,
+      uint64_t start,
+      std::vector<Arg> &&args);
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
 /// A class whose constructor/destructor delimit a region of code
 /// execution that should be timed, and may have further attributes
 /// associated with it.  This may be used to produce systrace output,
@@ -102,12 +175,64 @@ class PerfSection {
   }
 
 #else
-  // Dummy no-overhead implementations:
-  PerfSection(const char *name, const char *category = nullptr) {}
-  void addArg(const char *argName, size_t value) {}
-  void addArgD(const char *argName, double d) {}
+  // Record the section in PerfTrace, if it is enabled.
+  PerfSection(const char *name, const char *category = nullptr)
+      : name_(name), category_(category) {
+    if (LLVM_UNLIKELY(PerfTrace::isEnabled())) {
+      start_ = PerfTrace::now();
+      enabled_ = true;
+    }
+  }
+
+  ~PerfSection() {
+    if (LLVM_UNLIKELY(enabled_))
+      PerfTrace::record(name_, category_, start_, std::move(args_));
+  }
+
+  PerfSection(const PerfSection &) = delete;
+  void operator=(const PerfSection &) = delete;
+
+  void addArg(const char *argName, size_t value) {
+    if (LLVM_UNLIKELY(enabled_)) {
+      PerfTrace::Arg &arg = getArg(argName, PerfTrace::Arg::Type::Size);
+      arg.size = value;
+    }
+  }
+  void addArgD(const char *argName, double d) {
+    if (LLVM_UNLIKELY(enabled_)) {
+      PerfTrace::Arg &arg = getArg(argName, PerfTrace::Arg::Type::Double);
+      arg.d = d;
+    }
+  }
+  /// The value is always copied, since the section may be exported after
+  /// \p value is gone.
   void
-  addArg(const char *argName, const llvh::StringRef value, bool copy = true) {}
+  addArg(const char *argName, const llvh::StringRef value, bool copy = true) {
+    (void)copy;
+    if (LLVM_UNLIKELY(enabled_))
+      getArg(argName, PerfTrace::Arg::Type::String).str = value.str();
+  }
+
+ private:
+  /// \return the argument named \p argName, added if needed, with its type
+  /// set to \p type.
+  PerfTrace::Arg &getArg(const char *argName, PerfTrace::Arg::Type type) {
+    for (PerfTrace::Arg &arg : args_) {
+      if (llvh::StringRef(arg.name) == argName) {
+        arg.type = type;
+        return arg;
+      }
+    }
+    args_.push_back(PerfTrace::Arg{argName, type, {0}});
+    return args_.back();
+  }
+
+  const char *name_;
+  const char *category_;
+  /// Whether the section is being recorded.
+  bool enabled_{false};
+  uint64_t start_{0};
+  std::vector<PerfTrace::Arg> args_{};
 #endif
 };
 
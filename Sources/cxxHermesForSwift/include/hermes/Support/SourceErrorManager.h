@@ -17,7 +17,9 @@
 #include "llvh/ADT/SmallBitVector.h"
 #include "llvh/Support/SourceMgr.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <string>
 
 namespace hermes {
@@ -287,6 +289,30 @@ class SourceErrorManager {
     errorLimitReached_ = false;
   }
 
+  /// Remove the source buffer \p bufId, which must not be virtual. No
+  /// location in it may be used again. The other buffers keep their IDs.
+  void removeSourceBuffer(unsigned bufId) {
+    assert(!isVirtualBufferId(bufId) && "virtual buffers can't be removed");
+    sm_.removeBuffer(bufId);
+    if (findLineCache_.bufferId == bufId)
+      findLineCache_ = FindLineCache{};
+    sourceMappingUrls_.erase(bufId);
+    sourceUrls_.erase(bufId);
+  }
+
+  /// Remove all source buffers and reset the message counts, so that the
+  /// manager can be reused for unrelated input. Settings and the diagnostic
+  /// handler are kept. No location in a removed buffer may be used again.
+  void clearBuffers() {
+    sm_.clearBuffers();
+    findLineCache_ = FindLineCache{};
+    sourceMappingUrls_.clear();
+    sourceUrls_.clear();
+    std::fill(std::begin(messageCount_), std::end(messageCount_), 0);
+    errorLimitReached_ = false;
+    lastMessageSuppressed_ = false;
+  }
+
   /// \return true if \c warning is treated as an error or false if it's treated
   /// as a warning.
   bool isWarningAnError(Warning warning) const {
@@ -554,6 +580,17 @@ class SourceErrorManager {
     message(DK_Note, loc, msg, subsystem);
   }
 
+  /// Report an error that ends the compilation: it is counted and reported
+  /// even while messages are suppressed or collected by a
+  /// CollectMessagesRAII, and every message after it is dropped as if the
+  /// error limit had been reached.
+  void fatalError(SMLoc loc, const llvh::Twine &msg) {
+    if (errorLimitReached_)
+      return;
+    countAndGenMessage(DK_Error, loc, SMRange{}, msg);
+    errorLimitReached_ = true;
+  }
+
   unsigned getMessageCount(DiagKind dk) const {
     assert(dk <= DK_Note);
     return messageCount_[dk];
@@ -689,6 +726,15 @@ class CollectMessagesRAII {
     storage_.emplace_back(dk, loc, sm, msg);
   }
 
+  /// \return whether an error has been collected.
+  bool hasErrors() const {
+    for (const StoredMessage &msg : storage_) {
+      if (msg.dk == SourceErrorManager::DK_Error)
+        return true;
+    }
+    return false;
+  }
+
   void setDiscardMessages(bool discardMessages) {
     discardMessages_ = discardMessages;
   }
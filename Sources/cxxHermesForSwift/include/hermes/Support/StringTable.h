@@ -13,6 +13,8 @@
 #include "llvh/ADT/DenseMap.h"
 #include "llvh/ADT/StringRef.h"
 
+#include <vector>
+
 namespace llvh {
 class raw_ostream;
 } // namespace llvh
@@ -107,6 +109,16 @@ class StringTable {
 
   llvh::DenseMap<llvh::StringRef, UniqueString *> strMap_{};
 
+  /// Strings added since setCheckpoint(), in order.
+  std::vector<llvh::StringRef> sinceCheckpoint_{};
+
+  /// Whether setCheckpoint() is in effect.
+  bool hasCheckpoint_ = false;
+
+  /// The number of calls to getString(), and those that found the string.
+  uint64_t lookups_ = 0;
+  uint64_t hits_ = 0;
+
   StringTable(const StringTable &) = delete;
   StringTable &operator=(const StringTable &_) = delete;
 
@@ -115,18 +127,62 @@ class StringTable {
 
   /// Return a unique zero-terminated copy of the supplied string \p name.
   UniqueString *getString(llvh::StringRef name) {
+    ++lookups_;
     // Already in the map?
     auto it = strMap_.find(name);
-    if (it != strMap_.end())
+    if (it != strMap_.end()) {
+      ++hits_;
       return it->second;
+    }
 
     // Allocate a zero-terminated copy of the string
     auto *str = new (allocator_.Allocate<UniqueString>())
         UniqueString(zeroTerminate(allocator_, name));
     strMap_.insert({str->str(), str});
+    if (hasCheckpoint_)
+      sinceCheckpoint_.push_back(str->str());
     return str;
   }
 
+  /// Start recording the strings that are added, so that
+  /// rollbackToCheckpoint() can remove them again.
+  void setCheckpoint() {
+    sinceCheckpoint_.clear();
+    hasCheckpoint_ = true;
+  }
+
+  /// Keep the strings added since setCheckpoint() and stop recording.
+  void clearCheckpoint() {
+    sinceCheckpoint_.clear();
+    hasCheckpoint_ = false;
+  }
+
+  /// Remove the strings added since setCheckpoint(). Their memory is not
+  /// freed; that is up to the owner of the allocator, which must also make
+  /// sure that they are no longer referenced.
+  void rollbackToCheckpoint() {
+    assert(hasCheckpoint_ && "no string table checkpoint");
+    for (llvh::StringRef str : sinceCheckpoint_)
+      strMap_.erase(str);
+    sinceCheckpoint_.clear();
+  }
+
+  /// \return the number of unique strings.
+  size_t size() const {
+    return strMap_.size();
+  }
+
+  /// \return the number of calls to getString().
+  uint64_t getLookupCount() const {
+    return lookups_;
+  }
+
+  /// \return the number of calls to getString() that found an existing
+  /// string.
+  uint64_t getHitCount() const {
+    return hits_;
+  }
+
   /// A wrapper arond getString() returning an Identifier.
   Identifier getIdentifier(llvh::StringRef name) {
     return Identifier::getFromPointer(getString(name));
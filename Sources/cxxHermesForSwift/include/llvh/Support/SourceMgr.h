@@ -179,6 +179,28 @@ public:
     return BufId;
   }
 
+  /// Remove the buffer \p i. The IDs of the other buffers don't change, and
+  /// the ID of the last buffer is reused afterwards.
+  void removeBuffer(unsigned i) {
+    assert(isValidBufferID(i) && Buffers[i - 1].Buffer && "no such buffer");
+    auto It = BufferEnds.find(Buffers[i - 1].Buffer->getBufferEnd());
+    if (It != BufferEnds.end() && It->second == i)
+      BufferEnds.erase(It);
+    if (LastFoundBufId == i)
+      LastFoundBufId = 0;
+    if (i == Buffers.size())
+      Buffers.pop_back();
+    else
+      SrcBuffer Removed{std::move(Buffers[i - 1])};
+  }
+
+  /// Remove all buffers. Buffer IDs are reused afterwards.
+  void clearBuffers() {
+    Buffers.clear();
+    BufferEnds.clear();
+    LastFoundBufId = 0;
+  }
+
   /// Search for a file with the specified name in the current directory or in
   /// one of the IncludeDirs.
   ///
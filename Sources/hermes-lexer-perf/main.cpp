@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/// Hardware performance counters of the lexer's hot paths.
+///
+/// Usage: hermes-lexer-perf [options] [file...]
+///   --filter=<substr>   only run inputs whose name contains <substr>
+///   --min-time=<sec>    lex each input for at least this long (0.5)
+///   --size=<KB>         the size of each synthetic input (1024)
+///   --pretty            pretty-print the report
+///
+/// Each synthetic input consists almost entirely of one kind of token, so
+/// that lexing it exercises one path of JSLexer::advance():
+///   identifiers     scanIdentifierFastPath()
+///   strings         scanString(), with and without escapes
+///   numbers         scanNumber(): decimal, hex, fractions and exponents
+///   block-comments  skipBlockComment()
+///   punctuators     the punctuator dispatch of advance() itself
+/// Files given on the command line are lexed as well, to measure a real mix.
+///
+/// On Linux the counters are read with perf_event_open(): instructions,
+/// cycles, branches, branch misses, L1 data cache read misses and last-level
+/// cache read misses, reported per byte of input. Counters that cannot be
+/// opened, e.g. in a container or with a restrictive
+/// kernel.perf_event_paranoid, are reported as null and the reason is given
+/// under "counterErrors"; wall-clock time is always reported.
+///
+/// To check a lexer change, compare branchMissesPerByte and
+/// instructionsPerByte of the affected input before and after.
+
+#include "hermes/Parser/JSLexer.h"
+#include "hermes/Support/JSONEmitter.h"
+
+#include "llvh/Support/MemoryBuffer.h"
+#include "llvh/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+using namespace hermes;
+using namespace hermes::parser;
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Counters
+
+/// The counters, in the order of the fields of a report.
+enum class Counter {
+  Instructions,
+  Cycles,
+  Branches,
+  BranchMisses,
+  L1DReadMisses,
+  LLCReadMisses,
+  _Count,
+};
+
+constexpr unsigned kNumCounters = (unsigned)Counter::_Count;
+
+const char *counterName(Counter counter) {
+  switch (counter) {
+    case Counter::Instructions:
+      return "instructions";
+    case Counter::Cycles:
+      return "cycles";
+    case Counter::Branches:
+      return "branches";
+    case Counter::BranchMisses:
+      return "branchMisses";
+    case Counter::L1DReadMisses:
+      return "l1dReadMisses";
+    case Counter::LLCReadMisses:
+      return "llcReadMisses";
+    case Counter::_Count:
+      break;
+  }
+  llvm_unreachable("invalid Counter");
+}
+
+/// A set of hardware counters of the current thread. Each counter is opened
+/// separately, so that those the machine lacks do not prevent the others
+/// from being used, and scaled by its running time if the kernel had to
+/// multiplex them.
+class PerfCounters {
+ public:
+  PerfCounters() {
+#ifdef __linux__
+    for (unsigned i = 0; i < kNumCounters; ++i)
+      fds_[i] = open((Counter)i, errors_[i]);
+#else
+    for (std::string &error : errors_)
+      error = "hardware counters are only supported on Linux";
+#endif
+  }
+
+  ~PerfCounters() {
+#ifdef __linux__
+    for (int fd : fds_) {
+      if (fd >= 0)
+        close(fd);
+    }
+#endif
+  }
+
+  PerfCounters(const PerfCounters &) = delete;
+  void operator=(const PerfCounters &) = delete;
+
+  /// \return why \p counter is unavailable, or an empty string.
+  const std::string &getError(Counter counter) const {
+    return errors_[(unsigned)counter];
+  }
+
+  /// Reset and start every available counter.
+  void start() {
+#ifdef __linux__
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif
+  }
+
+  /// Stop the counters and store their values in \p values. Unavailable
+  /// counters are stored as -1.
+  void stop(double (&values)[kNumCounters]) {
+    for (unsigned i = 0; i < kNumCounters; ++i)
+      values[i] = -1;
+#ifdef __linux__
+    for (int fd : fds_) {
+      if (fd >= 0)
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (unsigned i = 0; i < kNumCounters; ++i) {
+      // value, time enabled, time running.
+      uint64_t data[3];
+      if (fds_[i] < 0 || read(fds_[i], data, sizeof(data)) != sizeof(data) ||
+          data[2] == 0)
+        continue;
+      values[i] = (double)data[0] * ((double)data[1] / (double)data[2]);
+    }
+#endif
+  }
+
+ private:
+#ifdef __linux__
+  static int open(Counter counter, std::string &error) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    constexpr uint64_t readMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    switch (counter) {
+      case Counter::Instructions:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+      case Counter::Cycles:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+      case Counter::Branches:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS;
+        break;
+      case Counter::BranchMisses:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+      case Counter::L1DReadMisses:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_L1D | readMiss;
+        break;
+      case Counter::LLCReadMisses:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_LL | readMiss;
+        break;
+      case Counter::_Count:
+        llvm_unreachable("invalid Counter");
+    }
+
+    int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd < 0) {
+      int err = errno;
+      error = std::string("perf_event_open: ") + std::strerror(err);
+      if (err == EACCES || err == EPERM)
+        error += " (see /proc/sys/kernel/perf_event_paranoid)";
+      else if (err == ENOENT || err == EOPNOTSUPP)
+        error += " (not supported by this CPU or virtual machine)";
+    }
+    return fd;
+  }
+
+  int fds_[kNumCounters];
+#endif
+  std::string errors_[kNumCounters];
+};
+
+//===----------------------------------------------------------------------===//
+// Inputs
+
+/// A small deterministic generator, so that every run lexes the same input.
+class Random {
+  uint64_t state_;
+
+ public:
+  explicit Random(uint64_t seed) : state_(seed) {}
+
+  uint32_t next() {
+    state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (uint32_t)(state_ >> 33);
+  }
+
+  /// \return a number in [0, n).
+  uint32_t below(uint32_t n) {
+    return next() % n;
+  }
+
+  char pick(const char *chars) {
+    return chars[below(std::strlen(chars))];
+  }
+};
+
+struct Input {
+  std::string name;
+  std::string text;
+};
+
+void genIdentifier(Random &rnd, std::string &out) {
+  static const char *const first = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJ_$";
+  static const char *const rest =
+      "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789";
+  unsigned len = 1 + rnd.below(3) * rnd.below(6) + rnd.below(4);
+  out += rnd.pick(first);
+  for (unsigned i = 1; i < len; ++i)
+    out += rnd.pick(rest);
+}
+
+void genString(Random &rnd, std::string &out) {
+  static const char *const chars =
+      "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789.,:-";
+  static const char *const escapes[] = {
+      "\\n", "\\t", "\\\\", "\\u00e9", "\\x41", "\\'", "\\\""};
+  char quote = rnd.below(2) ? '"' : '\'';
+  unsigned len = rnd.below(40);
+  out += quote;
+  for (unsigned i = 0; i < len; ++i) {
+    if (rnd.below(16) == 0)
+      out += escapes[rnd.below(sizeof(escapes) / sizeof(escapes[0]))];
+    else
+      out += rnd.pick(chars);
+  }
+  out += quote;
+}
+
+void genNumber(Random &rnd, std::string &out) {
+  switch (rnd.below(5)) {
+    case 0:
+      out += std::to_string(rnd.below(10));
+      break;
+    case 1:
+      out += std::to_string(rnd.next());
+      break;
+    case 2:
+      out += std::to_string(rnd.below(1000)) + "." +
+          std::to_string(rnd.below(100000));
+      break;
+    case 3: {
+      static const char *const hex = "0123456789abcdefABCDEF";
+      out += "0x";
+      for (unsigned i = 0, e = 1 + rnd.below(8); i < e; ++i)
+        out += rnd.pick(hex);
+      break;
+    }
+    case 4:
+      out += std::to_string(1 + rnd.below(9)) + "." +
+          std::to_string(rnd.below(1000)) + "e" +
+          (rnd.below(2) ? "-" : "") + std::to_string(rnd.below(300));
+      break;
+  }
+}
+
+void genBlockComment(Random &rnd, std::string &out) {
+  static const char *const chars =
+      "abcdefghijklmnopqrstuvwxyz abcdefghijklmnopqrstuvwxyz*/@.,";
+  out += "/*";
+  for (unsigned i = 0, e = 20 + rnd.below(200); i < e; ++i) {
+    char c = rnd.pick(chars);
+    // A '*' followed by '/' would end the comment early.
+    if (c == '/' && out.back() == '*')
+      c = ' ';
+    out += rnd.below(40) == 0 ? '\n' : c;
+  }
+  if (out.back() == '*')
+    out += ' ';
+  out += "*/";
+}
+
+void genPunctuator(Random &rnd, std::string &out) {
+  static const char *const puncs[] = {
+      "{",   "}",  "(",  ")",   "[",  "]",  ".",   ";",  ",",  "<",
+      ">",   "<=", ">=", "==",  "!=", "===", "!==", "+",  "-",  "*",
+      "%",   "++", "--", "<<",  ">>", ">>>", "&",   "|",  "^",  "!",
+      "~",   "&&", "||", "?\?",  "?.", "?",   ":",   "=",  "+=", "-=",
+      "*=",  "=>", "**", "...", "&&=", "||=", "?\?="};
+  out += puncs[rnd.below(sizeof(puncs) / sizeof(puncs[0]))];
+}
+
+/// Generate \p size bytes of tokens made by \p gen, separated by whitespace.
+/// When \p withIdentifiers is set, every token is followed by an identifier,
+/// which keeps block comments between tokens.
+template <typename Gen>
+Input generate(
+    const char *name,
+    size_t size,
+    Gen gen,
+    bool withIdentifiers = false) {
+  Random rnd{std::hash<std::string>{}(name)};
+  Input input{name, {}};
+  input.text.reserve(size + 256);
+  while (input.text.size() < size) {
+    gen(rnd, input.text);
+    if (withIdentifiers) {
+      input.text += ' ';
+      genIdentifier(rnd, input.text);
+    }
+    input.text += rnd.below(12) == 0 ? '\n' : ' ';
+  }
+  return input;
+}
+
+//===----------------------------------------------------------------------===//
+// Measurement
+
+struct Options {
+  std::string filter;
+  double minTime = 0.5;
+  size_t size = 1024 * 1024;
+  bool pretty = false;
+};
+
+/// Lex the whole buffer of \p lexer from its start.
+/// \return the number of tokens, or 0 on error.
+size_t lexAll(JSLexer &lexer) {
+  lexer.seek(llvh::SMLoc::getFromPointer(lexer.getBufferStart()));
+  size_t count = 0;
+  auto grammarContext = JSLexer::AllowRegExp;
+  for (;;) {
+    const Token *tok = lexer.advance(grammarContext);
+    switch (tok->getKind()) {
+      case TokenKind::eof:
+        return lexer.getSourceMgr().getErrorCount() == 0 ? count : 0;
+      case TokenKind::identifier:
+      case TokenKind::numeric_literal:
+      case TokenKind::string_literal:
+      case TokenKind::r_paren:
+      case TokenKind::r_square:
+      case TokenKind::r_brace:
+        grammarContext = JSLexer::AllowDiv;
+        break;
+      default:
+        grammarContext = JSLexer::AllowRegExp;
+        break;
+    }
+    ++count;
+  }
+}
+
+void measure(
+    const Options &options,
+    PerfCounters &counters,
+    const Input &input,
+    JSONEmitter &json) {
+  SourceErrorManager sm;
+  JSLexer::Allocator allocator;
+  StringTable strTab{allocator};
+  JSLexer lexer{input.text, sm, allocator, &strTab, false};
+
+  json.openDict();
+  json.emitKeyValue("input", input.name);
+  json.emitKeyValue("bytes", (unsigned long long)input.text.size());
+
+  // Warm up the caches and the string table.
+  size_t tokens = lexAll(lexer);
+  json.emitKeyValue("ok", tokens != 0);
+  if (tokens == 0) {
+    llvh::errs() << input.name << ": lexing failed\n";
+    json.closeDict();
+    return;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  unsigned iterations = 0;
+  double values[kNumCounters];
+  Clock::time_point start = Clock::now();
+  counters.start();
+  do {
+    lexAll(lexer);
+    ++iterations;
+  } while (std::chrono::duration<double>(Clock::now() - start).count() <
+           options.minTime);
+  counters.stop(values);
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  double bytes = (double)input.text.size() * iterations;
+  json.emitKeyValue("tokens", (unsigned long long)tokens);
+  json.emitKeyValue("iterations", iterations);
+  json.emitKeyValue("mbPerSecond", bytes / (1024 * 1024) / seconds);
+  json.emitKeyValue("nsPerByte", seconds * 1e9 / bytes);
+  for (unsigned i = 0; i < kNumCounters; ++i) {
+    std::string key = std::string(counterName((Counter)i)) + "PerByte";
+    if (values[i] < 0) {
+      json.emitKey(key);
+      json.emitNullValue();
+    } else {
+      json.emitKeyValue(key, values[i] / bytes);
+    }
+  }
+  double branches = values[(unsigned)Counter::Branches];
+  double misses = values[(unsigned)Counter::BranchMisses];
+  if (branches > 0 && misses >= 0)
+    json.emitKeyValue("branchMissRate", misses / branches);
+  double cycles = values[(unsigned)Counter::Cycles];
+  double instructions = values[(unsigned)Counter::Instructions];
+  if (cycles > 0 && instructions >= 0)
+    json.emitKeyValue("instructionsPerCycle", instructions / cycles);
+  json.closeDict();
+}
+
+bool parseOptions(
+    int argc,
+    char **argv,
+    Options &options,
+    std::vector<std::string> &paths) {
+  for (int i = 1; i < argc; ++i) {
+    llvh::StringRef arg = argv[i];
+    if (arg.consume_front("--filter=")) {
+      options.filter = arg.str();
+    } else if (arg.consume_front("--min-time=")) {
+      options.minTime = std::atof(arg.str().c_str());
+    } else if (arg.consume_front("--size=")) {
+      options.size = std::max(1, std::atoi(arg.str().c_str())) * 1024;
+    } else if (arg == "--pretty") {
+      options.pretty = true;
+    } else if (arg.startswith("-")) {
+      llvh::errs() << "usage: " << argv[0]
+                   << " [--filter=<substr>] [--min-time=<sec>] [--size=<KB>]"
+                      " [--pretty] [file...]\n";
+      return false;
+    } else {
+      paths.push_back(arg.str());
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  std::vector<std::string> paths;
+  if (!parseOptions(argc, argv, options, paths))
+    return 2;
+
+  std::vector<Input> inputs;
+  inputs.push_back(generate("identifiers", options.size, genIdentifier));
+  inputs.push_back(generate("strings", options.size, genString));
+  inputs.push_back(generate("numbers", options.size, genNumber));
+  inputs.push_back(
+      generate("block-comments", options.size, genBlockComment, true));
+  inputs.push_back(generate("punctuators", options.size, genPunctuator));
+  for (const std::string &path : paths) {
+    auto fileOrErr = llvh::MemoryBuffer::getFile(path);
+    if (!fileOrErr) {
+      llvh::errs() << path << ": " << fileOrErr.getError().message() << "\n";
+      return 1;
+    }
+    inputs.push_back(Input{path, (*fileOrErr)->getBuffer().str()});
+  }
+
+  PerfCounters counters;
+  llvh::raw_ostream &os = llvh::outs();
+  JSONEmitter json{os, options.pretty};
+  json.openDict();
+  json.emitKey("counterErrors");
+  json.openDict();
+  for (unsigned i = 0; i < kNumCounters; ++i) {
+    const std::string &error = counters.getError((Counter)i);
+    if (!error.empty())
+      json.emitKeyValue(counterName((Counter)i), error);
+  }
+  json.closeDict();
+  json.emitKey("results");
+  json.openArray();
+  for (const Input &input : inputs) {
+    if (input.name.find(options.filter) != std::string::npos)
+      measure(options, counters, input, json);
+  }
+  json.closeArray();
+  json.closeDict();
+  os << "\n";
+  return 0;
+}
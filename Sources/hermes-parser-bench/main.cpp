@@ -0,0 +1,515 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/// Throughput benchmarks of the lexer, the parsers and the ESTree dumper.
+///
+/// Usage: hermes-parser-bench [options] <file or directory>...
+///   --filter=<substr>   only run benchmarks whose name contains <substr>
+///   --min-time=<sec>    run each benchmark for at least this long (0.5)
+///   --min-iterations=N  and at least this many times (5)
+///   --pretty            pretty-print the report
+///
+/// Inputs are usually generated by utils/gen-bench-corpus.py. The parser
+/// settings are chosen from the file name: *.jsx enables JSX, *.flow.js
+/// Flow, *.ts TypeScript, and *.json files are run through JSONParser
+/// instead of the JavaScript benchmarks.
+///
+/// The report, written to stdout, is a JSON object with one entry per
+/// benchmark and input, giving the median time of an iteration, the
+/// throughput in MB/s and the number of heap allocations (calls to operator
+/// new, which includes the allocator slabs) per KB of input.
+
+#include "hermes/AST/Context.h"
+#include "hermes/AST/ESTreeJSONDumper.h"
+#include "hermes/Parser/DocBlock.h"
+#include "hermes/Parser/JSLexer.h"
+#include "hermes/Parser/JSONParser.h"
+#include "hermes/Parser/JSParser.h"
+#include "hermes/Parser/SourceDialect.h"
+#include "hermes/Support/JSONEmitter.h"
+
+#include "llvh/Support/FileSystem.h"
+#include "llvh/Support/MemoryBuffer.h"
+#include "llvh/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace hermes;
+using namespace hermes::parser;
+
+//===----------------------------------------------------------------------===//
+// Allocation counting
+
+namespace {
+std::atomic<uint64_t> allocationCount{0};
+std::atomic<uint64_t> allocatedBytes{0};
+} // namespace
+
+void *operator new(size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+void *operator new[](size_t size) {
+  return ::operator new(size);
+}
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void *ptr) noexcept {
+  std::free(ptr);
+}
+void operator delete(void *ptr, size_t) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void *ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Inputs
+
+enum class InputKind { JS, JSX, Flow, TS, JSON };
+
+const char *inputKindName(InputKind kind) {
+  switch (kind) {
+    case InputKind::JS:
+      return "js";
+    case InputKind::JSX:
+      return "jsx";
+    case InputKind::Flow:
+      return "flow";
+    case InputKind::TS:
+      return "ts";
+    case InputKind::JSON:
+      return "json";
+  }
+  llvm_unreachable("invalid InputKind");
+}
+
+struct Input {
+  std::string name;
+  InputKind kind;
+  std::unique_ptr<llvh::MemoryBuffer> buffer;
+
+  llvh::StringRef text() const {
+    return buffer->getBuffer();
+  }
+};
+
+InputKind classify(llvh::StringRef path) {
+  if (path.endswith(".json"))
+    return InputKind::JSON;
+  if (path.endswith(".jsx"))
+    return InputKind::JSX;
+  if (path.endswith(".flow.js"))
+    return InputKind::Flow;
+  if (path.endswith(".ts") || path.endswith(".tsx"))
+    return InputKind::TS;
+  return InputKind::JS;
+}
+
+bool isInputFile(llvh::StringRef path) {
+  return path.endswith(".js") || path.endswith(".jsx") ||
+      path.endswith(".ts") || path.endswith(".tsx") || path.endswith(".json");
+}
+
+/// Append the inputs at \p path, a file or a directory, to \p inputs.
+bool addInputs(const std::string &path, std::vector<Input> &inputs) {
+  if (llvh::sys::fs::is_directory(path)) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (llvh::sys::fs::directory_iterator it(path, ec), end; !ec && it != end;
+         it.increment(ec)) {
+      if (isInputFile(it->path()))
+        files.push_back(it->path());
+    }
+    if (ec) {
+      llvh::errs() << path << ": " << ec.message() << "\n";
+      return false;
+    }
+    std::sort(files.begin(), files.end());
+    for (const std::string &file : files) {
+      if (!addInputs(file, inputs))
+        return false;
+    }
+    return true;
+  }
+
+  auto fileOrErr = llvh::MemoryBuffer::getFile(path);
+  if (!fileOrErr) {
+    llvh::errs() << path << ": " << fileOrErr.getError().message() << "\n";
+    return false;
+  }
+  llvh::StringRef name = llvh::StringRef(path).rsplit('/').second;
+  inputs.push_back(
+      Input{name.empty() ? path : name.str(),
+            classify(path),
+            std::move(*fileOrErr)});
+  return true;
+}
+
+void applyDialect(Context &context, InputKind kind) {
+  context.setParseJSX(kind == InputKind::JSX);
+  context.setParseFlow(
+      kind == InputKind::Flow ? ParseFlowSetting::ALL : ParseFlowSetting::NONE);
+  context.setParseTS(kind == InputKind::TS);
+}
+
+//===----------------------------------------------------------------------===//
+// Benchmarks
+
+/// Lex the whole input. Without a parser to tell it, the lexer guesses
+/// whether a '/' starts a regexp from the previous token, which is right for
+/// everything the corpus generator produces.
+bool benchLex(const Input &input) {
+  SourceErrorManager sm;
+  JSLexer::Allocator allocator;
+  StringTable strTab{allocator};
+  JSLexer lexer{input.buffer->getMemBufferRef(), sm, allocator, &strTab};
+  auto grammarContext = JSLexer::AllowRegExp;
+  for (;;) {
+    const Token *tok = lexer.advance(grammarContext);
+    switch (tok->getKind()) {
+      case TokenKind::eof:
+        return sm.getErrorCount() == 0;
+      case TokenKind::identifier:
+      case TokenKind::numeric_literal:
+      case TokenKind::string_literal:
+      case TokenKind::r_paren:
+      case TokenKind::r_square:
+      case TokenKind::r_brace:
+        grammarContext = JSLexer::AllowDiv;
+        break;
+      default:
+        grammarContext = JSLexer::AllowRegExp;
+        break;
+    }
+  }
+}
+
+bool benchParse(const Input &input) {
+  SourceErrorManager sm;
+  Context context{sm};
+  applyDialect(context, input.kind);
+  JSParser parser{context, input.buffer->getMemBufferRef()};
+  return parser.parse().hasValue() && sm.getErrorCount() == 0;
+}
+
+/// Parse the input with the dialects of \p kind and JSX enabled, which
+/// shows what their checks cost the parsing of plain JavaScript.
+bool benchParseAs(const Input &input, InputKind kind) {
+  SourceErrorManager sm;
+  Context context{sm};
+  applyDialect(context, kind);
+  context.setParseJSX(true);
+  JSParser parser{context, input.buffer->getMemBufferRef()};
+  return parser.parse().hasValue() && sm.getErrorCount() == 0;
+}
+
+/// Parse the input a top-level statement at a time, freeing each statement
+/// as soon as it has been parsed.
+bool benchParseStreaming(const Input &input) {
+  SourceErrorManager sm;
+  Context context{sm};
+  applyDialect(context, input.kind);
+  JSParser parser{context, input.buffer->getMemBufferRef()};
+  auto program = parser.parseStreaming(
+      [](ESTree::Node *) { return StatementAction::Release; });
+  return program.hasValue() && sm.getErrorCount() == 0;
+}
+
+/// Find the dependencies of the input without building its AST.
+bool benchScanDependencies(const Input &input) {
+  SourceErrorManager sm;
+  Context context{sm};
+  applyDialect(context, input.kind);
+  JSParser parser{context, input.buffer->getMemBufferRef()};
+  return parser.scanDependencies() && sm.getErrorCount() == 0;
+}
+
+/// Detect the dialect of the input from its file name and text, as
+/// HermesParseOptions::detectDialect does before every parse.
+bool benchDetectDialect(const Input &input) {
+  SourceErrorManager sm;
+  Context context{sm};
+  uint32_t bufId = sm.addNewSourceBuffer(
+      llvh::MemoryBuffer::getMemBuffer(input.buffer->getMemBufferRef()));
+  SourceDialect dialect = detectSourceDialect(context, bufId);
+  // JSX is detected in plain JavaScript that has "</" in a string or regexp,
+  // and parsing that as JSX is only slower.
+  switch (input.kind) {
+    case InputKind::JS:
+      return dialect == SourceDialect::JS || dialect == SourceDialect::JSX;
+    case InputKind::JSX:
+      return dialect == SourceDialect::JSX;
+    case InputKind::Flow:
+      return dialect == SourceDialect::Flow ||
+          dialect == SourceDialect::FlowJSX;
+    case InputKind::TS:
+      return dialect == SourceDialect::TS || dialect == SourceDialect::TSX;
+    case InputKind::JSON:
+      break;
+  }
+  return false;
+}
+
+/// Read the docblock of the input and its pragmas, as tools do for every file
+/// before deciding how to process it.
+bool benchScanDocBlock(const Input &input) {
+  DocBlock docBlock = scanDocBlock(input.text());
+  return docBlock.end <= input.text().size();
+}
+
+/// Pre-parse the input, then parse it lazily, skipping every function body,
+/// as the compiler does with lazy compilation enabled.
+bool benchLazyParse(const Input &input) {
+  SourceErrorManager sm;
+  Context context{sm};
+  applyDialect(context, input.kind);
+  uint32_t bufId = sm.addNewSourceBuffer(
+      llvh::MemoryBuffer::getMemBuffer(input.buffer->getMemBufferRef()));
+  if (!JSParser::preParseBuffer(context, bufId))
+    return false;
+  JSParser parser{context, bufId, LazyParse};
+  return parser.parse().hasValue() && sm.getErrorCount() == 0;
+}
+
+bool benchJSON(const Input &input, JSONParserEngine engine) {
+  SourceErrorManager sm;
+  JSONFactory::Allocator allocator;
+  JSONFactory factory{allocator};
+  JSONParser parser{factory, input.buffer->getMemBufferRef(), sm};
+  parser.setEngine(engine);
+  return parser.parse().hasValue();
+}
+
+/// The results of running one benchmark on one input.
+struct Result {
+  std::string benchmark;
+  const Input *input;
+  std::vector<double> seconds;
+  uint64_t allocations;
+  uint64_t allocatedBytes;
+  bool ok;
+};
+
+struct Options {
+  std::string filter;
+  double minTime = 0.5;
+  unsigned minIterations = 5;
+  bool pretty = false;
+};
+
+/// Run \p body repeatedly on \p input, after one untimed warm-up iteration.
+Result run(
+    const Options &options,
+    const char *benchmark,
+    const Input &input,
+    const std::function<bool()> &body) {
+  Result result{benchmark, &input, {}, 0, 0, body()};
+  if (!result.ok)
+    return result;
+
+  using Clock = std::chrono::steady_clock;
+  uint64_t allocationsBefore = allocationCount.load();
+  uint64_t bytesBefore = allocatedBytes.load();
+  double total = 0;
+  while (total < options.minTime ||
+         result.seconds.size() < options.minIterations) {
+    Clock::time_point start = Clock::now();
+    result.ok &= body();
+    double elapsed =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    result.seconds.push_back(elapsed);
+    total += elapsed;
+  }
+  result.allocations =
+      (allocationCount.load() - allocationsBefore) / result.seconds.size();
+  result.allocatedBytes =
+      (allocatedBytes.load() - bytesBefore) / result.seconds.size();
+  return result;
+}
+
+void emitResult(JSONEmitter &json, Result &result) {
+  const Input &input = *result.input;
+  double kb = input.text().size() / 1024.0;
+  json.openDict();
+  json.emitKeyValue("benchmark", result.benchmark);
+  json.emitKeyValue("input", input.name);
+  json.emitKeyValue("dialect", inputKindName(input.kind));
+  json.emitKeyValue("bytes", (unsigned long long)input.text().size());
+  json.emitKeyValue("ok", result.ok);
+  if (result.ok) {
+    std::vector<double> &seconds = result.seconds;
+    std::sort(seconds.begin(), seconds.end());
+    double median = seconds[seconds.size() / 2];
+    json.emitKeyValue("iterations", (unsigned long long)seconds.size());
+    json.emitKeyValue("medianSeconds", median);
+    json.emitKeyValue("minSeconds", seconds.front());
+    json.emitKeyValue("mbPerSecond", kb / 1024.0 / median);
+    json.emitKeyValue("allocationsPerKB", result.allocations / kb);
+    json.emitKeyValue("allocatedBytesPerKB", result.allocatedBytes / kb);
+  }
+  json.closeDict();
+}
+
+bool parseOptions(
+    int argc,
+    char **argv,
+    Options &options,
+    std::vector<std::string> &paths) {
+  for (int i = 1; i < argc; ++i) {
+    llvh::StringRef arg = argv[i];
+    if (arg.consume_front("--filter=")) {
+      options.filter = arg.str();
+    } else if (arg.consume_front("--min-time=")) {
+      options.minTime = std::atof(arg.str().c_str());
+    } else if (arg.consume_front("--min-iterations=")) {
+      options.minIterations = std::max(1, std::atoi(arg.str().c_str()));
+    } else if (arg == "--pretty") {
+      options.pretty = true;
+    } else if (arg.startswith("-")) {
+      llvh::errs() << "unknown option " << arg << "\n";
+      return false;
+    } else {
+      paths.push_back(arg.str());
+    }
+  }
+  if (paths.empty()) {
+    llvh::errs() << "usage: " << argv[0]
+                 << " [--filter=<substr>] [--min-time=<sec>]"
+                    " [--min-iterations=N] [--pretty] <file or directory>...\n";
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  std::vector<std::string> paths;
+  if (!parseOptions(argc, argv, options, paths))
+    return 2;
+
+  std::vector<Input> inputs;
+  for (const std::string &path : paths) {
+    if (!addInputs(path, inputs))
+      return 1;
+  }
+
+  std::vector<Result> results;
+  auto bench = [&](const char *name,
+                   const Input &input,
+                   const std::function<bool()> &body) {
+    std::string fullName = std::string(name) + "/" + input.name;
+    if (fullName.find(options.filter) == std::string::npos)
+      return;
+    results.push_back(run(options, name, input, body));
+    if (!results.back().ok)
+      llvh::errs() << fullName << ": failed\n";
+  };
+
+  for (const Input &input : inputs) {
+    if (input.kind == InputKind::JSON) {
+      bench("json-lexer", input, [&] {
+        return benchJSON(input, JSONParserEngine::Lexer);
+      });
+      bench("json-structural-index", input, [&] {
+        return benchJSON(input, JSONParserEngine::StructuralIndex);
+      });
+      continue;
+    }
+
+    // JSX text cannot be tokenized without the parser driving the lexer.
+    if (input.kind != InputKind::JSX)
+      bench("lex", input, [&] { return benchLex(input); });
+    bench("parse", input, [&] { return benchParse(input); });
+    if (input.kind == InputKind::JS) {
+      bench("parse-as-jsx", input, [&] {
+        return benchParseAs(input, InputKind::JSX);
+      });
+      bench("parse-as-flow-jsx", input, [&] {
+        return benchParseAs(input, InputKind::Flow);
+      });
+      bench("parse-as-ts-jsx", input, [&] {
+        return benchParseAs(input, InputKind::TS);
+      });
+    }
+    bench("parse-streaming", input, [&] {
+      return benchParseStreaming(input);
+    });
+    bench("lazy-parse", input, [&] { return benchLazyParse(input); });
+    bench("scan-dependencies", input, [&] {
+      return benchScanDependencies(input);
+    });
+    bench("detect-dialect", input, [&] { return benchDetectDialect(input); });
+    bench("scan-docblock", input, [&] { return benchScanDocBlock(input); });
+
+    // Dump an AST parsed once, outside of the timed region.
+    SourceErrorManager sm;
+    Context context{sm};
+    applyDialect(context, input.kind);
+    JSParser parser{context, input.buffer->getMemBufferRef()};
+    auto program = parser.parse();
+    if (!program)
+      continue;
+    bench("dump-estree-json", input, [&] {
+      llvh::raw_null_ostream os;
+      dumpESTreeJSON(os, *program, false, ESTreeDumpMode::HideEmpty);
+      return true;
+    });
+
+    // Reparse that AST after a keystroke: a space is typed after the first
+    // ';' past the middle of the input, then deleted on the next iteration.
+    llvh::StringRef original = input.text();
+    size_t semi = original.find(';', original.size() / 2);
+    size_t offset = semi == llvh::StringRef::npos ? original.size() : semi + 1;
+    std::string edited =
+        (original.substr(0, offset) + " " + original.substr(offset)).str();
+    bool typed = false;
+    bench("reparse-edit", input, [&] {
+      if (!program)
+        return false;
+      llvh::StringRef oldSource = typed ? llvh::StringRef(edited) : original;
+      llvh::StringRef newSource = typed ? original : llvh::StringRef(edited);
+      SourceEdit edit{offset, typed ? 1u : 0u, typed ? 0u : 1u};
+      JSParser reparser{context, llvh::MemoryBufferRef(newSource, "edited")};
+      program = reparser.reparse(*program, oldSource, edit);
+      typed = !typed;
+      return program.hasValue() && sm.getErrorCount() == 0;
+    });
+  }
+
+  bool ok = true;
+  llvh::raw_ostream &os = llvh::outs();
+  JSONEmitter json{os, options.pretty};
+  json.openDict();
+  json.emitKeyValue("minTime", options.minTime);
+  json.emitKey("results");
+  json.openArray();
+  for (Result &result : results) {
+    emitResult(json, result);
+    ok &= result.ok;
+  }
+  json.closeArray();
+  json.closeDict();
+  os << "\n";
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+import Foundation
+
+/// The outcome of parsing one file with `ParseSession.parseMany`.
+public struct ParsedFile: Sendable {
+    /// The path as it was passed to `parseMany`.
+    public let path: String
+
+    /// The position of the path in the list passed to `parseMany`.
+    public let index: Int
+
+    public let result: Result<ParseSession, ParseError>
+}
+
+extension ParseSession {
+    /// Parse `files` concurrently, each in its own Context, and deliver the
+    /// results in completion order as they become available.
+    ///
+    /// At most `maxConcurrency` files are parsed at a time, and it must be
+    /// positive. Once the task iterating the stream is cancelled or stops
+    /// iterating, no further file is started, and parses already under way
+    /// are interrupted. An empty `files` gives a stream that is already
+    /// finished.
+    ///
+    /// Every successful result holds a whole AST, so a consumer that keeps
+    /// all of them keeps all of the arenas alive.
+    public static func parseMany(
+        files: [String],
+        options: ParseOptions = ParseOptions(),
+        maxConcurrency: Int = ProcessInfo.processInfo.activeProcessorCount
+    ) -> AsyncStream<ParsedFile> {
+        precondition(maxConcurrency > 0, "maxConcurrency must be positive")
+        if files.isEmpty {
+            return AsyncStream { $0.finish() }
+        }
+        let width = min(maxConcurrency, files.count)
+
+        @Sendable func parseFile(_ index: Int) async -> ParsedFile? {
+            if Task.isCancelled {
+                return nil
+            }
+            let path = files[index]
+            do {
+                let session = try await parse(contentsOfFile: path, options: options)
+                return ParsedFile(path: path, index: index, result: .success(session))
+            } catch let error as ParseError {
+                return ParsedFile(path: path, index: index, result: .failure(error))
+            } catch {
+                // Cancelled.
+                return nil
+            }
+        }
+
+        return AsyncStream { continuation in
+            let producer = Task {
+                await withTaskGroup(of: ParsedFile?.self) { group in
+                    var next = 0
+                    while next < width {
+                        let index = next
+                        group.addTask { await parseFile(index) }
+                        next += 1
+                    }
+                    // Start the next file whenever one completes, so no more
+                    // than `width` are in flight.
+                    for await parsed in group {
+                        if let parsed {
+                            continuation.yield(parsed)
+                        }
+                        if next < files.count && !Task.isCancelled {
+                            let index = next
+                            group.addTask { await parseFile(index) }
+                            next += 1
+                        }
+                    }
+                }
+                continuation.finish()
+            }
+            continuation.onTermination = { _ in
+                producer.cancel()
+            }
+        }
+    }
+}
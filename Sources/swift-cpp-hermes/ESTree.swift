@@ -0,0 +1,2973 @@
+// Generated by utils/gen-swift-estree.py from ESTree.def. Do not edit.
+
+import cxxHermesForSwift
+
+extension ESTree {
+
+    public struct EmptyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .Empty }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    public struct MetadataNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .Metadata }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    public struct ProgramNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .Program }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var body: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    public struct FunctionExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .FunctionExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+        public var returnType: Node? { Node(hermesNodeGetNode(node.raw, 4)) }
+        public var predicate: Node? { Node(hermesNodeGetNode(node.raw, 5)) }
+        public var generator: Bool { hermesNodeGetBoolean(node.raw, 6) }
+        public var `async`: Bool { hermesNodeGetBoolean(node.raw, 7) }
+    }
+
+    public struct ArrowFunctionExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ArrowFunctionExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+        public var returnType: Node? { Node(hermesNodeGetNode(node.raw, 4)) }
+        public var predicate: Node? { Node(hermesNodeGetNode(node.raw, 5)) }
+        public var expression: Bool { hermesNodeGetBoolean(node.raw, 6) }
+        public var `async`: Bool { hermesNodeGetBoolean(node.raw, 7) }
+    }
+
+    public struct FunctionDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .FunctionDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+        public var returnType: Node? { Node(hermesNodeGetNode(node.raw, 4)) }
+        public var predicate: Node? { Node(hermesNodeGetNode(node.raw, 5)) }
+        public var generator: Bool { hermesNodeGetBoolean(node.raw, 6) }
+        public var `async`: Bool { hermesNodeGetBoolean(node.raw, 7) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ComponentDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ComponentDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+        public var rendersType: Node? { Node(hermesNodeGetNode(node.raw, 4)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct HookDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .HookDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+        public var returnType: Node? { Node(hermesNodeGetNode(node.raw, 4)) }
+    }
+
+    public struct WhileStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .WhileStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var test: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct DoWhileStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DoWhileStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var test: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct ForInStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ForInStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var left: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var right: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    public struct ForOfStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ForOfStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var left: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var right: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+        public var `await`: Bool { hermesNodeGetBoolean(node.raw, 3) }
+    }
+
+    public struct ForStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ForStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var `init`: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var test: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var update: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 3)) }
+    }
+
+    public struct DebuggerStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DebuggerStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    public struct EmptyStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EmptyStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    public struct BlockStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .BlockStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var body: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    public struct BreakStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .BreakStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var label: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct ContinueStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ContinueStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var label: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct ThrowStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ThrowStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var argument: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct ReturnStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ReturnStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var argument: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct WithStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .WithStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var object: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct SwitchStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .SwitchStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var discriminant: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var cases: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+    }
+
+    public struct LabeledStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .LabeledStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var label: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct ExpressionStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ExpressionStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var expression: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var directive: StringView? { StringView(hermesNodeGetString(node.raw, 1)) }
+    }
+
+    public struct TryStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TryStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var block: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var handler: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var finalizer: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    public struct IfStatementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .IfStatement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var test: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var consequent: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var alternate: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    public struct NullLiteralNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .NullLiteral }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    public struct BooleanLiteralNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .BooleanLiteral }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var value: Bool { hermesNodeGetBoolean(node.raw, 0) }
+    }
+
+    public struct StringLiteralNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .StringLiteral }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var value: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+    }
+
+    public struct NumericLiteralNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .NumericLiteral }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var value: Double { hermesNodeGetNumber(node.raw, 0) }
+    }
+
+    public struct RegExpLiteralNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .RegExpLiteral }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var pattern: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+        public var flags: StringView? { StringView(hermesNodeGetString(node.raw, 1)) }
+    }
+
+    public struct BigIntLiteralNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .BigIntLiteral }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var bigint: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+    }
+
+    public struct ThisExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ThisExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    public struct SuperNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .Super }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    public struct SequenceExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .SequenceExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var expressions: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    public struct ObjectExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ObjectExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var properties: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    public struct ArrayExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ArrayExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var elements: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var trailingComma: Bool { hermesNodeGetBoolean(node.raw, 1) }
+    }
+
+    public struct SpreadElementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .SpreadElement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var argument: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct NewExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .NewExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var callee: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeArguments: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var arguments: NodeList { NodeList(hermesNodeGetList(node.raw, 2)) }
+    }
+
+    public struct YieldExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .YieldExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var argument: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var delegate: Bool { hermesNodeGetBoolean(node.raw, 1) }
+    }
+
+    public struct AwaitExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .AwaitExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var argument: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct ImportExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ImportExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var source: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var attributes: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct CallExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .CallExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var callee: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeArguments: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var arguments: NodeList { NodeList(hermesNodeGetList(node.raw, 2)) }
+    }
+
+    public struct OptionalCallExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .OptionalCallExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var callee: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeArguments: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var arguments: NodeList { NodeList(hermesNodeGetList(node.raw, 2)) }
+        public var optional: Bool { hermesNodeGetBoolean(node.raw, 3) }
+    }
+
+    public struct AssignmentExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .AssignmentExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var `operator`: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+        public var left: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var right: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    public struct UnaryExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .UnaryExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var `operator`: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+        public var argument: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var prefix: Bool { hermesNodeGetBoolean(node.raw, 2) }
+    }
+
+    public struct UpdateExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .UpdateExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var `operator`: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+        public var argument: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var prefix: Bool { hermesNodeGetBoolean(node.raw, 2) }
+    }
+
+    public struct MemberExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .MemberExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var object: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var property: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var computed: Bool { hermesNodeGetBoolean(node.raw, 2) }
+    }
+
+    public struct OptionalMemberExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .OptionalMemberExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var object: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var property: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var computed: Bool { hermesNodeGetBoolean(node.raw, 2) }
+        public var optional: Bool { hermesNodeGetBoolean(node.raw, 3) }
+    }
+
+    public struct LogicalExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .LogicalExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var left: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var right: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var `operator`: StringView? { StringView(hermesNodeGetString(node.raw, 2)) }
+    }
+
+    public struct ConditionalExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ConditionalExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var test: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var alternate: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var consequent: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    public struct BinaryExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .BinaryExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var left: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var right: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var `operator`: StringView? { StringView(hermesNodeGetString(node.raw, 2)) }
+    }
+
+    public struct DirectiveNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .Directive }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var value: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct DirectiveLiteralNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DirectiveLiteral }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var value: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+    }
+
+    public struct IdentifierNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .Identifier }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var name: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+        public var typeAnnotation: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var optional: Bool { hermesNodeGetBoolean(node.raw, 2) }
+    }
+
+    public struct PrivateNameNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .PrivateName }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct MetaPropertyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .MetaProperty }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var meta: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var property: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct SwitchCaseNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .SwitchCase }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var test: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var consequent: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+    }
+
+    public struct CatchClauseNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .CatchClause }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var param: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct VariableDeclaratorNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .VariableDeclarator }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var `init`: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct VariableDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .VariableDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var kind: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+        public var declarations: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+    }
+
+    public struct TemplateLiteralNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TemplateLiteral }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var quasis: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var expressions: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+    }
+
+    public struct TaggedTemplateExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TaggedTemplateExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var tag: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var quasi: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct TemplateElementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TemplateElement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var tail: Bool { hermesNodeGetBoolean(node.raw, 0) }
+        public var cooked: StringView? { StringView(hermesNodeGetString(node.raw, 1)) }
+        public var raw: StringView? { StringView(hermesNodeGetString(node.raw, 2)) }
+    }
+
+    public struct PropertyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .Property }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var key: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var value: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var kind: StringView? { StringView(hermesNodeGetString(node.raw, 2)) }
+        public var computed: Bool { hermesNodeGetBoolean(node.raw, 3) }
+        public var method: Bool { hermesNodeGetBoolean(node.raw, 4) }
+        public var shorthand: Bool { hermesNodeGetBoolean(node.raw, 5) }
+    }
+
+    public struct ClassDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ClassDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var superClass: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+        public var superTypeParameters: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+        public var implements: NodeList { NodeList(hermesNodeGetList(node.raw, 4)) }
+        public var decorators: NodeList { NodeList(hermesNodeGetList(node.raw, 5)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 6)) }
+    }
+
+    public struct ClassExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ClassExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var superClass: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+        public var superTypeParameters: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+        public var implements: NodeList { NodeList(hermesNodeGetList(node.raw, 4)) }
+        public var decorators: NodeList { NodeList(hermesNodeGetList(node.raw, 5)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 6)) }
+    }
+
+    public struct ClassBodyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ClassBody }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var body: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    public struct ClassPropertyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ClassProperty }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var key: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var value: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var computed: Bool { hermesNodeGetBoolean(node.raw, 2) }
+        public var `static`: Bool { hermesNodeGetBoolean(node.raw, 3) }
+        public var declare: Bool { hermesNodeGetBoolean(node.raw, 4) }
+        public var optional: Bool { hermesNodeGetBoolean(node.raw, 5) }
+        public var variance: Node? { Node(hermesNodeGetNode(node.raw, 6)) }
+        public var typeAnnotation: Node? { Node(hermesNodeGetNode(node.raw, 7)) }
+        public var tsModifiers: Node? { Node(hermesNodeGetNode(node.raw, 8)) }
+    }
+
+    public struct ClassPrivatePropertyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ClassPrivateProperty }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var key: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var value: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var `static`: Bool { hermesNodeGetBoolean(node.raw, 2) }
+        public var declare: Bool { hermesNodeGetBoolean(node.raw, 3) }
+        public var optional: Bool { hermesNodeGetBoolean(node.raw, 4) }
+        public var variance: Node? { Node(hermesNodeGetNode(node.raw, 5)) }
+        public var typeAnnotation: Node? { Node(hermesNodeGetNode(node.raw, 6)) }
+        public var tsModifiers: Node? { Node(hermesNodeGetNode(node.raw, 7)) }
+    }
+
+    public struct MethodDefinitionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .MethodDefinition }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var key: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var value: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var kind: StringView? { StringView(hermesNodeGetString(node.raw, 2)) }
+        public var computed: Bool { hermesNodeGetBoolean(node.raw, 3) }
+        public var `static`: Bool { hermesNodeGetBoolean(node.raw, 4) }
+    }
+
+    public struct ImportDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ImportDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var specifiers: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var source: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var assertions: NodeList { NodeList(hermesNodeGetList(node.raw, 2)) }
+        public var importKind: StringView? { StringView(hermesNodeGetString(node.raw, 3)) }
+    }
+
+    public struct ImportSpecifierNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ImportSpecifier }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var imported: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var local: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var importKind: StringView? { StringView(hermesNodeGetString(node.raw, 2)) }
+    }
+
+    public struct ImportDefaultSpecifierNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ImportDefaultSpecifier }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var local: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct ImportNamespaceSpecifierNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ImportNamespaceSpecifier }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var local: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct ImportAttributeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ImportAttribute }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var key: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var value: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct ExportNamedDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ExportNamedDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var declaration: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var specifiers: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var source: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+        public var exportKind: StringView? { StringView(hermesNodeGetString(node.raw, 3)) }
+    }
+
+    public struct ExportSpecifierNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ExportSpecifier }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var exported: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var local: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct ExportNamespaceSpecifierNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ExportNamespaceSpecifier }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var exported: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct ExportDefaultDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ExportDefaultDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var declaration: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct ExportAllDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ExportAllDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var source: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var exportKind: StringView? { StringView(hermesNodeGetString(node.raw, 1)) }
+    }
+
+    public struct ObjectPatternNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ObjectPattern }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var properties: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var typeAnnotation: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct ArrayPatternNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ArrayPattern }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var elements: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var typeAnnotation: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    public struct RestElementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .RestElement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var argument: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    public struct AssignmentPatternNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .AssignmentPattern }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var left: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var right: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXIdentifierNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXIdentifier }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var name: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXMemberExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXMemberExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var object: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var property: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXNamespacedNameNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXNamespacedName }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var namespace: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var name: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXEmptyExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXEmptyExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXExpressionContainerNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXExpressionContainer }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var expression: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXSpreadChildNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXSpreadChild }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var expression: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXOpeningElementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXOpeningElement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var name: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var attributes: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var selfClosing: Bool { hermesNodeGetBoolean(node.raw, 2) }
+        public var typeArguments: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXClosingElementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXClosingElement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var name: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXAttributeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXAttribute }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var name: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var value: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXSpreadAttributeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXSpreadAttribute }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var argument: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXStringLiteralNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXStringLiteral }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var value: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+        public var raw: StringView? { StringView(hermesNodeGetString(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXTextNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXText }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var value: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+        public var raw: StringView? { StringView(hermesNodeGetString(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXElementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXElement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var openingElement: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var children: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var closingElement: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXFragmentNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXFragment }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var openingFragment: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var children: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var closingFragment: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXOpeningFragmentNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXOpeningFragment }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_JSX.
+    public struct JSXClosingFragmentNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .JSXClosingFragment }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ExistsTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ExistsTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct EmptyTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EmptyTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct StringTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .StringTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct NumberTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .NumberTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct StringLiteralTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .StringLiteralTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var value: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+        public var raw: StringView? { StringView(hermesNodeGetString(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct NumberLiteralTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .NumberLiteralTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var value: Double { hermesNodeGetNumber(node.raw, 0) }
+        public var raw: StringView? { StringView(hermesNodeGetString(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct BigIntLiteralTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .BigIntLiteralTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var raw: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct BooleanTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .BooleanTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct BooleanLiteralTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .BooleanLiteralTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var value: Bool { hermesNodeGetBoolean(node.raw, 0) }
+        public var raw: StringView? { StringView(hermesNodeGetString(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct NullLiteralTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .NullLiteralTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct SymbolTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .SymbolTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct AnyTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .AnyTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct MixedTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .MixedTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct BigIntTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .BigIntTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct VoidTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .VoidTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct FunctionTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .FunctionTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var this: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var returnType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+        public var rest: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 4)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct HookTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .HookTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var returnType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var rest: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct FunctionTypeParamNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .FunctionTypeParam }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var name: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var optional: Bool { hermesNodeGetBoolean(node.raw, 2) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ComponentTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ComponentTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var rest: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+        public var rendersType: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ComponentTypeParameterNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ComponentTypeParameter }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var name: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var optional: Bool { hermesNodeGetBoolean(node.raw, 2) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct NullableTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .NullableTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct QualifiedTypeIdentifierNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .QualifiedTypeIdentifier }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var qualification: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct TypeofTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TypeofTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var argument: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeArguments: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct KeyofTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .KeyofTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var argument: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct TypeOperatorNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TypeOperator }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var `operator`: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct QualifiedTypeofIdentifierNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .QualifiedTypeofIdentifier }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var qualification: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct TupleTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TupleTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var types: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var inexact: Bool { hermesNodeGetBoolean(node.raw, 1) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct TupleTypeSpreadElementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TupleTypeSpreadElement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var label: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct TupleTypeLabeledElementNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TupleTypeLabeledElement }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var label: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var elementType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var optional: Bool { hermesNodeGetBoolean(node.raw, 2) }
+        public var variance: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ArrayTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ArrayTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var elementType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct InferTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .InferTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var typeParameter: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct UnionTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .UnionTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var types: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct IntersectionTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .IntersectionTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var types: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct GenericTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .GenericTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct IndexedAccessTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .IndexedAccessType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var objectType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var indexType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct OptionalIndexedAccessTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .OptionalIndexedAccessType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var objectType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var indexType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var optional: Bool { hermesNodeGetBoolean(node.raw, 2) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ConditionalTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ConditionalTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var checkType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var extendsType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var trueType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+        public var falseType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 3)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct TypePredicateNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TypePredicate }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var parameterName: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeAnnotation: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var kind: StringView? { StringView(hermesNodeGetString(node.raw, 2)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct InterfaceTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .InterfaceTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var extends: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var body: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct TypeAliasNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TypeAlias }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var right: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct OpaqueTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .OpaqueType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var impltype: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+        public var supertype: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct InterfaceDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .InterfaceDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var extends: NodeList { NodeList(hermesNodeGetList(node.raw, 2)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 3)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareTypeAliasNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareTypeAlias }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var right: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareOpaqueTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareOpaqueType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var impltype: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+        public var supertype: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareInterfaceNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareInterface }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var extends: NodeList { NodeList(hermesNodeGetList(node.raw, 2)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 3)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareClassNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareClass }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var extends: NodeList { NodeList(hermesNodeGetList(node.raw, 2)) }
+        public var implements: NodeList { NodeList(hermesNodeGetList(node.raw, 3)) }
+        public var mixins: NodeList { NodeList(hermesNodeGetList(node.raw, 4)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 5)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareFunctionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareFunction }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var predicate: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareHookNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareHook }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareComponentNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareComponent }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var rest: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+        public var rendersType: Node? { Node(hermesNodeGetNode(node.raw, 4)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareVariableNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareVariable }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var kind: StringView? { StringView(hermesNodeGetString(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareEnumNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareEnum }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareExportDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareExportDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var declaration: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var specifiers: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var source: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+        public var `default`: Bool { hermesNodeGetBoolean(node.raw, 3) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareExportAllDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareExportAllDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var source: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareModuleNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareModule }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareNamespaceNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareNamespace }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclareModuleExportsNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclareModuleExports }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct InterfaceExtendsNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .InterfaceExtends }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ClassImplementsNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ClassImplements }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct TypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ObjectTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ObjectTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var properties: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var indexers: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var callProperties: NodeList { NodeList(hermesNodeGetList(node.raw, 2)) }
+        public var internalSlots: NodeList { NodeList(hermesNodeGetList(node.raw, 3)) }
+        public var inexact: Bool { hermesNodeGetBoolean(node.raw, 4) }
+        public var exact: Bool { hermesNodeGetBoolean(node.raw, 5) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ObjectTypePropertyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ObjectTypeProperty }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var key: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var value: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var method: Bool { hermesNodeGetBoolean(node.raw, 2) }
+        public var optional: Bool { hermesNodeGetBoolean(node.raw, 3) }
+        public var `static`: Bool { hermesNodeGetBoolean(node.raw, 4) }
+        public var proto: Bool { hermesNodeGetBoolean(node.raw, 5) }
+        public var variance: Node? { Node(hermesNodeGetNode(node.raw, 6)) }
+        public var kind: StringView? { StringView(hermesNodeGetString(node.raw, 7)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ObjectTypeSpreadPropertyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ObjectTypeSpreadProperty }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var argument: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ObjectTypeInternalSlotNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ObjectTypeInternalSlot }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var value: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var optional: Bool { hermesNodeGetBoolean(node.raw, 2) }
+        public var `static`: Bool { hermesNodeGetBoolean(node.raw, 3) }
+        public var method: Bool { hermesNodeGetBoolean(node.raw, 4) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ObjectTypeCallPropertyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ObjectTypeCallProperty }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var value: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var `static`: Bool { hermesNodeGetBoolean(node.raw, 1) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ObjectTypeIndexerNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ObjectTypeIndexer }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node? { Node(hermesNodeGetNode(node.raw, 0)) }
+        public var key: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var value: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+        public var `static`: Bool { hermesNodeGetBoolean(node.raw, 3) }
+        public var variance: Node? { Node(hermesNodeGetNode(node.raw, 4)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ObjectTypeMappedTypePropertyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ObjectTypeMappedTypeProperty }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var keyTparam: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var propType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var sourceType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+        public var variance: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+        public var optional: StringView? { StringView(hermesNodeGetString(node.raw, 4)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct VarianceNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .Variance }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var kind: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct TypeParameterDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TypeParameterDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct TypeParameterNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TypeParameter }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var name: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+        public var bound: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var variance: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+        public var `default`: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+        public var usesExtendsBound: Bool { hermesNodeGetBoolean(node.raw, 4) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct TypeParameterInstantiationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TypeParameterInstantiation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct TypeCastExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TypeCastExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var expression: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct AsExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .AsExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var expression: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct AsConstExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .AsConstExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var expression: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct InferredPredicateNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .InferredPredicate }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct DeclaredPredicateNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .DeclaredPredicate }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var value: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct EnumDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EnumDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct EnumStringBodyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EnumStringBody }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var members: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var explicitType: Bool { hermesNodeGetBoolean(node.raw, 1) }
+        public var hasUnknownMembers: Bool { hermesNodeGetBoolean(node.raw, 2) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct EnumNumberBodyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EnumNumberBody }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var members: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var explicitType: Bool { hermesNodeGetBoolean(node.raw, 1) }
+        public var hasUnknownMembers: Bool { hermesNodeGetBoolean(node.raw, 2) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct EnumBigIntBodyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EnumBigIntBody }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var members: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var explicitType: Bool { hermesNodeGetBoolean(node.raw, 1) }
+        public var hasUnknownMembers: Bool { hermesNodeGetBoolean(node.raw, 2) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct EnumBooleanBodyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EnumBooleanBody }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var members: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var explicitType: Bool { hermesNodeGetBoolean(node.raw, 1) }
+        public var hasUnknownMembers: Bool { hermesNodeGetBoolean(node.raw, 2) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct EnumSymbolBodyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EnumSymbolBody }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var members: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var hasUnknownMembers: Bool { hermesNodeGetBoolean(node.raw, 1) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct EnumDefaultedMemberNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EnumDefaultedMember }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct EnumStringMemberNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EnumStringMember }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var `init`: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct EnumNumberMemberNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EnumNumberMember }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var `init`: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct EnumBigIntMemberNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EnumBigIntMember }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var `init`: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct EnumBooleanMemberNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .EnumBooleanMember }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var `init`: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_FLOW.
+    public struct ComponentParameterNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .ComponentParameter }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var name: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var local: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var shorthand: Bool { hermesNodeGetBoolean(node.raw, 2) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSTypeAnnotationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSTypeAnnotation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSAnyKeywordNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSAnyKeyword }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSNumberKeywordNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSNumberKeyword }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSBooleanKeywordNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSBooleanKeyword }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSStringKeywordNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSStringKeyword }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSSymbolKeywordNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSSymbolKeyword }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSVoidKeywordNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSVoidKeyword }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSUndefinedKeywordNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSUndefinedKeyword }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSUnknownKeywordNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSUnknownKeyword }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSNeverKeywordNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSNeverKeyword }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSBigIntKeywordNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSBigIntKeyword }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSThisTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSThisType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSLiteralTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSLiteralType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var literal: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSIndexedAccessTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSIndexedAccessType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var objectType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var indexType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSArrayTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSArrayType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var elementType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSTypeReferenceNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSTypeReference }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var typeName: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSQualifiedNameNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSQualifiedName }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var left: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var right: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSFunctionTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSFunctionType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var returnType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSConstructorTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSConstructorType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var returnType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSTypePredicateNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSTypePredicate }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var parameterName: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSTupleTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSTupleType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var elementTypes: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSTypeAssertionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSTypeAssertion }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var expression: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSAsExpressionNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSAsExpression }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var expression: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSParameterPropertyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSParameterProperty }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var parameter: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var accessibility: StringView? { StringView(hermesNodeGetString(node.raw, 1)) }
+        public var readonly: Bool { hermesNodeGetBoolean(node.raw, 2) }
+        public var `static`: Bool { hermesNodeGetBoolean(node.raw, 3) }
+        public var export: Bool { hermesNodeGetBoolean(node.raw, 4) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSTypeAliasDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSTypeAliasDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var typeAnnotation: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSInterfaceDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSInterfaceDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var extends: NodeList { NodeList(hermesNodeGetList(node.raw, 2)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 3)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSInterfaceHeritageNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSInterfaceHeritage }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var expression: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeParameters: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSInterfaceBodyNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSInterfaceBody }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var body: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSEnumDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSEnumDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var members: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSEnumMemberNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSEnumMember }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var initializer: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSModuleDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSModuleDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var body: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSModuleBlockNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSModuleBlock }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var body: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSModuleMemberNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSModuleMember }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var id: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var initializer: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSTypeParameterDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSTypeParameterDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSTypeParameterNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSTypeParameter }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var name: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var constraint: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var `default`: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSTypeParameterInstantiationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSTypeParameterInstantiation }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSUnionTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSUnionType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var types: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSIntersectionTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSIntersectionType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var types: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSTypeQueryNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSTypeQuery }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var exprName: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSConditionalTypeNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSConditionalType }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var checkType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var extendsType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 1)) }
+        public var trueType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 2)) }
+        public var falseType: Node { Node(unchecked: hermesNodeGetNode(node.raw, 3)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSTypeLiteralNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSTypeLiteral }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var members: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSPropertySignatureNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSPropertySignature }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var key: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var typeAnnotation: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+        public var initializer: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+        public var optional: Bool { hermesNodeGetBoolean(node.raw, 3) }
+        public var computed: Bool { hermesNodeGetBoolean(node.raw, 4) }
+        public var readonly: Bool { hermesNodeGetBoolean(node.raw, 5) }
+        public var `static`: Bool { hermesNodeGetBoolean(node.raw, 6) }
+        public var export: Bool { hermesNodeGetBoolean(node.raw, 7) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSMethodSignatureNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSMethodSignature }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var key: Node { Node(unchecked: hermesNodeGetNode(node.raw, 0)) }
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 1)) }
+        public var returnType: Node? { Node(hermesNodeGetNode(node.raw, 2)) }
+        public var computed: Bool { hermesNodeGetBoolean(node.raw, 3) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSIndexSignatureNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSIndexSignature }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var parameters: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var typeAnnotation: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSCallSignatureDeclarationNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSCallSignatureDeclaration }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var params: NodeList { NodeList(hermesNodeGetList(node.raw, 0)) }
+        public var returnType: Node? { Node(hermesNodeGetNode(node.raw, 1)) }
+    }
+
+    // Requires HERMES_PARSE_TS.
+    public struct TSModifiersNode: TypedNode {
+        public static var kind: hermes.ESTree.NodeKind { .TSModifiers }
+        public let node: Node
+
+        public init(unchecked node: Node) {
+            self.node = node
+        }
+
+        public var accessibility: StringView? { StringView(hermesNodeGetString(node.raw, 0)) }
+        public var readonly: Bool { hermesNodeGetBoolean(node.raw, 1) }
+    }
+}
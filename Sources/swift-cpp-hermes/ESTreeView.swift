@@ -0,0 +1,145 @@
+import cxxHermesForSwift
+
+/// A read-only view of the AST of a `ParseSession`.
+///
+/// Handles are plain pointers into the Context arena: they are not reference
+/// counted, and nothing is allocated on the Swift side until a field is read.
+/// They do not keep the AST alive, so they must not be used after the session
+/// that produced them has been released (see `ParseSession.withAST`).
+///
+/// The typed node structs (`ESTree.IdentifierNode` and so on) are generated
+/// from ESTree.def by utils/gen-swift-estree.py into ESTree.swift.
+public enum ESTree {
+    /// A node of any kind.
+    public struct Node: Hashable {
+        let raw: UnsafeRawPointer
+
+        init(unchecked raw: UnsafeRawPointer?) {
+            self.raw = raw!
+        }
+
+        init?(_ raw: UnsafeRawPointer?) {
+            guard let raw else { return nil }
+            self.raw = raw
+        }
+
+        public var kind: hermes.ESTree.NodeKind {
+            hermesNodeKind(raw)
+        }
+
+        /// The source text of the node, or nil if it has no location.
+        public var sourceText: StringView? {
+            let range = hermesNodeSourceRange(raw)
+            guard let start = range.start, let end = range.end else { return nil }
+            return StringView(HermesStringRef(data: start, size: end - start))
+        }
+
+        /// The node as `type`, or nil if it is of a different kind.
+        public func `as`<T: TypedNode>(_ type: T.Type) -> T? {
+            T(self)
+        }
+    }
+
+    /// A node of one particular kind, with typed accessors for its fields.
+    public protocol TypedNode: Hashable {
+        static var kind: hermes.ESTree.NodeKind { get }
+        var node: Node { get }
+        /// Wrap `node`, which must be of kind `Self.kind`.
+        init(unchecked node: Node)
+    }
+
+    /// The elements of a NodeList field, visited in order. Nothing is
+    /// materialized: iteration follows the list links in the arena.
+    public struct NodeList: Sequence {
+        let list: UnsafeRawPointer
+
+        init(_ list: UnsafeRawPointer?) {
+            self.list = list!
+        }
+
+        public var isEmpty: Bool {
+            hermesNodeListFirst(list) == nil
+        }
+
+        public var first: Node? {
+            Node(hermesNodeListFirst(list))
+        }
+
+        public func makeIterator() -> Iterator {
+            Iterator(list: list, next: hermesNodeListFirst(list))
+        }
+
+        public struct Iterator: IteratorProtocol {
+            let list: UnsafeRawPointer
+            var next: UnsafeRawPointer?
+
+            public mutating func next() -> Node? {
+                guard let current = next else { return nil }
+                next = hermesNodeListNext(list, current)
+                return Node(unchecked: current)
+            }
+        }
+    }
+
+    /// The bytes of an identifier, string literal or source range, viewed in
+    /// place.
+    ///
+    /// Labels and strings use Hermes' modified UTF-8, in which each half of a
+    /// surrogate pair is encoded separately; `description` replaces such
+    /// sequences with U+FFFD.
+    public struct StringView: RandomAccessCollection, Hashable, CustomStringConvertible {
+        public let bytes: UnsafeBufferPointer<UInt8>
+
+        init?(_ ref: HermesStringRef) {
+            guard let data = ref.data else { return nil }
+            bytes = UnsafeBufferPointer(
+                start: UnsafeRawPointer(data).assumingMemoryBound(to: UInt8.self),
+                count: ref.size)
+        }
+
+        public var startIndex: Int { 0 }
+        public var endIndex: Int { bytes.count }
+
+        public subscript(position: Int) -> UInt8 {
+            bytes[position]
+        }
+
+        public var description: String {
+            String(decoding: bytes, as: UTF8.self)
+        }
+
+        public static func == (lhs: StringView, rhs: StringView) -> Bool {
+            lhs.bytes.elementsEqual(rhs.bytes)
+        }
+
+        /// Compare with `string` without creating a String from the view.
+        public static func == (lhs: StringView, rhs: String) -> Bool {
+            lhs.bytes.elementsEqual(rhs.utf8)
+        }
+
+        public func hash(into hasher: inout Hasher) {
+            hasher.combine(bytes: UnsafeRawBufferPointer(bytes))
+        }
+    }
+}
+
+extension ESTree.TypedNode {
+    /// Wrap `node` if it is of kind `Self.kind`.
+    public init?(_ node: ESTree.Node) {
+        guard node.kind == Self.kind else { return nil }
+        self.init(unchecked: node)
+    }
+}
+
+extension ParseSession {
+    /// The root of the AST. It is valid as long as the session is alive.
+    public var ast: ESTree.ProgramNode {
+        ESTree.ProgramNode(unchecked: ESTree.Node(unchecked: UnsafeRawPointer(program)))
+    }
+
+    /// Pass the root of the AST to `body`, keeping the session alive until
+    /// `body` returns.
+    public func withAST<R>(_ body: (ESTree.ProgramNode) throws -> R) rethrows -> R {
+        try withExtendedLifetime(self) { try body(ast) }
+    }
+}
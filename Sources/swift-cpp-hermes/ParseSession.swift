@@ -0,0 +1,572 @@
+import cxxHermesForSwift
+
+/// Parser settings, mirroring the parser flags of `hermes::Context`.
+public struct ParseOptions: Sendable {
+    public enum FlowSyntax: Sendable {
+        case none
+        case all
+        /// Syntax that could also be plain JavaScript is parsed as JavaScript.
+        case unambiguous
+    }
+
+    /// A dialect of JavaScript, which sets `jsx`, `flow` and `typeScript`.
+    public enum Dialect: Sendable, Hashable {
+        case javaScript
+        case jsx
+        /// Flow with `flow: .all`.
+        case flow
+        case flowJSX
+        case typeScript
+        case tsx
+
+        init(_ cxx: hermes.parser.SourceDialect) {
+            switch cxx {
+            case .JS: self = .javaScript
+            case .JSX: self = .jsx
+            case .Flow: self = .flow
+            case .FlowJSX: self = .flowJSX
+            case .TS: self = .typeScript
+            case .TSX: self = .tsx
+            @unknown default: self = .javaScript
+            }
+        }
+    }
+
+    /// What the parser does with Flow and TypeScript types.
+    public enum TypeSyntax: Sendable {
+        /// Types are part of the AST.
+        case build
+        /// Types are parsed but left out of the AST; only their ranges are
+        /// kept, see `ParseSession.skippedTypes`.
+        case skip
+    }
+
+    public var strictMode: Bool
+    public var jsx: Bool
+    public var flow: FlowSyntax
+    public var flowComponentSyntax: Bool
+    public var typeScript: Bool
+    public var typeSyntax: TypeSyntax
+
+    /// If set, the dialect of every source is detected from its name and
+    /// text, without parsing it, and replaces `jsx`, `flow` and `typeScript`
+    /// for its parse. TypeScript is chosen by extension, Flow by extension or
+    /// an `@flow` pragma, and JSX if the text may contain an element. The
+    /// result is in `ParseSession.detectedDialect`, and can be cached and
+    /// passed back with `setDialect(_:)`.
+    public var detectDialect: Bool
+
+    /// If set, a parse that takes longer fails with a "deadline exceeded"
+    /// error.
+    public var timeLimit: Duration?
+
+    /// If set, a parse fails with a "step budget exceeded" error after this
+    /// many steps, which are counted at statements, function bodies and every
+    /// few hundred tokens. Unlike `timeLimit`, it stops at the same point on
+    /// every run.
+    public var stepBudget: Int?
+
+    /// If set, a parse fails with a "memory budget exceeded" error once the
+    /// session holds more than this many bytes of AST, identifiers and lexer
+    /// storage. The count includes the memory every session starts with, a
+    /// few hundred KB, and is checked every few hundred tokens.
+    public var memoryLimit: Int?
+
+    /// If set, a parse fails with a "too many nested expressions" error when
+    /// code is nested deeper than this, instead of 1024 levels. Chains such
+    /// as `a ? b : c ? d : e`, `!!x` and `a.b.c` count one level per link
+    /// but are parsed without using more stack.
+    public var maxNestingDepth: Int?
+
+    /// If set, a parse fails with a "too many nested expressions" error once
+    /// the parser uses more than this many bytes of the thread's stack. Set
+    /// it below the stack size of the threads that parse, together with a
+    /// larger `maxNestingDepth`, to accept deep code without risking a stack
+    /// overflow.
+    public var stackLimit: Int?
+
+    /// Whether to count what the parser does, see `ParseSession.statistics`.
+    public var collectStatistics: Bool
+
+    public init(
+        strictMode: Bool = false,
+        jsx: Bool = false,
+        flow: FlowSyntax = .none,
+        flowComponentSyntax: Bool = false,
+        typeScript: Bool = false,
+        typeSyntax: TypeSyntax = .build,
+        detectDialect: Bool = false,
+        timeLimit: Duration? = nil,
+        stepBudget: Int? = nil,
+        memoryLimit: Int? = nil,
+        maxNestingDepth: Int? = nil,
+        stackLimit: Int? = nil,
+        collectStatistics: Bool = false
+    ) {
+        self.strictMode = strictMode
+        self.jsx = jsx
+        self.flow = flow
+        self.flowComponentSyntax = flowComponentSyntax
+        self.typeScript = typeScript
+        self.typeSyntax = typeSyntax
+        self.detectDialect = detectDialect
+        self.timeLimit = timeLimit
+        self.stepBudget = stepBudget
+        self.memoryLimit = memoryLimit
+        self.maxNestingDepth = maxNestingDepth
+        self.stackLimit = stackLimit
+        self.collectStatistics = collectStatistics
+    }
+
+    /// Parse as `dialect`, without detecting it.
+    public mutating func setDialect(_ dialect: Dialect) {
+        jsx = dialect == .jsx || dialect == .flowJSX || dialect == .tsx
+        flow = dialect == .flow || dialect == .flowJSX ? .all : .none
+        typeScript = dialect == .typeScript || dialect == .tsx
+        detectDialect = false
+    }
+
+    var cxxOptions: HermesParseOptions {
+        var options = HermesParseOptions()
+        options.strictMode = strictMode
+        options.parseJSX = jsx
+        switch flow {
+        case .none: options.parseFlow = .NONE
+        case .all: options.parseFlow = .ALL
+        case .unambiguous: options.parseFlow = .UNAMBIGUOUS
+        }
+        options.parseFlowComponentSyntax = flowComponentSyntax
+        options.parseTS = typeScript
+        options.detectDialect = detectDialect
+        switch typeSyntax {
+        case .build: options.typeSyntax = .BUILD
+        case .skip: options.typeSyntax = .SKIP
+        }
+        if let timeLimit {
+            let (seconds, attoseconds) = timeLimit.components
+            options.timeLimitMicroseconds = UInt64(
+                max(1, seconds * 1_000_000 + attoseconds / 1_000_000_000_000))
+        }
+        if let stepBudget {
+            options.stepBudget = UInt64(max(1, stepBudget))
+        }
+        if let memoryLimit {
+            options.memoryLimitBytes = UInt64(max(1, memoryLimit))
+        }
+        if let maxNestingDepth {
+            options.maxNestingDepth = UInt32(clamping: max(1, maxNestingDepth))
+        }
+        if let stackLimit {
+            options.stackLimitBytes = UInt64(max(1, stackLimit))
+        }
+        options.collectStats = collectStatistics
+        return options
+    }
+}
+
+/// Flow or TypeScript syntax that was left out of the AST because
+/// `ParseOptions.typeSyntax` is `.skip`. Removing every skipped range from the
+/// source leaves plain JavaScript.
+public struct SkippedType: Sendable, Hashable {
+    public enum Kind: Sendable, Hashable {
+        /// `: T`, including return types and `this` parameters.
+        case annotation
+        /// `<T>` after the name of a declaration.
+        case typeParameters
+        /// `<T>` in a call, `new`, superclass or JSX element.
+        case typeArguments
+        /// `as T`, or `<T>` before an expression.
+        case cast
+        /// The `implements` clause of a class.
+        case implements
+        /// A type alias, interface, `declare`, or type-only import or export,
+        /// or a `type` import specifier with its comma.
+        case declaration
+        /// The `?` of an optional parameter or property, a Flow variance
+        /// sigil, or a TypeScript accessibility or `readonly` modifier.
+        case modifier
+    }
+
+    public let kind: Kind
+    /// The UTF-8 offsets of the syntax in the source.
+    public let range: Range<Int>
+}
+
+/// What `ParseSession.stripTypes` puts in place of the types it removes.
+public enum StripMode: Sendable {
+    /// Spaces, keeping line breaks, so that every token of the output is at
+    /// the same line and column as in the source.
+    case blank
+    /// Nothing but the line breaks, so that every token stays on its line.
+    case remove
+
+    var cxx: hermes.parser.StripMode {
+        switch self {
+        case .blank: return .Blank
+        case .remove: return .Remove
+        }
+    }
+}
+
+/// JavaScript made from Flow or TypeScript by leaving out the types.
+public struct StrippedSource: Sendable {
+    public let code: String
+    /// A version 3 source map from `code` to the source, if one was asked for.
+    public let sourceMap: String?
+}
+
+/// A module that a program depends on, found by
+/// `ParseSession.scanDependencies`.
+public struct ModuleDependency: Sendable, Hashable {
+    public enum Kind: Sendable, Hashable {
+        /// `import ... from 'm'` or `import 'm'`.
+        case `import`
+        /// `export ... from 'm'`.
+        case export
+        /// `import('m')`.
+        case dynamicImport
+        /// `require('m')`.
+        case require
+    }
+
+    public let kind: Kind
+    /// Whether only types are imported or exported, as in
+    /// `import type {T} from 'm'`.
+    public let isTypeOnly: Bool
+    /// The module specifier.
+    public let specifier: String
+    /// The UTF-8 offsets of the string literal that names the module, including
+    /// its quotes.
+    public let range: Range<Int>
+}
+
+/// The diagnostics of a parse that failed.
+public struct ParseError: Error, Sendable, CustomStringConvertible {
+    /// One diagnostic per line, formatted as `name:line:column: message`.
+    public let description: String
+}
+
+/// A parsed program, the Context its AST is allocated in, and the source text
+/// the AST refers to.
+///
+/// The source is never copied on the way into the parser; instead the session
+/// retains whatever owns it, so the text and the AST are released together.
+///
+/// A session is only mutated while it parses, before it is returned, so it
+/// can be shared between threads and the AST read concurrently. The exception
+/// is `reparse`, which updates the AST in place.
+///
+/// The `async` variants of the parse functions stop parsing as soon as the
+/// calling task is cancelled, and then throw `CancellationError`.
+public final class ParseSession: @unchecked Sendable {
+    var cxx: HermesParseSession
+
+    /// The parsed text, or nil when it is owned by the C++ side (a
+    /// memory-mapped file, or the copy `reparse` edits) or borrowed for the
+    /// duration of `withParsed`.
+    public private(set) var source: SourceBuffer?
+
+    /// The pool the C++ session is returned to when this one is released.
+    private let pool: HermesParseSessionPool?
+
+    /// Cleared when a session borrowed by `withParsed` goes out of scope.
+    private var isValid = true
+
+    init(cxx: HermesParseSession, source: SourceBuffer?, pool: HermesParseSessionPool?) {
+        self.cxx = cxx
+        self.source = source
+        self.pool = pool
+    }
+
+    private convenience init(options: ParseOptions, source: SourceBuffer?) {
+        self.init(cxx: HermesParseSession(options.cxxOptions), source: source, pool: nil)
+    }
+
+    deinit {
+        pool?.release(cxx)
+    }
+
+    /// The root of the AST.
+    public var program: UnsafeMutablePointer<hermes.ESTree.ProgramNode> {
+        precondition(isValid, "session used outside of withParsed")
+        return cxx.getProgram()!
+    }
+
+    /// The types left out of the AST, in source order.
+    public var skippedTypes: [SkippedType] {
+        precondition(isValid, "session used outside of withParsed")
+        return (0..<cxx.getSkippedTypeCount()).map { index in
+            let kind: SkippedType.Kind
+            switch cxx.getSkippedTypeKind(index) {
+            case .Annotation: kind = .annotation
+            case .TypeParameters: kind = .typeParameters
+            case .TypeArguments: kind = .typeArguments
+            case .Cast: kind = .cast
+            case .Implements: kind = .implements
+            case .Declaration: kind = .declaration
+            case .Modifier: kind = .modifier
+            @unknown default: kind = .annotation
+            }
+            let start = Int(cxx.getSkippedTypeStart(index))
+            let end = Int(cxx.getSkippedTypeEnd(index))
+            return SkippedType(kind: kind, range: start..<end)
+        }
+    }
+
+    /// The dialect the last parse detected, or nil if
+    /// `ParseOptions.detectDialect` is not set.
+    public var detectedDialect: ParseOptions.Dialect? {
+        cxx.wasDialectDetected() ? ParseOptions.Dialect(cxx.getDetectedDialect()) : nil
+    }
+
+    /// The most memory the session has held, in bytes, as counted for
+    /// `ParseOptions.memoryLimit`.
+    public var peakMemoryBytes: Int {
+        Int(cxx.getPeakMemoryBytes())
+    }
+
+    /// Parse `source` in place. The session keeps `source` alive.
+    public static func parse(
+        _ source: SourceBuffer,
+        name: String = "JavaScript",
+        options: ParseOptions = ParseOptions()
+    ) throws -> ParseSession {
+        let session = ParseSession(options: options, source: source)
+        try session.parseBuffer(source.base, count: source.count, name: name)
+        return session
+    }
+
+    /// Copy `source` once into a `SourceBuffer` and parse it. To avoid the
+    /// copy, use `withParsed(_:name:options:_:)`.
+    public static func parse(
+        _ source: String,
+        name: String = "JavaScript",
+        options: ParseOptions = ParseOptions()
+    ) throws -> ParseSession {
+        try parse(SourceBuffer(copying: source), name: name, options: options)
+    }
+
+    /// Parse the file at `path`. The file is memory-mapped when possible, and
+    /// the mapping is released with the session.
+    public static func parse(
+        contentsOfFile path: String,
+        options: ParseOptions = ParseOptions()
+    ) throws -> ParseSession {
+        let session = ParseSession(options: options, source: nil)
+        try session.parseFile(path)
+        return session
+    }
+
+    /// Parse `source` in place, and pass every top-level statement, directives
+    /// included, to `keep` as soon as it has been parsed. A statement for
+    /// which `keep` returns false is freed right away, so `keep` must not hold
+    /// on to it, and `program` only has the statements that were kept. The
+    /// session keeps `source` alive.
+    public static func parseStreaming(
+        _ source: SourceBuffer,
+        name: String = "JavaScript",
+        options: ParseOptions = ParseOptions(),
+        keep: (UnsafeMutablePointer<hermes.ESTree.Node>) -> Bool
+    ) throws -> ParseSession {
+        let session = ParseSession(options: options, source: source)
+        try withoutActuallyEscaping(keep) { keep in
+            var keep = keep
+            let succeeded = withUnsafeMutablePointer(to: &keep) { context in
+                session.cxx.parseBufferStreaming(
+                    source.base, source.count, std.string(name),
+                    { context, statement in
+                        context!.assumingMemoryBound(
+                            to: ((UnsafeMutablePointer<hermes.ESTree.Node>) -> Bool).self
+                        ).pointee(statement!)
+                    },
+                    context)
+            }
+            try session.check(succeeded)
+        }
+        return session
+    }
+
+    /// Parse `source` in place, stopping early if the task is cancelled.
+    public static func parse(
+        _ source: SourceBuffer,
+        name: String = "JavaScript",
+        options: ParseOptions = ParseOptions()
+    ) async throws -> ParseSession {
+        let session = ParseSession(options: options, source: source)
+        try await session.cancellable {
+            try session.parseBuffer(source.base, count: source.count, name: name)
+        }
+        return session
+    }
+
+    /// Parse the file at `path`, stopping early if the task is cancelled.
+    public static func parse(
+        contentsOfFile path: String,
+        options: ParseOptions = ParseOptions()
+    ) async throws -> ParseSession {
+        let session = ParseSession(options: options, source: nil)
+        try await session.cancellable { try session.parseFile(path) }
+        return session
+    }
+
+    /// Bring the session up to date with `source`, which must be the text it
+    /// last parsed with the bytes in `range` replaced by `insertedCount`
+    /// bytes. Only the statements around the edit are parsed again, unless
+    /// the edit reaches beyond them; the rest of the AST is kept, and its
+    /// source locations are moved to `source`. Otherwise the whole of `source`
+    /// is parsed, as it is when the last parse failed or when `source` is not
+    /// the edited text.
+    ///
+    /// The AST is updated in place, so nothing may read it while this runs.
+    /// The C++ side parses a copy of `source`, to which the later edits are
+    /// applied in place, so neither `source` nor the sources parsed before it
+    /// are kept. If this throws, `program` must not be used until a later
+    /// call succeeds.
+    /// - Returns: whether only the statements around the edit were parsed.
+    @discardableResult
+    public func reparse(
+        _ source: SourceBuffer,
+        replacing range: Range<Int>,
+        insertedCount: Int,
+        name: String = "JavaScript"
+    ) throws -> Bool {
+        precondition(isValid, "session used outside of withParsed")
+        // The last source is only released once the AST has moved off it.
+        defer { self.source = nil }
+        try check(cxx.reparseBuffer(
+            source.base, source.count, std.string(name),
+            range.lowerBound, range.count, insertedCount))
+        return cxx.wasReparsedIncrementally()
+    }
+
+    /// Turn Flow or TypeScript into JavaScript by copying `source` without its
+    /// types, the way flow-remove-types does. `options` selects the dialect;
+    /// no AST is built for the types, and the rest of the AST is freed as soon
+    /// as the source has been parsed. TypeScript enums, namespaces and
+    /// parameter properties are left as they are.
+    public static func stripTypes(
+        _ source: String,
+        name: String = "JavaScript",
+        options: ParseOptions,
+        mode: StripMode = .blank,
+        sourceMap: Bool = false
+    ) throws -> StrippedSource {
+        try ParseSession(options: options, source: nil)
+            .stripTypes(source, name: name, mode: mode, sourceMap: sourceMap)
+    }
+
+    func stripTypes(
+        _ source: String,
+        name: String,
+        mode: StripMode,
+        sourceMap: Bool
+    ) throws -> StrippedSource {
+        let count = source.utf8.count
+        return try source.withCString { base in
+            try check(cxx.stripTypes(base, count, std.string(name), mode.cxx, sourceMap))
+            return StrippedSource(
+                code: String(cxx.getStrippedCode()),
+                sourceMap: sourceMap ? String(cxx.getStrippedSourceMap()) : nil)
+        }
+    }
+
+    /// Find the modules that `source` depends on: the ones named by its import
+    /// and export declarations, and by `import()` and `require()` calls with a
+    /// string literal. Only the declarations are parsed; the rest of the source
+    /// is skipped without building an AST, unless it can't be told apart
+    /// without the grammar. Syntax errors outside of the declarations are not
+    /// necessarily found.
+    public static func scanDependencies(
+        _ source: String,
+        name: String = "JavaScript",
+        options: ParseOptions = ParseOptions()
+    ) throws -> [ModuleDependency] {
+        try ParseSession(options: options, source: nil).scanDependencies(source, name: name)
+    }
+
+    func scanDependencies(_ source: String, name: String) throws -> [ModuleDependency] {
+        let count = source.utf8.count
+        return try source.withCString { base in
+            try check(cxx.scanDependencies(base, count, std.string(name)))
+            return (0..<cxx.getDependencyCount()).map { index in
+                let kind: ModuleDependency.Kind
+                switch cxx.getDependencyKind(index) {
+                case .Import: kind = .import
+                case .Export: kind = .export
+                case .DynamicImport: kind = .dynamicImport
+                case .Require: kind = .require
+                @unknown default: kind = .import
+                }
+                let start = Int(cxx.getDependencyStart(index))
+                let end = Int(cxx.getDependencyEnd(index))
+                return ModuleDependency(
+                    kind: kind,
+                    isTypeOnly: cxx.isDependencyTypeOnly(index),
+                    specifier: String(cxx.getDependencySpecifier(index)),
+                    range: start..<end)
+            }
+        }
+    }
+
+    /// Parse `source` directly from its own storage and pass the session to
+    /// `body`. A native Swift string is already NUL-terminated UTF-8, so
+    /// nothing is copied; bridged strings are transcoded once by
+    /// `withCString`.
+    ///
+    /// The session refers to the storage of `source`, which is only valid
+    /// inside `body`; it must not be used after `body` returns.
+    public static func withParsed<R>(
+        _ source: String,
+        name: String = "JavaScript",
+        options: ParseOptions = ParseOptions(),
+        _ body: (ParseSession) throws -> R
+    ) throws -> R {
+        try withParsed(source, name: name, in: ParseSession(options: options, source: nil), body)
+    }
+
+    static func withParsed<R>(
+        _ source: String,
+        name: String,
+        in session: ParseSession,
+        _ body: (ParseSession) throws -> R
+    ) throws -> R {
+        let count = source.utf8.count
+        return try source.withCString { base in
+            defer { session.isValid = false }
+            try session.parseBuffer(base, count: count, name: name)
+            return try body(session)
+        }
+    }
+
+    func parseBuffer(_ base: UnsafePointer<CChar>, count: Int, name: String) throws {
+        try check(cxx.parseBuffer(base, count, std.string(name)))
+    }
+
+    func parseFile(_ path: String) throws {
+        try check(cxx.parseFile(std.string(path)))
+    }
+
+    /// Run `parse` so that cancelling the current task interrupts it. The
+    /// parser is cancelled from whichever thread cancels the task.
+    func cancellable(_ parse: () throws -> Void) async throws {
+        let canceller = cxx.getCanceller()
+        try await withTaskCancellationHandler {
+            do {
+                try parse()
+            } catch {
+                if cxx.wasInterrupted() && Task.isCancelled {
+                    throw CancellationError()
+                }
+                throw error
+            }
+        } onCancel: {
+            canceller.cancel()
+        }
+    }
+
+    private func check(_ succeeded: Bool) throws {
+        if !succeeded {
+            throw ParseError(description: String(cxx.getErrors()))
+        }
+    }
+}
@@ -0,0 +1,90 @@
+import cxxHermesForSwift
+
+/// A thread-safe pool of reusable parse sessions that share the same options.
+///
+/// Creating a Context, and interning the identifiers every parser needs, costs
+/// more than parsing a small snippet. Sessions taken from a pool are reset
+/// instead of destroyed when they are released: the allocator keeps its slabs
+/// and the string table keeps the known identifiers, so the next parse starts
+/// almost for free.
+public final class ParseSessionPool: @unchecked Sendable {
+    let cxx: HermesParseSessionPool
+
+    /// - Parameter maxIdle: the number of idle sessions kept; sessions
+    ///   released beyond that are destroyed.
+    public init(options: ParseOptions = ParseOptions(), maxIdle: Int = 64) {
+        cxx = HermesParseSessionPool(options.cxxOptions, maxIdle)
+    }
+
+    /// The number of sessions ready to be used.
+    public var idleCount: Int {
+        cxx.getIdleCount()
+    }
+
+    /// Parse `source` in place with a pooled session. The session goes back to
+    /// the pool when it is released.
+    public func parse(_ source: SourceBuffer, name: String = "JavaScript") throws -> ParseSession {
+        let session = acquire(source: source)
+        try session.parseBuffer(source.base, count: source.count, name: name)
+        return session
+    }
+
+    /// Parse the file at `path` with a pooled session.
+    public func parse(contentsOfFile path: String) throws -> ParseSession {
+        let session = acquire(source: nil)
+        try session.parseFile(path)
+        return session
+    }
+
+    /// Parse `source` in place with a pooled session, stopping early if the
+    /// task is cancelled.
+    public func parse(_ source: SourceBuffer, name: String = "JavaScript") async throws -> ParseSession {
+        let session = acquire(source: source)
+        try await session.cancellable {
+            try session.parseBuffer(source.base, count: source.count, name: name)
+        }
+        return session
+    }
+
+    /// Parse the file at `path` with a pooled session, stopping early if the
+    /// task is cancelled.
+    public func parse(contentsOfFile path: String) async throws -> ParseSession {
+        let session = acquire(source: nil)
+        try await session.cancellable { try session.parseFile(path) }
+        return session
+    }
+
+    /// Parse `source` from its own storage with a pooled session, as
+    /// `ParseSession.withParsed` does.
+    public func withParsed<R>(
+        _ source: String,
+        name: String = "JavaScript",
+        _ body: (ParseSession) throws -> R
+    ) throws -> R {
+        try ParseSession.withParsed(source, name: name, in: acquire(source: nil), body)
+    }
+
+    /// Strip the types from `source` with a pooled session, as
+    /// `ParseSession.stripTypes` does.
+    public func stripTypes(
+        _ source: String,
+        name: String = "JavaScript",
+        mode: StripMode = .blank,
+        sourceMap: Bool = false
+    ) throws -> StrippedSource {
+        try acquire(source: nil).stripTypes(source, name: name, mode: mode, sourceMap: sourceMap)
+    }
+
+    /// Find the dependencies of `source` with a pooled session, as
+    /// `ParseSession.scanDependencies` does.
+    public func scanDependencies(
+        _ source: String,
+        name: String = "JavaScript"
+    ) throws -> [ModuleDependency] {
+        try acquire(source: nil).scanDependencies(source, name: name)
+    }
+
+    private func acquire(source: SourceBuffer?) -> ParseSession {
+        ParseSession(cxx: cxx.acquire(), source: source, pool: cxx)
+    }
+}
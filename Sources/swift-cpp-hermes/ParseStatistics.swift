@@ -0,0 +1,82 @@
+import cxxHermesForSwift
+
+/// What the parser did, counted when `ParseOptions.collectStatistics` is set.
+///
+/// The arena and string table figures are reported by every build. Counting
+/// tokens, nodes, speculative parses and recursion is only compiled into the
+/// parser if `HERMES_PARSE_STATS` is set, which is the default in debug
+/// builds; see `isSupported`.
+public struct ParseStatistics: Sendable {
+    /// Whether the parser counts tokens, nodes, speculative parses and
+    /// recursion. If not, those counters are 0.
+    public static var isSupported: Bool {
+        hermes.parser.ParseStats.isSupported()
+    }
+
+    /// Tokens produced by the lexer, including those lexed again.
+    public var tokensLexed: Int
+    /// Tokens lexed again after a speculative parse was rolled back.
+    public var tokensRelexed: Int
+    /// Speculative parses attempted, e.g. of `<` as type arguments.
+    public var speculativeAttempts: Int
+    /// Speculative parses that were rolled back.
+    public var speculativeFailures: Int
+    /// The deepest parser recursion seen.
+    public var maxRecursionDepth: Int
+
+    /// AST nodes constructed, by node kind, including nodes discarded by a
+    /// rolled back speculative parse.
+    public var nodeCounts: [String: Int]
+
+    /// Bytes requested from the AST arena.
+    public var arenaBytesAllocated: Int
+    /// Arena bytes lost to alignment and to the unused ends of slabs.
+    public var arenaBytesWasted: Int
+    /// The size of the arena after the last parse.
+    public var arenaBytesReserved: Int
+
+    /// Unique strings in the string table after the last parse.
+    public var stringTableSize: Int
+    /// Identifiers and strings looked up in the string table.
+    public var stringTableLookups: Int
+    /// Lookups that found an existing string.
+    public var stringTableHits: Int
+
+    /// The fraction of string table lookups that were hits.
+    public var stringTableHitRate: Double {
+        stringTableLookups == 0 ? 0 : Double(stringTableHits) / Double(stringTableLookups)
+    }
+
+    /// The total number of AST nodes constructed.
+    public var nodeCount: Int {
+        nodeCounts.values.reduce(0, +)
+    }
+
+    init(_ stats: hermes.parser.ParseStats) {
+        tokensLexed = Int(stats.tokensLexed)
+        tokensRelexed = Int(stats.tokensRelexed)
+        speculativeAttempts = Int(stats.speculativeAttempts)
+        speculativeFailures = Int(stats.speculativeFailures)
+        maxRecursionDepth = Int(stats.maxRecursionDepth)
+        var nodeCounts: [String: Int] = [:]
+        for (kind, count) in stats.nodesByKind.enumerated() where count != 0 {
+            if let name = hermesNodeKindName(UInt32(kind)) {
+                nodeCounts[String(cString: name)] = Int(count)
+            }
+        }
+        self.nodeCounts = nodeCounts
+        arenaBytesAllocated = Int(stats.arenaBytesAllocated)
+        arenaBytesWasted = Int(stats.arenaBytesWasted)
+        arenaBytesReserved = Int(stats.arenaBytesReserved)
+        stringTableSize = Int(stats.stringTableSize)
+        stringTableLookups = Int(stats.stringTableLookups)
+        stringTableHits = Int(stats.stringTableHits)
+    }
+}
+
+extension ParseSession {
+    /// What the parser did to produce this session's AST.
+    public var statistics: ParseStatistics {
+        ParseStatistics(cxx.getParseStats())
+    }
+}
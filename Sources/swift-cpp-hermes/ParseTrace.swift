@@ -0,0 +1,24 @@
+import cxxHermesForSwift
+
+/// Tracing of the parser's sections ("Parsing JavaScript", "Dumping ESTree
+/// JSON" and so on), recorded by `hermes::PerfTrace` on every thread.
+///
+/// Tracing is off by default and costs next to nothing while it is off.
+public enum ParseTrace {
+    /// Whether sections are being recorded.
+    public static var isEnabled: Bool {
+        get { hermes.PerfTrace.isEnabled() }
+        set { hermes.PerfTrace.setEnabled(newValue) }
+    }
+
+    /// The sections recorded so far, in the Chrome Trace Event format, which
+    /// can be loaded in Perfetto or chrome://tracing.
+    public static func chromeTraceJSON() -> String {
+        String(hermes.PerfTrace.getChromeTrace())
+    }
+
+    /// Discard the sections recorded so far. No parse may be running.
+    public static func clear() {
+        hermes.PerfTrace.clear()
+    }
+}
@@ -0,0 +1,62 @@
+import cxxHermesForSwift
+
+/// UTF-8 source text at a fixed address, followed by a NUL byte.
+///
+/// The parser does not copy its input: the lexer reads it in place and the
+/// AST refers back into it. A `SourceBuffer` provides storage that stays put
+/// for as long as it is referenced, and `ParseSession` holds on to the buffer
+/// it parsed so the text lives exactly as long as the AST.
+public final class SourceBuffer: @unchecked Sendable {
+    /// The first byte of the text. `base[count]` is always 0.
+    let base: UnsafePointer<CChar>
+
+    /// The length of the text in bytes, not counting the terminating NUL.
+    public let count: Int
+
+    /// Keeps externally owned bytes alive. Nil when the buffer owns `base`.
+    private let owner: AnyObject?
+
+    /// Copy the UTF-8 encoding of `string`, once, into a new buffer.
+    public convenience init(copying string: String) {
+        self.init(copying: string.utf8)
+    }
+
+    /// Copy `bytes` into a new buffer and append the terminator.
+    public init<Bytes: Collection>(copying bytes: Bytes) where Bytes.Element == UInt8 {
+        let count = bytes.count
+        let storage = UnsafeMutableBufferPointer<UInt8>.allocate(capacity: count + 1)
+        _ = storage.initialize(from: bytes)
+        storage[count] = 0
+        base = UnsafeRawPointer(storage.baseAddress!).assumingMemoryBound(to: CChar.self)
+        self.count = count
+        owner = nil
+    }
+
+    /// Refer to `bytes` without copying them, for example a memory-mapped
+    /// file. The byte just past the end of `bytes` must be 0, and both must
+    /// stay valid and unmodified for as long as `owner` is alive.
+    public init(unsafeBytes bytes: UnsafeRawBufferPointer, owner: AnyObject) {
+        guard let start = bytes.baseAddress, bytes.count > 0 else {
+            // An empty buffer may have no address, or none followed by a NUL:
+            // own a lone terminator instead.
+            let storage = UnsafeMutablePointer<CChar>.allocate(capacity: 1)
+            storage.initialize(to: 0)
+            base = UnsafePointer(storage)
+            count = 0
+            self.owner = nil
+            return
+        }
+        precondition(
+            start.load(fromByteOffset: bytes.count, as: UInt8.self) == 0,
+            "source must be followed by a NUL byte")
+        base = start.assumingMemoryBound(to: CChar.self)
+        count = bytes.count
+        self.owner = owner
+    }
+
+    deinit {
+        if owner == nil {
+            UnsafeMutablePointer(mutating: base).deallocate()
+        }
+    }
+}
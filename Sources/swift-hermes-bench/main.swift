@@ -0,0 +1,203 @@
+import Foundation
+import swift_cpp_hermes
+
+#if canImport(Darwin)
+import Darwin
+#endif
+
+/// Throughput benchmarks of the Swift API, for comparison with
+/// hermes-parser-bench, which measures the C++ parser on its own.
+///
+/// Usage: swift-hermes-bench [--filter=<substr>] [--min-time=<sec>]
+///                           [--min-iterations=N] <file or directory>...
+///
+/// The inputs and their dialects are the same as for hermes-parser-bench;
+/// JSON files are skipped. The report is a JSON object on stdout, with one
+/// entry per benchmark and input.
+
+struct Options {
+    var filter = ""
+    var minTime = 0.5
+    var minIterations = 5
+    var paths: [String] = []
+}
+
+struct Input {
+    let name: String
+    let dialect: String
+    let options: ParseOptions
+    let source: SourceBuffer
+}
+
+func parseOptions() -> Options? {
+    var options = Options()
+    for arg in CommandLine.arguments.dropFirst() {
+        if arg.hasPrefix("--filter=") {
+            options.filter = String(arg.dropFirst("--filter=".count))
+        } else if arg.hasPrefix("--min-time="), let value = Double(arg.dropFirst("--min-time=".count)) {
+            options.minTime = value
+        } else if arg.hasPrefix("--min-iterations="), let value = Int(arg.dropFirst("--min-iterations=".count)) {
+            options.minIterations = max(1, value)
+        } else if arg.hasPrefix("-") {
+            return nil
+        } else {
+            options.paths.append(arg)
+        }
+    }
+    return options.paths.isEmpty ? nil : options
+}
+
+/// The dialect of `path`, following the naming of utils/gen-bench-corpus.py.
+func dialect(of path: String) -> (String, ParseOptions)? {
+    if path.hasSuffix(".jsx") {
+        return ("jsx", ParseOptions(jsx: true))
+    } else if path.hasSuffix(".flow.js") {
+        return ("flow", ParseOptions(flow: .all))
+    } else if path.hasSuffix(".ts") || path.hasSuffix(".tsx") {
+        return ("ts", ParseOptions(typeScript: true))
+    } else if path.hasSuffix(".js") {
+        return ("js", ParseOptions())
+    }
+    return nil
+}
+
+func loadInputs(_ paths: [String]) throws -> [Input] {
+    var files: [String] = []
+    for path in paths {
+        var isDirectory: ObjCBool = false
+        if FileManager.default.fileExists(atPath: path, isDirectory: &isDirectory), isDirectory.boolValue {
+            files += try FileManager.default.contentsOfDirectory(atPath: path).sorted().map {
+                (path as NSString).appendingPathComponent($0)
+            }
+        } else {
+            files.append(path)
+        }
+    }
+    return try files.compactMap { path in
+        guard let match = dialect(of: path) else { return nil }
+        let data = try Data(contentsOf: URL(fileURLWithPath: path))
+        return Input(
+            name: (path as NSString).lastPathComponent,
+            dialect: match.0,
+            options: match.1,
+            source: SourceBuffer(copying: data))
+    }
+}
+
+/// The number of heap blocks currently allocated, where the platform exposes
+/// it. This counts blocks still alive at the end of an iteration, not calls
+/// to malloc, so it measures what a parse retains rather than its churn.
+func liveHeapBlocks() -> Int? {
+    #if canImport(Darwin)
+    var stats = malloc_statistics_t()
+    malloc_zone_statistics(nil, &stats)
+    return Int(stats.blocks_in_use)
+    #else
+    return nil
+    #endif
+}
+
+func run(_ options: Options, _ body: () throws -> Void) rethrows -> (seconds: [Double], retainedBlocks: Int?) {
+    try body()
+    let clock = ContinuousClock()
+    var seconds: [Double] = []
+    var total = 0.0
+    var retainedBlocks = 0
+    while total < options.minTime || seconds.count < options.minIterations {
+        let blocksBefore = liveHeapBlocks()
+        let elapsed = try clock.measure(body)
+        if let blocksBefore, let blocksAfter = liveHeapBlocks() {
+            retainedBlocks += blocksAfter - blocksBefore
+        }
+        let (whole, attoseconds) = elapsed.components
+        seconds.append(Double(whole) + Double(attoseconds) / 1e18)
+        total += seconds.last!
+    }
+    return (seconds, liveHeapBlocks() == nil ? nil : retainedBlocks / seconds.count)
+}
+
+guard let options = parseOptions() else {
+    FileHandle.standardError.write(Data("""
+        usage: swift-hermes-bench [--filter=<substr>] [--min-time=<sec>] \
+        [--min-iterations=N] <file or directory>...
+
+        """.utf8))
+    exit(2)
+}
+
+/// The results collected so far.
+struct Report {
+    let options: Options
+    var results: [[String: Any]] = []
+    var failed = false
+
+    mutating func bench(_ name: String, _ input: Input, _ body: () throws -> Void) {
+        guard options.filter.isEmpty || "\(name)/\(input.name)".contains(options.filter) else { return }
+        var result: [String: Any] = [
+            "benchmark": name,
+            "input": input.name,
+            "dialect": input.dialect,
+            "bytes": input.source.count,
+        ]
+        do {
+            let (seconds, retainedBlocks) = try run(options, body)
+            let median = seconds.sorted()[seconds.count / 2]
+            let kb = Double(input.source.count) / 1024
+            result["ok"] = true
+            result["iterations"] = seconds.count
+            result["medianSeconds"] = median
+            result["minSeconds"] = seconds.min()!
+            result["mbPerSecond"] = kb / 1024 / median
+            if let retainedBlocks {
+                result["retainedBlocksPerKB"] = Double(retainedBlocks) / kb
+            }
+        } catch {
+            FileHandle.standardError.write(Data("\(name)/\(input.name): \(error)\n".utf8))
+            result["ok"] = false
+            failed = true
+        }
+        results.append(result)
+    }
+}
+
+let inputs: [Input]
+do {
+    inputs = try loadInputs(options.paths)
+} catch {
+    FileHandle.standardError.write(Data("\(error)\n".utf8))
+    exit(1)
+}
+
+var report = Report(options: options)
+for input in inputs {
+    report.bench("session-parse", input) {
+        _ = try ParseSession.parse(input.source, name: input.name, options: input.options)
+    }
+
+    let pool = ParseSessionPool(options: input.options, maxIdle: 1)
+    report.bench("pooled-parse", input) {
+        _ = try pool.parse(input.source, name: input.name)
+    }
+
+    // Walk the top-level statements of an AST parsed once, reading the
+    // source text of each.
+    guard let session = try? ParseSession.parse(input.source, name: input.name, options: input.options) else {
+        continue
+    }
+    report.bench("ast-view-walk", input) {
+        var bytes = 0
+        session.withAST { program in
+            for statement in program.body {
+                bytes += statement.sourceText?.count ?? 0
+            }
+        }
+        precondition(bytes > 0)
+    }
+}
+
+let json = try JSONSerialization.data(
+    withJSONObject: ["minTime": options.minTime, "results": report.results] as [String: Any],
+    options: [.sortedKeys])
+FileHandle.standardOutput.write(json)
+FileHandle.standardOutput.write(Data("\n".utf8))
+exit(report.failed ? 1 : 0)
@@ -1,4 +1,5 @@
 import XCTest
+import cxxHermesForSwift
 @testable import swift_cpp_hermes
 
 final class swift_cpp_hermesTests: XCTestCase {
@@ -9,4 +10,1078 @@ final class swift_cpp_hermesTests: XCTestCase {
         // Defining Test Cases and Test Methods
         // https://developer.apple.com/documentation/xctest/defining_test_cases_and_test_methods
     }
+
+    // MARK: - Source buffers
+
+    func testEmptyUnsafeBytes() throws {
+        let empty = SourceBuffer(unsafeBytes: UnsafeRawBufferPointer(start: nil, count: 0), owner: self)
+        XCTAssertEqual(empty.count, 0)
+        XCTAssertEqual(empty.base[0], 0)
+        XCTAssertNotNil(try ParseSession.parse(empty).cxx.getProgram())
+    }
+
+    // MARK: - Limits
+
+    /// `count` short statements, each of which takes about one step to parse.
+    private func statements(_ count: Int) -> String {
+        (0..<count).map { "var x\($0) = \($0);\n" }.joined()
+    }
+
+    /// Replace the whole source of `session`, `previous`, with `source`.
+    @discardableResult
+    private func replace(_ previous: String, with source: String, in session: ParseSession) throws -> Bool {
+        try session.reparse(
+            SourceBuffer(copying: source), replacing: 0..<previous.utf8.count,
+            insertedCount: source.utf8.count)
+    }
+
+    func testStepBudgetIsPerParse() throws {
+        let source = statements(200)
+        let session = try ParseSession.parse(source, options: ParseOptions(stepBudget: 300))
+        // Every reparse gets the whole budget again.
+        for _ in 0..<10 {
+            try replace(source, with: source, in: session)
+        }
+        XCTAssertFalse(session.cxx.wasInterrupted())
+    }
+
+    func testParseAfterInterruptedParse() throws {
+        let small = statements(1)
+        let large = statements(2_000)
+        let session = try ParseSession.parse(small, options: ParseOptions(stepBudget: 300))
+        XCTAssertThrowsError(try replace(small, with: large, in: session))
+        XCTAssertTrue(session.cxx.wasInterrupted())
+
+        // Neither the exhausted budget nor its error fails the next parse.
+        try replace(large, with: small, in: session)
+        XCTAssertFalse(session.cxx.wasInterrupted())
+        XCTAssertEqual(session.cxx.getErrorCount(), 0)
+    }
+
+    func testCancellationIsSticky() throws {
+        let source = statements(1)
+        let session = try ParseSession.parse(source)
+        session.cxx.getCanceller().cancel()
+        for _ in 0..<2 {
+            XCTAssertThrowsError(try replace(source, with: source, in: session))
+            XCTAssertTrue(session.cxx.wasInterrupted())
+        }
+    }
+
+    /// Check that parsing `source` fails with an error containing `message`.
+    private func assertParseFails(
+        _ source: String,
+        options: ParseOptions = ParseOptions(),
+        with message: String,
+        file: StaticString = #filePath,
+        line: UInt = #line
+    ) {
+        XCTAssertThrowsError(try ParseSession.parse(source, options: options), file: file, line: line) {
+            XCTAssertTrue(
+                ($0 as? ParseError)?.description.contains(message) ?? false,
+                "\($0)", file: file, line: line)
+        }
+    }
+
+    func testNestingDepthLimit() throws {
+        let options = ParseOptions(maxNestingDepth: 50)
+        let message = "Too many nested expressions"
+        XCTAssertNoThrow(try ParseSession.parse(
+            "x = " + String(repeating: "a ? b : ", count: 20) + "c;", options: options))
+        // Chains parsed in a loop still count every link.
+        assertParseFails(
+            "x = " + String(repeating: "a ? b : ", count: 200) + "c;", options: options, with: message)
+        assertParseFails(
+            "x = " + String(repeating: "!", count: 200) + "y;", options: options, with: message)
+    }
+
+    func testStackLimit() throws {
+        // Far below the depth limit, but beyond the stack limit.
+        let options = ParseOptions(maxNestingDepth: 1_000_000, stackLimit: 256 * 1024)
+        let message = "Too many nested expressions"
+        let depth = 100_000
+        assertParseFails(
+            "x = " + String(repeating: "[", count: depth) + String(repeating: "]", count: depth) + ";",
+            options: options, with: message)
+        assertParseFails(
+            "x = " + String(repeating: "(", count: depth) + "y" + String(repeating: ")", count: depth) + ";",
+            options: options, with: message)
+    }
+
+    func testMemoryLimit() throws {
+        let options = ParseOptions(memoryLimit: 1024 * 1024)
+        let message = "parsing memory budget exceeded"
+        let elements = String(repeating: "0,", count: 1_000_000)
+        assertParseFails("x = [" + elements + "0];", options: options, with: message)
+        // A single token, with no regular poll of the budget after it.
+        let long = String(repeating: "a", count: 8 * 1024 * 1024)
+        assertParseFails("x = '" + long + "';", options: options, with: message)
+        assertParseFails("'" + long + "'", options: options, with: message)
+        assertParseFails("x = `" + long + "`;", options: options, with: message)
+        XCTAssertNoThrow(try ParseSession.parse("x = [0, 0];", options: options))
+    }
+
+    func testPeakMemoryBytes() throws {
+        let small = try ParseSession.parse("x = 1;").peakMemoryBytes
+        XCTAssertGreaterThan(small, 0)
+        let source = "x = [" + String(repeating: "0,", count: 100_000) + "0];"
+        let peak = try ParseSession.parse(source).peakMemoryBytes
+        XCTAssertGreaterThan(peak, small)
+        // The peak is the most the parse needed: a limit of that much is
+        // enough, and a limit of half of it is not.
+        XCTAssertNoThrow(try ParseSession.parse(source, options: ParseOptions(memoryLimit: peak)))
+        assertParseFails(
+            source, options: ParseOptions(memoryLimit: peak / 2), with: "parsing memory budget exceeded")
+    }
+
+    // MARK: - Expression chains
+
+    /// Check that `source` parses to the same AST as `parenthesized`, the
+    /// same code with the nesting spelled out, apart from the source ranges.
+    private func assertParsesLike(
+        _ source: String,
+        _ parenthesized: String,
+        options: ParseOptions = ParseOptions(),
+        file: StaticString = #filePath,
+        line: UInt = #line
+    ) throws {
+        func dump(_ source: String) throws -> String {
+            let dump = try String(ParseSession.parse(source, options: options).cxx.dumpProgram())
+            return dump.replacing(#/"range":\[\d+,\d+\]/#, with: "")
+        }
+        XCTAssertEqual(try dump(source), try dump(parenthesized), file: file, line: line)
+    }
+
+    func testConditionalChains() throws {
+        try assertParsesLike("x = a ? b : c ? d : e;", "x = a ? b : (c ? d : e);")
+        try assertParsesLike("x = a ? b ? c : d : e ? f : g;", "x = a ? (b ? c : d) : (e ? f : g);")
+        try assertParsesLike("x = a ? b : c = 1;", "x = a ? b : (c = 1);")
+        try assertParsesLike("x = a ? b : c ? d : e = f;", "x = a ? b : (c ? d : (e = f));")
+    }
+
+    func testConditionalAlternates() throws {
+        try assertParsesLike(
+            "function* g() { x = a ? b : yield c; }", "function* g() { x = a ? b : (yield c); }")
+        try assertParsesLike(
+            "function* g() { x = a ? b : yield; }", "function* g() { x = a ? b : (yield); }")
+        try assertParsesLike("x = a ? b : async y => y;", "x = a ? b : (async y => y);")
+        try assertParsesLike("x = a ? b : async (y) => y;", "x = a ? b : (async (y) => y);")
+        try assertParsesLike("x = a ? b : async(y);", "x = a ? b : (async(y));")
+        try assertParsesLike("x = a ? b : async ? c : d;", "x = a ? b : (async ? c : d);")
+
+        let flow = ParseOptions(flow: .all)
+        try assertParsesLike(
+            "x = a ? b : <T>(y: T) => y;", "x = a ? b : (<T>(y: T) => y);", options: flow)
+        try assertParsesLike("x = a ? b : (y): T => y;", "x = a ? b : ((y): T => y);", options: flow)
+    }
+
+    func testUnaryChains() throws {
+        try assertParsesLike("x = !!-y;", "x = !(!(-y));")
+        try assertParsesLike("x = typeof void delete y.z;", "x = typeof (void (delete y.z));")
+        try assertParsesLike("x = <T><U>y;", "x = <T>(<U>y);", options: ParseOptions(typeScript: true))
+
+        let message = "Unary operator before ** must use parens"
+        assertParseFails("x = -y ** 2;", with: message)
+        assertParseFails("x = !!-y ** 2;", with: message)
+    }
+
+    // MARK: - Speculative parses
+
+    /// Check `assertParsesLike` as Flow and as TypeScript, with more code
+    /// after `source` to reuse the memory freed by rolled back attempts.
+    private func assertTypedParsesLike(
+        _ source: String,
+        _ parenthesized: String,
+        file: StaticString = #filePath,
+        line: UInt = #line
+    ) throws {
+        let tail = "\nvar t = [1, {u: 2, v: [3, 4]}, function w() { return t; }];\n"
+        for options in [ParseOptions(flow: .all), ParseOptions(typeScript: true)] {
+            try assertParsesLike(
+                source + tail, parenthesized + tail, options: options, file: file, line: line)
+        }
+    }
+
+    func testRolledBackTypeArguments() throws {
+        try assertTypedParsesLike("x = a < b > c;", "x = (a < b) > c;")
+        try assertTypedParsesLike("x = a < (b + c) > d;", "x = (a < (b + c)) > d;")
+        try assertTypedParsesLike("x = a < b > c<d>(e);", "x = (a < b) > (c<d>(e));")
+        try assertTypedParsesLike("x = async < b > c;", "x = (async < b) > c;")
+    }
+
+    func testRolledBackTypedConditionals() throws {
+        try assertTypedParsesLike("x = a ? (b) : c;", "x = a ? b : c;")
+        try assertTypedParsesLike("x = a ? (b) : (c) => d;", "x = a ? b : ((c) => d);")
+    }
+
+    func testRolledBackArrowReturnTypes() throws {
+        try assertTypedParsesLike("x = a ? (b): T => b : c;", "x = a ? ((b): T => b) : c;")
+        try assertTypedParsesLike("x = async (y) < z;", "x = (async(y)) < z;")
+    }
+
+    // MARK: - Batch parsing
+
+    func testParseManyOfNoFiles() async throws {
+        var count = 0
+        for await _ in ParseSession.parseMany(files: [], maxConcurrency: 4) {
+            count += 1
+        }
+        XCTAssertEqual(count, 0)
+    }
+
+    // MARK: - Streaming
+
+    /// Stream the program made of `statements`, one per line, keeping the
+    /// statements whose index is in `kept`, and check that the AST is that of
+    /// a parse of the same program with the other statements blanked out.
+    private func assertStreamingMatchesParse(
+        _ statements: [String],
+        keeping kept: Set<Int>,
+        file: StaticString = #filePath,
+        line: UInt = #line
+    ) throws {
+        var index = 0
+        let streamed = try ParseSession.parseStreaming(
+            SourceBuffer(copying: statements.joined(separator: "\n"))
+        ) { _ in
+            defer { index += 1 }
+            return kept.contains(index)
+        }
+        XCTAssertEqual(index, statements.count, file: file, line: line)
+        let blanked = statements.enumerated().map { index, statement in
+            kept.contains(index) ? statement : String(repeating: " ", count: statement.utf8.count)
+        }
+        let parsed = try ParseSession.parse(blanked.joined(separator: "\n"))
+        XCTAssertEqual(
+            String(streamed.cxx.dumpProgram()), String(parsed.cxx.dumpProgram()),
+            file: file, line: line)
+    }
+
+    func testStreamingMatchesParse() throws {
+        let statements = [
+            "'use strict';",
+            "var a = 1;",
+            "function f(x) { return x + 1; }",
+            "if (a) { f(a); }",
+            "var b = [1, {c: 2}];",
+        ]
+        try assertStreamingMatchesParse(statements, keeping: Set(statements.indices))
+        try assertStreamingMatchesParse(statements, keeping: [0, 2, 4])
+    }
+
+    func testStreamingReleasesBeforeRegExp() throws {
+        // The regexp literal is lexed as the lookahead of the statement that
+        // is released, in the memory that statement is freed with.
+        try assertStreamingMatchesParse([
+            "var k = 0;",
+            "var a = [1, 2, 3, 4, 5, 6, 7, 8];",
+            "/ab+c/g.test(a);",
+            "var b = {x: 1, y: 2, z: [3, 4]};",
+        ], keeping: [0, 2, 3])
+    }
+
+    func testStreamingReleasesDirectives() throws {
+        try assertStreamingMatchesParse(
+            ["'use strict';", "'use asm';", "var a = 1;"], keeping: [0, 2])
+
+        // A released directive still applies to the rest of the program.
+        XCTAssertThrowsError(try ParseSession.parseStreaming(
+            SourceBuffer(copying: "'use strict';\nvar let = 1;\n")) { _ in false })
+    }
+
+    func testStreamingReleasedStatementsReuseOneSlab() throws {
+        let source = SourceBuffer(copying: (0..<20_000).map {
+            "var x\($0) = {a: [\($0), 2, 3], b: function () { return 1; }};\n"
+        }.joined())
+        let options = ParseOptions(collectStatistics: true)
+        let streamed = try ParseSession.parseStreaming(source, options: options) { _ in false }
+        let parsed = try ParseSession.parse(source, options: options)
+        // The AST arena allocates in slabs of 256 KiB.
+        XCTAssertEqual(streamed.statistics.arenaBytesReserved, 256 * 1024)
+        XCTAssertGreaterThan(parsed.statistics.arenaBytesReserved, 256 * 1024)
+    }
+
+    // MARK: - Reparse
+
+    /// The UTF-8 offset of the first `needle` in `source`.
+    private func offset(of needle: String, in source: String) -> Int {
+        source.utf8.distance(from: source.startIndex, to: source.range(of: needle)!.lowerBound)
+    }
+
+    /// Reparse `source` with `range` replaced by `replacement`, and check that
+    /// the AST and the skipped types are those of a fresh parse of the result.
+    /// - Returns: whether only the statements around the edit were parsed.
+    @discardableResult
+    private func assertReparseMatchesParse(
+        _ source: String,
+        replacing range: Range<Int>,
+        with replacement: String,
+        options: ParseOptions = ParseOptions(),
+        file: StaticString = #filePath,
+        line: UInt = #line
+    ) throws -> Bool {
+        var bytes = Array(source.utf8)
+        bytes.replaceSubrange(range, with: Array(replacement.utf8))
+        let edited = String(decoding: bytes, as: UTF8.self)
+
+        let session = try ParseSession.parse(source, options: options)
+        let incremental = try session.reparse(
+            SourceBuffer(copying: edited), replacing: range,
+            insertedCount: replacement.utf8.count)
+        let fresh = try ParseSession.parse(edited, options: options)
+        XCTAssertEqual(
+            String(session.cxx.dumpProgram()), String(fresh.cxx.dumpProgram()),
+            file: file, line: line)
+        XCTAssertEqual(session.skippedTypes, fresh.skippedTypes, file: file, line: line)
+        return incremental
+    }
+
+    private let program = """
+        var a = 1;
+        function f(x) {
+          var y = x + 1;
+          return y;
+        }
+        var b = f(a);
+
+        """
+
+    func testReparseMatchesParse() throws {
+        let inFunction = offset(of: "1;\n  return", in: program)
+        XCTAssertTrue(try assertReparseMatchesParse(
+            program, replacing: inFunction..<inFunction + 1, with: "2"))
+        let end = program.utf8.count
+        XCTAssertTrue(try assertReparseMatchesParse(
+            program, replacing: end..<end, with: "var c = 3;\n"))
+        let name = offset(of: "b =", in: program)
+        XCTAssertTrue(try assertReparseMatchesParse(
+            program, replacing: name..<name + 1, with: "bee"))
+        try assertReparseMatchesParse(program, replacing: 0..<11, with: "")
+    }
+
+    func testReparseOfDirectiveParsesEverything() throws {
+        let source = "'use strict';\nvar a = 1;\nfunction g() { return 1; }\n"
+        XCTAssertFalse(try assertReparseMatchesParse(
+            source, replacing: 1..<11, with: "use sloppy"))
+        let sloppy = "'use sloppy';\nvar a = 1;\n"
+        XCTAssertFalse(try assertReparseMatchesParse(
+            sloppy, replacing: 1..<11, with: "use strict"))
+    }
+
+    func testReparseOfStatementsEndingElsewhereParsesEverything() throws {
+        // `a = b, c = d` is one statement.
+        let source = "a = b\nc = d\nfunction f() {}\n"
+        let end = offset(of: "\nc", in: source)
+        XCTAssertFalse(try assertReparseMatchesParse(source, replacing: end..<end, with: ","))
+    }
+
+    func testReparseInComponentAndModule() throws {
+        let flow = ParseOptions(flow: .all, flowComponentSyntax: true)
+        let component = """
+            component Foo(bar: string) {
+              const x = bar;
+              return x;
+            }
+            var y = 1;
+
+            """
+        let bar = offset(of: "bar;", in: component)
+        try assertReparseMatchesParse(
+            component, replacing: bar..<bar + 3, with: "bar + 1", options: flow)
+
+        let module = """
+            namespace N {
+              export const x: number = 1;
+              const y = 2;
+            }
+            var z = 1;
+
+            """
+        let two = offset(of: "2;", in: module)
+        try assertReparseMatchesParse(
+            module, replacing: two..<two + 1, with: "3", options: ParseOptions(typeScript: true))
+    }
+
+    func testReparseWithSkippedTypes() throws {
+        let options = ParseOptions(flow: .all, typeSyntax: .skip)
+        let source = """
+            function f(x: number): string {
+              return String(x);
+            }
+            var a: number = 1;
+            var b = (a: any);
+
+            """
+        let one = offset(of: "1;", in: source)
+        XCTAssertTrue(try assertReparseMatchesParse(
+            source, replacing: one..<one + 1, with: "2", options: options))
+        let b = offset(of: "var b", in: source)
+        XCTAssertTrue(try assertReparseMatchesParse(
+            source, replacing: b..<b, with: "type T = number;\n", options: options))
+    }
+
+    func testReparseWithWrongEditParsesEverything() throws {
+        let session = try ParseSession.parse(program)
+        // The edit says the `1` of `x + 1` was replaced, but `b` was.
+        var edited = program
+        edited.replaceSubrange(edited.range(of: "var b")!, with: "var c")
+        let one = offset(of: "1;\n  return", in: program)
+        XCTAssertFalse(try session.reparse(
+            SourceBuffer(copying: edited), replacing: one..<one + 1, insertedCount: 1))
+        XCTAssertEqual(
+            String(session.cxx.dumpProgram()),
+            String(try ParseSession.parse(edited).cxx.dumpProgram()))
+
+        // An edit outside of the source.
+        let count = edited.utf8.count
+        XCTAssertFalse(try session.reparse(
+            SourceBuffer(copying: edited), replacing: count + 5..<count + 15, insertedCount: 0))
+    }
+
+    func testReparseKeepsNoSource() throws {
+        var text = program
+        weak var parsed: SourceBuffer?
+        let session: ParseSession
+        do {
+            let buffer = SourceBuffer(copying: text)
+            parsed = buffer
+            session = try ParseSession.parse(buffer)
+        }
+        // Edits in place, appended statements, and the full parses that free
+        // the statements they replace.
+        for i in 0..<200 {
+            weak var edited: SourceBuffer?
+            let one = offset(of: "+ ", in: text) + 2
+            let digit = text.utf8[text.utf8.index(text.utf8.startIndex, offsetBy: one)]
+            var bytes = Array(text.utf8)
+            let range = i % 10 == 0 ? bytes.count..<bytes.count : one..<one + 1
+            let replacement = i % 10 == 0 ? "var v\(i) = \(i);\n" : digit == UInt8(ascii: "1") ? "2" : "1"
+            bytes.replaceSubrange(range, with: Array(replacement.utf8))
+            text = String(decoding: bytes, as: UTF8.self)
+            do {
+                let buffer = SourceBuffer(copying: text)
+                edited = buffer
+                try session.reparse(
+                    buffer, replacing: range, insertedCount: replacement.utf8.count)
+            }
+            XCTAssertNil(edited)
+        }
+        XCTAssertNil(parsed)
+        XCTAssertNil(session.source)
+        XCTAssertEqual(
+            String(session.cxx.dumpProgram()),
+            String(try ParseSession.parse(text).cxx.dumpProgram()))
+    }
+
+    func testErrorsAreThoseOfTheLastParse() throws {
+        let session = try ParseSession.parse(program)
+        let count = program.utf8.count
+        XCTAssertThrowsError(try session.reparse(
+            SourceBuffer(copying: "var = ;"), replacing: 0..<count, insertedCount: 7))
+        XCTAssertNotEqual(String(session.cxx.getErrors()), "")
+        try session.reparse(SourceBuffer(copying: program), replacing: 0..<7, insertedCount: count)
+        XCTAssertEqual(String(session.cxx.getErrors()), "")
+        XCTAssertEqual(session.cxx.getErrorCount(), 0)
+    }
+
+    // MARK: - Dialect detection
+
+    /// The dialect detected for `source` named `name`.
+    private func dialect(of source: String, name: String = "JavaScript") throws -> ParseOptions.Dialect? {
+        try ParseSession.parse(source, name: name, options: ParseOptions(detectDialect: true)).detectedDialect
+    }
+
+    func testDialectOfExtension() throws {
+        let source = "var a = 1;\n"
+        let dialects: [String: ParseOptions.Dialect] = [
+            "a.ts": .typeScript, "a.mts": .typeScript, "a.cts": .typeScript, "a.tsx": .tsx,
+            "a.flow": .flow,
+            "a.js": .javaScript, "a.mjs": .javaScript, "a.cjs": .javaScript, "a.jsx": .jsx,
+            "JavaScript": .javaScript,
+        ]
+        for (name, dialect) in dialects {
+            XCTAssertEqual(try self.dialect(of: source, name: name), dialect, name)
+        }
+        // JSX is added to Flow, but not to TypeScript chosen by extension.
+        XCTAssertEqual(try dialect(of: "var a = 1; // </\n", name: "a.flow"), .flowJSX)
+        XCTAssertEqual(try dialect(of: "var a = 1; // </\n", name: "a.ts"), .typeScript)
+    }
+
+    func testDialectOfFlowPragma() throws {
+        XCTAssertEqual(try dialect(of: "/** @flow */\nvar a = 1;\n"), .flow)
+        XCTAssertEqual(try dialect(of: "/** @flow strict */\nvar a = 1;\n"), .flow)
+        XCTAssertEqual(try dialect(of: "// @flow\nvar a = 1;\n"), .flow)
+        XCTAssertEqual(try dialect(of: "/** @noflow */\nvar a = 1;\n"), .javaScript)
+        XCTAssertEqual(try dialect(of: "/** @flowfoo */\nvar a = 1;\n"), .javaScript)
+        // Only the docblock counts.
+        XCTAssertEqual(try dialect(of: "var a = 1;\n/** @flow */\n"), .javaScript)
+    }
+
+    func testDialectOfText() throws {
+        // JSX is detected from text that every element has, which strings and
+        // comments may have too.
+        XCTAssertEqual(try dialect(of: "var s = \"</div>\";\n"), .jsx)
+        XCTAssertEqual(try dialect(of: "// <a/>\nvar a = 1;\n"), .jsx)
+
+        XCTAssertEqual(try dialect(of: "var s = \"x: string\";\n"), .typeScript)
+        XCTAssertEqual(try dialect(of: "var s = \"readonly x\";\n"), .typeScript)
+        XCTAssertEqual(try dialect(of: "var s = \"isreadonly x\";\n"), .javaScript)
+        // TypeScript is never detected in a file named as JavaScript.
+        XCTAssertEqual(try dialect(of: "var s = \"x: string\";\n", name: "a.js"), .javaScript)
+    }
+
+    func testDialectOfShortSources() throws {
+        // The search reads 16 bytes at a time and then the rest one by one.
+        for count in [15, 16, 17, 33] {
+            let comment = "//" + String(repeating: "a", count: count - 4)
+            XCTAssertEqual(try dialect(of: comment + "/>"), .jsx, "\(count)")
+            XCTAssertEqual(try dialect(of: comment + "aa"), .javaScript, "\(count)")
+        }
+        // A pair that starts in one block of 16 bytes and ends in the next.
+        let aligned = "//" + String(repeating: "a", count: 13)
+        XCTAssertEqual(try dialect(of: aligned + "</" + String(repeating: "a", count: 16)), .jsx)
+    }
+
+    // MARK: - Docblocks
+
+    /// The comments, the pragmas and the end of the docblock of `source`, and
+    /// whether it has an @flow pragma.
+    private func docBlock(_ source: String) -> (comments: [String], pragmas: [String], end: Int, flow: Bool) {
+        let block = source.withCString { hermesScanDocBlock($0, source.utf8.count) }
+        return (
+            block.comments.map { String($0) }, block.pragmas.map { String($0) },
+            Int(block.end), block.hasFlowPragma)
+    }
+
+    func testDocBlockEndsAtFirstNonDirective() throws {
+        let source = "/** @flow */\n'use strict';\n// after\nvar a; // not\n"
+        let block = docBlock(source)
+        XCTAssertEqual(block.comments, ["/** @flow */", "// after"])
+        XCTAssertEqual(block.end, offset(of: "var a", in: source))
+    }
+
+    func testDocBlockAfterDirective() throws {
+        XCTAssertEqual(docBlock("'use strict'; /* c */ x").comments, ["/* c */"])
+        XCTAssertEqual(docBlock("'use strict' /* c */\nx").comments, ["/* c */"])
+        XCTAssertEqual(docBlock("'use strict'\n// c\nx").comments, ["// c"])
+        // Not a directive, so there is no docblock after it.
+        let block = docBlock("'use strict'.length; // c\n")
+        XCTAssertEqual(block.comments, [])
+        XCTAssertEqual(block.end, 0)
+    }
+
+    func testDocBlockEdges() throws {
+        // The hashbang is a comment of the docblock, but has no pragmas.
+        var block = docBlock("#!/usr/bin/env node\n// @flow\nx")
+        XCTAssertEqual(block.comments, ["#!/usr/bin/env node", "// @flow"])
+        XCTAssertTrue(block.flow)
+        XCTAssertFalse(docBlock("#!@flow\n").flow)
+
+        block = docBlock("\u{FEFF}/* @flow */ x")
+        XCTAssertEqual(block.comments, ["/* @flow */"])
+        XCTAssertTrue(block.flow)
+
+        // An unterminated comment ends the source. The lexer-based
+        // hasFlowPragma() missed @flow in it, taking "ow" for the "*/".
+        block = docBlock("/* @flow")
+        XCTAssertEqual(block.comments, ["/* @flow"])
+        XCTAssertEqual(block.end, 8)
+        XCTAssertTrue(block.flow)
+
+        block = docBlock("/** @format @generated @my_pragma2 @flow strict */\nx")
+        XCTAssertEqual(block.pragmas, ["format", "generated", "my_pragma2", "flow"])
+        XCTAssertTrue(block.flow)
+    }
+
+    func testFlowPragmaMatchesLexerBasedCheck() throws {
+        XCTAssertTrue(docBlock("/* @flow */").flow)
+        XCTAssertTrue(docBlock("/* @flow strict */").flow)
+        XCTAssertFalse(docBlock("/* @flowtype */").flow)
+        XCTAssertTrue(docBlock("/**@flow*/").flow)
+        XCTAssertEqual(docBlock("/* @flowtype */").pragmas, ["flowtype"])
+    }
+
+    // MARK: - Dependencies
+
+    /// Scan `source`, and check that the result is the same when the whole
+    /// source is parsed.
+    /// - Returns: the dependencies.
+    @discardableResult
+    private func assertScanMatchesParse(
+        _ source: String,
+        options: ParseOptions = ParseOptions(),
+        file: StaticString = #filePath,
+        line: UInt = #line
+    ) throws -> [ModuleDependency] {
+        let scanned = try ParseSession.scanDependencies(source, options: options)
+        // The scanner leaves non-ASCII identifiers to the parser, so it gives
+        // up at the end and parses the whole source.
+        let parsed = try ParseSession.scanDependencies(source + "\nvar é;\n", options: options)
+        XCTAssertEqual(scanned, parsed, file: file, line: line)
+        return scanned
+    }
+
+    func testScanMatchesParse() throws {
+        let modules = try assertScanMatchesParse("""
+            import a from 'a';
+            import {b, c as d} from "b";
+            import * as e from 'e';
+            import 'side';
+            export {f} from 'f';
+            export * from 'g';
+            const h = require('h');
+            import('i').then(() => {});
+
+            """)
+        XCTAssertEqual(modules.map(\.specifier), ["a", "b", "e", "side", "f", "g", "h", "i"])
+        XCTAssertEqual(
+            modules.map(\.kind),
+            [.import, .import, .import, .import, .export, .export, .require, .dynamicImport])
+
+        try assertScanMatchesParse("""
+            // require('no')
+            /* import('no') */
+            const s = "require('no')";
+            const re = /require\\('no'\\)/;
+            const t = `${require('yes')} require('no')`;
+            function f() { if (x) { return require('a'); } }
+            for (const m of [require('b')]) {}
+            class C { m() { return import('c'); } }
+
+            """)
+    }
+
+    func testScanSkipsWhatIsNotARequireCall() throws {
+        let modules = try assertScanMatchesParse("""
+            const x = new require('x');
+            const y = new (require('y'))();
+            obj.require('z');
+            require('w', 1);
+            require(name);
+            require?.('v');
+
+            """)
+        XCTAssertEqual(modules.map(\.specifier), ["y"])
+    }
+
+    func testScanMatchesParseOfDialects() throws {
+        try assertScanMatchesParse("""
+            import React from 'react';
+            const el = <div a={require('a')}>require('no') {import('b')}</div>;
+
+            """, options: ParseOptions(jsx: true))
+
+        let flow = try assertScanMatchesParse("""
+            import type {T} from 't';
+            import typeof U from 'u';
+            export type {V} from 'v';
+            const x: T = require('x');
+
+            """, options: ParseOptions(flow: .all))
+        XCTAssertEqual(flow.map(\.isTypeOnly), [true, true, true, false])
+
+        try assertScanMatchesParse("""
+            import type {T} from 't';
+            const x = require('x') as T;
+            const y = new require('y');
+
+            """, options: ParseOptions(typeScript: true))
+    }
+
+    // MARK: - Skipped types
+
+    /// Parse `source` with types skipped, check that it is JavaScript without
+    /// them, and describe every skipped range as its kind and its text.
+    private func skippedTypes(
+        _ source: String,
+        options: ParseOptions,
+        file: StaticString = #filePath,
+        line: UInt = #line
+    ) throws -> [String] {
+        var options = options
+        options.typeSyntax = .skip
+        let session = try ParseSession.parse(source, options: options)
+        let bytes = Array(source.utf8)
+        var javaScript: [UInt8] = []
+        var end = 0
+        let described = session.skippedTypes.map { type in
+            javaScript += bytes[end..<type.range.lowerBound]
+            end = type.range.upperBound
+            return "\(type.kind) \(String(decoding: bytes[type.range], as: UTF8.self))"
+        }
+        javaScript += bytes[end...]
+        XCTAssertNoThrow(
+            try ParseSession.parse(String(decoding: javaScript, as: UTF8.self)),
+            file: file, line: line)
+        return described
+    }
+
+    func testSkippedFlowTypes() throws {
+        let flow = ParseOptions(flow: .all)
+        XCTAssertEqual(
+            try skippedTypes("function f<T>(x: T, y?: number): T { return (x: any); }", options: flow),
+            [
+                "typeParameters <T>", "annotation : T", "modifier ?", "annotation : number",
+                "annotation : T", "annotation : any",
+            ])
+        XCTAssertEqual(
+            try skippedTypes("""
+                type A = number;
+                opaque type B = string;
+                interface I { x: number }
+                declare var d: number;
+                import type {T} from 't';
+                import {type U, V} from 'uv';
+                export type {A};
+                var x = 1;
+                """, options: flow),
+            [
+                "declaration type A = number;", "declaration opaque type B = string;",
+                "declaration interface I { x: number }", "declaration declare var d: number;",
+                "declaration import type {T} from 't';", "declaration type U,",
+                "declaration export type {A};",
+            ])
+        XCTAssertEqual(
+            try skippedTypes(
+                "class C<T> extends D<T> implements I { +p: T; -q: number; declare r: string; m<U>(): void {} }",
+                options: flow),
+            [
+                "typeParameters <T>", "typeArguments <T>", "implements implements I", "modifier +",
+                "annotation : T", "modifier -", "annotation : number", "declaration declare r: string;",
+                "typeParameters <U>", "annotation : void",
+            ])
+        XCTAssertEqual(
+            try skippedTypes("const v = f<number>(1); const w = new C<string>();", options: flow),
+            ["typeArguments <number>", "typeArguments <string>"])
+    }
+
+    func testSkippedTypeScriptTypes() throws {
+        let typeScript = ParseOptions(typeScript: true)
+        XCTAssertEqual(
+            try skippedTypes("""
+                function f<T>(x: T, y?: number): T { return x as T; }
+                let a = <any>b;
+                """, options: typeScript),
+            [
+                "typeParameters <T>", "annotation : T", "modifier ?", "annotation : number",
+                "annotation : T", "cast as T", "cast <any>",
+            ])
+        XCTAssertEqual(
+            try skippedTypes(
+                "class C<T> extends D<T> { private p: T; public readonly q?: number; }",
+                options: typeScript),
+            [
+                "typeParameters <T>", "typeArguments <T>", "modifier private", "annotation : T",
+                "modifier public", "modifier readonly", "modifier ?", "annotation : number",
+            ])
+        XCTAssertEqual(
+            try skippedTypes("""
+                type A = number;
+                interface I { x: number }
+                import type {T} from 't';
+                var x = 1;
+                """, options: typeScript),
+            [
+                "declaration type A = number;", "declaration interface I { x: number }",
+                "declaration import type {T} from 't';",
+            ])
+    }
+
+    // MARK: - Type stripping
+
+    /// Strip the types from `source` in both modes, and check that the output
+    /// is JavaScript and that `.blank` keeps everything else in place.
+    /// - Returns: the output of `.remove`, one string per line.
+    private func strip(
+        _ source: String,
+        options: ParseOptions,
+        file: StaticString = #filePath,
+        line: UInt = #line
+    ) throws -> [String] {
+        let blank = try ParseSession.stripTypes(source, options: options, mode: .blank).code
+        let removed = try ParseSession.stripTypes(source, options: options, mode: .remove).code
+        for code in [blank, removed] {
+            XCTAssertNoThrow(try ParseSession.parse(code), file: file, line: line)
+        }
+        // Types are blanked with spaces, or with the ';' that ends the
+        // statement before a declaration.
+        XCTAssertEqual(blank.utf8.count, source.utf8.count, file: file, line: line)
+        for (output, input) in zip(blank.utf8, source.utf8)
+        where output != input && output != UInt8(ascii: " ") && output != UInt8(ascii: ";") {
+            XCTFail("blanked \(input) with \(output)", file: file, line: line)
+        }
+        // Both modes leave out the same characters.
+        XCTAssertEqual(
+            blank.filter { $0 != " " }, removed.filter { $0 != " " }, file: file, line: line)
+        return removed.components(separatedBy: "\n")
+    }
+
+    func testStripFlow() throws {
+        let source = """
+            // @flow
+            import type {T} from 't';
+            import {type U, V} from 'uv';
+            function f<X>(x: X, y?: number): X {
+              return (x: any);
+            }
+            export type {T};
+            class C<X> extends D<X> implements I {
+              +p: X;
+              -q: number;
+              declare r: string;
+            }
+
+            """
+        XCTAssertEqual(try strip(source, options: ParseOptions(flow: .all)), [
+            "// @flow",
+            "",
+            "import { V} from 'uv';",
+            "function f(x, y) {",
+            "  return (x);",
+            "}",
+            "",
+            "class C extends D  {",
+            "  p;",
+            "  q;",
+            "  ",
+            "}",
+            "",
+        ])
+    }
+
+    func testStripTypeScript() throws {
+        let source = """
+            import type {T} from 't';
+            function f<X>(x: X, y?: number): X {
+              return x as X;
+            }
+            let a = <any>b;
+            class C {
+              private p: number;
+              public readonly q?: string;
+            }
+            interface I { x: number }
+
+            """
+        XCTAssertEqual(try strip(source, options: ParseOptions(typeScript: true)), [
+            "",
+            "function f(x, y) {",
+            "  return x ;",
+            "}",
+            "let a = b;",
+            "class C {",
+            "   p;",
+            "    q;",
+            "}",
+            "",
+            "",
+        ])
+    }
+
+    func testStripEndsStatementBeforeDeclaration() throws {
+        let flow = ParseOptions(flow: .all)
+        // Without the type, `[a]` and `(a)` would continue `const a = 1`.
+        XCTAssertEqual(
+            try strip("const a = 1\ntype T = number;\n[a].forEach(f);\n", options: flow),
+            ["const a = 1", ";", "[a].forEach(f);", ""])
+        XCTAssertEqual(
+            try strip("const a = 1\ntype T = number;\n(a);\n", options: flow),
+            ["const a = 1", ";", "(a);", ""])
+        XCTAssertEqual(
+            try strip("const a = 1\ntype T = number;\n`t`;\n", options: flow),
+            ["const a = 1", ";", "`t`;", ""])
+        // Not needed after a ';', or before a token that starts a statement.
+        XCTAssertEqual(
+            try strip("const a = 1;\ntype T = number;\n(a);\n", options: flow),
+            ["const a = 1;", "", "(a);", ""])
+        XCTAssertEqual(
+            try strip("const a = 1\ntype T = number;\nlet b = 2\n", options: flow),
+            ["const a = 1", "", "let b = 2", ""])
+    }
+
+    func testStripSourceMap() throws {
+        let stripped = try ParseSession.stripTypes(
+            "let x: number = 1;\nlet y: string = 'a';\n", name: "in.js",
+            options: ParseOptions(flow: .all), mode: .remove, sourceMap: true)
+        XCTAssertEqual(stripped.code, "let x = 1;\nlet y = 'a';\n")
+        let map = try XCTUnwrap(
+            JSONSerialization.jsonObject(with: Data(XCTUnwrap(stripped.sourceMap).utf8))
+                as? [String: Any])
+        XCTAssertEqual(map["version"] as? Int, 3)
+        XCTAssertEqual(map["sources"] as? [String], ["in.js"])
+        // Each line maps column 0 to column 0, and ` = ` at column 5 to
+        // column 13, after the annotation.
+        XCTAssertEqual(map["mappings"] as? String, "AAAA,KAAa;AACb,KAAa")
+
+        let unmapped = try ParseSession.stripTypes(
+            "let x: number = 1;", options: ParseOptions(flow: .all), mode: .remove)
+        XCTAssertNil(unmapped.sourceMap)
+    }
+
+    func testStripKeepsTypeScriptThatRuns() throws {
+        let source = """
+            enum E { A, B }
+            namespace N { export const x: number = 1; }
+            let y: E = E.A;
+
+            """
+        let typeScript = ParseOptions(typeScript: true)
+        XCTAssertEqual(
+            try ParseSession.stripTypes(source, options: typeScript, mode: .remove).code,
+            """
+            enum E { A, B }
+            namespace N { export const x = 1; }
+            let y = E.A;
+
+            """)
+        let blank = try ParseSession.stripTypes(source, options: typeScript, mode: .blank).code
+        XCTAssertTrue(blank.hasPrefix("enum E { A, B }\nnamespace N { export const x"))
+    }
+
+    // MARK: - JSON
+
+    /// `json` parsed with `engine` and printed back, or "" if it is rejected.
+    private func formatJSON(_ json: String, _ engine: hermes.parser.JSONParserEngine) -> String {
+        json.withCString { String(hermesFormatJSON($0, json.utf8.count, engine)) }
+    }
+
+    func testJSONEnginesMatchOnValidJSON() throws {
+        let valid = [
+            "{}", "[]", "0", "-1.5e3", "true", "false", "null",
+            #""a\u00e9\n\"\/""#, "\"é😀\"", #""\ud83d\ude00""#,
+            #"{"a":[1,2,{"b":null}],"c":"x","":{}}"#,
+            " [ 1 , [ [ ] ] ]\n", "[1e400, 0.1, -0, 123456789012345678]",
+        ]
+        for json in valid {
+            let lexer = formatJSON(json, .Lexer)
+            XCTAssertFalse(lexer.isEmpty, json)
+            XCTAssertEqual(lexer, formatJSON(json, .StructuralIndex), json)
+        }
+    }
+
+    func testJSONEnginesRejectInvalidJSON() throws {
+        let invalid = [
+            "", "[", "[1 2]", "[1,,2]", "[,]", "{,}", "{a:1}", #"{"a"}"#,
+            #"{"a":1,"a":2}"#, #""abc"#, "\"a\nb\"", "tru", "nul", "[01]",
+            "[+1]", "[Infinity]", "1n",
+        ]
+        for json in invalid {
+            XCTAssertEqual(formatJSON(json, .Lexer), "", json)
+            XCTAssertEqual(formatJSON(json, .StructuralIndex), "", json)
+        }
+
+        // Only the lexer-based parser accepts JavaScript strings, numbers and
+        // comments.
+        for json in ["'a'", #""\x41""#, "0x10", ".5", "1.", "[/*c*/1]"] {
+            XCTAssertNotEqual(formatJSON(json, .Lexer), "", json)
+            XCTAssertEqual(formatJSON(json, .StructuralIndex), "", json)
+        }
+    }
+
+    /// The value of the property `name` of the object `json`, found with a
+    /// JSONCursor and printed back, or "" if the cursor fails.
+    private func findJSONField(_ json: String, _ name: String) -> String {
+        json.withCString { String(hermesFindJSONField($0, json.utf8.count, std.string(name))) }
+    }
+
+    func testJSONCursorFindsEscapedKeys() throws {
+        XCTAssertEqual(findJSONField(#"{"a\"b":[1],"x":2}"#, #"a"b"#), "[1]")
+        XCTAssertEqual(findJSONField(#"{"a\\":true}"#, #"a\"#), "true")
+        XCTAssertEqual(findJSONField(#"{"\u0061":1,"a":2}"#, "a"), "1")
+        XCTAssertEqual(findJSONField(#"{"a":1}"#, "b"), "")
+    }
+
+    func testJSONCursorSkipsBracketsInStrings() throws {
+        let json = #"{"s":"[{\"]}","t":{"u":"}"},"v":[1,{"w":null}],"x":0}"#
+        XCTAssertEqual(findJSONField(json, "v"), #"[1,{"w":null}]"#)
+        XCTAssertEqual(findJSONField(#"{"s":"]]]","v":"x"}"#, "v"), #""x""#)
+    }
+
+    func testJSONCursorRejectsUnterminatedInput() throws {
+        for json in [
+            #"{"a":[1,2"#, #"{"a":"abc"#, #"{"a":1,"b":[1,{"c":2}"#,
+            #"{"a":1,"b":"x"#, #"{"a":[1 2],"c":2}"#,
+        ] {
+            XCTAssertEqual(findJSONField(json, json.contains("\"b\"") ? "b" : "a"), "", json)
+        }
+    }
+
+    /// The records of the JSON Lines `input`, each with the offset of its line,
+    /// in delivery order.
+    private func readJSONLines(
+        _ input: String, _ options: hermes.parser.JSONLinesOptions, recordDelayUs: UInt32 = 0
+    ) -> (records: [(Int, String)], peakChunksInFlight: Int, ok: Bool) {
+        let lines = input.withCString { hermesReadJSONLines($0, input.utf8.count, options, recordDelayUs) }
+        let records = zip(lines.offsets, lines.records).map { (Int($0), String($1)) }
+        return (records, Int(lines.peakChunksInFlight), lines.ok)
+    }
+
+    /// Lines `{"i":0}` to `{"i":count-1}`.
+    private func numberedLines(_ count: Int) -> String {
+        (0..<count).map { #"{"i":\#($0)}"# + "\n" }.joined()
+    }
+
+    func testJSONLinesOrderedDelivery() throws {
+        var options = hermes.parser.JSONLinesOptions()
+        options.chunkSize = 64
+        options.numThreads = 4
+        let lines = readJSONLines(numberedLines(200), options)
+        XCTAssertTrue(lines.ok)
+        XCTAssertEqual(lines.records.map(\.1), (0..<200).map { #"{"i":\#($0)}"# })
+        var offset = 0
+        let offsets = (0..<200).map { i -> Int in
+            defer { offset += #"{"i":\#(i)}"#.utf8.count + 1 }
+            return offset
+        }
+        XCTAssertEqual(lines.records.map(\.0), offsets)
+    }
+
+    func testJSONLinesUnorderedDelivery() throws {
+        // The first line takes far longer to parse than the chunks after it,
+        // which are then usually delivered first.
+        let first = "[" + String(repeating: "1234.5678,", count: 100_000) + "0]\n"
+        let input = first + numberedLines(2000)
+        var options = hermes.parser.JSONLinesOptions()
+        options.chunkSize = 65536
+        options.numThreads = 4
+        options.maxChunksInFlight = 64
+        let ordered = readJSONLines(input, options)
+        options.ordered = false
+        let unordered = readJSONLines(input, options)
+        XCTAssertTrue(unordered.ok)
+        XCTAssertEqual(ordered.records.count, 2001)
+        XCTAssertEqual(
+            unordered.records.sorted { $0.0 < $1.0 }.map { "\($0.0):\($0.1)" },
+            ordered.records.map { "\($0.0):\($0.1)" })
+    }
+
+    func testJSONLinesWindowBoundsChunksInFlight() throws {
+        // A callback slower than parsing leaves the workers waiting on the
+        // window rather than running ahead.
+        var options = hermes.parser.JSONLinesOptions()
+        options.chunkSize = 64
+        options.numThreads = 4
+        options.maxChunksInFlight = 2
+        let lines = readJSONLines(numberedLines(200), options, recordDelayUs: 200)
+        XCTAssertTrue(lines.ok)
+        XCTAssertEqual(lines.records.count, 200)
+        XCTAssertEqual(lines.peakChunksInFlight, 2)
+
+        options.maxChunksInFlight = 0
+        XCTAssertLessThanOrEqual(readJSONLines(numberedLines(200), options).peakChunksInFlight, 8)
+    }
+
+    func testJSONLinesMalformedLineAndMissingNewline() throws {
+        let options = hermes.parser.JSONLinesOptions()
+        // The error is reported in place and the rest of the chunk is read.
+        var lines = readJSONLines("1\n{x\n[3]\n", options)
+        XCTAssertTrue(lines.ok)
+        XCTAssertEqual(lines.records.map(\.0), [0, 2, 5])
+        XCTAssertEqual(lines.records.map(\.1), ["1", "error: expected a string", "[3]"])
+
+        // Blank lines are skipped and the last line needs no newline.
+        lines = readJSONLines("1\n\n  \n{\"a\":2}", options)
+        XCTAssertEqual(lines.records.map(\.0), [0, 6])
+        XCTAssertEqual(lines.records.map(\.1), ["1", #"{"a":2}"#])
+    }
 }
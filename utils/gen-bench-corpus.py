@@ -0,0 +1,348 @@
+#!/usr/bin/env python3
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Generate the synthetic input corpus of the parser benchmarks.
+
+The corpus imitates the shapes of real-world inputs rather than any particular
+program, and is fully determined by the seed, so numbers from different runs
+and machines can be compared:
+
+  bundle.min.js      a minified bundle of module factories
+  app.jsx            React components using hooks and JSX
+  flow-typed.flow.js Flow-annotated modules
+  declarations.ts    TypeScript interfaces, aliases, enums and typed code
+  large.json         a large, irregular API response
+
+The benchmarks pick the parser settings from the file name, so the suffixes
+matter.
+
+Usage: gen-bench-corpus.py [--seed N] [--scale MB] [output-dir]
+"""
+
+import argparse
+import json
+import os
+import random
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+DEFAULT_OUT = os.path.join(ROOT, ".build", "bench-corpus")
+
+WORDS = (
+    "user item list value state props data index count total name id key "
+    "node child parent result error event target config options cache "
+    "request response handler callback promise buffer offset length size "
+    "width height color style theme layout render update effect ref token"
+).split()
+
+
+class Gen:
+    def __init__(self, rng):
+        self.rng = rng
+        self.counter = 0
+
+    def word(self):
+        return self.rng.choice(WORDS)
+
+    def ident(self):
+        self.counter += 1
+        return "%s%s%d" % (
+            self.word(),
+            self.word().capitalize(),
+            self.counter % 97,
+        )
+
+    def short(self):
+        # Minifier-style names.
+        alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_$"
+        n = self.rng.randrange(len(alphabet) * 4)
+        if n < len(alphabet):
+            return alphabet[n]
+        return alphabet[n % len(alphabet)] + alphabet[n // len(alphabet)]
+
+    def string(self):
+        return json.dumps(" ".join(self.word() for _ in range(self.rng.randint(1, 4))))
+
+    def number(self):
+        r = self.rng.random()
+        if r < 0.6:
+            return str(self.rng.randrange(1000))
+        if r < 0.8:
+            return "%.3f" % (self.rng.random() * 100)
+        return hex(self.rng.randrange(1 << 24))
+
+
+def gen_bundle(g, size):
+    """Minified module factories in the style of a Metro/webpack bundle."""
+
+    def expr(depth):
+        r = g.rng.random()
+        if depth > 2 or r < 0.25:
+            return g.rng.choice([g.short(), g.number(), g.string(), "!0", "!1", "null"])
+        if r < 0.4:
+            return "%s(%s)" % (g.short(), ",".join(expr(depth + 1) for _ in range(g.rng.randint(0, 3))))
+        if r < 0.5:
+            return "%s.%s" % (g.short(), g.word())
+        if r < 0.6:
+            return "%s%s%s" % (expr(depth + 1), g.rng.choice("+-*<>&|"), expr(depth + 1))
+        if r < 0.7:
+            return "(%s?%s:%s)" % (expr(depth + 1), expr(depth + 1), expr(depth + 1))
+        if r < 0.8:
+            return "{%s}" % ",".join(
+                "%s:%s" % (g.word(), expr(depth + 1)) for _ in range(g.rng.randint(1, 4)))
+        if r < 0.88:
+            return "[%s]" % ",".join(expr(depth + 1) for _ in range(g.rng.randint(0, 4)))
+        if r < 0.94:
+            return "(%s=>(%s))" % (g.short(), expr(depth + 1))
+        return "/%s[0-9]+/g.test(%s)" % (g.word(), g.short())
+
+    def stmt(depth):
+        r = g.rng.random()
+        if depth > 2 or r < 0.35:
+            return "%s=%s;" % (g.short(), expr(0))
+        if r < 0.5:
+            return "var %s=%s,%s=%s;" % (g.short(), expr(0), g.short(), expr(0))
+        if r < 0.6:
+            return "if(%s){%s}else{%s}" % (expr(1), body(depth + 1), stmt(depth + 1))
+        if r < 0.7:
+            return "for(var %s=0;%s<%s.length;%s++){%s}" % (
+                "i", "i", g.short(), "i", body(depth + 1))
+        if r < 0.85:
+            # Function names never clash with the variables, which are
+            # block-scoped in strict mode.
+            g.counter += 1
+            return "function %s%d(%s){%sreturn %s}" % (
+                g.short(), g.counter, ",".join(sorted({g.short() for _ in range(g.rng.randint(0, 3))})),
+                body(depth + 1), expr(0))
+        return "try{%s}catch(%s){%s}" % (body(depth + 1), g.short(), body(depth + 1))
+
+    def body(depth):
+        return "".join(stmt(depth) for _ in range(g.rng.randint(1, 4)))
+
+    out = ['"use strict";']
+    n = 0
+    while sum(map(len, out)) < size:
+        out.append(
+            "__d(function(g,r,i,a,m,e,d){%s},%d,[%s]);"
+            % (body(0), n, ",".join(str(g.rng.randrange(n + 1)) for _ in range(3))))
+        n += 1
+    return "\n".join(out) + "\n"
+
+
+def gen_jsx(g, size):
+    """React function components with hooks, props and nested JSX."""
+
+    def element(depth):
+        tag = g.rng.choice(["View", "Text", "div", "span", "Button", "li", "section"])
+        attrs = " ".join(
+            '%s={%s}' % (g.word(), g.ident()) if g.rng.random() < 0.6 else '%s="%s"' % (g.word(), g.word())
+            for _ in range(g.rng.randint(0, 3)))
+        if depth > 3 or g.rng.random() < 0.3:
+            return "<%s %s />" % (tag, attrs)
+        children = []
+        for _ in range(g.rng.randint(1, 3)):
+            r = g.rng.random()
+            if r < 0.5:
+                children.append(element(depth + 1))
+            elif r < 0.7:
+                children.append("{%s.map(%s => <Item key={%s.id} %s={%s} />)}" % (
+                    g.ident(), "x", "x", g.word(), "x"))
+            elif r < 0.85:
+                children.append("{%s && %s}" % (g.ident(), element(depth + 1)))
+            else:
+                children.append(" ".join(g.word() for _ in range(3)))
+        pad = "  " * (depth + 2)
+        inner = "".join("\n" + pad + "  " + c for c in children)
+        return "<%s %s>%s\n%s</%s>" % (tag, attrs, inner, pad, tag)
+
+    out = ["import React, {useState, useEffect, useCallback} from 'react';\n"]
+    while sum(map(len, out)) < size:
+        name = g.ident().capitalize()
+        state = g.ident()
+        out.append(
+            "export function %s({%s}) {\n"
+            "  const [%s, set%s] = useState(%s);\n"
+            "  useEffect(() => {\n"
+            "    const handle = setTimeout(() => set%s(%s + 1), %s);\n"
+            "    return () => clearTimeout(handle);\n"
+            "  }, [%s]);\n"
+            "  const onPress = useCallback(event => {\n"
+            "    event.preventDefault();\n"
+            "    set%s(value => value * 2);\n"
+            "  }, []);\n"
+            "  return (\n    %s\n  );\n"
+            "}\n"
+            % (name, ", ".join(g.word() for _ in range(3)), state, state.capitalize(),
+               g.number(), state.capitalize(), state, g.number(), state,
+               state.capitalize(), element(0)))
+    return "\n".join(out)
+
+
+def gen_flow(g, size):
+    """Flow modules with type aliases, generics and annotated functions."""
+
+    def type_(depth):
+        r = g.rng.random()
+        if depth > 2 or r < 0.35:
+            return g.rng.choice(["string", "number", "boolean", "mixed", "void", "?string"])
+        if r < 0.5:
+            return "Array<%s>" % type_(depth + 1)
+        if r < 0.65:
+            return "{|%s|}" % ", ".join(
+                "%s%s: %s" % ("+" if g.rng.random() < 0.3 else "", g.word(), type_(depth + 1))
+                for _ in range(g.rng.randint(1, 4)))
+        if r < 0.8:
+            return " | ".join(type_(depth + 1) for _ in range(g.rng.randint(2, 3)))
+        if r < 0.9:
+            return "((%s) => %s)" % (
+                ", ".join("%s: %s" % (g.word(), type_(depth + 1)) for _ in range(g.rng.randint(0, 2))),
+                type_(depth + 1))
+        return "$ReadOnly<%s>" % type_(depth + 1)
+
+    out = ["/**\n * @flow strict\n * @format\n */\n",
+           "import type {Node} from 'react';\n"]
+    while sum(map(len, out)) < size:
+        alias = g.ident().capitalize()
+        fn = g.ident()
+        out.append(
+            "export type %s<T> = %s;\n\n"
+            "export function %s<T: %s>(items: $ReadOnlyArray<T>, %s: %s): %s<T> | null {\n"
+            "  const result: Array<T> = [];\n"
+            "  for (const item of items) {\n"
+            "    if ((item: any).%s != null) {\n"
+            "      result.push(item);\n"
+            "    }\n"
+            "  }\n"
+            "  return result.length > 0 ? (result: any) : null;\n"
+            "}\n\n"
+            "class %sStore<K, +V> {\n"
+            "  _map: Map<K, V> = new Map();\n"
+            "  get(key: K): ?V {\n"
+            "    return this._map.get(key);\n"
+            "  }\n"
+            "}\n"
+            % (alias, type_(0), fn, type_(1), g.word(), type_(0), alias,
+               g.word(), alias))
+    return "\n".join(out)
+
+
+def gen_ts(g, size):
+    """TypeScript interfaces, aliases, enums, namespaces and typed code."""
+
+    def type_(depth):
+        r = g.rng.random()
+        if depth > 2 or r < 0.35:
+            return g.rng.choice(["string", "number", "boolean", "unknown", "undefined", "null"])
+        if r < 0.5:
+            return "%s[]" % g.rng.choice(["string", "number", "boolean"])
+        if r < 0.65:
+            return "{ %s }" % "; ".join(
+                "%s%s: %s" % (g.word(), "?" if g.rng.random() < 0.3 else "", type_(depth + 1))
+                for _ in range(g.rng.randint(1, 4)))
+        if r < 0.8:
+            return " | ".join(type_(depth + 1) for _ in range(g.rng.randint(2, 3)))
+        if r < 0.9:
+            return "((%s) => %s)" % (
+                ", ".join("%s: %s" % (g.word(), type_(depth + 1)) for _ in range(g.rng.randint(0, 2))),
+                type_(depth + 1))
+        return "Promise<%s>" % type_(depth + 1)
+
+    out = []
+    while sum(map(len, out)) < size:
+        iface = g.ident().capitalize()
+        members = "\n".join(
+            "  %s%s: %s;" % (g.ident(), "?" if g.rng.random() < 0.2 else "", type_(0))
+            for _ in range(g.rng.randint(2, 6)))
+        out.append(
+            "export interface %s<T> extends Base {\n%s\n  items: T[];\n}\n\n"
+            "export type %sKey = Partial<%s<unknown>> | %s;\n\n"
+            "export enum %sKind {\n  %s = %s,\n  %s,\n  %s,\n}\n\n"
+            "export namespace %sNS {\n"
+            "  export function create<T>(items: T[], %s: %s): %s<T> {\n"
+            "    return { items } as %s<T>;\n"
+            "  }\n"
+            "}\n\n"
+            "export class %sImpl<T> extends %sBase<T> {\n"
+            "  private readonly items: T[] = [];\n"
+            "  protected count: number;\n"
+            "  constructor(count: number) {\n"
+            "    this.count = count;\n"
+            "  }\n"
+            "  add(item: T): this {\n"
+            "    this.items.push(item);\n"
+            "    return this;\n"
+            "  }\n"
+            "}\n"
+            % (iface, members, iface, iface, type_(1), iface,
+               g.word().capitalize(), g.number(), g.word().capitalize() + "A",
+               g.word().capitalize() + "B", iface, g.word(), type_(0), iface,
+               iface, iface, iface))
+    return "\n".join(out)
+
+
+def gen_json(g, size):
+    """An array of irregular records, like a large API response."""
+
+    def value(depth):
+        r = g.rng.random()
+        if depth > 3 or r < 0.4:
+            return g.rng.choice([
+                lambda: g.rng.randrange(100000),
+                lambda: round(g.rng.random() * 1000, 3),
+                lambda: " ".join(g.word() for _ in range(g.rng.randint(1, 6))),
+                lambda: g.rng.random() < 0.5,
+                lambda: None,
+            ])()
+        if r < 0.7:
+            return {g.word(): value(depth + 1) for _ in range(g.rng.randint(1, 6))}
+        return [value(depth + 1) for _ in range(g.rng.randint(0, 5))]
+
+    records = []
+    total = 0
+    while total < size:
+        record = {
+            "id": len(records),
+            "name": g.ident(),
+            "tags": [g.word() for _ in range(g.rng.randint(0, 4))],
+            "attributes": value(0),
+        }
+        text = json.dumps(record)
+        total += len(text) + 2
+        records.append(text)
+    return '{"data": [\n' + ",\n".join(records) + '\n]}\n'
+
+
+GENERATORS = [
+    ("bundle.min.js", gen_bundle),
+    ("app.jsx", gen_jsx),
+    ("flow-typed.flow.js", gen_flow),
+    ("declarations.ts", gen_ts),
+    ("large.json", gen_json),
+]
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument(
+        "--scale", type=float, default=2.0,
+        help="approximate size of each file in MB (default 2)")
+    parser.add_argument("out", nargs="?", default=DEFAULT_OUT)
+    args = parser.parse_args(argv)
+
+    os.makedirs(args.out, exist_ok=True)
+    size = int(args.scale * 1024 * 1024)
+    for name, generate in GENERATORS:
+        # Each file has its own stream so that changing one generator does
+        # not change the others.
+        g = Gen(random.Random("%d:%s" % (args.seed, name)))
+        path = os.path.join(args.out, name)
+        with open(path, "w") as f:
+            f.write(generate(g, size))
+        print("%s: %d bytes" % (path, os.path.getsize(path)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Generate the typed Swift view of the AST from ESTree.def.
+
+Every concrete node kind becomes a struct in the `ESTree` namespace that wraps
+an `ESTree.Node` handle and has one accessor per field. Accessors call the
+untyped shims in HermesESTreeBridge.h with the index of the field in the
+ESTree.def entry, which is also how the shims find it.
+
+Usage: gen-swift-estree.py [ESTree.def] [output.swift]
+"""
+
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+DEFAULT_DEF = os.path.join(
+    ROOT, "Sources/cxxHermesForSwift/include/hermes/AST/ESTree.def"
+)
+DEFAULT_OUT = os.path.join(ROOT, "Sources/swift-cpp-hermes/ESTree.swift")
+
+# Field names that must be escaped with backticks in Swift.
+SWIFT_KEYWORDS = {
+    "as", "associatedtype", "async", "await", "break", "case", "catch",
+    "class", "continue", "default", "defer", "deinit", "do", "else", "enum",
+    "extension", "fallthrough", "false", "for", "func", "guard", "if",
+    "import", "in", "init", "inout", "internal", "is", "let", "nil",
+    "operator", "private", "protocol", "public", "repeat", "rethrows",
+    "return", "self", "static", "struct", "subscript", "super", "switch",
+    "throw", "throws", "true", "try", "typealias", "var", "where", "while",
+}
+
+TOKEN_RE = re.compile(
+    r"(?P<if>^#if(?:n?def)?\s+(?P<cond>\w+))"
+    r"|(?P<endif>^#endif)"
+    r"|ESTREE_NODE_(?P<n>\d)_ARGS\s*\((?P<args>[^)]*)\)",
+    re.MULTILINE,
+)
+
+
+class Field:
+    def __init__(self, type, name, optional):
+        self.type = type
+        self.name = name
+        self.optional = optional == "true"
+
+
+class NodeDef:
+    def __init__(self, name, base, fields, conditions):
+        self.name = name
+        self.base = base
+        self.fields = fields
+        self.conditions = conditions
+
+
+def parse_def(text):
+    """Return the node definitions in ESTree.def, in order."""
+    text = re.sub(r"//[^\n]*", "", text)
+    conditions = []
+    nodes = []
+    for m in TOKEN_RE.finditer(text):
+        if m.group("if"):
+            conditions.append(m.group("cond"))
+        elif m.group("endif"):
+            conditions.pop()
+        else:
+            args = [a.strip() for a in m.group("args").split(",")]
+            assert len(args) == 2 + 3 * int(m.group("n")), args
+            fields = [
+                Field(*args[i : i + 3]) for i in range(2, len(args), 3)
+            ]
+            nodes.append(NodeDef(args[0], args[1], fields, list(conditions)))
+    return nodes
+
+
+def swift_name(name):
+    return "`%s`" % name if name in SWIFT_KEYWORDS else name
+
+
+def accessor(field, index):
+    name = swift_name(field.name)
+    if field.type == "NodePtr":
+        if field.optional:
+            return (
+                "public var %s: Node? { Node(hermesNodeGetNode(node.raw, %d)) }"
+                % (name, index)
+            )
+        return (
+            "public var %s: Node { Node(unchecked: hermesNodeGetNode(node.raw, %d)) }"
+            % (name, index)
+        )
+    if field.type == "NodeList":
+        return (
+            "public var %s: NodeList { NodeList(hermesNodeGetList(node.raw, %d)) }"
+            % (name, index)
+        )
+    if field.type in ("NodeLabel", "NodeString"):
+        return (
+            "public var %s: StringView? { StringView(hermesNodeGetString(node.raw, %d)) }"
+            % (name, index)
+        )
+    if field.type == "NodeBoolean":
+        return "public var %s: Bool { hermesNodeGetBoolean(node.raw, %d) }" % (
+            name,
+            index,
+        )
+    if field.type == "NodeNumber":
+        return "public var %s: Double { hermesNodeGetNumber(node.raw, %d) }" % (
+            name,
+            index,
+        )
+    raise ValueError("unknown ESTree field type " + field.type)
+
+
+def generate(nodes):
+    out = [
+        "// Generated by utils/gen-swift-estree.py from ESTree.def. Do not edit.",
+        "",
+        "import cxxHermesForSwift",
+        "",
+        "extension ESTree {",
+    ]
+    for node in nodes:
+        # Cover nodes only exist while parsing and never reach the final AST.
+        if "ESTREE_DEFINE_COVER_NODES" in node.conditions:
+            continue
+        out.append("")
+        if node.conditions:
+            out.append("    // Requires %s." % " && ".join(node.conditions))
+        out.append("    public struct %sNode: TypedNode {" % node.name)
+        out.append(
+            "        public static var kind: hermes.ESTree.NodeKind { .%s }"
+            % node.name
+        )
+        out.append("        public let node: Node")
+        out.append("")
+        out.append("        public init(unchecked node: Node) {")
+        out.append("            self.node = node")
+        out.append("        }")
+        if node.fields:
+            out.append("")
+        for index, field in enumerate(node.fields):
+            out.append("        " + accessor(field, index))
+        out.append("    }")
+    out.append("}")
+    out.append("")
+    return "\n".join(out)
+
+
+def main(argv):
+    def_path = argv[1] if len(argv) > 1 else DEFAULT_DEF
+    out_path = argv[2] if len(argv) > 2 else DEFAULT_OUT
+    with open(def_path) as f:
+        nodes = parse_def(f.read())
+    with open(out_path, "w") as f:
+        f.write(generate(nodes))
+
+
+if __name__ == "__main__":
+    main(sys.argv)
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Generate the Unicode category tables used by CharacterProperties.cpp.
+
+The tables are sorted, non-overlapping ranges of code points, taken from the
+Unicode database of the Python running the script. The letter and space tables
+omit ASCII, which the lexer classifies itself.
+
+Usage: gen-unicode-data.py [output-file]
+"""
+
+import os
+import sys
+import unicodedata
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+DEFAULT_OUTPUT = os.path.join(
+    ROOT,
+    "Sources",
+    "cxxHermesForSwift",
+    "include",
+    "hermes",
+    "Platform",
+    "Unicode",
+    "UnicodeData.inc",
+)
+
+# Table name -> (general categories, extra code points, ASCII too, doc comment).
+TABLES = [
+    (
+        "UNICODE_LETTERS",
+        {"Lu", "Ll", "Lt", "Lm", "Lo", "Nl"},
+        set(),
+        False,
+        "Letters: categories Lu, Ll, Lt, Lm, Lo and Nl.",
+    ),
+    (
+        "UNICODE_SPACES",
+        {"Zs"},
+        # ES14 12.2: <ZWNBSP> is WhiteSpace too.
+        {0xFEFF},
+        False,
+        "White space: category Zs and U+FEFF.",
+    ),
+    (
+        "UNICODE_COMBINING_MARK",
+        {"Mn", "Mc"},
+        set(),
+        True,
+        "Combining marks: categories Mn and Mc.",
+    ),
+    (
+        "UNICODE_DIGIT",
+        {"Nd"},
+        set(),
+        True,
+        "Decimal digits: category Nd.",
+    ),
+    (
+        "UNICODE_CONNECTOR_PUNCTUATION",
+        {"Pc"},
+        set(),
+        True,
+        "Connector punctuation: category Pc.",
+    ),
+]
+
+
+def ranges(categories, extra, ascii):
+    result = []
+    for cp in range(0 if ascii else 0x80, sys.maxunicode + 1):
+        if cp not in extra and unicodedata.category(chr(cp)) not in categories:
+            continue
+        if result and result[-1][1] == cp - 1:
+            result[-1][1] = cp
+        else:
+            result.append([cp, cp])
+    return result
+
+
+def main():
+    output = sys.argv[1] if len(sys.argv) > 1 else DEFAULT_OUTPUT
+    lines = [
+        "/*",
+        " * Copyright (c) Meta Platforms, Inc. and affiliates.",
+        " *",
+        " * This source code is licensed under the MIT license found in the",
+        " * LICENSE file in the root directory of this source tree.",
+        " */",
+        "",
+        "// Generated by utils/gen-unicode-data.py from Unicode %s. Do not edit."
+        % unicodedata.unidata_version,
+        "",
+    ]
+    for name, categories, extra, ascii, doc in TABLES:
+        lines.append("/// %s" % doc)
+        lines.append("static constexpr UnicodeRange %s[] = {" % name)
+        for first, last in ranges(categories, extra, ascii):
+            lines.append("    {0x%04X, 0x%04X}," % (first, last))
+        lines.append("};")
+        lines.append("")
+    with open(output, "w") as f:
+        f.write("\n".join(lines))
+
+
+if __name__ == "__main__":
+    main()